@@ -20,6 +20,7 @@
 #include <ResourceCache.h>
 #include <ScriptCache.h>
 #include <plugins/PluginManager.h>
+#include <shared/StringInterner.h>
 #include <EntityEditFilters.h>
 #include <NetworkingConstants.h>
 #include <hfm/ModelFormatRegistry.h>
@@ -55,6 +56,7 @@ EntityServer::EntityServer(ReceivedMessage& message) :
         PacketType::EntityEdit,
         PacketType::EntityErase,
         PacketType::EntityPhysics,
+        PacketType::EntityPhysicsBatch,
         PacketType::ChallengeOwnership,
         PacketType::ChallengeOwnershipRequest,
         PacketType::ChallengeOwnershipReply },
@@ -76,6 +78,10 @@ EntityServer::~EntityServer() {
 }
 
 void EntityServer::aboutToFinish() {
+    if (_traversalService) {
+        _traversalService->stop();
+    }
+
     DependencyManager::get<ResourceManager>()->cleanup();
 
     DependencyManager::destroy<AssignmentDynamicFactory>();
@@ -336,6 +342,13 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
 
     startDynamicDomainVerification();
 
+    int sharedTraversalThreads = DEFAULT_SHARED_TRAVERSAL_THREADS;
+    readOptionInt("sharedTraversalThreads", settingsSectionObject, sharedTraversalThreads);
+    qDebug("sharedTraversalThreads=%d", sharedTraversalThreads);
+    if (sharedTraversalThreads > 0 && !_traversalService) {
+        _traversalService = std::make_shared<EntityTraversalService>(tree, sharedTraversalThreads);
+    }
+
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
 
@@ -412,6 +425,35 @@ QString EntityServer::serverSubclassStats() {
     statsString += "<b>Entity Server Memory Statistics</b>\r\n";
     statsString += QString().sprintf("EntityTreeElement size... %ld bytes\r\n", sizeof(EntityTreeElement));
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
+    statsString += "\r\n";
+
+    statsString += "Entity Type           Count    Certifiable        Total Bytes    Bytes per Entity\r\n";
+    EntityTreePointer entityTree = std::static_pointer_cast<EntityTree>(_tree);
+    auto memoryStats = entityTree->getMemoryStatsByType();
+    int totalEntities = 0;
+    size_t totalBytes = 0;
+    for (auto itr = memoryStats.cbegin(); itr != memoryStats.cend(); ++itr) {
+        const EntityTree::TypeMemoryStats& typeStats = itr.value();
+        statsString += QString("%1 %2 %3 %4 %5\r\n")
+            .arg(EntityTypes::getEntityTypeName(itr.key()), -16)
+            .arg(locale.toString(typeStats.numEntities), 10)
+            .arg(locale.toString(typeStats.numWithCertifiableProperties), 14)
+            .arg(locale.toString((qulonglong)typeStats.numBytes), 18)
+            .arg(locale.toString((qulonglong)(typeStats.numBytes / std::max(typeStats.numEntities, 1))), 19);
+        totalEntities += typeStats.numEntities;
+        totalBytes += typeStats.numBytes;
+    }
+    statsString += QString("%1 %2 %3 %4\r\n")
+        .arg("Total", -16)
+        .arg(locale.toString(totalEntities), 10)
+        .arg("", 14)
+        .arg(locale.toString((qulonglong)totalBytes), 18);
+
+    auto internerStats = StringInterner::getStats();
+    statsString += QString("Interned strings... %1 (%2 bytes), %3 hits\r\n")
+        .arg(locale.toString((qulonglong)internerStats.numStrings))
+        .arg(locale.toString((qulonglong)internerStats.numBytes))
+        .arg(locale.toString((qulonglong)internerStats.numHits));
     statsString += "\r\n\r\n";
 
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
@@ -455,6 +497,33 @@ QString EntityServer::serverSubclassStats() {
     }
     statsString += "\r\n\r\n";
 
+    if (_traversalService) {
+        auto groupStats = _traversalService->getGroupStats();
+        statsString += "<b>Entity Server Shared Traversal Statistics</b>\r\n";
+        statsString += QString("Worker Threads:  %1    Completed Traversals:  %2\r\n")
+            .arg(_traversalService->getNumWorkers())
+            .arg(locale.toString((qulonglong)_traversalService->getNumTraversals()));
+        statsString += "Group    Viewers    Visible Entities    Generation    "
+                       "Result Age (msecs)    Last Traversal (msecs)    Last Work (msecs)    Slices\r\n";
+        const int STATS_COLUMN_WIDTH = 10;
+        for (size_t i = 0; i < groupStats.size(); ++i) {
+            const auto& stats = groupStats[i];
+            statsString += QString("%1 %2 %3 %4 %5 %6 %7 %8\r\n")
+                .arg(QString::number(i).rightJustified(5, ' '))
+                .arg(QString::number(stats.numClients).rightJustified(STATS_COLUMN_WIDTH, ' '))
+                .arg(locale.toString((qulonglong)stats.numVisibleEntities).rightJustified(STATS_COLUMN_WIDTH * 2, ' '))
+                .arg(locale.toString((qulonglong)stats.generation).rightJustified(STATS_COLUMN_WIDTH + 4, ' '))
+                .arg(locale.toString((double)stats.resultAge / USECS_PER_MSEC, 'f', 1).rightJustified(STATS_COLUMN_WIDTH * 2 + 2, ' '))
+                .arg(locale.toString((double)stats.lastTraversalTime / USECS_PER_MSEC, 'f', 2).rightJustified(STATS_COLUMN_WIDTH * 2 + 6, ' '))
+                .arg(locale.toString((double)stats.lastWorkTime / USECS_PER_MSEC, 'f', 2).rightJustified(STATS_COLUMN_WIDTH * 2 + 1, ' '))
+                .arg(QString::number(stats.lastNumSlices).rightJustified(STATS_COLUMN_WIDTH, ' '));
+        }
+        if (groupStats.empty()) {
+            statsString += "    no view groups... \r\n";
+        }
+        statsString += "\r\n\r\n";
+    }
+
     return statsString;
 }
 
@@ -21,6 +21,7 @@
 #include <SimpleEntitySimulation.h>
 
 #include "EntityServerConsts.h"
+#include "EntityTraversalService.h"
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
 
@@ -59,6 +60,9 @@ public:
 
     virtual void aboutToFinish() override;
 
+    // nullptr when shared traversals are disabled, send threads then traverse the tree on their own
+    EntityTraversalServicePointer getTraversalService() const { return _traversalService; }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -75,6 +79,7 @@ private slots:
 
 private:
     SimpleEntitySimulationPointer _entitySimulation;
+    EntityTraversalServicePointer _traversalService;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
     QReadWriteLock _viewerSendingStatsLock;
@@ -85,6 +90,8 @@ private:
     int _MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 45m
     int _MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 1h
     QTimer _dynamicDomainVerificationTimer;
+
+    static const int DEFAULT_SHARED_TRAVERSAL_THREADS = 0;
     void startDynamicDomainVerification();
 };
 
@@ -0,0 +1,282 @@
+//
+//  EntityTraversalService.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTraversalService.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
+#include <EntityPriorityQueue.h>
+
+#include "../octree/OctreeServerConsts.h"
+
+// time a worker spends on one group before moving on to the next
+const uint64_t TRAVERSAL_SLICE = 1000; // usec
+
+// a group is traversed at most once per send interval...
+const uint64_t MIN_TRAVERSAL_INTERVAL = OCTREE_SEND_INTERVAL_USECS;
+// ...and at least this often, even when the change feed didn't move
+const uint64_t MAX_RESULT_AGE = USECS_PER_SECOND;
+
+class EntityTraversalService::Group {
+public:
+    // guarded by the service mutex
+    DiffTraversal::View view;
+    bool viewChanged { false };
+    int numClients { 0 };
+    bool claimed { false };
+    bool inProgress { false };
+    ResultPointer result;
+    uint64_t generation { 0 };
+    EntityChangeFeed::Sequence resultSequence { 0 };
+    uint64_t resultStartTime { 0 };
+    uint64_t lastTraversalTime { 0 };
+    uint64_t lastWorkTime { 0 };
+    int lastNumSlices { 0 };
+
+    // owned by the worker that claimed the group
+    DiffTraversal traversal;
+    DiffTraversal::View pendingView;
+    DiffTraversal::Type pendingType { DiffTraversal::First };
+    ResultPointer previous;
+    std::shared_ptr<Result> pending;
+    EntityChangeFeed::Sequence pendingSequence { 0 };
+    uint64_t pendingStartTime { 0 };
+    uint64_t pendingWorkTime { 0 };
+    int pendingNumSlices { 0 };
+};
+
+EntityTraversalService::EntityTraversalService(const EntityTreePointer& tree, int numWorkers) : _tree(tree) {
+    numWorkers = std::max(numWorkers, 1);
+    for (int i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+EntityTraversalService::~EntityTraversalService() {
+    stop();
+}
+
+void EntityTraversalService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopping) {
+            return;
+        }
+        _stopping = true;
+    }
+    _workAvailable.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+EntityTraversalService::GroupPointer EntityTraversalService::joinGroup(const DiffTraversal::View& view,
+                                                                       const GroupPointer& currentGroup) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (currentGroup && currentGroup->view.isVerySimilar(view)) {
+        return currentGroup;
+    }
+
+    // hold on to the match itself, leaving the current group below can erase from _groups
+    auto similarGroupItr = std::find_if(_groups.begin(), _groups.end(), [&](const GroupPointer& group) {
+        return group != currentGroup && group->view.isVerySimilar(view);
+    });
+    GroupPointer similarGroup = (similarGroupItr != _groups.end()) ? *similarGroupItr : nullptr;
+    if (!similarGroup && currentGroup && currentGroup->numClients == 1) {
+        // nobody else is looking this way, drag our own group along with the view
+        currentGroup->view = view;
+        currentGroup->viewChanged = true;
+        return currentGroup;
+    }
+
+    if (currentGroup) {
+        if (--currentGroup->numClients == 0) {
+            _groups.erase(std::remove(_groups.begin(), _groups.end(), currentGroup), _groups.end());
+        }
+    }
+
+    GroupPointer group = similarGroup;
+    if (!group) {
+        group = std::make_shared<Group>();
+        group->view = view;
+        _groups.push_back(group);
+    }
+    ++group->numClients;
+    _workAvailable.notify_one();
+    return group;
+}
+
+void EntityTraversalService::leaveGroup(const GroupPointer& group) {
+    if (!group) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (--group->numClients == 0) {
+        _groups.erase(std::remove(_groups.begin(), _groups.end(), group), _groups.end());
+    }
+}
+
+EntityTraversalService::ResultPointer EntityTraversalService::getResult(const GroupPointer& group,
+                                                                        uint64_t& generation) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    generation = group->generation;
+    return group->result;
+}
+
+std::vector<EntityTraversalService::GroupStats> EntityTraversalService::getGroupStats() const {
+    std::vector<GroupStats> stats;
+    uint64_t now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    stats.reserve(_groups.size());
+    for (const auto& group : _groups) {
+        GroupStats groupStats;
+        groupStats.numClients = group->numClients;
+        groupStats.numVisibleEntities = group->result ? group->result->size() : 0;
+        groupStats.generation = group->generation;
+        groupStats.resultAge = group->result ? now - group->resultStartTime : 0;
+        groupStats.lastTraversalTime = group->lastTraversalTime;
+        groupStats.lastWorkTime = group->lastWorkTime;
+        groupStats.lastNumSlices = group->lastNumSlices;
+        stats.push_back(groupStats);
+    }
+    return stats;
+}
+
+EntityTraversalService::GroupPointer EntityTraversalService::claimNextGroup(uint64_t now) {
+    // assumes _mutex is held
+    EntityChangeFeed::Sequence latestSequence = _tree->getChangeFeed().getLatestSequence();
+    size_t numGroups = _groups.size();
+    for (size_t i = 0; i < numGroups; ++i) {
+        size_t index = (_nextGroupIndex + i) % numGroups;
+        const GroupPointer& group = _groups[index];
+        if (group->claimed) {
+            continue;
+        }
+
+        bool needsWork = group->inProgress || !group->result;
+        if (!needsWork) {
+            uint64_t age = now - group->resultStartTime;
+            needsWork = age >= MIN_TRAVERSAL_INTERVAL &&
+                (group->viewChanged || group->resultSequence != latestSequence || age >= MAX_RESULT_AGE);
+        }
+        if (needsWork) {
+            // round-robin so that a large traversal yields to the other groups between slices
+            _nextGroupIndex = index + 1;
+            group->claimed = true;
+            return group;
+        }
+    }
+    return GroupPointer();
+}
+
+void EntityTraversalService::workerLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stopping) {
+        GroupPointer group = claimNextGroup(usecTimestampNow());
+        if (!group) {
+            _workAvailable.wait_for(lock, std::chrono::microseconds(MIN_TRAVERSAL_INTERVAL / 2));
+            continue;
+        }
+
+        bool startTraversal = !group->inProgress;
+        if (startTraversal) {
+            group->pendingView = group->view;
+            group->viewChanged = false;
+            group->previous = group->result;
+            // sample the feed before walking, anything published from here on triggers another traversal
+            group->pendingSequence = _tree->getChangeFeed().getLatestSequence();
+        }
+
+        lock.unlock();
+        runSlice(*group, startTraversal);
+        lock.lock();
+
+        group->inProgress = !group->traversal.finished();
+        if (!group->inProgress) {
+            group->result = group->pending;
+            group->pending.reset();
+            group->previous.reset();
+            ++group->generation;
+            group->resultSequence = group->pendingSequence;
+            group->resultStartTime = group->pendingStartTime;
+            group->lastTraversalTime = usecTimestampNow() - group->pendingStartTime;
+            group->lastWorkTime = group->pendingWorkTime;
+            group->lastNumSlices = group->pendingNumSlices;
+            ++_numTraversals;
+        }
+        group->claimed = false;
+    }
+}
+
+void EntityTraversalService::runSlice(Group& group, bool startTraversal) {
+    uint64_t start = usecTimestampNow();
+    if (startTraversal) {
+        group.pending = std::make_shared<Result>();
+        group.pendingStartTime = start;
+        group.pendingWorkTime = 0;
+        group.pendingNumSlices = 0;
+    }
+
+    _tree->withReadLock([&] {
+        if (startTraversal) {
+            EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_tree->getRoot());
+            if (!root) {
+                return;
+            }
+            // Repeat and Differential traversals only visit what changed or came into view, the rest of the
+            // result is carried over from the previous one once the traversal is done
+            group.pendingType = group.traversal.prepareNewTraversal(group.pendingView, root, !group.previous);
+
+            Result* pending = group.pending.get();
+            DiffTraversal* traversal = &group.traversal;
+            group.traversal.setScanCallback([pending, traversal](DiffTraversal::VisibleElement& next) {
+                next.element->forEachEntity([&](EntityItemPointer entity) {
+                    float priority = traversal->getCurrentView().computePriority(entity);
+                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
+                        pending->emplace_back(entity, priority);
+                    }
+                });
+            });
+        }
+        group.traversal.traverse(TRAVERSAL_SLICE);
+        if (group.traversal.finished() && group.pendingType != DiffTraversal::First && group.previous) {
+            carryOverPreviousResult(group);
+        }
+    });
+
+    group.pendingWorkTime += usecTimestampNow() - start;
+    ++group.pendingNumSlices;
+}
+
+void EntityTraversalService::carryOverPreviousResult(Group& group) {
+    // assumes the tree read lock is held
+    Result& pending = *group.pending;
+    std::unordered_set<const EntityItem*> found;
+    found.reserve(pending.size());
+    for (const auto& visible : pending) {
+        found.insert(visible.entity.get());
+    }
+
+    // what the traversal didn't revisit is still in the result if it's still alive and in view
+    const DiffTraversal::View& view = group.traversal.getCurrentView();
+    for (const auto& visible : *group.previous) {
+        const EntityItemPointer& entity = visible.entity;
+        if (found.count(entity.get()) > 0 || entity->isDead() || !entity->getElement()) {
+            continue;
+        }
+        float priority = view.computePriority(entity);
+        if (priority != PrioritizedEntity::DO_NOT_SEND) {
+            pending.emplace_back(entity, priority);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+//
+//  EntityTraversalService.h
+//  assignment-client/src/entities
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTraversalService_h
+#define hifi_EntityTraversalService_h
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <DiffTraversal.h>
+#include <EntityTree.h>
+
+/// Traverses the entity tree once per group of viewers with similar views, on a fixed pool of worker threads.
+///
+/// Each send thread joins the group whose view is very similar to its own (DiffTraversal::View::isVerySimilar) and
+/// picks up the group's latest result: every entity in view along with its priority.  A group is re-traversed at most
+/// once per send interval, and only when the tree's change feed moved or the result got old.  After the first one,
+/// traversals are Repeat or Differential ones that only visit what changed or came into view, and the rest of the
+/// previous result is carried over while it stays in view.  Workers run traversals in short time slices and resume
+/// them later, rotating between groups so one large view can't starve the others.  Send threads then filter the
+/// shared result against what their own client already knows.
+class EntityTraversalService {
+public:
+    class VisibleEntity {
+    public:
+        VisibleEntity(const EntityItemPointer& entity, float priority) : entity(entity), priority(priority) {}
+        EntityItemPointer entity;
+        float priority;
+    };
+    using Result = std::vector<VisibleEntity>;
+    using ResultPointer = std::shared_ptr<const Result>;
+
+    class Group;
+    using GroupPointer = std::shared_ptr<Group>;
+
+    class GroupStats {
+    public:
+        int numClients { 0 };
+        size_t numVisibleEntities { 0 };
+        uint64_t generation { 0 };
+        uint64_t resultAge { 0 }; // usec since the last result's traversal started
+        uint64_t lastTraversalTime { 0 }; // usec from start to finish of the last traversal
+        uint64_t lastWorkTime { 0 }; // usec spent by workers on the last traversal
+        int lastNumSlices { 0 };
+    };
+
+    EntityTraversalService(const EntityTreePointer& tree, int numWorkers);
+    ~EntityTraversalService();
+
+    /// Returns the group a viewer with this view belongs to.  'currentGroup' is the group the viewer was in until
+    /// now (or nullptr); if its view is no longer similar the viewer leaves it.  A group with a single viewer
+    /// follows that viewer's view instead of being replaced.
+    GroupPointer joinGroup(const DiffTraversal::View& view, const GroupPointer& currentGroup);
+    void leaveGroup(const GroupPointer& group);
+
+    /// Latest completed traversal for the group, nullptr until the first one finishes
+    /// \param[out] generation increases each time the group's result is replaced
+    ResultPointer getResult(const GroupPointer& group, uint64_t& generation) const;
+
+    int getNumWorkers() const { return (int)_workers.size(); }
+    uint64_t getNumTraversals() const { return _numTraversals; }
+    std::vector<GroupStats> getGroupStats() const;
+
+    void stop();
+
+private:
+    void workerLoop();
+    GroupPointer claimNextGroup(uint64_t now);
+    void runSlice(Group& group, bool startTraversal);
+    void carryOverPreviousResult(Group& group);
+
+    EntityTreePointer _tree;
+    std::vector<std::thread> _workers;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::vector<GroupPointer> _groups;
+    size_t _nextGroupIndex { 0 };
+    bool _stopping { false };
+    std::atomic<uint64_t> _numTraversals { 0 };
+};
+
+using EntityTraversalServicePointer = std::shared_ptr<EntityTraversalService>;
+
+#endif // hifi_EntityTraversalService_h
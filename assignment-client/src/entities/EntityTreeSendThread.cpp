@@ -20,6 +20,8 @@
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     OctreeSendThread(myServer, node)
 {
+    _traversalService = static_cast<EntityServer*>(myServer)->getTraversalService();
+
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
 
@@ -28,11 +30,19 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
     connect(nodeData, &EntityNodeData::incomingConnectionIDChanged, this, &EntityTreeSendThread::resetState);
 }
 
+EntityTreeSendThread::~EntityTreeSendThread() {
+    if (_traversalService) {
+        _traversalService->leaveGroup(_traversalGroup);
+    }
+}
+
 void EntityTreeSendThread::resetState() {
     qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
 
     _knownState.clear();
     _traversal.reset();
+    _hasTraversalSequence = false;
+    _sharedResult.reset();
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -99,47 +109,38 @@ void EntityTreeSendThread::preDistributionProcessing() {
     }
 }
 
+DiffTraversal::View EntityTreeSendThread::computeView(OctreeQueryNode* nodeData, bool viewFrustumChanged) const {
+    DiffTraversal::View view;
+    view.viewFrustums = nodeData->getCurrentViews();
+
+    int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
+    view.lodScaleFactor = powf(2.0f, lodLevelOffset);
+    return view;
+}
+
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
-    if (viewFrustumChanged || _traversal.finished()) {
+    if (_traversalService) {
+        collectSharedTraversalResult(nodeData, viewFrustumChanged, isFullScene);
+    } else if (viewFrustumChanged || _traversal.finished()) {
         EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
+        DiffTraversal::View newView = computeView(nodeData, viewFrustumChanged);
+
+        // a Repeat traversal only finds what changed since the last one started, so when the view is static
+        // and the tree's change feed has nothing new since then there is nothing for it to find
+        const EntityChangeFeed& changeFeed = std::static_pointer_cast<EntityTree>(_myServer->getOctree())->getChangeFeed();
+        EntityChangeFeed::Sequence latestSequence = changeFeed.getLatestSequence();
+        bool canSkipTraversal = _hasTraversalSequence && !viewFrustumChanged && !isFullScene &&
+            latestSequence == _traversalSequence && _sendQueue.empty() && _traversal.wouldRepeat(newView);
+        if (!canSkipTraversal) {
+            _traversalSequence = latestSequence;
+            _hasTraversalSequence = true;
+            startNewTraversal(newView, root, isFullScene);
+        }
 
-        DiffTraversal::View newView;
-        newView.viewFrustums = nodeData->getCurrentViews();
-
-        int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
-        newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
-        
-        startNewTraversal(newView, root, isFullScene);
-
-        // When the viewFrustum changed the sort order may be incorrect, so we re-sort
-        // and also use the opportunity to cull anything no longer in view
-        if (viewFrustumChanged && !_sendQueue.empty()) {
-            EntityPriorityQueue prevSendQueue;
-            std::swap(_sendQueue, prevSendQueue);
-            assert(_sendQueue.empty());
-
-            // Re-add elements from previous traversal if they still need to be sent
-            while (!prevSendQueue.empty()) {
-                EntityItemPointer entity = prevSendQueue.top().getEntity();
-                bool forceRemove = prevSendQueue.top().shouldForceRemove();
-                prevSendQueue.pop();
-                if (entity) {
-                    float priority = PrioritizedEntity::DO_NOT_SEND;
-
-                    if (forceRemove) {
-                        priority = PrioritizedEntity::FORCE_REMOVE;
-                    } else {
-                        const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
-                    }
-
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority, forceRemove);
-                    }
-                }
-            }
+        if (viewFrustumChanged) {
+            resortSendQueue();
         }
     }
 
@@ -157,7 +158,8 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
 
     bool sendComplete = OctreeSendThread::traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
 
-    if (sendComplete && nodeData->wantReportInitialCompletion() && _traversal.finished()) {
+    bool traversalFinished = _traversalService ? (bool)_sharedResult : _traversal.finished();
+    if (sendComplete && nodeData->wantReportInitialCompletion() && traversalFinished) {
         // Dealt with all nearby entities.
         nodeData->setReportInitialCompletion(false);
         // initial stats and entity packets are reliable until the initial query is complete
@@ -225,6 +227,82 @@ bool EntityTreeSendThread::addDescendantsToExtraFlaggedEntities(const QUuid& fil
     return hasNewChild || hasNewDescendants;
 }
 
+void EntityTreeSendThread::resortSendQueue() {
+    // When the viewFrustum changed the sort order may be incorrect, so we re-sort
+    // and also use the opportunity to cull anything no longer in view
+    if (_sendQueue.empty()) {
+        return;
+    }
+    EntityPriorityQueue prevSendQueue;
+    std::swap(_sendQueue, prevSendQueue);
+    assert(_sendQueue.empty());
+
+    // Re-add elements from previous traversal if they still need to be sent
+    while (!prevSendQueue.empty()) {
+        EntityItemPointer entity = prevSendQueue.top().getEntity();
+        bool forceRemove = prevSendQueue.top().shouldForceRemove();
+        prevSendQueue.pop();
+        if (entity) {
+            float priority = PrioritizedEntity::DO_NOT_SEND;
+
+            if (forceRemove) {
+                priority = PrioritizedEntity::FORCE_REMOVE;
+            } else {
+                const auto& view = getCurrentView();
+                priority = view.computePriority(entity);
+            }
+
+            if (priority != PrioritizedEntity::DO_NOT_SEND) {
+                _sendQueue.emplace(entity, priority, forceRemove);
+            }
+        }
+    }
+}
+
+void EntityTreeSendThread::collectSharedTraversalResult(OctreeQueryNode* nodeData, bool viewFrustumChanged,
+                                                        bool isFullScene) {
+    _sharedView = computeView(nodeData, viewFrustumChanged);
+    _traversalGroup = _traversalService->joinGroup(_sharedView, _traversalGroup);
+    if (viewFrustumChanged) {
+        resortSendQueue();
+    }
+
+    uint64_t generation;
+    EntityTraversalService::ResultPointer result = _traversalService->getResult(_traversalGroup, generation);
+    if (!result || (result == _sharedResult && !isFullScene)) {
+        // nothing new from our group since we last looked
+        return;
+    }
+
+    if (!_sharedResult || isFullScene) {
+        // the first result we see plays the part of a First traversal
+        _knownState.clear();
+    }
+    _sharedResult = result;
+
+    // the group already culled and prioritized for its view, we only filter against what our client knows
+    for (const auto& visible : *result) {
+        const EntityItemPointer& entity = visible.entity;
+        if (_sendQueue.contains(entity.get())) {
+            continue;
+        }
+        float priority = PrioritizedEntity::DO_NOT_SEND;
+
+        auto knownTimestamp = _knownState.find(entity.get());
+        if (knownTimestamp == _knownState.end()) {
+            priority = visible.priority;
+        } else if (entity->getLastEdited() > knownTimestamp->second ||
+                   entity->getLastChangedOnServer() > knownTimestamp->second) {
+            // it is known and it changed --> put it on the queue with any priority
+            priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+        }
+
+        if (priority != PrioritizedEntity::DO_NOT_SEND) {
+            _sendQueue.emplace(entity, priority);
+        }
+    }
+}
+
 void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
                                              bool forceFirstPass) {
 
@@ -421,7 +499,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
     if (entity) {
         if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
-            const auto& view = _traversal.getCurrentView();
+            const auto& view = getCurrentView();
             float priority = view.computePriority(entity);
 
             // We can force a removal from _knownState if the current view is used and entity is out of view
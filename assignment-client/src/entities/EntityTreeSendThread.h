@@ -15,8 +15,10 @@
 #include <unordered_set>
 
 #include "../octree/OctreeSendThread.h"
+#include "EntityTraversalService.h"
 
 #include <DiffTraversal.h>
+#include <EntityChangeFeed.h>
 #include <EntityPriorityQueue.h>
 #include <shared/ConicalViewFrustum.h>
 
@@ -29,6 +31,7 @@ class EntityTreeSendThread : public OctreeSendThread {
 
 public:
     EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
+    ~EntityTreeSendThread();
 
 protected:
     bool traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
@@ -42,7 +45,11 @@ private:
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
+    DiffTraversal::View computeView(OctreeQueryNode* nodeData, bool viewFrustumChanged) const;
+    const DiffTraversal::View& getCurrentView() const { return _traversalService ? _sharedView : _traversal.getCurrentView(); }
+    void resortSendQueue();
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
+    void collectSharedTraversalResult(OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
     void preDistributionProcessing() override;
@@ -50,6 +57,15 @@ private:
     bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) override { return viewFrustumChanged || _traversal.finished(); }
 
     DiffTraversal _traversal;
+    // sequence of the tree's change feed when the current traversal started
+    EntityChangeFeed::Sequence _traversalSequence { 0 };
+    bool _hasTraversalSequence { false };
+
+    // when the server shares traversals between similar views we read our group's result instead of using _traversal
+    EntityTraversalServicePointer _traversalService;
+    EntityTraversalService::GroupPointer _traversalGroup;
+    EntityTraversalService::ResultPointer _sharedResult;
+    DiffTraversal::View _sharedView;
     EntityPriorityQueue _sendQueue;
     std::unordered_map<EntityItem*, uint64_t> _knownState;
 
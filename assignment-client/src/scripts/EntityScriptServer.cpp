@@ -125,7 +125,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        ScriptEnginePointer engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -154,6 +155,19 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    static const QString NUM_SCRIPT_ENGINES_OPTION = "num_script_engines";
+    static const QString SCRIPT_ENGINE_ASSIGNMENT_OPTION = "script_engine_assignment";
+    static const QString LOAD_BALANCED_ASSIGNMENT = "load";
+
+    if (entityScriptServerSettings.contains(SCRIPT_ENGINE_ASSIGNMENT_OPTION)) {
+        bool balanceByLoad = entityScriptServerSettings[SCRIPT_ENGINE_ASSIGNMENT_OPTION].toString() == LOAD_BALANCED_ASSIGNMENT;
+        _entitiesScriptEngineAssignment = balanceByLoad ?
+            EntityScriptEnginePool::Assignment::Load : EntityScriptEnginePool::Assignment::Hash;
+    }
+    if (entityScriptServerSettings.contains(NUM_SCRIPT_ENGINES_OPTION)) {
+        resizeEntitiesScriptEngines(entityScriptServerSettings[NUM_SCRIPT_ENGINES_OPTION].toInt());
+    }
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -170,7 +184,10 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = 0;
+    for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -231,7 +248,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -245,7 +262,8 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        // goes to whichever engine runs the entity's script
+        _entitiesScriptEngines->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -276,8 +294,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -439,9 +457,11 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+ScriptEnginePointer EntityScriptServer::createEntitiesScriptEngine(bool drivesEntityTree) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
+    // only a pool of engines balances scripts by their run time
+    newEngine->setTrackEntityScriptRunTimes(_numEntitiesScriptEngines > 1);
 
     auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
     newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
@@ -456,48 +476,88 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->preUpdate();
-        _entityViewer.getTree()->update();
-    });
+    if (drivesEntityTree) {
+        connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->preUpdate();
+            _entityViewer.getTree()->update();
+        });
+    }
 
     scriptEngines->runScriptInitializers(newEngine);
     newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngineSP);
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+    connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+            this, &EntityScriptServer::updateEntityPPS);
+    return newEngine;
+}
+
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated,
                    this, &EntityScriptServer::updateEntityPPS);
     }
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    std::vector<ScriptEnginePointer> newEngines;
+    for (int i = 0; i < _numEntitiesScriptEngines; ++i) {
+        // only the first engine's update drives the tree, the others just run scripts
+        newEngines.push_back(createEntitiesScriptEngine(i == 0));
+    }
+    _entitiesScriptEngines->setEngines(newEngines);
+
+    // calls from scripts to entity methods are routed by the pool to the engine running the target entity's script
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(_entitiesScriptEngines);
 }
 
+void EntityScriptServer::resizeEntitiesScriptEngines(int numEngines) {
+    numEngines = std::max(numEngines, 1);
+    if (numEngines == _numEntitiesScriptEngines) {
+        return;
+    }
+    qCDebug(entity_script_server) << "Running entity scripts on" << numEngines << "script engines";
+    _numEntitiesScriptEngines = numEngines;
 
-void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    if (_shuttingDown || _entitiesScriptEngines->getNumEngines() == 0) {
+        return;
+    }
+
+    // start over with the new engines and reload every script that was loaded, reassigning them as we go
+    QList<EntityItemID> entityIDs = _entitiesScriptEngines->getAssignedEntities();
+    stopEntitiesScriptEngines();
+    resetEntitiesScriptEngines();
+    for (const auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
+    }
+}
+
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    auto engines = _entitiesScriptEngines->getEngines();
+    for (const auto& engine : engines) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+        engine->unloadAllEntityScripts();
+        engine->stop();
+    }
+    for (const auto& engine : engines) {
+        engine->waitTillDoneRunning();
     }
+    _entitiesScriptEngines->setEngines(std::vector<ScriptEnginePointer>());
+}
+
+void EntityScriptServer::clear() {
+    // unload and stop the engines
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -506,9 +566,11 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    // drop the engines and everything the pool knew about their scripts
+    _entitiesScriptEngines->clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    entityScriptingInterface->setEntitiesScriptEngine(QSharedPointer<EntitiesScriptEngineProvider>());
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
     entityScriptingInterface->setEntityTree(nullptr);
 
@@ -524,8 +586,12 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown) {
+        ScriptEnginePointer engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+        if (engine) {
+            engine->unloadEntityScript(entityID, true);
+        }
+        _entitiesScriptEngines->forgetEntity(entityID);
     }
 }
 
@@ -536,20 +602,26 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines->getNumEngines() > 0) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
+        ScriptEnginePointer engine = _entitiesScriptEngines->getEngineForEntity(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool isRunning = engine && engine->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
-            if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+            if (engine) {
+                // also when the load is still queued on the engine, the unload is queued behind it
+                engine->unloadEntityScript(entityID, true);
+                _entitiesScriptEngines->unassign(entityID);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                // a (re)load is where a script may move to another engine
+                int engineIndex = _entitiesScriptEngines->selectEngine(entityID, _entitiesScriptEngineAssignment);
+                _entitiesScriptEngines->assign(entityID, engineIndex);
+                _entitiesScriptEngines->getEngine(engineIndex)->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
@@ -565,12 +637,32 @@ void EntityScriptServer::sendStatsPacket() {
     statsObject["octree_stats"] = octreeStats;
 
     QJsonObject scriptEngineStats;
+    _entitiesScriptEngines->updateRunTimes();
+
     int numberRunningScripts = 0;
-    const auto scriptEngine = _entitiesScriptEngine;
-    if (scriptEngine) {
-        numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
+    QJsonObject enginesObject;
+    auto engineStats = _entitiesScriptEngines->getEngineStats();
+    for (size_t i = 0; i < engineStats.size(); ++i) {
+        QJsonObject engineObject;
+        engineObject["number_scripts"] = engineStats[i].numScripts;
+        engineObject["number_running_scripts"] = engineStats[i].numRunningScripts;
+        engineObject["script_usecs_per_second"] = (double)engineStats[i].runTimePerSecond;
+        enginesObject[QString("engine_%1").arg(i)] = engineObject;
+        numberRunningScripts += engineStats[i].numRunningScripts;
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
+    scriptEngineStats["engines"] = enginesObject;
+
+    static const size_t MAX_REPORTED_SCRIPTS = 10;
+    QJsonObject busiestScriptsObject;
+    for (const auto& script : _entitiesScriptEngines->getBusiestScripts(MAX_REPORTED_SCRIPTS)) {
+        QJsonObject scriptObject;
+        scriptObject["engine"] = script.engineIndex;
+        scriptObject["usecs_per_second"] = (double)script.runTimePerSecond;
+        scriptObject["total_msecs"] = (double)(script.runTime / USECS_PER_MSEC);
+        busiestScriptsObject[uuidStringWithoutCurlyBraces(script.entityID)] = scriptObject;
+    }
+    scriptEngineStats["busiest_scripts"] = busiestScriptsObject;
     statsObject["script_engine_stats"] = scriptEngineStats;
     
 
@@ -19,6 +19,7 @@
 #include <QtCore/QUuid>
 
 #include <EntityEditPacketSender.h>
+#include <EntityScriptEnginePool.h>
 #include <plugins/CodecPlugin.h>
 #include <ScriptEngine.h>
 #include <SimpleEntitySimulation.h>
@@ -34,6 +35,8 @@ public:
 
     virtual void aboutToFinish() override;
 
+    static const int DEFAULT_NUM_ENTITY_SCRIPT_ENGINES = 1;
+
 public slots:
     void run() override;
     void nodeActivated(SharedNodePointer activatedNode);
@@ -61,7 +64,10 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    ScriptEnginePointer createEntitiesScriptEngine(bool drivesEntityTree);
+    void resetEntitiesScriptEngines();
+    void resizeEntitiesScriptEngines(int numEngines);
+    void stopEntitiesScriptEngines();
     void clear();
     void shutdownScriptEngine();
 
@@ -75,7 +81,9 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    EntityScriptEnginePoolPointer _entitiesScriptEngines { new EntityScriptEnginePool() };
+    int _numEntitiesScriptEngines { DEFAULT_NUM_ENTITY_SCRIPT_ENGINES };
+    EntityScriptEnginePool::Assignment _entitiesScriptEngineAssignment { EntityScriptEnginePool::Assignment::Hash };
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
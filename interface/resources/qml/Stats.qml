@@ -71,6 +71,11 @@ Item {
                     StatText {
                         text: "Physics Object Count: " + root.physicsObjectCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "  Shape Cache Hits / Misses / Writes: " + root.collisionShapeCacheHits + " / " +
+                            root.collisionShapeCacheMisses + " / " + root.collisionShapeCacheWrites
+                    }
                     StatText {
                         visible: root.expanded
                         text: root.gameUpdateStats
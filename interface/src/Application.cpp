@@ -1492,6 +1492,12 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     }
     ResourceCache::setRequestLimit(concurrentDownloads);
 
+    QString concurrentDownloadsPerOriginStr = getCmdOption(argc, constArgv, "--concurrent-downloads-per-origin");
+    uint32_t concurrentDownloadsPerOrigin = concurrentDownloadsPerOriginStr.toUInt(&success);
+    if (success) {
+        ResourceCache::setOriginRequestLimit(concurrentDownloadsPerOrigin);
+    }
+
     // perhaps override the avatar url.  Since we will test later for validity
     // we don't need to do so here.
     QString avatarURL = getCmdOption(argc, constArgv, "--avatarURL");
@@ -5587,7 +5593,15 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    auto processedModelCache = std::make_shared<ProcessedModelCache>();
+    processedModelCache->initialize();
+    DependencyManager::get<ModelCache>()->setProcessedModelCache(processedModelCache);
+
+    auto collisionShapeCache = std::make_shared<CollisionShapeCache>();
+    collisionShapeCache->initialize();
+    _shapeManager.setCollisionShapeCache(collisionShapeCache);
     ObjectMotionState::setShapeManager(&_shapeManager);
+    setMultithreadedPhysics(Menu::getInstance()->isOptionChecked(MenuOption::PhysicsMultithreaded));
     _physicsEngine->init();
 
     EntityTreePointer tree = getEntities()->getTree();
@@ -9018,6 +9032,13 @@ void Application::setShowBulletConstraintLimits(bool value) {
     _physicsEngine->setShowBulletConstraintLimits(value);
 }
 
+void Application::setMultithreadedPhysics(bool value) {
+    // leave cores for the main, render and audio threads
+    const int NUM_RESERVED_CORES = 3;
+    int numThreads = value ? std::max(2, QThread::idealThreadCount() - NUM_RESERVED_CORES) : 1;
+    PhysicsEngine::setNumSimulationThreads(numThreads);
+}
+
 void Application::createLoginDialog() {
     const glm::vec3 LOGIN_DIMENSIONS { 0.89f, 0.5f, 0.01f };
     const auto OFFSET = glm::vec2(0.7f, -0.1f);
@@ -202,6 +202,7 @@ public:
     size_t getRenderFrameCount() const { return _graphicsEngine.getRenderFrameCount(); }
     float getRenderLoopRate() const { return _graphicsEngine.getRenderLoopRate(); }
     float getNumCollisionObjects() const;
+    const ShapeManager& getShapeManager() const { return _shapeManager; }
     float getTargetRenderFrameRate() const; // frames/second
 
     static void setupQmlSurface(QQmlContext* surfaceContext, bool setAdditionalContextProperties);
@@ -537,6 +538,7 @@ private slots:
     void setShowBulletContactPoints(bool value);
     void setShowBulletConstraints(bool value);
     void setShowBulletConstraintLimits(bool value);
+    void setMultithreadedPhysics(bool value);
 
     void onDismissedLoginDialog();
 
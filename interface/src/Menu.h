@@ -34,6 +34,8 @@ namespace MenuOption {
     const QString AnimDebugDrawDefaultPose = "Debug Draw Default Pose";
     const QString AnimDebugDrawPosition= "Debug Draw Position";
     const QString AnimDebugDrawOtherSkeletons = "Debug Draw Other Skeletons";
+    const QString AnimOtherAvatarsLOD = "Other Avatar Animation LOD";
+    const QString AnimOtherAvatarsMultithreaded = "Multithreaded Other Avatar Animation";
     const QString AskToResetSettings = "Ask To Reset Settings on Start";
     const QString AssetMigration = "ATP Asset Migration";
     const QString AssetServer = "Asset Browser";
@@ -152,6 +154,7 @@ namespace MenuOption {
     const QString PhysicsShowBulletContactPoints = "Show Bullet Contact Points";
     const QString PhysicsShowBulletConstraints = "Show Bullet Constraints";
     const QString PhysicsShowBulletConstraintLimits = "Show Bullet Constraint Limits";
+    const QString PhysicsMultithreaded = "Multithreaded Physics";
     const QString PipelineWarnings = "Log Render Pipeline Warnings";
     const QString Preferences = "General...";
     const QString Quit =  "Quit";
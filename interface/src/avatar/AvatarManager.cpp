@@ -35,6 +35,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -123,6 +124,8 @@ void AvatarManager::init() {
     }
 
     setEnableDebugDrawOtherSkeletons(Menu::getInstance()->isOptionChecked(MenuOption::AnimDebugDrawOtherSkeletons));
+    setEnableParallelAnimation(Menu::getInstance()->isOptionChecked(MenuOption::AnimOtherAvatarsMultithreaded));
+    setEnableAnimationLOD(Menu::getInstance()->isOptionChecked(MenuOption::AnimOtherAvatarsLOD));
 }
 
 void AvatarManager::setSpace(workload::SpacePointer& space ) {
@@ -272,6 +275,12 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         // DO NOT update _myAvatar!  Its update has already been done earlier in the main loop.
         // DO NOT update or fade out uninitialized Avatars
         if (avatar != _myAvatar && avatar->isInitialized() && !nodeList->isPersonalMutingNode(avatar->getID())) {
+            auto otherAvatar = std::static_pointer_cast<OtherAvatar>(avatar);
+            if (_enableAnimationLOD) {
+                otherAvatar->updateAnimationLOD(views, avatar->getHasPriority());
+            } else {
+                otherAvatar->setAnimationLOD(AnimationLOD::Full);
+            }
             if (avatar->getHasPriority()) {
                 avatarPriorityQueues[kHero].push(SortableAvatar(avatar));
             } else {
@@ -283,6 +292,29 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     _numHeroAvatars = (int)avatarPriorityQueues[kHero].size();
 
+    // Pose the joints of the avatars in view in parallel: each one only touches its own rig.  The rest of
+    // their update (and the joints of any avatar left out here) happens in simulate() below, on this thread.
+    std::vector<OtherAvatarPointer> jointUpdates;
+    if (_enableParallelAnimation) {
+        for (int p = kHero; p < NumVariants; p++) {
+            for (const auto& sortData : avatarPriorityQueues[p].getSortedVector()) {
+                const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+                if (sortData.getPriority() > OUT_OF_VIEW_THRESHOLD && avatar->getSkeletonModel()->isLoaded() &&
+                        avatar->needsJointUpdate()) {
+                    jointUpdates.push_back(avatar);
+                }
+            }
+        }
+    }
+    if (jointUpdates.size() > 1) {
+        PROFILE_RANGE(simulation, "computeJointPoses");
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, jointUpdates.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                jointUpdates[i]->computeJointPoses();
+            }
+        });
+    }
+
     // process in sorted order
     uint64_t startTime = usecTimestampNow();
 
@@ -341,7 +373,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->setIsNewAvatar(false);
                 }
                 avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
+                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1 &&
+                        avatar->getAnimationLOD() != AnimationLOD::Low) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
                 if (_drawOtherAvatarSkeletons) {
@@ -386,6 +419,11 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
     }
 
+    // avatars posed above but left out of simulate() by the time budget get posed again on their next update
+    for (auto& avatar : jointUpdates) {
+        avatar->_jointPosesComputed = false;
+    }
+
     if (_shouldRender) {
         qApp->getMain3DScene()->enqueueTransaction(renderTransaction);
     }
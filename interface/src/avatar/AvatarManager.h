@@ -271,6 +271,26 @@ public slots:
         _drawOtherAvatarSkeletons = isEnabled;
     }
 
+    /**jsdoc
+    * Poses other avatars' joints on worker threads, ahead of the rest of their update on the main thread.
+    * @function AvatarManager.setEnableParallelAnimation
+    * @param {boolean} enabled - <code>true</code> to pose the joints in parallel, <code>false</code> to pose them on the
+    *     main thread.
+    */
+    void setEnableParallelAnimation(bool isEnabled) {
+        _enableParallelAnimation = isEnabled;
+    }
+
+    /**jsdoc
+    * Lowers the animation update rate and detail of other avatars that are far away or small on screen.
+    * @function AvatarManager.setEnableAnimationLOD
+    * @param {boolean} enabled - <code>true</code> to pick the animation detail of other avatars from their distance and
+    *     size on screen, <code>false</code> to animate them all in full.
+    */
+    void setEnableAnimationLOD(bool isEnabled) {
+        _enableAnimationLOD = isEnabled;
+    }
+
 protected:
     AvatarSharedPointer addAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer) override;
     DetailedMotionState* createDetailedMotionState(OtherAvatarPointer avatar, int32_t jointIndex);
@@ -313,6 +333,8 @@ private:
 
     AvatarTransit::TransitConfig  _transitConfig;
     bool _drawOtherAvatarSkeletons { false };
+    bool _enableParallelAnimation { false };
+    bool _enableAnimationLOD { false };
 };
 
 #endif // hifi_AvatarManager_h
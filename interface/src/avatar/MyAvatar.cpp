@@ -98,13 +98,13 @@ static const QString USER_RECENTER_MODEL_FORCE_STAND = QStringLiteral("ForceStan
 static const QString USER_RECENTER_MODEL_AUTO = QStringLiteral("Auto");
 static const QString USER_RECENTER_MODEL_DISABLE_HMD_LEAN = QStringLiteral("DisableHMDLean");
 
-const QString HEAD_BLEND_DIRECTIONAL_ALPHA_NAME = "lookAroundAlpha";
-const QString HEAD_BLEND_LINEAR_ALPHA_NAME = "lookBlendAlpha";
-const QString SEATED_HEAD_BLEND_LINEAR_ALPHA_NAME = "seatedLookBlendAlpha";
+const AnimVariantKey HEAD_BLEND_DIRECTIONAL_ALPHA_NAME("lookAroundAlpha");
+const AnimVariantKey HEAD_BLEND_LINEAR_ALPHA_NAME("lookBlendAlpha");
+const AnimVariantKey SEATED_HEAD_BLEND_LINEAR_ALPHA_NAME("seatedLookBlendAlpha");
 
 const QString POINT_REACTION_NAME = "point";
-const QString POINT_BLEND_DIRECTIONAL_ALPHA_NAME = "pointAroundAlpha";
-const QString POINT_BLEND_LINEAR_ALPHA_NAME = "pointBlendAlpha";
+const AnimVariantKey POINT_BLEND_DIRECTIONAL_ALPHA_NAME("pointAroundAlpha");
+const AnimVariantKey POINT_BLEND_LINEAR_ALPHA_NAME("pointBlendAlpha");
 const QString POINT_REF_JOINT_NAME = "RightShoulder";
 const float POINT_ALPHA_BLENDING = 1.0f;
 
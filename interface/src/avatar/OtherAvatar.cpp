@@ -261,10 +261,12 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
         PROFILE_RANGE(simulation, "updateJoints");
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            _skeletonModel->setEnableEyeLookAt(_animationLOD.getLevel() == AnimationLOD::Full);
+            if (needsJointUpdate()) {
+                if (!_jointPosesComputed) {
+                    computeJointPoses();
+                }
+                _animationLOD.jointsUpdated();
                 _jointDataSimulationRate.increment();
 
                 head->simulate(deltaTime);
@@ -279,6 +281,7 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
                 }
                 head->setPosition(headPosition);
             } else {
+                _animationLOD.jointsSkipped();
                 head->simulate(deltaTime);
                 _skeletonModel->simulate(deltaTime, false);
             }
@@ -289,6 +292,7 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
             _skeletonModel->simulate(deltaTime, false);
         }
         _skeletonModelSimulationRate.increment();
+        _jointPosesComputed = false;
     }
 
     // update animation for display name fade in/out
@@ -326,6 +330,22 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     }
 }
 
+void OtherAvatar::updateAnimationLOD(const ConicalViewFrustums& views, bool isHero) {
+    _animationLOD.update(views, getWorldPosition(), getBoundingRadius(), isHero);
+}
+
+bool OtherAvatar::needsJointUpdate() const {
+    return _transit.isActive() || _animationLOD.isJointUpdateDue(_hasNewJointData);
+}
+
+void OtherAvatar::computeJointPoses() {
+    PROFILE_RANGE(simulation, "computeJointPoses");
+    // the network thread writes _jointData under its lock, so work from a (shared) copy
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computePosesFromJointData(getJointData(), rootTransform);
+    _jointPosesComputed = true;
+}
+
 void OtherAvatar::debugJointData() const {
     // Get a copy of the joint data
     auto jointData = getJointData();
@@ -12,7 +12,9 @@
 #include <memory>
 #include <vector>
 
+#include <AnimationLOD.h>
 #include <avatars-renderer/Avatar.h>
+#include <shared/ConicalViewFrustum.h>
 #include <workload/Space.h>
 
 #include "InterfaceLogging.h"
@@ -64,6 +66,17 @@ public:
     void setCollisionWithOtherAvatarsFlags() override;
 
     void simulate(float deltaTime, bool inView) override;
+
+    void updateAnimationLOD(const ConicalViewFrustums& views, bool isHero);
+    AnimationLOD::Level getAnimationLOD() const { return _animationLOD.getLevel(); }
+    void setAnimationLOD(AnimationLOD::Level level) { _animationLOD.setLevel(level); }
+
+    // true when simulate() will pose the joints from the network joint data
+    bool needsJointUpdate() const;
+    // Poses the rig from a snapshot of the network joint data.  Touches nothing but this avatar's rig, so avatars
+    // can run it in parallel on worker threads ahead of simulate(), which then skips the work.
+    void computeJointPoses();
+
     void debugJointData() const;
     friend AvatarManager;
 
@@ -90,6 +103,8 @@ protected:
     int32_t _spaceIndex { -1 };
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
+    AnimationLOD _animationLOD;
+    bool _jointPosesComputed { false };
     bool _needsDetailedRebuild { false };
 };
 
@@ -127,6 +127,10 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
     STAT_UPDATE(heroAvatarCount, avatarManager->getNumHeroAvatars());
     STAT_UPDATE(physicsObjectCount, qApp->getNumCollisionObjects());
+    const ShapeManager& shapeManager = qApp->getShapeManager();
+    STAT_UPDATE(collisionShapeCacheHits, (int)shapeManager.getNumDiskCacheHits());
+    STAT_UPDATE(collisionShapeCacheMisses, (int)shapeManager.getNumDiskCacheMisses());
+    STAT_UPDATE(collisionShapeCacheWrites, (int)shapeManager.getNumDiskCacheWrites());
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
@@ -87,6 +87,13 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} physicsObjectCount - The number of objects that have collisions enabled.
  *     <em>Read-only.</em>
+ * @property {number} collisionShapeCacheHits - The number of collision shapes loaded from the disk cache.
+ *     <em>Read-only.</em>
+ * @property {number} collisionShapeCacheMisses - The number of collision shapes the disk cache didn't have, or had damaged
+ *     entries for.
+ *     <em>Read-only.</em>
+ * @property {number} collisionShapeCacheWrites - The number of collision shapes written to the disk cache.
+ *     <em>Read-only.</em>
  * @property {number} updatedAvatarCount - The number of avatars in the domain, other than the client's, that were updated in 
  *     the most recent game loop.
  *     <em>Read-only.</em>
@@ -481,6 +488,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, uxMode, QString())
     STATS_PROPERTY(int, heroAvatarCount, 0)
     STATS_PROPERTY(int, physicsObjectCount, 0)
+    STATS_PROPERTY(int, collisionShapeCacheHits, 0)
+    STATS_PROPERTY(int, collisionShapeCacheMisses, 0)
+    STATS_PROPERTY(int, collisionShapeCacheWrites, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
@@ -789,6 +799,27 @@ signals:
      */
     void physicsObjectCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>collisionShapeCacheHits</code> property changes.
+     * @function Stats.collisionShapeCacheHitsChanged
+     * @returns {Signal}
+     */
+    void collisionShapeCacheHitsChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>collisionShapeCacheMisses</code> property changes.
+     * @function Stats.collisionShapeCacheMissesChanged
+     * @returns {Signal}
+     */
+    void collisionShapeCacheMissesChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>collisionShapeCacheWrites</code> property changes.
+     * @function Stats.collisionShapeCacheWritesChanged
+     * @returns {Signal}
+     */
+    void collisionShapeCacheWritesChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>updatedAvatarCount</code> property changes.
      * @function Stats.updatedAvatarCountChanged
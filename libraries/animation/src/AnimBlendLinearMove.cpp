@@ -18,6 +18,7 @@ AnimBlendLinearMove::AnimBlendLinearMove(const QString& id, float alpha, float d
     AnimNode(AnimNode::Type::BlendLinearMove, id),
     _alpha(alpha),
     _desiredSpeed(desiredSpeed),
+    _speedVar(QString("moveForwardSpeed")),
     _characteristicSpeeds(characteristicSpeeds) {
 
 }
@@ -26,6 +27,18 @@ AnimBlendLinearMove::~AnimBlendLinearMove() {
 
 }
 
+void AnimBlendLinearMove::setAlphaVar(const QString& alphaVar) {
+    _alphaVar = alphaVar;
+    if (_alphaVar.contains("Lateral")) {
+        _speedVar = AnimVariantKey(QString("moveLateralSpeed"));
+    } else if (_alphaVar.contains("Backward")) {
+        _speedVar = AnimVariantKey(QString("moveBackwardSpeed"));
+    } else {
+        //this is forward movement
+        _speedVar = AnimVariantKey(QString("moveForwardSpeed"));
+    }
+}
+
 static float calculateAlpha(const float speed, const std::vector<float>& characteristicSpeeds) {
 
     assert(characteristicSpeeds.size() > 0);
@@ -52,15 +65,7 @@ const AnimPoseVec& AnimBlendLinearMove::evaluate(const AnimVariantMap& animVars,
 
     _desiredSpeed = animVars.lookup(_desiredSpeedVar, _desiredSpeed);
 
-    float speed = 0.0f;
-    if (_alphaVar.contains("Lateral")) {
-        speed = animVars.lookup("moveLateralSpeed", speed);
-    } else if (_alphaVar.contains("Backward")) {
-        speed = animVars.lookup("moveBackwardSpeed", speed);
-    } else {
-        //this is forward movement
-        speed = animVars.lookup("moveForwardSpeed", speed);
-    }
+    float speed = animVars.lookup(_speedVar, 0.0f);
     _alpha = calculateAlpha(speed, _characteristicSpeeds);
     float parentDebugAlpha = context.getDebugAlpha(_id);
 
@@ -41,7 +41,7 @@ public:
 
     virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
 
-    void setAlphaVar(const QString& alphaVar) { _alphaVar = alphaVar; }
+    void setAlphaVar(const QString& alphaVar);
     void setDesiredSpeedVar(const QString& desiredSpeedVar) { _desiredSpeedVar = desiredSpeedVar; }
 
 protected:
@@ -65,7 +65,8 @@ protected:
     float _phase = 0.0f;
 
     QString _alphaVar;
-    QString _desiredSpeedVar;
+    AnimVariantKey _desiredSpeedVar;
+    AnimVariantKey _speedVar; // picked by the name of the alpha var
 
     std::vector<float> _characteristicSpeeds;
 
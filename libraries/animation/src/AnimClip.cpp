@@ -261,51 +261,16 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame, dt, _loopFlag, _id, triggersOut);
 
     // poll network anim to see if it's finished loading yet.
-    if (_blendType == AnimBlendType_Normal) {
-        if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            _mirrorAnim.clear();
-
-            _poses.resize(_skeleton->getNumJoints());
-        }
-    } else {
-        // an additive blend type
-        if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            // TODO: handle mirrored relative animations.
-            _mirrorAnim.clear();
-
-            _poses.resize(_skeleton->getNumJoints());
-
-            // copy & retarget baseAnim!
-            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
-
-            if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
-            } else {
-                // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
-            }
-        }
+    if (_networkAnim && _networkAnim->isLoaded() && _skeleton &&
+        (_blendType == AnimBlendType_Normal || (_baseNetworkAnim && _baseNetworkAnim->isLoaded()))) {
+        loadClipData();
     }
 
-    if (_anim.size()) {
+    if (_clipData && _clipData->getNumFrames() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
-            buildMirrorAnim();
+        if (_mirrorFlag && !_mirrorClipData) {
+            loadMirrorClipData();
         }
 
         int prevIndex = (int)glm::floor(_frame);
@@ -318,15 +283,14 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _clipData->getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        const AnimClipData& clipData = _mirrorFlag ? *_mirrorClipData : *_clipData;
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        clipData.sample(prevIndex, nextIndex, alpha, &_poses[0]);
     }
 
     processOutputJoints(triggersOut);
@@ -341,15 +305,65 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
-void AnimClip::buildMirrorAnim() {
+void AnimClip::loadClipData() {
     assert(_skeleton);
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    // clips are shared by url, skeleton and the options that change their frames.
+    _clipDataKey = QString("%1|%2|%3").arg(_url).arg(AnimClipData::getSkeletonKey(*_skeleton)).arg((int)_blendType);
+    if (_blendType != AnimBlendType_Normal) {
+        _clipDataKey += QString("|%1|%2").arg(_baseURL).arg(_baseFrame);
     }
+
+    AnimationPointer networkAnim = _networkAnim;
+    AnimationPointer baseNetworkAnim = _baseNetworkAnim;
+    AnimSkeleton::ConstPointer skeleton = _skeleton;
+    AnimBlendType blendType = _blendType;
+    float baseFrame = _baseFrame;
+    _clipData = DependencyManager::get<AnimationCache>()->getClipData(_clipDataKey, [=] {
+        // loading is complete, copy & retarget animation.
+        auto anim = copyAndRetargetFromNetworkAnim(networkAnim, skeleton);
+
+        if (blendType != AnimBlendType_Normal) {
+            // copy & retarget baseAnim!
+            auto baseAnim = copyAndRetargetFromNetworkAnim(baseNetworkAnim, skeleton);
+            if (!baseAnim.empty()) {
+                int baseIndex = std::min(std::max(0, (int)baseFrame), (int)baseAnim.size() - 1);
+                if (blendType == AnimBlendType_AddAbsolute) {
+                    bakeAbsoluteDeltaAnim(anim, baseAnim[baseIndex], skeleton);
+                } else {
+                    // AnimBlendType_AddRelative
+                    bakeRelativeDeltaAnim(anim, baseAnim[baseIndex]);
+                }
+            }
+        }
+        float unitScale = extractScale(skeleton->getGeometryOffset()).y;
+        return std::make_shared<const AnimClipData>(anim, unitScale);
+    });
+
+    // we no longer need the actual animation resource anymore.
+    _networkAnim.reset();
+
+    // mirror clip will be re-built on demand, if needed.
+    // TODO: handle mirrored relative animations.
+    _mirrorClipData.reset();
+
+    _poses.resize(_skeleton->getNumJoints());
+}
+
+void AnimClip::loadMirrorClipData() {
+    assert(_skeleton && _clipData);
+
+    AnimClipData::ConstPointer clipData = _clipData;
+    AnimSkeleton::ConstPointer skeleton = _skeleton;
+    _mirrorClipData = DependencyManager::get<AnimationCache>()->getClipData(_clipDataKey + "|mirror", [=] {
+        // mirrored from the decompressed frames, so its error can be up to twice the tolerance.
+        auto anim = clipData->decompress();
+        for (auto& relPoses : anim) {
+            skeleton->mirrorRelativePoses(relPoses);
+        }
+        float unitScale = extractScale(skeleton->getGeometryOffset()).y;
+        return std::make_shared<const AnimClipData>(anim, unitScale);
+    });
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
@@ -61,7 +61,8 @@ protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
-    void buildMirrorAnim();
+    void loadClipData();
+    void loadMirrorClipData();
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
@@ -71,9 +72,10 @@ protected:
 
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // compressed frames, shared with every other clip playing this animation on the same skeleton
+    AnimClipData::ConstPointer _clipData;
+    AnimClipData::ConstPointer _mirrorClipData;
+    QString _clipDataKey;
 
     QString _url;
     float _startFrame;
@@ -86,12 +88,12 @@ protected:
     QString _baseURL;
     float _baseFrame;
 
-    QString _startFrameVar;
-    QString _endFrameVar;
-    QString _timeScaleVar;
-    QString _loopFlagVar;
-    QString _mirrorFlagVar;
-    QString _frameVar;
+    AnimVariantKey _startFrameVar;
+    AnimVariantKey _endFrameVar;
+    AnimVariantKey _timeScaleVar;
+    AnimVariantKey _loopFlagVar;
+    AnimVariantKey _mirrorFlagVar;
+    AnimVariantKey _frameVar;
 
     // no copies
     AnimClip(const AnimClip&) = delete;
@@ -0,0 +1,296 @@
+//
+//  AnimClipData.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipData.h"
+
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
+
+#include <GLMHelpers.h>
+
+#include "AnimationLogging.h"
+#include "AnimSkeleton.h"
+#include "AnimUtil.h"
+
+const float AnimClipData::DEFAULT_ROTATION_TOLERANCE = 0.001f; // ~0.06 degrees
+const float AnimClipData::DEFAULT_TRANSLATION_TOLERANCE = 0.0005f;
+const float AnimClipData::DEFAULT_SCALE_TOLERANCE = 0.0001f;
+const int AnimClipData::MAX_FRAMES = 1 << 16;
+
+// longest run of frames between two keys, bounds the cost of the key reduction
+static const int MAX_KEY_SPAN = 64;
+static const int ROT_KEY_SIZE = 6;
+
+static float rotationError(const glm::quat& a, const glm::quat& b) {
+    return 2.0f * acosf(std::min(1.0f, fabsf(glm::dot(a, b))));
+}
+
+static float vec3Error(const glm::vec3& a, const glm::vec3& b) {
+    return glm::length(a - b);
+}
+
+static glm::quat quantizeRot(const glm::quat& rot) {
+    uint8_t buffer[ROT_KEY_SIZE];
+    packOrientationQuatToSixBytes(buffer, rot);
+    glm::quat result;
+    unpackOrientationQuatFromSixBytes(buffer, result);
+    return result;
+}
+
+// Returns the frames of a track to keep as keys: frame 0, the last frame and as few frames in between as are needed to
+// reproduce every frame within tolerance by interpolating the (quantized) keys.  A constant track keeps frame 0 only.
+template <typename T, typename Interpolate, typename Error>
+static std::vector<uint16_t> reduceKeys(const std::vector<T>& values, const std::vector<T>& quantized,
+                                        Interpolate interpolate, Error error, float tolerance) {
+    const int numFrames = (int)values.size();
+    std::vector<uint16_t> keys { 0 };
+
+    bool constant = true;
+    for (int frame = 1; frame < numFrames && constant; frame++) {
+        constant = error(quantized[0], values[frame]) <= tolerance;
+    }
+    if (constant) {
+        return keys;
+    }
+
+    const int lastFrame = numFrames - 1;
+    int key = 0;
+    while (key < lastFrame) {
+        int nextKey = key + 1;
+        int maxNextKey = std::min(lastFrame, key + MAX_KEY_SPAN);
+        for (int candidate = key + 2; candidate <= maxNextKey; candidate++) {
+            bool fits = true;
+            for (int frame = key + 1; frame < candidate && fits; frame++) {
+                float alpha = (float)(frame - key) / (float)(candidate - key);
+                fits = error(interpolate(quantized[key], quantized[candidate], alpha), values[frame]) <= tolerance;
+            }
+            if (!fits) {
+                break;
+            }
+            nextKey = candidate;
+        }
+        keys.push_back((uint16_t)nextKey);
+        key = nextKey;
+    }
+    return keys;
+}
+
+template <typename T>
+static size_t vectorSize(const std::vector<T>& vector) {
+    return vector.size() * sizeof(T);
+}
+
+AnimClipData::AnimClipData(const std::vector<AnimPoseVec>& anim, float unitScale, float rotationTolerance,
+                           float translationTolerance, float scaleTolerance) {
+    _numFrames = std::min((int)anim.size(), MAX_FRAMES);
+    if (_numFrames < (int)anim.size()) {
+        qCWarning(animation) << "AnimClipData: animation truncated from" << anim.size() << "to" << _numFrames << "frames";
+    }
+    const int numJoints = _numFrames > 0 ? (int)anim[0].size() : 0;
+    const float transTolerance = unitScale > 0.0f ? translationTolerance / unitScale : translationTolerance;
+
+    auto interpolateVec3 = [](const glm::vec3& a, const glm::vec3& b, float alpha) { return lerp(a, b, alpha); };
+    auto interpolateRot = [](const glm::quat& a, const glm::quat& b, float alpha) { return safeLerp(a, b, alpha); };
+
+    _scaleTracks.resize(numJoints);
+    _rotTracks.resize(numJoints);
+    _transTracks.resize(numJoints);
+
+    std::vector<glm::vec3> scales(_numFrames);
+    std::vector<glm::quat> rots(_numFrames);
+    std::vector<glm::quat> quantizedRots(_numFrames);
+    std::vector<glm::vec3> translations(_numFrames);
+    for (int joint = 0; joint < numJoints; joint++) {
+        for (int frame = 0; frame < _numFrames; frame++) {
+            const AnimPose& pose = anim[frame][joint];
+            scales[frame] = pose.scale();
+            rots[frame] = pose.rot();
+            quantizedRots[frame] = quantizeRot(pose.rot());
+            translations[frame] = pose.trans();
+        }
+
+        std::vector<uint16_t> keys = reduceKeys(scales, scales, interpolateVec3, vec3Error, scaleTolerance);
+        _scaleTracks[joint].firstKey = (uint32_t)_scaleKeyFrames.size();
+        _scaleTracks[joint].numKeys = (uint32_t)keys.size();
+        for (auto frame : keys) {
+            _scaleKeyFrames.push_back(frame);
+            _scaleValues.push_back(scales[frame]);
+        }
+
+        keys = reduceKeys(rots, quantizedRots, interpolateRot, rotationError, rotationTolerance);
+        _rotTracks[joint].firstKey = (uint32_t)_rotKeyFrames.size();
+        _rotTracks[joint].numKeys = (uint32_t)keys.size();
+        for (auto frame : keys) {
+            _rotKeyFrames.push_back(frame);
+            size_t offset = _rotValues.size();
+            _rotValues.resize(offset + ROT_KEY_SIZE);
+            packOrientationQuatToSixBytes(&_rotValues[offset], rots[frame]);
+        }
+
+        keys = reduceKeys(translations, translations, interpolateVec3, vec3Error, transTolerance);
+        _transTracks[joint].firstKey = (uint32_t)_transKeyFrames.size();
+        _transTracks[joint].numKeys = (uint32_t)keys.size();
+        for (auto frame : keys) {
+            _transKeyFrames.push_back(frame);
+            _transValues.push_back(translations[frame]);
+        }
+    }
+
+    _stats.numFrames = _numFrames;
+    _stats.numJoints = numJoints;
+    for (auto tracks : { &_scaleTracks, &_rotTracks, &_transTracks }) {
+        for (const auto& track : *tracks) {
+            if (track.numKeys == 1) {
+                _stats.numConstantTracks++;
+            } else {
+                _stats.numAnimatedTracks++;
+                _stats.numKeys += (int)track.numKeys;
+            }
+        }
+    }
+    _stats.rawSize = (size_t)_numFrames * (size_t)numJoints * sizeof(AnimPose);
+    _stats.compressedSize = sizeof(AnimClipData) +
+        vectorSize(_scaleTracks) + vectorSize(_scaleKeyFrames) + vectorSize(_scaleValues) +
+        vectorSize(_rotTracks) + vectorSize(_rotKeyFrames) + vectorSize(_rotValues) +
+        vectorSize(_transTracks) + vectorSize(_transKeyFrames) + vectorSize(_transValues);
+    measureError(anim, unitScale);
+}
+
+glm::quat AnimClipData::getRotKey(uint32_t key) const {
+    glm::quat rot;
+    unpackOrientationQuatFromSixBytes(&_rotValues[(size_t)key * ROT_KEY_SIZE], rot);
+    return rot;
+}
+
+// index of the last key at or before frame
+static uint32_t findKey(const uint16_t* keyFrames, uint32_t numKeys, int frame) {
+    const uint16_t* key = std::upper_bound(keyFrames + 1, keyFrames + numKeys, (uint16_t)frame);
+    return (uint32_t)(key - keyFrames) - 1;
+}
+
+glm::vec3 AnimClipData::sampleVec3(const Track& track, const std::vector<uint16_t>& keyFrames,
+                                   const std::vector<glm::vec3>& values, int frame) const {
+    if (track.numKeys == 1) {
+        return values[track.firstKey];
+    }
+    const uint16_t* frames = &keyFrames[track.firstKey];
+    uint32_t key = findKey(frames, track.numKeys, frame);
+    if (key + 1 == track.numKeys || frames[key] == frame) {
+        return values[track.firstKey + key];
+    }
+    float alpha = (float)(frame - frames[key]) / (float)(frames[key + 1] - frames[key]);
+    return lerp(values[track.firstKey + key], values[track.firstKey + key + 1], alpha);
+}
+
+glm::quat AnimClipData::sampleRot(const Track& track, int frame) const {
+    if (track.numKeys == 1) {
+        return getRotKey(track.firstKey);
+    }
+    const uint16_t* frames = &_rotKeyFrames[track.firstKey];
+    uint32_t key = findKey(frames, track.numKeys, frame);
+    if (key + 1 == track.numKeys || frames[key] == frame) {
+        return getRotKey(track.firstKey + key);
+    }
+    float alpha = (float)(frame - frames[key]) / (float)(frames[key + 1] - frames[key]);
+    return safeLerp(getRotKey(track.firstKey + key), getRotKey(track.firstKey + key + 1), alpha);
+}
+
+void AnimClipData::sample(int prevFrame, int nextFrame, float alpha, AnimPose* result) const {
+    const int numJoints = getNumJoints();
+    for (int i = 0; i < numJoints; i++) {
+        const Track& scaleTrack = _scaleTracks[i];
+        if (scaleTrack.numKeys == 1) {
+            result[i].scale() = _scaleValues[scaleTrack.firstKey];
+        } else {
+            result[i].scale() = lerp(sampleVec3(scaleTrack, _scaleKeyFrames, _scaleValues, prevFrame),
+                                     sampleVec3(scaleTrack, _scaleKeyFrames, _scaleValues, nextFrame), alpha);
+        }
+
+        const Track& rotTrack = _rotTracks[i];
+        if (rotTrack.numKeys == 1) {
+            result[i].rot() = getRotKey(rotTrack.firstKey);
+        } else {
+            result[i].rot() = safeLerp(sampleRot(rotTrack, prevFrame), sampleRot(rotTrack, nextFrame), alpha);
+        }
+
+        const Track& transTrack = _transTracks[i];
+        if (transTrack.numKeys == 1) {
+            result[i].trans() = _transValues[transTrack.firstKey];
+        } else {
+            result[i].trans() = lerp(sampleVec3(transTrack, _transKeyFrames, _transValues, prevFrame),
+                                     sampleVec3(transTrack, _transKeyFrames, _transValues, nextFrame), alpha);
+        }
+    }
+}
+
+void AnimClipData::decompressFrame(int frame, AnimPose* result) const {
+    const int numJoints = getNumJoints();
+    for (int i = 0; i < numJoints; i++) {
+        result[i].scale() = sampleVec3(_scaleTracks[i], _scaleKeyFrames, _scaleValues, frame);
+        result[i].rot() = sampleRot(_rotTracks[i], frame);
+        result[i].trans() = sampleVec3(_transTracks[i], _transKeyFrames, _transValues, frame);
+    }
+}
+
+std::vector<AnimPoseVec> AnimClipData::decompress() const {
+    std::vector<AnimPoseVec> anim(_numFrames, AnimPoseVec(getNumJoints()));
+    for (int frame = 0; frame < _numFrames; frame++) {
+        decompressFrame(frame, anim[frame].data());
+    }
+    return anim;
+}
+
+void AnimClipData::measureError(const std::vector<AnimPoseVec>& anim, float unitScale) {
+    AnimPoseVec poses(getNumJoints());
+    for (int frame = 0; frame < _numFrames; frame++) {
+        decompressFrame(frame, poses.data());
+        for (int i = 0; i < (int)poses.size(); i++) {
+            const AnimPose& pose = anim[frame][i];
+            _stats.maxScaleError = std::max(_stats.maxScaleError, vec3Error(poses[i].scale(), pose.scale()));
+            _stats.maxRotationError = std::max(_stats.maxRotationError, rotationError(poses[i].rot(), pose.rot()));
+            _stats.maxTranslationError = std::max(_stats.maxTranslationError,
+                                                  unitScale * vec3Error(poses[i].trans(), pose.trans()));
+        }
+    }
+}
+
+QString AnimClipData::formatStats() const {
+    float ratio = _stats.rawSize > 0 ? (float)_stats.compressedSize / (float)_stats.rawSize : 1.0f;
+    return QString("%1 frames x %2 joints, %3 -> %4 bytes (%5%), %6 constant and %7 animated tracks (%8 keys), "
+                   "max error %9 deg / %10 mm / %11 scale")
+        .arg(_stats.numFrames)
+        .arg(_stats.numJoints)
+        .arg(_stats.rawSize)
+        .arg(_stats.compressedSize)
+        .arg(100.0f * ratio, 0, 'f', 1)
+        .arg(_stats.numConstantTracks)
+        .arg(_stats.numAnimatedTracks)
+        .arg(_stats.numKeys)
+        .arg(glm::degrees(_stats.maxRotationError), 0, 'f', 3)
+        .arg(1000.0f * _stats.maxTranslationError, 0, 'f', 3)
+        .arg(_stats.maxScaleError, 0, 'f', 5);
+}
+
+QString AnimClipData::getSkeletonKey(const AnimSkeleton& skeleton) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (int i = 0; i < skeleton.getNumJoints(); i++) {
+        hash.addData(skeleton.getJointName(i).toUtf8());
+        int parentIndex = skeleton.getParentIndex(i);
+        hash.addData(reinterpret_cast<const char*>(&parentIndex), (int)sizeof(parentIndex));
+        const AnimPose& pose = skeleton.getRelativeDefaultPose(i);
+        hash.addData(reinterpret_cast<const char*>(&pose.scale()), (int)sizeof(glm::vec3));
+        hash.addData(reinterpret_cast<const char*>(&pose.rot()), (int)sizeof(glm::quat));
+        hash.addData(reinterpret_cast<const char*>(&pose.trans()), (int)sizeof(glm::vec3));
+    }
+    const glm::mat4& offset = skeleton.getGeometryOffset();
+    hash.addData(reinterpret_cast<const char*>(&offset), (int)sizeof(glm::mat4));
+    return QString(hash.result().toHex());
+}
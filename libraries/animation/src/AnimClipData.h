@@ -0,0 +1,104 @@
+//
+//  AnimClipData.h
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipData_h
+#define hifi_AnimClipData_h
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "AnimPose.h"
+
+class AnimSkeleton;
+
+// Immutable, compressed frames of a retargeted animation clip, shared (via the AnimationCache) by every AnimClip that
+// plays the same animation on the same skeleton.
+//
+// Each joint has a scale, rotation and translation track.  A track that stays within tolerance of its first value is
+// stored as that single value.  The others keep only the keyframes needed to reproduce every frame within tolerance by
+// linear interpolation.  Rotations are stored in six bytes (see packOrientationQuatToSixBytes).
+class AnimClipData {
+public:
+    using ConstPointer = std::shared_ptr<const AnimClipData>;
+
+    static const float DEFAULT_ROTATION_TOLERANCE; // radians
+    static const float DEFAULT_TRANSLATION_TOLERANCE; // meters
+    static const float DEFAULT_SCALE_TOLERANCE;
+    static const int MAX_FRAMES;
+
+    class Stats {
+    public:
+        int numFrames { 0 };
+        int numJoints { 0 };
+        int numConstantTracks { 0 };
+        int numAnimatedTracks { 0 };
+        int numKeys { 0 }; // keys stored for the animated tracks
+        size_t rawSize { 0 }; // bytes as AnimPoseVec frames
+        size_t compressedSize { 0 };
+        float maxRotationError { 0.0f }; // radians
+        float maxTranslationError { 0.0f }; // meters
+        float maxScaleError { 0.0f };
+    };
+
+    // anim[frame][joint] holds relative poses.  unitScale converts translations into meters.
+    AnimClipData(const std::vector<AnimPoseVec>& anim, float unitScale,
+                 float rotationTolerance = DEFAULT_ROTATION_TOLERANCE,
+                 float translationTolerance = DEFAULT_TRANSLATION_TOLERANCE,
+                 float scaleTolerance = DEFAULT_SCALE_TOLERANCE);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_scaleTracks.size(); }
+
+    // result must hold getNumJoints() poses.
+    void sample(int prevFrame, int nextFrame, float alpha, AnimPose* result) const;
+    void decompressFrame(int frame, AnimPose* result) const;
+    std::vector<AnimPoseVec> decompress() const;
+
+    const Stats& getStats() const { return _stats; }
+    QString formatStats() const;
+
+    // identifies the joints and default pose a clip was retargeted to, for sharing between rigs.
+    static QString getSkeletonKey(const AnimSkeleton& skeleton);
+
+private:
+    class Track {
+    public:
+        uint32_t firstKey { 0 };
+        uint32_t numKeys { 0 }; // 1 for a constant track
+    };
+
+    glm::vec3 sampleVec3(const Track& track, const std::vector<uint16_t>& keyFrames,
+                         const std::vector<glm::vec3>& values, int frame) const;
+    glm::quat sampleRot(const Track& track, int frame) const;
+    glm::quat getRotKey(uint32_t key) const;
+
+    void measureError(const std::vector<AnimPoseVec>& anim, float unitScale);
+
+    int _numFrames { 0 };
+
+    std::vector<Track> _scaleTracks;
+    std::vector<uint16_t> _scaleKeyFrames;
+    std::vector<glm::vec3> _scaleValues;
+
+    std::vector<Track> _rotTracks;
+    std::vector<uint16_t> _rotKeyFrames;
+    std::vector<uint8_t> _rotValues; // six bytes per key
+
+    std::vector<Track> _transTracks;
+    std::vector<uint16_t> _transKeyFrames;
+    std::vector<glm::vec3> _transValues;
+
+    Stats _stats;
+};
+
+#endif // hifi_AnimClipData_h
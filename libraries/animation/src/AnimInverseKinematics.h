@@ -164,13 +164,13 @@ protected:
         IKTargetVar(const IKTargetVar& orig);
 
         QString jointName;
-        QString positionVar;
-        QString rotationVar;
-        QString typeVar;
-        QString weightVar;
-        QString poleVectorEnabledVar;
-        QString poleReferenceVectorVar;
-        QString poleVectorVar;
+        AnimVariantKey positionVar;
+        AnimVariantKey rotationVar;
+        AnimVariantKey typeVar;
+        AnimVariantKey weightVar;
+        AnimVariantKey poleVectorEnabledVar;
+        AnimVariantKey poleReferenceVectorVar;
+        AnimVariantKey poleVectorVar;
         float weight;
         float flexCoefficients[MAX_FLEX_COEFFICIENTS];
         size_t numFlexCoefficients;
@@ -200,7 +200,7 @@ protected:
     float _maxErrorOnLastSolve { FLT_MAX };
     bool _previousEnableDebugIKTargets { false };
     SolutionSource _solutionSource { SolutionSource::RelaxToUnderPoses };
-    QString _solutionSourceVar;
+    AnimVariantKey _solutionSourceVar;
 
     JointChainInfoVec _prevJointChainInfoVec;
 };
@@ -117,19 +117,27 @@ const AnimPoseVec& AnimTwoBoneIK::evaluate(const AnimVariantMap& animVars, const
         beginInterp(InterpType::SnapshotToSolve, poseChain);
     }
 
+    // the end effector vars rarely change, so their keys are only looked up when they do.
+    if (endEffectorRotationVar != _prevEndEffectorRotationVar) {
+        _endEffectorRotationKey = AnimVariantKey(endEffectorRotationVar);
+    }
+    if (endEffectorPositionVar != _prevEndEffectorPositionVar) {
+        _endEffectorPositionKey = AnimVariantKey(endEffectorPositionVar);
+    }
+
     // Look up end effector from animVars, make sure to convert into geom space.
     // First look in the triggers then look in the animVars, so we can follow output joints underneath us in the anim graph
     AnimPose targetPose(tipPose);
-    if (triggersOut.hasKey(endEffectorRotationVar)) {
-        targetPose.rot() = triggersOut.lookupRigToGeometry(endEffectorRotationVar, tipPose.rot());
-    } else if (animVars.hasKey(endEffectorRotationVar)) {
-        targetPose.rot() = animVars.lookupRigToGeometry(endEffectorRotationVar, tipPose.rot());
+    if (triggersOut.hasKey(_endEffectorRotationKey)) {
+        targetPose.rot() = triggersOut.lookupRigToGeometry(_endEffectorRotationKey, tipPose.rot());
+    } else if (animVars.hasKey(_endEffectorRotationKey)) {
+        targetPose.rot() = animVars.lookupRigToGeometry(_endEffectorRotationKey, tipPose.rot());
     }
 
-    if (triggersOut.hasKey(endEffectorPositionVar)) {
-        targetPose.trans() = triggersOut.lookupRigToGeometry(endEffectorPositionVar, tipPose.trans());
-    } else if (animVars.hasKey(endEffectorPositionVar)) {
-        targetPose.trans() = animVars.lookupRigToGeometry(endEffectorPositionVar, tipPose.trans());
+    if (triggersOut.hasKey(_endEffectorPositionKey)) {
+        targetPose.trans() = triggersOut.lookupRigToGeometry(_endEffectorPositionKey, tipPose.trans());
+    } else if (animVars.hasKey(_endEffectorPositionKey)) {
+        targetPose.trans() = animVars.lookupRigToGeometry(_endEffectorPositionKey, tipPose.trans());
     }
 
     _prevEndEffectorRotationVar = endEffectorRotationVar;
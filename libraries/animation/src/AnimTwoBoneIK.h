@@ -59,13 +59,15 @@ protected:
     int _midJointIndex { -1 };
     int _tipJointIndex { -1 };
 
-    QString _alphaVar;  // float - (0, 1) 0 means underPoses only, 1 means IK only.
-    QString _enabledVar;  // bool
-    QString _endEffectorRotationVarVar; // string
-    QString _endEffectorPositionVarVar; // string
+    AnimVariantKey _alphaVar;  // float - (0, 1) 0 means underPoses only, 1 means IK only.
+    AnimVariantKey _enabledVar;  // bool
+    AnimVariantKey _endEffectorRotationVarVar; // string
+    AnimVariantKey _endEffectorPositionVarVar; // string
 
     QString _prevEndEffectorRotationVar;
     QString _prevEndEffectorPositionVar;
+    AnimVariantKey _endEffectorRotationKey;
+    AnimVariantKey _endEffectorPositionKey;
 
     InterpType _interpType { InterpType::None };
     float _interpAlphaVel { 0.0f };
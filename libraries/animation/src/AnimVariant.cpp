@@ -11,12 +11,84 @@
 
 #include "AnimVariant.h" // which has AnimVariant/AnimVariantMap
 
+#include <iterator>
+
+#include <QHash>
+#include <QReadWriteLock>
 #include <QScriptEngine>
 #include <QScriptValueIterator>
 #include <QThread>
 #include <RegisteredMetaTypes.h>
 
 const AnimVariant AnimVariant::False = AnimVariant();
+const int AnimVariantKey::INVALID_ID;
+
+namespace {
+    // function-local, so static keys can be made during static initialization
+    struct KeyTable {
+        QReadWriteLock lock;
+        QHash<QString, int> ids;
+        std::vector<QString> names;
+    };
+
+    KeyTable& getKeyTable() {
+        static KeyTable table;
+        return table;
+    }
+}
+
+int AnimVariantKey::intern(const QString& name) {
+    if (name.isEmpty()) {
+        return INVALID_ID;
+    }
+    KeyTable& table = getKeyTable();
+    {
+        QReadLocker locker(&table.lock);
+        auto iter = table.ids.constFind(name);
+        if (iter != table.ids.constEnd()) {
+            return iter.value();
+        }
+    }
+    QWriteLocker locker(&table.lock);
+    auto iter = table.ids.constFind(name);
+    if (iter != table.ids.constEnd()) {
+        return iter.value();
+    }
+    int id = (int)table.names.size();
+    table.names.push_back(name);
+    table.ids.insert(name, id);
+    return id;
+}
+
+AnimVariantKey AnimVariantKey::find(const QString& name) {
+    AnimVariantKey key;
+    if (!name.isEmpty()) {
+        KeyTable& table = getKeyTable();
+        QReadLocker locker(&table.lock);
+        key._id = table.ids.value(name, INVALID_ID);
+    }
+    return key;
+}
+
+int AnimVariantKey::getNumKeys() {
+    KeyTable& table = getKeyTable();
+    QReadLocker locker(&table.lock);
+    return (int)table.names.size();
+}
+
+QString AnimVariantKey::getName(int id) {
+    KeyTable& table = getKeyTable();
+    QReadLocker locker(&table.lock);
+    return (id >= 0 && id < (int)table.names.size()) ? table.names[id] : QString();
+}
+
+void AnimVariantMap::unset(const AnimVariantKey& key) {
+    int id = key.getId();
+    auto itr = std::lower_bound(_entries.begin(), _entries.end(), id, isBefore);
+    if (itr != _entries.end() && itr->first == id) {
+        _entries.erase(itr);
+    }
+}
 
 QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine, const QStringList& names, bool useNames) const {
     if (QThread::currentThread() != engine->thread()) {
@@ -52,26 +124,44 @@ QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine,
     };
     if (useNames) { // copy only the requested names
         for (const QString& name : names) {
-            auto search = _map.find(name);
-            if (search != _map.end()) {
-                setOne(name, search->second);
-            } else if (_triggers.count(name) == 1) {
-                target.setProperty(name, true);
+            const AnimVariant* value = find(AnimVariantKey::find(name));
+            if (value) {
+                setOne(name, *value);
             } // scripts are allowed to request names that do not exist
         }
 
     } else {  // copy all of them
-        for (auto& pair : _map) {
-            setOne(pair.first, pair.second);
+        for (const auto& entry : _entries) {
+            setOne(AnimVariantKey::getName(entry.first), entry.second);
         }
     }
     return target;
 }
 
 void AnimVariantMap::copyVariantsFrom(const AnimVariantMap& other) {
-    for (auto& pair : other._map) {
-        _map[pair.first] = pair.second;
+    if (_entries.empty()) {
+        _entries = other._entries;
+        return;
+    }
+
+    // merge, the other map's values win
+    std::vector<Entry> merged;
+    merged.reserve(_entries.size() + other._entries.size());
+    auto itr = _entries.begin();
+    auto otherItr = other._entries.begin();
+    while (itr != _entries.end() && otherItr != other._entries.end()) {
+        if (itr->first < otherItr->first) {
+            merged.push_back(std::move(*itr++));
+        } else {
+            if (itr->first == otherItr->first) {
+                ++itr;
+            }
+            merged.push_back(*otherItr++);
+        }
     }
+    std::move(itr, _entries.end(), std::back_inserter(merged));
+    merged.insert(merged.end(), otherItr, other._entries.end());
+    _entries.swap(merged);
 }
 
 void AnimVariantMap::animVariantMapFromScriptValue(const QScriptValue& source) {
@@ -128,21 +218,23 @@ void AnimVariantMap::animVariantMapFromScriptValue(const QScriptValue& source) {
 
 std::map<QString, QString> AnimVariantMap::toDebugMap() const {
     std::map<QString, QString> result;
-    for (auto& pair : _map) {
-        switch (pair.second.getType()) {
+    for (const auto& entry : _entries) {
+        const QString name = AnimVariantKey::getName(entry.first);
+        const AnimVariant& variant = entry.second;
+        switch (variant.getType()) {
         case AnimVariant::Type::Bool:
-            result[pair.first] = QString("%1").arg(pair.second.getBool());
+            result[name] = QString("%1").arg(variant.getBool());
             break;
         case AnimVariant::Type::Int:
-            result[pair.first] = QString("%1").arg(pair.second.getInt());
+            result[name] = QString("%1").arg(variant.getInt());
             break;
         case AnimVariant::Type::Float:
-            result[pair.first] = QString::number(pair.second.getFloat(), 'f', 3);
+            result[name] = QString::number(variant.getFloat(), 'f', 3);
             break;
         case AnimVariant::Type::Vec3: {
             // To prevent filling up debug stats, don't show vec3 values
-            glm::vec3 value = pair.second.getVec3();
-            result[pair.first] = QString("(%1, %2, %3)").
+            glm::vec3 value = variant.getVec3();
+            result[name] = QString("(%1, %2, %3)").
                 arg(QString::number(value.x, 'f', 3)).
                 arg(QString::number(value.y, 'f', 3)).
                 arg(QString::number(value.z, 'f', 3));
@@ -150,8 +242,8 @@ std::map<QString, QString> AnimVariantMap::toDebugMap() const {
         }
         case AnimVariant::Type::Quat: {
             // To prevent filling up the anim stats, don't show quat values
-            glm::quat value = pair.second.getQuat();
-            result[pair.first] = QString("(%1, %2, %3, %4)").
+            glm::quat value = variant.getQuat();
+            result[name] = QString("(%1, %2, %3, %4)").
                 arg(QString::number(value.x, 'f', 3)).
                 arg(QString::number(value.y, 'f', 3)).
                 arg(QString::number(value.z, 'f', 3)).
@@ -160,7 +252,7 @@ std::map<QString, QString> AnimVariantMap::toDebugMap() const {
         }
         case AnimVariant::Type::String:
             // To prevent filling up anim stats, don't show string values
-            result[pair.first] = pair.second.getString();
+            result[name] = variant.getString();
             break;
         default:
             // invalid AnimVariant::Type
@@ -169,3 +261,35 @@ std::map<QString, QString> AnimVariantMap::toDebugMap() const {
     }
     return result;
 }
+
+#ifndef NDEBUG
+void AnimVariantMap::dump() const {
+    qCDebug(animation) << "AnimVariantMap =";
+    for (const auto& entry : _entries) {
+        const QString name = AnimVariantKey::getName(entry.first);
+        const AnimVariant& value = entry.second;
+        switch (value.getType()) {
+        case AnimVariant::Type::Bool:
+            qCDebug(animation) << "    " << name << "=" << value.getBool();
+            break;
+        case AnimVariant::Type::Int:
+            qCDebug(animation) << "    " << name << "=" << value.getInt();
+            break;
+        case AnimVariant::Type::Float:
+            qCDebug(animation) << "    " << name << "=" << value.getFloat();
+            break;
+        case AnimVariant::Type::Vec3:
+            qCDebug(animation) << "    " << name << "=" << value.getVec3();
+            break;
+        case AnimVariant::Type::Quat:
+            qCDebug(animation) << "    " << name << "=" << value.getQuat();
+            break;
+        case AnimVariant::Type::String:
+            qCDebug(animation) << "    " << name << "=" << value.getString();
+            break;
+        default:
+            assert(false);
+        }
+    }
+}
+#endif
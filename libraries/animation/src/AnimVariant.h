@@ -11,12 +11,13 @@
 #ifndef hifi_AnimVariant_h
 #define hifi_AnimVariant_h
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <map>
-#include <set>
+#include <vector>
 #include <QScriptValue>
 #include <StreamUtils.h>
 #include <GLMHelpers.h>
@@ -114,119 +115,143 @@ protected:
     } _val;
 };
 
+// The name of an anim var, interned to a small integer id that is shared by every AnimVariantMap.  Anim graph nodes
+// hold their var names as keys, interned once when the graph is loaded, so their per-frame lookups compare ids rather
+// than strings.  An empty name is an invalid key, which is never found.  Ids are never released, but a map only holds
+// the vars set in it, whatever ids were handed out elsewhere.
+class AnimVariantKey {
+public:
+    AnimVariantKey() {}
+    AnimVariantKey(const QString& name) : _id(intern(name)) {}
+
+    // the key of a name, without interning it: invalid when no key for the name was made yet, as no map can hold it.
+    static AnimVariantKey find(const QString& name);
+    static int getNumKeys();
+    static QString getName(int id);
+
+    bool isValid() const { return _id != INVALID_ID; }
+    int getId() const { return _id; }
+    QString getName() const { return getName(_id); }
+
+    bool operator==(const AnimVariantKey& other) const { return _id == other._id; }
+    bool operator!=(const AnimVariantKey& other) const { return _id != other._id; }
+
+private:
+    static const int INVALID_ID = -1;
+    static int intern(const QString& name);
+
+    int _id { INVALID_ID };
+};
+
+inline QDebug operator<<(QDebug debug, const AnimVariantKey& key) {
+    debug << key.getName();
+    return debug;
+}
+
 class AnimVariantMap {
 public:
 
-    bool lookup(const QString& key, bool defaultValue) const {
-        // check triggers first, then map
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else if (_triggers.find(key) != _triggers.end()) {
-            return true;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getBool() : defaultValue;
-        }
+    bool lookup(const AnimVariantKey& key, bool defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? value->getBool() : defaultValue;
     }
 
-    int lookup(const QString& key, int defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getInt() : defaultValue;
-        }
+    int lookup(const AnimVariantKey& key, int defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? value->getInt() : defaultValue;
     }
 
-    float lookup(const QString& key, float defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getFloat() : defaultValue;
-        }
+    float lookup(const AnimVariantKey& key, float defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? value->getFloat() : defaultValue;
     }
 
-    const glm::vec3& lookupRaw(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getVec3() : defaultValue;
-        }
+    const glm::vec3& lookupRaw(const AnimVariantKey& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? value->getVec3() : defaultValue;
     }
 
-    glm::vec3 lookupRigToGeometry(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformPoint(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+    glm::vec3 lookupRigToGeometry(const AnimVariantKey& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? transformPoint(_rigToGeometryMat, value->getVec3()) : defaultValue;
     }
 
-    glm::vec3 lookupRigToGeometryVector(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformVectorFast(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+    glm::vec3 lookupRigToGeometryVector(const AnimVariantKey& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? transformVectorFast(_rigToGeometryMat, value->getVec3()) : defaultValue;
     }
 
-    const glm::quat& lookupRaw(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getQuat() : defaultValue;
-        }
+    const glm::quat& lookupRaw(const AnimVariantKey& key, const glm::quat& defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? value->getQuat() : defaultValue;
     }
 
-    glm::quat lookupRigToGeometry(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? _rigToGeometryRot * iter->second.getQuat() : defaultValue;
-        }
+    glm::quat lookupRigToGeometry(const AnimVariantKey& key, const glm::quat& defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? _rigToGeometryRot * value->getQuat() : defaultValue;
+    }
+
+    const QString& lookup(const AnimVariantKey& key, const QString& defaultValue) const {
+        const AnimVariant* value = find(key);
+        return value ? value->getString() : defaultValue;
     }
 
+    // lookups by name, for scripts and names that are only known at runtime
+    bool lookup(const QString& key, bool defaultValue) const { return lookup(AnimVariantKey::find(key), defaultValue); }
+    int lookup(const QString& key, int defaultValue) const { return lookup(AnimVariantKey::find(key), defaultValue); }
+    float lookup(const QString& key, float defaultValue) const { return lookup(AnimVariantKey::find(key), defaultValue); }
+    const glm::vec3& lookupRaw(const QString& key, const glm::vec3& defaultValue) const {
+        return lookupRaw(AnimVariantKey::find(key), defaultValue);
+    }
+    glm::vec3 lookupRigToGeometry(const QString& key, const glm::vec3& defaultValue) const {
+        return lookupRigToGeometry(AnimVariantKey::find(key), defaultValue);
+    }
+    glm::vec3 lookupRigToGeometryVector(const QString& key, const glm::vec3& defaultValue) const {
+        return lookupRigToGeometryVector(AnimVariantKey::find(key), defaultValue);
+    }
+    const glm::quat& lookupRaw(const QString& key, const glm::quat& defaultValue) const {
+        return lookupRaw(AnimVariantKey::find(key), defaultValue);
+    }
+    glm::quat lookupRigToGeometry(const QString& key, const glm::quat& defaultValue) const {
+        return lookupRigToGeometry(AnimVariantKey::find(key), defaultValue);
+    }
     const QString& lookup(const QString& key, const QString& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getString() : defaultValue;
-        }
+        return lookup(AnimVariantKey::find(key), defaultValue);
     }
 
-    void set(const QString& key, bool value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, int value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, float value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::vec3& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::quat& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const QString& value) { _map[key] = AnimVariant(value); }
-    void unset(const QString& key) { _map.erase(key); }
+    void set(const AnimVariantKey& key, bool value) { insert(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, int value) { insert(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, float value) { insert(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const glm::vec3& value) { insert(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const glm::quat& value) { insert(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const QString& value) { insert(key, AnimVariant(value)); }
+    void unset(const AnimVariantKey& key);
 
-    void setTrigger(const QString& key) { _map[key] = AnimVariant(true); }
+    void set(const QString& key, bool value) { set(AnimVariantKey(key), value); }
+    void set(const QString& key, int value) { set(AnimVariantKey(key), value); }
+    void set(const QString& key, float value) { set(AnimVariantKey(key), value); }
+    void set(const QString& key, const glm::vec3& value) { set(AnimVariantKey(key), value); }
+    void set(const QString& key, const glm::quat& value) { set(AnimVariantKey(key), value); }
+    void set(const QString& key, const QString& value) { set(AnimVariantKey(key), value); }
+    void unset(const QString& key) { unset(AnimVariantKey::find(key)); }
+
+    void setTrigger(const AnimVariantKey& key) { insert(key, AnimVariant(true)); }
+    void setTrigger(const QString& key) { setTrigger(AnimVariantKey(key)); }
 
     void setRigToGeometryTransform(const glm::mat4& rigToGeometry) {
         _rigToGeometryMat = rigToGeometry;
         _rigToGeometryRot = glmExtractRotation(rigToGeometry);
     }
 
-    void clearMap() { _map.clear(); _triggers.clear(); }
-    bool hasKey(const QString& key) const { return _map.find(key) != _map.end(); }
+    void clearMap() { _entries.clear(); }
+    bool hasKey(const AnimVariantKey& key) const { return find(key) != nullptr; }
+    bool hasKey(const QString& key) const { return hasKey(AnimVariantKey::find(key)); }
 
-    const AnimVariant& get(const QString& key) const {
-        auto iter = _map.find(key);
-        if (iter != _map.end()) {
-            return iter->second;
-        } else {
-            return AnimVariant::False;
-        }
+    const AnimVariant& get(const AnimVariantKey& key) const {
+        const AnimVariant* value = find(key);
+        return value ? *value : AnimVariant::False;
     }
+    const AnimVariant& get(const QString& key) const { return get(AnimVariantKey::find(key)); }
 
     // Answer a Plain Old Javascript Object (for the given engine) all of our values set as properties.
     QScriptValue animVariantMapToScriptValue(QScriptEngine* engine, const QStringList& names, bool useNames) const;
@@ -238,38 +263,35 @@ public:
     std::map<QString, QString> toDebugMap() const;
 
 #ifndef NDEBUG
-    void dump() const {
-        qCDebug(animation) << "AnimVariantMap =";
-        for (auto& pair : _map) {
-            switch (pair.second.getType()) {
-            case AnimVariant::Type::Bool:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getBool();
-                break;
-            case AnimVariant::Type::Int:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getInt();
-                break;
-            case AnimVariant::Type::Float:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getFloat();
-                break;
-            case AnimVariant::Type::Vec3:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getVec3();
-                break;
-            case AnimVariant::Type::Quat:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getQuat();
-                break;
-            case AnimVariant::Type::String:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getString();
-                break;
-            default:
-                assert(false);
-            }
-        }
-    }
+    void dump() const;
 #endif
 
 protected:
-    std::map<QString, AnimVariant> _map;
-    std::set<QString> _triggers;
+    using Entry = std::pair<int, AnimVariant>;
+
+    static bool isBefore(const Entry& entry, int id) { return entry.first < id; }
+
+    const AnimVariant* find(const AnimVariantKey& key) const {
+        int id = key.getId();
+        auto itr = std::lower_bound(_entries.begin(), _entries.end(), id, isBefore);
+        return (itr != _entries.end() && itr->first == id) ? &itr->second : nullptr;
+    }
+
+    void insert(const AnimVariantKey& key, AnimVariant&& value) {
+        if (!key.isValid()) {
+            return;
+        }
+        int id = key.getId();
+        auto itr = std::lower_bound(_entries.begin(), _entries.end(), id, isBefore);
+        if (itr != _entries.end() && itr->first == id) {
+            itr->second = std::move(value);
+        } else {
+            _entries.emplace(itr, id, std::move(value));
+        }
+    }
+
+    // sorted by key id: a map holds a few dozen vars, so copies cost what is set and lookups are a short binary search
+    std::vector<Entry> _entries;
     glm::mat4 _rigToGeometryMat;
     glm::quat _rigToGeometryRot;
 };
@@ -11,6 +11,8 @@
 
 #include "AnimationCache.h"
 
+#include <algorithm>
+
 #include <QRunnable>
 #include <QThreadPool>
 
@@ -36,6 +38,68 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+AnimClipData::ConstPointer AnimationCache::getClipData(const QString& key,
+                                                     const std::function<AnimClipData::ConstPointer()>& create) {
+    {
+        std::lock_guard<std::mutex> lock(_clipDataMutex);
+        auto clipData = _clipData.value(key).lock();
+        if (clipData) {
+            return clipData;
+        }
+    }
+
+    auto clipData = create();
+
+    std::lock_guard<std::mutex> lock(_clipDataMutex);
+    auto existing = _clipData.value(key).lock();
+    if (existing) {
+        // another clip created it meanwhile
+        return existing;
+    }
+    for (auto itr = _clipData.begin(); itr != _clipData.end();) {
+        if (itr.value().expired()) {
+            itr = _clipData.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    if (clipData) {
+        _clipData.insert(key, clipData);
+    }
+    return clipData;
+}
+
+QString AnimationCache::getClipReport() const {
+    std::vector<std::pair<QString, AnimClipData::ConstPointer>> clips;
+    {
+        std::lock_guard<std::mutex> lock(_clipDataMutex);
+        for (auto itr = _clipData.cbegin(); itr != _clipData.cend(); ++itr) {
+            auto clipData = itr.value().lock();
+            if (clipData) {
+                clips.emplace_back(itr.key(), clipData);
+            }
+        }
+    }
+    std::sort(clips.begin(), clips.end(), [](const std::pair<QString, AnimClipData::ConstPointer>& a,
+                                             const std::pair<QString, AnimClipData::ConstPointer>& b) {
+        return a.second->getStats().compressedSize > b.second->getStats().compressedSize;
+    });
+
+    size_t rawSize = 0;
+    size_t compressedSize = 0;
+    QString report;
+    for (const auto& clip : clips) {
+        const auto& stats = clip.second->getStats();
+        rawSize += stats.rawSize;
+        compressedSize += stats.compressedSize;
+        // the key starts with the url, the skeleton hash and options follow
+        report += clip.first.section('|', 0, 0) + ": " + clip.second->formatStats() +
+            QString(" (%1 users)\n").arg(clip.second.use_count() - 1);
+    }
+    report += QString("%1 clips, %2 -> %3 bytes\n").arg(clips.size()).arg(rawSize).arg(compressedSize);
+    return report;
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url) {
     return QSharedPointer<Resource>(new Animation(url), &Resource::deleter);
 }
@@ -12,6 +12,10 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
 #include <QtCore/QRunnable>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
@@ -20,6 +24,8 @@
 #include <hfm/HFM.h>
 #include <ResourceCache.h>
 
+#include "AnimClipData.h"
+
 class Animation;
 
 using AnimationPointer = QSharedPointer<Animation>;
@@ -33,6 +39,13 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    // Returns the clip data for key, shared by every AnimClip that asks while it is in use.  create is called (without
+    // holding the cache lock) when no clip data for key is alive.
+    AnimClipData::ConstPointer getClipData(const QString& key, const std::function<AnimClipData::ConstPointer()>& create);
+
+    // size and compression error of the clip data in use, one line per clip, largest first
+    QString getClipReport() const;
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
@@ -41,6 +54,8 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    mutable std::mutex _clipDataMutex;
+    QHash<QString, std::weak_ptr<const AnimClipData>> _clipData;
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
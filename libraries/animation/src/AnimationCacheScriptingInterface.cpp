@@ -18,3 +18,7 @@ AnimationCacheScriptingInterface::AnimationCacheScriptingInterface() :
 AnimationPointer AnimationCacheScriptingInterface::getAnimation(const QString& url) {
     return DependencyManager::get<AnimationCache>()->getAnimation(QUrl(url));
 }
+
+QString AnimationCacheScriptingInterface::getClipReport() {
+    return DependencyManager::get<AnimationCache>()->getClipReport();
+}
@@ -42,6 +42,8 @@ class AnimationCacheScriptingInterface : public ScriptableResourceCache, public
      *     <em>Read-only.</em>
      * @property {number} numGlobalQueriesLoading - Total number of global queries loading (across all resource cache managers).
      *     <em>Read-only.</em>
+     * @property {number} numGlobalBytesReceived - Total number of bytes downloaded (across all resource cache managers).
+     *     <em>Read-only.</em>
      *
      * @borrows ResourceCache.getResourceList as getResourceList
      * @borrows ResourceCache.updateTotalSize as updateTotalSize
@@ -59,6 +61,14 @@ public:
      * @returns {AnimationObject} An animation object.
      */
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url);
+
+    /**jsdoc
+     * Gets a report of the memory used by the compressed animation clips that avatars are playing, and of the largest
+     * error their compression introduced.
+     * @function AnimationCache.getClipReport
+     * @returns {string} One line per clip, largest first, followed by the totals.
+     */
+    Q_INVOKABLE QString getClipReport();
 };
 
 #endif // hifi_AnimationCacheScriptingInterface_h
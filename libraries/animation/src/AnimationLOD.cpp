@@ -0,0 +1,53 @@
+//
+//  AnimationLOD.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimationLOD.h"
+
+#include <algorithm>
+#include <limits>
+
+const float AnimationLOD::FULL_LOD_DISTANCE = 5.0f;
+const float AnimationLOD::LOW_LOD_DISTANCE = 40.0f;
+const float AnimationLOD::FULL_LOD_SCREEN_SIZE = 0.2f;
+const float AnimationLOD::REDUCED_LOD_SCREEN_SIZE = 0.05f;
+
+int AnimationLOD::getJointUpdateInterval(Level level) {
+    static const int JOINT_UPDATE_INTERVALS[NumLevels] = { 1, 2, 4 };
+    return JOINT_UPDATE_INTERVALS[level];
+}
+
+void AnimationLOD::update(const ConicalViewFrustums& views, const glm::vec3& position, float radius, bool isHero) {
+    if (isHero) {
+        _level = Full;
+        return;
+    }
+
+    float minDistance = std::numeric_limits<float>::max();
+    float maxScreenSize = 0.0f;
+    for (const auto& view : views) {
+        float distance = glm::distance(view.getPosition(), position);
+        minDistance = std::min(minDistance, distance);
+        if (view.getAngle() > 0.0f) {
+            maxScreenSize = std::max(maxScreenSize, view.getAngularSize(distance, radius) / view.getAngle());
+        }
+    }
+
+    if (minDistance < FULL_LOD_DISTANCE || maxScreenSize > FULL_LOD_SCREEN_SIZE) {
+        _level = Full;
+    } else if (minDistance > LOW_LOD_DISTANCE || maxScreenSize < REDUCED_LOD_SCREEN_SIZE) {
+        _level = Low;
+    } else {
+        _level = Reduced;
+    }
+}
+
+bool AnimationLOD::isJointUpdateDue(bool hasNewJointData) const {
+    return hasNewJointData && _updatesSinceJointUpdate + 1 >= getJointUpdateInterval(_level);
+}
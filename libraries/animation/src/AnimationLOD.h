@@ -0,0 +1,54 @@
+//
+//  AnimationLOD.h
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimationLOD_h
+#define hifi_AnimationLOD_h
+
+#include <glm/glm.hpp>
+
+#include <shared/ConicalViewFrustum.h>
+
+// How much work goes into animating an avatar that is posed from network joint data, picked from its distance to the
+// nearest view and its size in that view.  Also counts the updates that skipped the joints, to pace the next one.
+class AnimationLOD {
+public:
+    enum Level {
+        Full = 0, // joints on every update, eye look-at and flow collisions
+        Reduced,  // joints on at most every other update, no eye look-at
+        Low,      // joints on at most every fourth update, no eye look-at or flow collisions
+        NumLevels
+    };
+
+    // close avatars keep full animation whatever their size, since we may be interacting with them
+    static const float FULL_LOD_DISTANCE; // meters
+    static const float LOW_LOD_DISTANCE; // meters
+    // angular radius as a fraction of the half angle of the view
+    static const float FULL_LOD_SCREEN_SIZE;
+    static const float REDUCED_LOD_SCREEN_SIZE;
+
+    static int getJointUpdateInterval(Level level);
+
+    Level getLevel() const { return _level; }
+    void setLevel(Level level) { _level = level; }
+
+    // heroes always get full animation
+    void update(const ConicalViewFrustums& views, const glm::vec3& position, float radius, bool isHero);
+
+    // true when new joint data is due to be posed at this level
+    bool isJointUpdateDue(bool hasNewJointData) const;
+    void jointsUpdated() { _updatesSinceJointUpdate = 0; }
+    void jointsSkipped() { _updatesSinceJointUpdate++; }
+
+private:
+    Level _level { Full };
+    int _updatesSinceJointUpdate { 0 };
+};
+
+#endif // hifi_AnimationLOD_h
@@ -62,32 +62,136 @@ const glm::vec3 DEFAULT_HEAD_POS(0.0f, 0.75f, 0.0f);
 
 static const QString LEFT_FOOT_POSITION("leftFootPosition");
 static const QString LEFT_FOOT_ROTATION("leftFootRotation");
-static const QString LEFT_FOOT_IK_POSITION_VAR("leftFootIKPositionVar");
-static const QString LEFT_FOOT_IK_ROTATION_VAR("leftFootIKRotationVar");
+static const AnimVariantKey LEFT_FOOT_IK_POSITION_VAR("leftFootIKPositionVar");
+static const AnimVariantKey LEFT_FOOT_IK_ROTATION_VAR("leftFootIKRotationVar");
 static const QString MAIN_STATE_MACHINE_LEFT_FOOT_POSITION("mainStateMachineLeftFootPosition");
 static const QString MAIN_STATE_MACHINE_LEFT_FOOT_ROTATION("mainStateMachineLeftFootRotation");
 
 static const QString RIGHT_FOOT_POSITION("rightFootPosition");
 static const QString RIGHT_FOOT_ROTATION("rightFootRotation");
-static const QString RIGHT_FOOT_IK_POSITION_VAR("rightFootIKPositionVar");
-static const QString RIGHT_FOOT_IK_ROTATION_VAR("rightFootIKRotationVar");
+static const AnimVariantKey RIGHT_FOOT_IK_POSITION_VAR("rightFootIKPositionVar");
+static const AnimVariantKey RIGHT_FOOT_IK_ROTATION_VAR("rightFootIKRotationVar");
 static const QString MAIN_STATE_MACHINE_RIGHT_FOOT_ROTATION("mainStateMachineRightFootRotation");
 static const QString MAIN_STATE_MACHINE_RIGHT_FOOT_POSITION("mainStateMachineRightFootPosition");
 
 static const QString LEFT_HAND_POSITION("leftHandPosition");
 static const QString LEFT_HAND_ROTATION("leftHandRotation");
-static const QString LEFT_HAND_IK_POSITION_VAR("leftHandIKPositionVar");
-static const QString LEFT_HAND_IK_ROTATION_VAR("leftHandIKRotationVar");
+static const AnimVariantKey LEFT_HAND_IK_POSITION_VAR("leftHandIKPositionVar");
+static const AnimVariantKey LEFT_HAND_IK_ROTATION_VAR("leftHandIKRotationVar");
 static const QString MAIN_STATE_MACHINE_LEFT_HAND_POSITION("mainStateMachineLeftHandPosition");
 static const QString MAIN_STATE_MACHINE_LEFT_HAND_ROTATION("mainStateMachineLeftHandRotation");
 
 static const QString RIGHT_HAND_POSITION("rightHandPosition");
 static const QString RIGHT_HAND_ROTATION("rightHandRotation");
-static const QString RIGHT_HAND_IK_POSITION_VAR("rightHandIKPositionVar");
-static const QString RIGHT_HAND_IK_ROTATION_VAR("rightHandIKRotationVar");
+static const AnimVariantKey RIGHT_HAND_IK_POSITION_VAR("rightHandIKPositionVar");
+static const AnimVariantKey RIGHT_HAND_IK_ROTATION_VAR("rightHandIKRotationVar");
 static const QString MAIN_STATE_MACHINE_RIGHT_HAND_ROTATION("mainStateMachineRightHandRotation");
 static const QString MAIN_STATE_MACHINE_RIGHT_HAND_POSITION("mainStateMachineRightHandPosition");
 
+// the vars the rig sets every frame, interned once here rather than by every set() call
+static const AnimVariantKey USER_ANIM_NONE_VAR("userAnimNone");
+static const AnimVariantKey USER_ANIM_A_VAR("userAnimA");
+static const AnimVariantKey USER_ANIM_B_VAR("userAnimB");
+static const AnimVariantKey LEFT_HAND_ANIM_NONE_VAR("leftHandAnimNone");
+static const AnimVariantKey LEFT_HAND_ANIM_A_VAR("leftHandAnimA");
+static const AnimVariantKey LEFT_HAND_ANIM_B_VAR("leftHandAnimB");
+static const AnimVariantKey RIGHT_HAND_ANIM_NONE_VAR("rightHandAnimNone");
+static const AnimVariantKey RIGHT_HAND_ANIM_A_VAR("rightHandAnimA");
+static const AnimVariantKey RIGHT_HAND_ANIM_B_VAR("rightHandAnimB");
+
+static const AnimVariantKey SINE_VAR("sine");
+static const AnimVariantKey MOVE_FORWARD_SPEED_VAR("moveForwardSpeed");
+static const AnimVariantKey MOVE_BACKWARD_SPEED_VAR("moveBackwardSpeed");
+static const AnimVariantKey MOVE_LATERAL_SPEED_VAR("moveLateralSpeed");
+static const AnimVariantKey IN_AIR_ALPHA_VAR("inAirAlpha");
+
+static const AnimVariantKey IS_MOVING_FORWARD_VAR("isMovingForward");
+static const AnimVariantKey IS_MOVING_BACKWARD_VAR("isMovingBackward");
+static const AnimVariantKey IS_MOVING_RIGHT_VAR("isMovingRight");
+static const AnimVariantKey IS_MOVING_LEFT_VAR("isMovingLeft");
+static const AnimVariantKey IS_MOVING_RIGHT_HMD_VAR("isMovingRightHmd");
+static const AnimVariantKey IS_MOVING_LEFT_HMD_VAR("isMovingLeftHmd");
+static const AnimVariantKey IS_NOT_MOVING_VAR("isNotMoving");
+static const AnimVariantKey IS_TURNING_RIGHT_VAR("isTurningRight");
+static const AnimVariantKey IS_TURNING_LEFT_VAR("isTurningLeft");
+static const AnimVariantKey IS_NOT_TURNING_VAR("isNotTurning");
+static const AnimVariantKey IS_FLYING_VAR("isFlying");
+static const AnimVariantKey IS_NOT_FLYING_VAR("isNotFlying");
+static const AnimVariantKey IS_TAKEOFF_STAND_VAR("isTakeoffStand");
+static const AnimVariantKey IS_TAKEOFF_RUN_VAR("isTakeoffRun");
+static const AnimVariantKey IS_NOT_TAKEOFF_VAR("isNotTakeoff");
+static const AnimVariantKey IS_IN_AIR_STAND_VAR("isInAirStand");
+static const AnimVariantKey IS_IN_AIR_RUN_VAR("isInAirRun");
+static const AnimVariantKey IS_NOT_IN_AIR_VAR("isNotInAir");
+static const AnimVariantKey IS_SEATED_VAR("isSeated");
+static const AnimVariantKey IS_NOT_SEATED_VAR("isNotSeated");
+static const AnimVariantKey IS_SEATED_TURNING_RIGHT_VAR("isSeatedTurningRight");
+static const AnimVariantKey IS_SEATED_TURNING_LEFT_VAR("isSeatedTurningLeft");
+static const AnimVariantKey IS_SEATED_NOT_TURNING_VAR("isSeatedNotTurning");
+
+static const AnimVariantKey IS_INPUT_FORWARD_VAR("isInputForward");
+static const AnimVariantKey IS_INPUT_BACKWARD_VAR("isInputBackward");
+static const AnimVariantKey IS_INPUT_RIGHT_VAR("isInputRight");
+static const AnimVariantKey IS_INPUT_LEFT_VAR("isInputLeft");
+static const AnimVariantKey IS_NOT_INPUT_VAR("isNotInput");
+static const AnimVariantKey IS_NOT_INPUT_SLOW_VAR("isNotInputSlow");
+static const AnimVariantKey IS_NOT_INPUT_NO_MOMENTUM_VAR("isNotInputNoMomentum");
+
+static const AnimVariantKey IK_OVERLAY_ALPHA_VAR("ikOverlayAlpha");
+static const AnimVariantKey SPLINE_IK_ENABLED_VAR("splineIKEnabled");
+static const AnimVariantKey LEFT_HAND_IK_ENABLED_VAR("leftHandIKEnabled");
+static const AnimVariantKey RIGHT_HAND_IK_ENABLED_VAR("rightHandIKEnabled");
+static const AnimVariantKey LEFT_FOOT_IK_ENABLED_VAR("leftFootIKEnabled");
+static const AnimVariantKey RIGHT_FOOT_IK_ENABLED_VAR("rightFootIKEnabled");
+static const AnimVariantKey LEFT_HAND_POLE_VECTOR_ENABLED_VAR("leftHandPoleVectorEnabled");
+static const AnimVariantKey RIGHT_HAND_POLE_VECTOR_ENABLED_VAR("rightHandPoleVectorEnabled");
+static const AnimVariantKey LEFT_FOOT_POLE_VECTOR_ENABLED_VAR("leftFootPoleVectorEnabled");
+static const AnimVariantKey RIGHT_FOOT_POLE_VECTOR_ENABLED_VAR("rightFootPoleVectorEnabled");
+static const AnimVariantKey SOLUTION_SOURCE_VAR("solutionSource");
+static const AnimVariantKey DEFAULT_POSE_OVERLAY_ALPHA_VAR("defaultPoseOverlayAlpha");
+static const AnimVariantKey DEFAULT_POSE_OVERLAY_BONE_SET_VAR("defaultPoseOverlayBoneSet");
+
+static const AnimVariantKey HEAD_TYPE_VAR("headType");
+static const AnimVariantKey HEAD_POSITION_VAR("headPosition");
+static const AnimVariantKey HEAD_ROTATION_VAR("headRotation");
+static const AnimVariantKey HEAD_WEIGHT_VAR("headWeight");
+static const AnimVariantKey HIPS_TYPE_VAR("hipsType");
+static const AnimVariantKey HIPS_POSITION_VAR("hipsPosition");
+static const AnimVariantKey HIPS_ROTATION_VAR("hipsRotation");
+static const AnimVariantKey SPINE2_TYPE_VAR("spine2Type");
+static const AnimVariantKey SPINE2_POSITION_VAR("spine2Position");
+static const AnimVariantKey SPINE2_ROTATION_VAR("spine2Rotation");
+
+static const AnimVariantKey LEFT_HAND_TYPE_VAR("leftHandType");
+static const AnimVariantKey LEFT_HAND_POSITION_VAR("leftHandPosition");
+static const AnimVariantKey LEFT_HAND_ROTATION_VAR("leftHandRotation");
+static const AnimVariantKey LEFT_HAND_POLE_VECTOR_VAR("leftHandPoleVector");
+static const AnimVariantKey LEFT_HAND_POLE_REFERENCE_VECTOR_VAR("leftHandPoleReferenceVector");
+static const AnimVariantKey RIGHT_HAND_TYPE_VAR("rightHandType");
+static const AnimVariantKey RIGHT_HAND_POSITION_VAR("rightHandPosition");
+static const AnimVariantKey RIGHT_HAND_ROTATION_VAR("rightHandRotation");
+static const AnimVariantKey RIGHT_HAND_POLE_VECTOR_VAR("rightHandPoleVector");
+static const AnimVariantKey RIGHT_HAND_POLE_REFERENCE_VECTOR_VAR("rightHandPoleReferenceVector");
+
+static const AnimVariantKey LEFT_FOOT_POSITION_VAR("leftFootPosition");
+static const AnimVariantKey LEFT_FOOT_ROTATION_VAR("leftFootRotation");
+static const AnimVariantKey LEFT_FOOT_POLE_VECTOR_VAR("leftFootPoleVector");
+static const AnimVariantKey RIGHT_FOOT_POSITION_VAR("rightFootPosition");
+static const AnimVariantKey RIGHT_FOOT_ROTATION_VAR("rightFootRotation");
+static const AnimVariantKey RIGHT_FOOT_POLE_VECTOR_VAR("rightFootPoleVector");
+
+static const AnimVariantKey REACTION_POSITIVE_TRIGGER_VAR("reactionPositiveTrigger");
+static const AnimVariantKey REACTION_NEGATIVE_TRIGGER_VAR("reactionNegativeTrigger");
+static const AnimVariantKey REACTION_RAISE_HAND_ENABLED_VAR("reactionRaiseHandEnabled");
+static const AnimVariantKey REACTION_RAISE_HAND_DISABLED_VAR("reactionRaiseHandDisabled");
+static const AnimVariantKey REACTION_APPLAUD_ENABLED_VAR("reactionApplaudEnabled");
+static const AnimVariantKey REACTION_APPLAUD_DISABLED_VAR("reactionApplaudDisabled");
+static const AnimVariantKey REACTION_POINT_ENABLED_VAR("reactionPointEnabled");
+static const AnimVariantKey REACTION_POINT_DISABLED_VAR("reactionPointDisabled");
+
+static const AnimVariantKey TALK_OVERLAY_ALPHA_VAR("talkOverlayAlpha");
+static const AnimVariantKey IDLE_OVERLAY_ALPHA_VAR("idleOverlayAlpha");
+
 
 /**jsdoc
  * <p>An <code>AnimStateDictionary</code> object may have the following properties. It may also have other properties, set by 
@@ -355,9 +459,9 @@ void Rig::overrideAnimation(const QString& url, float fps, bool loop, float firs
     _userAnimState = { clipNodeEnum, url, fps, loop, firstFrame, lastFrame };
 
     // notify the userAnimStateMachine the desired state.
-    _animVars.set("userAnimNone", false);
-    _animVars.set("userAnimA", clipNodeEnum == UserAnimState::A);
-    _animVars.set("userAnimB", clipNodeEnum == UserAnimState::B);
+    _animVars.set(USER_ANIM_NONE_VAR, false);
+    _animVars.set(USER_ANIM_A_VAR, clipNodeEnum == UserAnimState::A);
+    _animVars.set(USER_ANIM_B_VAR, clipNodeEnum == UserAnimState::B);
 }
 
 void Rig::restoreAnimation() {
@@ -365,9 +469,9 @@ void Rig::restoreAnimation() {
         _userAnimState.clipNodeEnum = UserAnimState::None;
 
         // notify the userAnimStateMachine the desired state.
-        _animVars.set("userAnimNone", true);
-        _animVars.set("userAnimA", false);
-        _animVars.set("userAnimB", false);
+        _animVars.set(USER_ANIM_NONE_VAR, true);
+        _animVars.set(USER_ANIM_A_VAR, false);
+        _animVars.set(USER_ANIM_B_VAR, false);
     }
 }
 
@@ -419,15 +523,15 @@ void Rig::overrideHandAnimation(bool isLeft, const QString& url, float fps, bool
     if (isLeft) {
         // store current hand anim state.
         _leftHandAnimState = { clipNodeEnum, url, fps, loop, firstFrame, lastFrame };
-        _animVars.set("leftHandAnimNone", false);
-        _animVars.set("leftHandAnimA", clipNodeEnum == HandAnimState::A);
-        _animVars.set("leftHandAnimB", clipNodeEnum == HandAnimState::B);
+        _animVars.set(LEFT_HAND_ANIM_NONE_VAR, false);
+        _animVars.set(LEFT_HAND_ANIM_A_VAR, clipNodeEnum == HandAnimState::A);
+        _animVars.set(LEFT_HAND_ANIM_B_VAR, clipNodeEnum == HandAnimState::B);
     } else {
         // store current hand anim state.
         _rightHandAnimState = { clipNodeEnum, url, fps, loop, firstFrame, lastFrame };
-        _animVars.set("rightHandAnimNone", false);
-        _animVars.set("rightHandAnimA", clipNodeEnum == HandAnimState::A);
-        _animVars.set("rightHandAnimB", clipNodeEnum == HandAnimState::B);
+        _animVars.set(RIGHT_HAND_ANIM_NONE_VAR, false);
+        _animVars.set(RIGHT_HAND_ANIM_A_VAR, clipNodeEnum == HandAnimState::A);
+        _animVars.set(RIGHT_HAND_ANIM_B_VAR, clipNodeEnum == HandAnimState::B);
     }
 }
 
@@ -437,18 +541,18 @@ void Rig::restoreHandAnimation(bool isLeft) {
             _leftHandAnimState.clipNodeEnum = HandAnimState::None;
 
             // notify the handAnimStateMachine the desired state.
-            _animVars.set("leftHandAnimNone", true);
-            _animVars.set("leftHandAnimA", false);
-            _animVars.set("leftHandAnimB", false);
+            _animVars.set(LEFT_HAND_ANIM_NONE_VAR, true);
+            _animVars.set(LEFT_HAND_ANIM_A_VAR, false);
+            _animVars.set(LEFT_HAND_ANIM_B_VAR, false);
         }
     } else {
         if (_rightHandAnimState.clipNodeEnum != HandAnimState::None) {
             _rightHandAnimState.clipNodeEnum = HandAnimState::None;
 
             // notify the handAnimStateMachine the desired state.
-            _animVars.set("rightHandAnimNone", true);
-            _animVars.set("rightHandAnimA", false);
-            _animVars.set("rightHandAnimB", false);
+            _animVars.set(RIGHT_HAND_ANIM_NONE_VAR, true);
+            _animVars.set(RIGHT_HAND_ANIM_A_VAR, false);
+            _animVars.set(RIGHT_HAND_ANIM_B_VAR, false);
         }
     }
 }
@@ -1083,10 +1187,10 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
 
         // sine wave LFO var for testing.
         static float t = 0.0f;
-        _animVars.set("sine", 2.0f * 0.5f * sinf(t) + 0.5f);
-        _animVars.set("moveForwardSpeed", _averageForwardSpeed.getAverage());
-        _animVars.set("moveBackwardSpeed", -_averageForwardSpeed.getAverage());
-        _animVars.set("moveLateralSpeed", fabsf(_averageLateralSpeed.getAverage()));
+        _animVars.set(SINE_VAR, 2.0f * 0.5f * sinf(t) + 0.5f);
+        _animVars.set(MOVE_FORWARD_SPEED_VAR, _averageForwardSpeed.getAverage());
+        _animVars.set(MOVE_BACKWARD_SPEED_VAR, -_averageForwardSpeed.getAverage());
+        _animVars.set(MOVE_LATERAL_SPEED_VAR, fabsf(_averageLateralSpeed.getAverage()));
 
         const float MOVE_ENTER_SPEED_THRESHOLD = 0.2f; // m/sec
         const float MOVE_EXIT_SPEED_THRESHOLD = 0.07f;  // m/sec
@@ -1184,228 +1288,228 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
                 if (fabsf(forwardSpeed) > 0.5f * fabsf(lateralSpeed)) {
                     if (forwardSpeed > 0.0f) {
                         // forward
-                        _animVars.set("isMovingForward", true);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isMovingRight", false);
-                        _animVars.set("isMovingLeft", false);
-                        _animVars.set("isMovingRightHmd", false);
-                        _animVars.set("isMovingLeftHmd", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(IS_MOVING_FORWARD_VAR, true);
+                        _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+                        _animVars.set(IS_MOVING_RIGHT_VAR, false);
+                        _animVars.set(IS_MOVING_LEFT_VAR, false);
+                        _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+                        _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
+                        _animVars.set(IS_NOT_MOVING_VAR, false);
 
                     } else {
                         // backward
-                        _animVars.set("isMovingBackward", true);
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingRight", false);
-                        _animVars.set("isMovingLeft", false);
-                        _animVars.set("isMovingRightHmd", false);
-                        _animVars.set("isMovingLeftHmd", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(IS_MOVING_BACKWARD_VAR, true);
+                        _animVars.set(IS_MOVING_FORWARD_VAR, false);
+                        _animVars.set(IS_MOVING_RIGHT_VAR, false);
+                        _animVars.set(IS_MOVING_LEFT_VAR, false);
+                        _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+                        _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
+                        _animVars.set(IS_NOT_MOVING_VAR, false);
                     }
                 } else {
                     if (lateralSpeed > 0.0f) {
                         // right
                         if (!_headEnabled) {
-                            _animVars.set("isMovingRight", true);
-                            _animVars.set("isMovingLeft", false);
-                            _animVars.set("isMovingRightHmd", false);
-                            _animVars.set("isMovingLeftHmd", false);
+                            _animVars.set(IS_MOVING_RIGHT_VAR, true);
+                            _animVars.set(IS_MOVING_LEFT_VAR, false);
+                            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+                            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
                         } else {
-                            _animVars.set("isMovingRight", false);
-                            _animVars.set("isMovingLeft", false);
-                            _animVars.set("isMovingRightHmd", true);
-                            _animVars.set("isMovingLeftHmd", false);
+                            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+                            _animVars.set(IS_MOVING_LEFT_VAR, false);
+                            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, true);
+                            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
                         }
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(IS_MOVING_FORWARD_VAR, false);
+                        _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+                        _animVars.set(IS_NOT_MOVING_VAR, false);
                     } else {
                         // left
                         if (!_headEnabled) {
-                            _animVars.set("isMovingRight", false);
-                            _animVars.set("isMovingLeft", true);
-                            _animVars.set("isMovingRightHmd", false);
-                            _animVars.set("isMovingLeftHmd", false);
+                            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+                            _animVars.set(IS_MOVING_LEFT_VAR, true);
+                            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+                            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
                         } else {
-                            _animVars.set("isMovingRight", false);
-                            _animVars.set("isMovingLeft", false);
-                            _animVars.set("isMovingRightHmd", false);
-                            _animVars.set("isMovingLeftHmd", true);
+                            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+                            _animVars.set(IS_MOVING_LEFT_VAR, false);
+                            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+                            _animVars.set(IS_MOVING_LEFT_HMD_VAR, true);
                         }
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(IS_MOVING_FORWARD_VAR, false);
+                        _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+                        _animVars.set(IS_NOT_MOVING_VAR, false);
                     }
                 }
             }
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
-            _animVars.set("isSeated", false);
-            _animVars.set("isNotSeated", true);
-            _animVars.set("isSeatedTurningRight", false);
-            _animVars.set("isSeatedTurningLeft", false);
-            _animVars.set("isSeatedNotTurning", false);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
+            _animVars.set(IS_SEATED_VAR, false);
+            _animVars.set(IS_NOT_SEATED_VAR, true);
+            _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_SEATED_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_SEATED_NOT_TURNING_VAR, false);
 
         } else if (_state == RigRole::Turn) {
             if (turningSpeed > 0.0f) {
                 // turning right
-                _animVars.set("isTurningRight", true);
-                _animVars.set("isTurningLeft", false);
-                _animVars.set("isNotTurning", false);
+                _animVars.set(IS_TURNING_RIGHT_VAR, true);
+                _animVars.set(IS_TURNING_LEFT_VAR, false);
+                _animVars.set(IS_NOT_TURNING_VAR, false);
             } else {
                 // turning left
-                _animVars.set("isTurningRight", false);
-                _animVars.set("isTurningLeft", true);
-                _animVars.set("isNotTurning", false);
+                _animVars.set(IS_TURNING_RIGHT_VAR, false);
+                _animVars.set(IS_TURNING_LEFT_VAR, true);
+                _animVars.set(IS_NOT_TURNING_VAR, false);
             }
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRightHmd", false);
-            _animVars.set("isMovingLeftHmd", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
-            _animVars.set("isSeated", false);
-            _animVars.set("isNotSeated", true);
-            _animVars.set("isSeatedTurningRight", false);
-            _animVars.set("isSeatedTurningLeft", false);
-            _animVars.set("isSeatedNotTurning", false);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
+            _animVars.set(IS_SEATED_VAR, false);
+            _animVars.set(IS_NOT_SEATED_VAR, true);
+            _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_SEATED_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_SEATED_NOT_TURNING_VAR, false);
 
         } else if (_state == RigRole::Idle) {
             // default anim vars to notMoving and notTurning
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRightHmd", false);
-            _animVars.set("isMovingLeftHmd", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
-            _animVars.set("isSeated", false);
-            _animVars.set("isNotSeated", true);
-            _animVars.set("isSeatedTurningRight", false);
-            _animVars.set("isSeatedTurningLeft", false);
-            _animVars.set("isSeatedNotTurning", false);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
+            _animVars.set(IS_SEATED_VAR, false);
+            _animVars.set(IS_NOT_SEATED_VAR, true);
+            _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_SEATED_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_SEATED_NOT_TURNING_VAR, false);
 
         } else if (_state == RigRole::Hover) {
             // flying.
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRightHmd", false);
-            _animVars.set("isMovingLeftHmd", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", true);
-            _animVars.set("isNotFlying", false);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
-            _animVars.set("isSeated", false);
-            _animVars.set("isNotSeated", true);
-            _animVars.set("isSeatedTurningRight", false);
-            _animVars.set("isSeatedTurningLeft", false);
-            _animVars.set("isSeatedNotTurning", false);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, true);
+            _animVars.set(IS_NOT_FLYING_VAR, false);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
+            _animVars.set(IS_SEATED_VAR, false);
+            _animVars.set(IS_NOT_SEATED_VAR, true);
+            _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_SEATED_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_SEATED_NOT_TURNING_VAR, false);
 
         } else if (_state == RigRole::Takeoff) {
             // jumping in-air
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRightHmd", false);
-            _animVars.set("isMovingLeftHmd", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
 
             bool takeOffRun = forwardSpeed > 0.1f;
             if (takeOffRun) {
-                _animVars.set("isTakeoffStand", false);
-                _animVars.set("isTakeoffRun", true);
+                _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+                _animVars.set(IS_TAKEOFF_RUN_VAR, true);
             } else {
-                _animVars.set("isTakeoffStand", true);
-                _animVars.set("isTakeoffRun", false);
+                _animVars.set(IS_TAKEOFF_STAND_VAR, true);
+                _animVars.set(IS_TAKEOFF_RUN_VAR, false);
             }
 
-            _animVars.set("isNotTakeoff", false);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", false);
-            _animVars.set("isSeated", false);
-            _animVars.set("isNotSeated", true);
-            _animVars.set("isSeatedTurningRight", false);
-            _animVars.set("isSeatedTurningLeft", false);
-            _animVars.set("isSeatedNotTurning", false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, false);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, false);
+            _animVars.set(IS_SEATED_VAR, false);
+            _animVars.set(IS_NOT_SEATED_VAR, true);
+            _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_SEATED_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_SEATED_NOT_TURNING_VAR, false);
 
         } else if (_state == RigRole::InAir) {
             // jumping in-air
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRightHmd", false);
-            _animVars.set("isMovingLeftHmd", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isSeated", false);
-            _animVars.set("isNotSeated", true);
-            _animVars.set("isSeatedTurningRight", false);
-            _animVars.set("isSeatedTurningLeft", false);
-            _animVars.set("isSeatedNotTurning", false);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_SEATED_VAR, false);
+            _animVars.set(IS_NOT_SEATED_VAR, true);
+            _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_SEATED_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_SEATED_NOT_TURNING_VAR, false);
 
             bool inAirRun = forwardSpeed > 0.1f;
             if (inAirRun) {
-                _animVars.set("isInAirStand", false);
-                _animVars.set("isInAirRun", true);
+                _animVars.set(IS_IN_AIR_STAND_VAR, false);
+                _animVars.set(IS_IN_AIR_RUN_VAR, true);
             } else {
-                _animVars.set("isInAirStand", true);
-                _animVars.set("isInAirRun", false);
+                _animVars.set(IS_IN_AIR_STAND_VAR, true);
+                _animVars.set(IS_IN_AIR_RUN_VAR, false);
             }
-            _animVars.set("isNotInAir", false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, false);
 
             // We want to preserve the apparent jump height in sensor space.
             const float jumpHeight = std::max(sensorToWorldScale * DEFAULT_AVATAR_JUMP_HEIGHT, DEFAULT_AVATAR_MIN_JUMP_HEIGHT);
@@ -1416,62 +1520,62 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
             // compute inAirAlpha blend based on velocity
             float alpha = glm::clamp((-workingVelocity.y * sensorToWorldScale) / jumpSpeed, -1.0f, 1.0f) + 1.0f;
 
-            _animVars.set("inAirAlpha", alpha);
+            _animVars.set(IN_AIR_ALPHA_VAR, alpha);
         } else if (_state == RigRole::Seated) {
             if (fabsf(_previousControllerParameters.inputX) <= INPUT_DEADZONE_THRESHOLD) {
                 // seated not turning
-                _animVars.set("isSeatedTurningRight", false);
-                _animVars.set("isSeatedTurningLeft", false);
-                _animVars.set("isSeatedNotTurning", true);
+                _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, false);
+                _animVars.set(IS_SEATED_TURNING_LEFT_VAR, false);
+                _animVars.set(IS_SEATED_NOT_TURNING_VAR, true);
             } else if (_previousControllerParameters.inputX > 0.0f) {
                 // seated turning right
-                _animVars.set("isSeatedTurningRight", true);
-                _animVars.set("isSeatedTurningLeft", false);
-                _animVars.set("isSeatedNotTurning", false);
+                _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, true);
+                _animVars.set(IS_SEATED_TURNING_LEFT_VAR, false);
+                _animVars.set(IS_SEATED_NOT_TURNING_VAR, false);
             } else {
                 // seated turning left
-                _animVars.set("isSeatedTurningRight", false);
-                _animVars.set("isSeatedTurningLeft", true);
-                _animVars.set("isSeatedNotTurning", false);
+                _animVars.set(IS_SEATED_TURNING_RIGHT_VAR, false);
+                _animVars.set(IS_SEATED_TURNING_LEFT_VAR, true);
+                _animVars.set(IS_SEATED_NOT_TURNING_VAR, false);
             }
 
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRightHmd", false);
-            _animVars.set("isMovingLeftHmd", false);
-            _animVars.set("isNotMoving", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
-            _animVars.set("isSeated", true);
-            _animVars.set("isNotSeated", false);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_HMD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_HMD_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, false);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
+            _animVars.set(IS_SEATED_VAR, true);
+            _animVars.set(IS_NOT_SEATED_VAR, false);
         }
 
         t += deltaTime;
 
         if (_enableInverseKinematics) {
-            _animVars.set("ikOverlayAlpha", 1.0f);
+            _animVars.set(IK_OVERLAY_ALPHA_VAR, 1.0f);
         } else {
-            _animVars.set("ikOverlayAlpha", 0.0f);
-            _animVars.set("splineIKEnabled", false);
-            _animVars.set("leftHandIKEnabled", false);
-            _animVars.set("rightHandIKEnabled", false);
-            _animVars.set("leftFootIKEnabled", false);
-            _animVars.set("rightFootIKEnabled", false);
-            _animVars.set("leftHandPoleVectorEnabled", false);
-            _animVars.set("rightHandPoleVectorEnabled", false);
-            _animVars.set("leftFootPoleVectorEnabled", false);
-            _animVars.set("rightFootPoleVectorEnabled", false);
+            _animVars.set(IK_OVERLAY_ALPHA_VAR, 0.0f);
+            _animVars.set(SPLINE_IK_ENABLED_VAR, false);
+            _animVars.set(LEFT_HAND_IK_ENABLED_VAR, false);
+            _animVars.set(RIGHT_HAND_IK_ENABLED_VAR, false);
+            _animVars.set(LEFT_FOOT_IK_ENABLED_VAR, false);
+            _animVars.set(RIGHT_FOOT_IK_ENABLED_VAR, false);
+            _animVars.set(LEFT_HAND_POLE_VECTOR_ENABLED_VAR, false);
+            _animVars.set(RIGHT_HAND_POLE_VECTOR_ENABLED_VAR, false);
+            _animVars.set(LEFT_FOOT_POLE_VECTOR_ENABLED_VAR, false);
+            _animVars.set(RIGHT_FOOT_POLE_VECTOR_ENABLED_VAR, false);
         }
         _lastEnableInverseKinematics = _enableInverseKinematics;
 
@@ -1490,31 +1594,31 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
                 }
 
 
-                _animVars.set("isInputForward", false);
-                _animVars.set("isInputBackward", false);
-                _animVars.set("isInputRight", false);
-                _animVars.set("isInputLeft", false);
+                _animVars.set(IS_INPUT_FORWARD_VAR, false);
+                _animVars.set(IS_INPUT_BACKWARD_VAR, false);
+                _animVars.set(IS_INPUT_RIGHT_VAR, false);
+                _animVars.set(IS_INPUT_LEFT_VAR, false);
 
                 // directly reflects input
-                _animVars.set("isNotInput", true);  
+                _animVars.set(IS_NOT_INPUT_VAR, true);  
 
                 // no input + speed drops to SLOW_SPEED_THRESHOLD
                 // (don't transition run->idle - slow to walk first)
-                _animVars.set("isNotInputSlow", _isMovingWithMomentum);
+                _animVars.set(IS_NOT_INPUT_SLOW_VAR, _isMovingWithMomentum);
 
                 // no input + speed didn't get above HAS_MOMENTUM_THRESHOLD since last idle
                 // (brief inputs and movement adjustments)
-                _animVars.set("isNotInputNoMomentum", !_isMovingWithMomentum);
+                _animVars.set(IS_NOT_INPUT_NO_MOMENTUM_VAR, !_isMovingWithMomentum);
 
 
             } else {
-                _animVars.set("isInputForward", false);
-                _animVars.set("isInputBackward", false);
-                _animVars.set("isInputRight", false);
-                _animVars.set("isInputLeft", false);
-                _animVars.set("isNotInput", true);
-                _animVars.set("isNotInputSlow", false);
-                _animVars.set("isNotInputNoMomentum", false);
+                _animVars.set(IS_INPUT_FORWARD_VAR, false);
+                _animVars.set(IS_INPUT_BACKWARD_VAR, false);
+                _animVars.set(IS_INPUT_RIGHT_VAR, false);
+                _animVars.set(IS_INPUT_LEFT_VAR, false);
+                _animVars.set(IS_NOT_INPUT_VAR, true);
+                _animVars.set(IS_NOT_INPUT_SLOW_VAR, false);
+                _animVars.set(IS_NOT_INPUT_NO_MOMENTUM_VAR, false);
             }
         } else if (fabsf(_previousControllerParameters.inputZ) >= fabsf(_previousControllerParameters.inputX)) {
             if (fabsf(forwardSpeed) > HAS_MOMENTUM_THRESHOLD) {
@@ -1523,22 +1627,22 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
 
             if (_previousControllerParameters.inputZ > 0.0f) {
                 // forward
-                _animVars.set("isInputForward", true);
-                _animVars.set("isInputBackward", false);
-                _animVars.set("isInputRight", false);
-                _animVars.set("isInputLeft", false);
-                _animVars.set("isNotInput", false);
-                _animVars.set("isNotInputSlow", false);
-                _animVars.set("isNotInputNoMomentum", false);
+                _animVars.set(IS_INPUT_FORWARD_VAR, true);
+                _animVars.set(IS_INPUT_BACKWARD_VAR, false);
+                _animVars.set(IS_INPUT_RIGHT_VAR, false);
+                _animVars.set(IS_INPUT_LEFT_VAR, false);
+                _animVars.set(IS_NOT_INPUT_VAR, false);
+                _animVars.set(IS_NOT_INPUT_SLOW_VAR, false);
+                _animVars.set(IS_NOT_INPUT_NO_MOMENTUM_VAR, false);
             } else {
                 // backward
-                _animVars.set("isInputForward", false);
-                _animVars.set("isInputBackward", true);
-                _animVars.set("isInputRight", false);
-                _animVars.set("isInputLeft", false);
-                _animVars.set("isNotInput", false);
-                _animVars.set("isNotInputSlow", false);
-                _animVars.set("isNotInputNoMomentum", false);
+                _animVars.set(IS_INPUT_FORWARD_VAR, false);
+                _animVars.set(IS_INPUT_BACKWARD_VAR, true);
+                _animVars.set(IS_INPUT_RIGHT_VAR, false);
+                _animVars.set(IS_INPUT_LEFT_VAR, false);
+                _animVars.set(IS_NOT_INPUT_VAR, false);
+                _animVars.set(IS_NOT_INPUT_SLOW_VAR, false);
+                _animVars.set(IS_NOT_INPUT_NO_MOMENTUM_VAR, false);
             }
         } else {
             if (fabsf(lateralSpeed) > HAS_MOMENTUM_THRESHOLD) {
@@ -1548,31 +1652,31 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
             if (_previousControllerParameters.inputX > 0.0f) {
                 // right
                 if (!_headEnabled) {
-                    _animVars.set("isInputRight", true);
+                    _animVars.set(IS_INPUT_RIGHT_VAR, true);
                 } else {
-                    _animVars.set("isInputRight", false);
+                    _animVars.set(IS_INPUT_RIGHT_VAR, false);
                 }
 
-                _animVars.set("isInputLeft", false);
-                _animVars.set("isInputForward", false);
-                _animVars.set("isInputBackward", false);
-                _animVars.set("isNotInput", false);
-                _animVars.set("isNotInputSlow", false);
-                _animVars.set("isNotInputNoMomentum", false);
+                _animVars.set(IS_INPUT_LEFT_VAR, false);
+                _animVars.set(IS_INPUT_FORWARD_VAR, false);
+                _animVars.set(IS_INPUT_BACKWARD_VAR, false);
+                _animVars.set(IS_NOT_INPUT_VAR, false);
+                _animVars.set(IS_NOT_INPUT_SLOW_VAR, false);
+                _animVars.set(IS_NOT_INPUT_NO_MOMENTUM_VAR, false);
             } else {
                 // left
                 if (!_headEnabled) {
-                    _animVars.set("isInputLeft", true);
+                    _animVars.set(IS_INPUT_LEFT_VAR, true);
                 } else {
-                    _animVars.set("isInputLeft", false);
+                    _animVars.set(IS_INPUT_LEFT_VAR, false);
                 }
 
-                _animVars.set("isInputForward", false);
-                _animVars.set("isInputBackward", false);
-                _animVars.set("isInputRight", false);
-                _animVars.set("isNotInput", false);
-                _animVars.set("isNotInputSlow", false);
-                _animVars.set("isNotInputNoMomentum", false);
+                _animVars.set(IS_INPUT_FORWARD_VAR, false);
+                _animVars.set(IS_INPUT_BACKWARD_VAR, false);
+                _animVars.set(IS_INPUT_RIGHT_VAR, false);
+                _animVars.set(IS_NOT_INPUT_VAR, false);
+                _animVars.set(IS_NOT_INPUT_SLOW_VAR, false);
+                _animVars.set(IS_NOT_INPUT_NO_MOMENTUM_VAR, false);
             }
         }
 
@@ -1785,25 +1889,25 @@ void Rig::computeHeadFromHMD(const AnimPose& hmdPose, glm::vec3& headPositionOut
 void Rig::updateHead(bool headEnabled, bool hipsEnabled, const AnimPose& headPose) {
     if (_animSkeleton) {
         if (headEnabled) {
-            _animVars.set("splineIKEnabled", true);
-            _animVars.set("headPosition", headPose.trans());
-            _animVars.set("headRotation", headPose.rot());
+            _animVars.set(SPLINE_IK_ENABLED_VAR, true);
+            _animVars.set(HEAD_POSITION_VAR, headPose.trans());
+            _animVars.set(HEAD_ROTATION_VAR, headPose.rot());
             if (hipsEnabled) {
                 // Since there is an explicit hips ik target, switch the head to use the more flexible Spline IK chain type.
                 // this will allow the spine to compress/expand and bend more natrually, ensuring that it can reach the head target position.
-                _animVars.set("headType", (int)IKTarget::Type::Spline);
-                _animVars.unset("headWeight");  // use the default weight for this target.
+                _animVars.set(HEAD_TYPE_VAR, (int)IKTarget::Type::Spline);
+                _animVars.unset(HEAD_WEIGHT_VAR);  // use the default weight for this target.
             } else {
                 // When there is no hips IK target, use the HmdHead IK chain type.  This will make the spine very stiff,
                 // but because the IK _hipsOffset is enabled, the hips will naturally follow underneath the head.
-                _animVars.set("headType", (int)IKTarget::Type::HmdHead);
-                _animVars.set("headWeight", 8.0f);
+                _animVars.set(HEAD_TYPE_VAR, (int)IKTarget::Type::HmdHead);
+                _animVars.set(HEAD_WEIGHT_VAR, 8.0f);
             }
         } else {
-            _animVars.set("splineIKEnabled", false);
-            _animVars.unset("headPosition");
-            _animVars.set("headRotation", headPose.rot());
-            _animVars.set("headType", (int)IKTarget::Type::Unknown);
+            _animVars.set(SPLINE_IK_ENABLED_VAR, false);
+            _animVars.unset(HEAD_POSITION_VAR);
+            _animVars.set(HEAD_ROTATION_VAR, headPose.rot());
+            _animVars.set(HEAD_TYPE_VAR, (int)IKTarget::Type::Unknown);
         }
     }
 }
@@ -1866,12 +1970,12 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
 
     if (headEnabled) {
         // always do IK if head is enabled
-        _animVars.set("leftHandIKEnabled", true);
-        _animVars.set("rightHandIKEnabled", true);
+        _animVars.set(LEFT_HAND_IK_ENABLED_VAR, true);
+        _animVars.set(RIGHT_HAND_IK_ENABLED_VAR, true);
     } else {
         // only do IK if we have a valid foot.
-        _animVars.set("leftHandIKEnabled", leftHandEnabled);
-        _animVars.set("rightHandIKEnabled", rightHandEnabled);
+        _animVars.set(LEFT_HAND_IK_ENABLED_VAR, leftHandEnabled);
+        _animVars.set(RIGHT_HAND_IK_ENABLED_VAR, rightHandEnabled);
     }
 
     if (leftHandEnabled) {
@@ -1888,9 +1992,9 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
             handPosition = deflectHandFromTorso(handPosition, hipsShapeInfo, spineShapeInfo, spine1ShapeInfo, spine2ShapeInfo);
         }
 
-        _animVars.set("leftHandPosition", handPosition);
-        _animVars.set("leftHandRotation", handRotation);
-        _animVars.set("leftHandType", (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(LEFT_HAND_POSITION_VAR, handPosition);
+        _animVars.set(LEFT_HAND_ROTATION_VAR, handRotation);
+        _animVars.set(LEFT_HAND_TYPE_VAR, (int)IKTarget::Type::RotationAndPosition);
 
         // compute pole vector
         int handJointIndex = _animSkeleton->nameToJointIndex("LeftHand");
@@ -1902,29 +2006,29 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
             bool usePoleVector = calculateElbowPoleVector(handJointIndex, elbowJointIndex, armJointIndex, oppositeArmJointIndex, poleVector);
             if (usePoleVector) {
                 glm::vec3 sensorPoleVector = transformVectorFast(rigToSensorMatrix, poleVector);
-                _animVars.set("leftHandPoleVectorEnabled", true);
-                _animVars.set("leftHandPoleReferenceVector", Vectors::UNIT_X);
-                _animVars.set("leftHandPoleVector", transformVectorFast(sensorToRigMatrix, sensorPoleVector));
+                _animVars.set(LEFT_HAND_POLE_VECTOR_ENABLED_VAR, true);
+                _animVars.set(LEFT_HAND_POLE_REFERENCE_VECTOR_VAR, Vectors::UNIT_X);
+                _animVars.set(LEFT_HAND_POLE_VECTOR_VAR, transformVectorFast(sensorToRigMatrix, sensorPoleVector));
             } else {
-                _animVars.set("leftHandPoleVectorEnabled", false);
+                _animVars.set(LEFT_HAND_POLE_VECTOR_ENABLED_VAR, false);
             }
         } else {
-            _animVars.set("leftHandPoleVectorEnabled", false);
+            _animVars.set(LEFT_HAND_POLE_VECTOR_ENABLED_VAR, false);
         }
     } else {
         // need this for two bone ik
         _animVars.set(LEFT_HAND_IK_POSITION_VAR, MAIN_STATE_MACHINE_LEFT_HAND_POSITION);
         _animVars.set(LEFT_HAND_IK_ROTATION_VAR, MAIN_STATE_MACHINE_LEFT_HAND_ROTATION);
 
-        _animVars.set("leftHandPoleVectorEnabled", false);
-        _animVars.unset("leftHandPosition");
-        _animVars.unset("leftHandRotation");
+        _animVars.set(LEFT_HAND_POLE_VECTOR_ENABLED_VAR, false);
+        _animVars.unset(LEFT_HAND_POSITION_VAR);
+        _animVars.unset(LEFT_HAND_ROTATION_VAR);
 
         if (headEnabled) {
-            _animVars.set("leftHandType", (int)IKTarget::Type::HipsRelativeRotationAndPosition);
+            _animVars.set(LEFT_HAND_TYPE_VAR, (int)IKTarget::Type::HipsRelativeRotationAndPosition);
         } else {
             // disable hand IK for desktop mode
-            _animVars.set("leftHandType", (int)IKTarget::Type::Unknown);
+            _animVars.set(LEFT_HAND_TYPE_VAR, (int)IKTarget::Type::Unknown);
         }
     }
 
@@ -1942,9 +2046,9 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
             handPosition = deflectHandFromTorso(handPosition, hipsShapeInfo, spineShapeInfo, spine1ShapeInfo, spine2ShapeInfo);
         }
 
-        _animVars.set("rightHandPosition", handPosition);
-        _animVars.set("rightHandRotation", handRotation);
-        _animVars.set("rightHandType", (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(RIGHT_HAND_POSITION_VAR, handPosition);
+        _animVars.set(RIGHT_HAND_ROTATION_VAR, handRotation);
+        _animVars.set(RIGHT_HAND_TYPE_VAR, (int)IKTarget::Type::RotationAndPosition);
 
         // compute pole vector
         int handJointIndex = _animSkeleton->nameToJointIndex("RightHand");
@@ -1957,14 +2061,14 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
             bool usePoleVector = calculateElbowPoleVector(handJointIndex, elbowJointIndex, armJointIndex, oppositeArmJointIndex, poleVector);
             if (usePoleVector) {
                 glm::vec3 sensorPoleVector = transformVectorFast(rigToSensorMatrix, poleVector);
-                _animVars.set("rightHandPoleVectorEnabled", true);
-                _animVars.set("rightHandPoleReferenceVector", -Vectors::UNIT_X);
-                _animVars.set("rightHandPoleVector", transformVectorFast(sensorToRigMatrix, sensorPoleVector));
+                _animVars.set(RIGHT_HAND_POLE_VECTOR_ENABLED_VAR, true);
+                _animVars.set(RIGHT_HAND_POLE_REFERENCE_VECTOR_VAR, -Vectors::UNIT_X);
+                _animVars.set(RIGHT_HAND_POLE_VECTOR_VAR, transformVectorFast(sensorToRigMatrix, sensorPoleVector));
             } else {
-                _animVars.set("rightHandPoleVectorEnabled", false);
+                _animVars.set(RIGHT_HAND_POLE_VECTOR_ENABLED_VAR, false);
             }
         } else {
-            _animVars.set("rightHandPoleVectorEnabled", false);
+            _animVars.set(RIGHT_HAND_POLE_VECTOR_ENABLED_VAR, false);
         }
     } else {
 
@@ -1972,15 +2076,15 @@ void Rig::updateHands(bool leftHandEnabled, bool rightHandEnabled, bool hipsEnab
         _animVars.set(RIGHT_HAND_IK_POSITION_VAR, MAIN_STATE_MACHINE_RIGHT_HAND_POSITION);
         _animVars.set(RIGHT_HAND_IK_ROTATION_VAR, MAIN_STATE_MACHINE_RIGHT_HAND_ROTATION);
 
-        _animVars.set("rightHandPoleVectorEnabled", false);
-        _animVars.unset("rightHandPosition");
-        _animVars.unset("rightHandRotation");
+        _animVars.set(RIGHT_HAND_POLE_VECTOR_ENABLED_VAR, false);
+        _animVars.unset(RIGHT_HAND_POSITION_VAR);
+        _animVars.unset(RIGHT_HAND_ROTATION_VAR);
 
         if (headEnabled) {
-            _animVars.set("rightHandType", (int)IKTarget::Type::HipsRelativeRotationAndPosition);
+            _animVars.set(RIGHT_HAND_TYPE_VAR, (int)IKTarget::Type::HipsRelativeRotationAndPosition);
         } else {
             // disable hand IK for desktop mode
-            _animVars.set("rightHandType", (int)IKTarget::Type::Unknown);
+            _animVars.set(RIGHT_HAND_TYPE_VAR, (int)IKTarget::Type::Unknown);
         }
     }
 }
@@ -1996,18 +2100,18 @@ void Rig::updateFeet(bool leftFootEnabled, bool rightFootEnabled, bool headEnabl
 
     if (headEnabled && !isSeated) {
         // enable leg IK if head is enabled and we arent sitting down.
-        _animVars.set("leftFootIKEnabled", true);
-        _animVars.set("rightFootIKEnabled", true);
+        _animVars.set(LEFT_FOOT_IK_ENABLED_VAR, true);
+        _animVars.set(RIGHT_FOOT_IK_ENABLED_VAR, true);
     } else {
         // only do IK if we have a valid foot.
-        _animVars.set("leftFootIKEnabled", leftFootEnabled);
-        _animVars.set("rightFootIKEnabled", rightFootEnabled);
+        _animVars.set(LEFT_FOOT_IK_ENABLED_VAR, leftFootEnabled);
+        _animVars.set(RIGHT_FOOT_IK_ENABLED_VAR, rightFootEnabled);
     }
 
     if (leftFootEnabled) {
 
-        _animVars.set(LEFT_FOOT_POSITION, leftFootPose.trans());
-        _animVars.set(LEFT_FOOT_ROTATION, leftFootPose.rot());
+        _animVars.set(LEFT_FOOT_POSITION_VAR, leftFootPose.trans());
+        _animVars.set(LEFT_FOOT_ROTATION_VAR, leftFootPose.rot());
 
         // We want to drive the IK directly from the trackers.
         _animVars.set(LEFT_FOOT_IK_POSITION_VAR, LEFT_FOOT_POSITION);
@@ -2028,8 +2132,8 @@ void Rig::updateFeet(bool leftFootEnabled, bool rightFootEnabled, bool headEnabl
         glm::quat smoothDeltaRot = safeMix(deltaRot, Quaternions::IDENTITY, KNEE_POLE_VECTOR_BLEND_FACTOR);
         _prevLeftFootPoleVector = smoothDeltaRot * _prevLeftFootPoleVector;
 
-        _animVars.set("leftFootPoleVectorEnabled", true);
-        _animVars.set("leftFootPoleVector", transformVectorFast(sensorToRigMatrix, _prevLeftFootPoleVector));
+        _animVars.set(LEFT_FOOT_POLE_VECTOR_ENABLED_VAR, true);
+        _animVars.set(LEFT_FOOT_POLE_VECTOR_VAR, transformVectorFast(sensorToRigMatrix, _prevLeftFootPoleVector));
     } else {
         // We want to drive the IK from the underlying animation.
         // This gives us the ability to squat while in the HMD, without the feet from dipping under the floor.
@@ -2037,13 +2141,13 @@ void Rig::updateFeet(bool leftFootEnabled, bool rightFootEnabled, bool headEnabl
         _animVars.set(LEFT_FOOT_IK_ROTATION_VAR, MAIN_STATE_MACHINE_LEFT_FOOT_ROTATION);
 
         // We want to match the animated knee pose as close as possible, so don't use poleVectors
-        _animVars.set("leftFootPoleVectorEnabled", false);
+        _animVars.set(LEFT_FOOT_POLE_VECTOR_ENABLED_VAR, false);
         _prevLeftFootPoleVectorValid = false;
     }
 
     if (rightFootEnabled) {
-        _animVars.set(RIGHT_FOOT_POSITION, rightFootPose.trans());
-        _animVars.set(RIGHT_FOOT_ROTATION, rightFootPose.rot());
+        _animVars.set(RIGHT_FOOT_POSITION_VAR, rightFootPose.trans());
+        _animVars.set(RIGHT_FOOT_ROTATION_VAR, rightFootPose.rot());
 
         // We want to drive the IK directly from the trackers.
         _animVars.set(RIGHT_FOOT_IK_POSITION_VAR, RIGHT_FOOT_POSITION);
@@ -2064,8 +2168,8 @@ void Rig::updateFeet(bool leftFootEnabled, bool rightFootEnabled, bool headEnabl
         glm::quat smoothDeltaRot = safeMix(deltaRot, Quaternions::IDENTITY, KNEE_POLE_VECTOR_BLEND_FACTOR);
         _prevRightFootPoleVector = smoothDeltaRot * _prevRightFootPoleVector;
 
-        _animVars.set("rightFootPoleVectorEnabled", true);
-        _animVars.set("rightFootPoleVector", transformVectorFast(sensorToRigMatrix, _prevRightFootPoleVector));
+        _animVars.set(RIGHT_FOOT_POLE_VECTOR_ENABLED_VAR, true);
+        _animVars.set(RIGHT_FOOT_POLE_VECTOR_VAR, transformVectorFast(sensorToRigMatrix, _prevRightFootPoleVector));
     } else {
         // We want to drive the IK from the underlying animation.
         // This gives us the ability to squat while in the HMD, without the feet from dipping under the floor.
@@ -2073,7 +2177,7 @@ void Rig::updateFeet(bool leftFootEnabled, bool rightFootEnabled, bool headEnabl
         _animVars.set(RIGHT_FOOT_IK_ROTATION_VAR, MAIN_STATE_MACHINE_RIGHT_FOOT_ROTATION);
 
         // We want to match the animated knee pose as close as possible, so don't use poleVectors
-        _animVars.set("rightFootPoleVectorEnabled", false);
+        _animVars.set(RIGHT_FOOT_POLE_VECTOR_ENABLED_VAR, false);
         _prevRightFootPoleVectorValid = false;
     }
 }
@@ -2082,29 +2186,29 @@ void Rig::updateReactions(const ControllerParameters& params) {
 
     // trigger reactions
     if (params.reactionTriggers[AVATAR_REACTION_POSITIVE]) {
-        _animVars.set("reactionPositiveTrigger", true);
+        _animVars.set(REACTION_POSITIVE_TRIGGER_VAR, true);
     } else {
-        _animVars.set("reactionPositiveTrigger", false);
+        _animVars.set(REACTION_POSITIVE_TRIGGER_VAR, false);
     }
 
     if (params.reactionTriggers[AVATAR_REACTION_NEGATIVE]) {
-        _animVars.set("reactionNegativeTrigger", true);
+        _animVars.set(REACTION_NEGATIVE_TRIGGER_VAR, true);
     } else {
-        _animVars.set("reactionNegativeTrigger", false);
+        _animVars.set(REACTION_NEGATIVE_TRIGGER_VAR, false);
     }
 
     // begin end reactions
     bool enabled = params.reactionEnabledFlags[AVATAR_REACTION_RAISE_HAND];
-    _animVars.set("reactionRaiseHandEnabled", enabled);
-    _animVars.set("reactionRaiseHandDisabled", !enabled);
+    _animVars.set(REACTION_RAISE_HAND_ENABLED_VAR, enabled);
+    _animVars.set(REACTION_RAISE_HAND_DISABLED_VAR, !enabled);
 
     enabled = params.reactionEnabledFlags[AVATAR_REACTION_APPLAUD];
-    _animVars.set("reactionApplaudEnabled", enabled);
-    _animVars.set("reactionApplaudDisabled", !enabled);
+    _animVars.set(REACTION_APPLAUD_ENABLED_VAR, enabled);
+    _animVars.set(REACTION_APPLAUD_DISABLED_VAR, !enabled);
 
     enabled = params.reactionEnabledFlags[AVATAR_REACTION_POINT];
-    _animVars.set("reactionPointEnabled", enabled);
-    _animVars.set("reactionPointDisabled", !enabled);
+    _animVars.set(REACTION_POINT_ENABLED_VAR, enabled);
+    _animVars.set(REACTION_POINT_DISABLED_VAR, !enabled);
 
     // determine if we should ramp off IK
     if (_enableInverseKinematics) {
@@ -2122,7 +2226,7 @@ void Rig::updateReactions(const ControllerParameters& params) {
         if ((reactionPlaying || isSeated) && !hmdMode) {
             // TODO: make this smooth.
             // disable head IK while reaction is playing, but only in "desktop" mode.
-            _animVars.set("headType", (int)IKTarget::Type::Unknown);
+            _animVars.set(HEAD_TYPE_VAR, (int)IKTarget::Type::Unknown);
         }
     }
 }
@@ -2283,11 +2387,11 @@ void Rig::updateFromControllerParameters(const ControllerParameters& params, flo
                 _talkIdleInterpTime = 1.0f;
             }
             float easeOutInValue = _talkIdleInterpTime < 0.5f ? 4.0f * powf(_talkIdleInterpTime, 3.0f) : 4.0f * powf((_talkIdleInterpTime - 1.0f), 3.0f) + 1.0f;
-            _animVars.set("talkOverlayAlpha", easeOutInValue);
-            _animVars.set("idleOverlayAlpha", easeOutInValue);  // backward compatibility for older anim graphs.
+            _animVars.set(TALK_OVERLAY_ALPHA_VAR, easeOutInValue);
+            _animVars.set(IDLE_OVERLAY_ALPHA_VAR, easeOutInValue);  // backward compatibility for older anim graphs.
         } else {
-            _animVars.set("talkOverlayAlpha", 1.0f);
-            _animVars.set("idleOverlayAlpha", 1.0f);  // backward compatibility for older anim graphs.
+            _animVars.set(TALK_OVERLAY_ALPHA_VAR, 1.0f);
+            _animVars.set(IDLE_OVERLAY_ALPHA_VAR, 1.0f);  // backward compatibility for older anim graphs.
         }
     } else {
         if (_talkIdleInterpTime < 1.0f) {
@@ -2297,11 +2401,11 @@ void Rig::updateFromControllerParameters(const ControllerParameters& params, flo
             }
             float easeOutInValue = _talkIdleInterpTime < 0.5f ? 4.0f * powf(_talkIdleInterpTime, 3.0f) : 4.0f * powf((_talkIdleInterpTime - 1.0f), 3.0f) + 1.0f;
             float talkAlpha = 1.0f - easeOutInValue;
-            _animVars.set("talkOverlayAlpha", talkAlpha);
-            _animVars.set("idleOverlayAlpha", talkAlpha);  // backward compatibility for older anim graphs.
+            _animVars.set(TALK_OVERLAY_ALPHA_VAR, talkAlpha);
+            _animVars.set(IDLE_OVERLAY_ALPHA_VAR, talkAlpha);  // backward compatibility for older anim graphs.
         } else {
-            _animVars.set("talkOverlayAlpha", 0.0f);
-            _animVars.set("idleOverlayAlpha", 0.0f);  // backward compatibility for older anim graphs.
+            _animVars.set(TALK_OVERLAY_ALPHA_VAR, 0.0f);
+            _animVars.set(IDLE_OVERLAY_ALPHA_VAR, 0.0f);  // backward compatibility for older anim graphs.
         }
     }
 
@@ -2333,21 +2437,21 @@ void Rig::updateFromControllerParameters(const ControllerParameters& params, flo
 
     if (_headEnabled) {
         // Blend IK chains toward the joint limit centers, this should stablize head and hand ik.
-        _animVars.set("solutionSource", (int)AnimInverseKinematics::SolutionSource::RelaxToLimitCenterPoses);
+        _animVars.set(SOLUTION_SOURCE_VAR, (int)AnimInverseKinematics::SolutionSource::RelaxToLimitCenterPoses);
     } else {
         // Blend IK chains toward the UnderPoses, so some of the animaton motion is present in the IK solution.
-        _animVars.set("solutionSource", (int)AnimInverseKinematics::SolutionSource::RelaxToUnderPoses);
+        _animVars.set(SOLUTION_SOURCE_VAR, (int)AnimInverseKinematics::SolutionSource::RelaxToUnderPoses);
     }
 
     // if the hips or the feet are being controlled.
     if (hipsEnabled || rightFootEnabled || leftFootEnabled) {
         // replace the feet animation with the default pose, this is to prevent unexpected toe wiggling.
-        _animVars.set("defaultPoseOverlayAlpha", 1.0f);
-        _animVars.set("defaultPoseOverlayBoneSet", (int)AnimOverlay::BothFeetBoneSet);
+        _animVars.set(DEFAULT_POSE_OVERLAY_ALPHA_VAR, 1.0f);
+        _animVars.set(DEFAULT_POSE_OVERLAY_BONE_SET_VAR, (int)AnimOverlay::BothFeetBoneSet);
     } else {
         // feet should follow source animation
-        _animVars.unset("defaultPoseOverlayAlpha");
-        _animVars.unset("defaultPoseOverlayBoneSet");
+        _animVars.unset(DEFAULT_POSE_OVERLAY_ALPHA_VAR);
+        _animVars.unset(DEFAULT_POSE_OVERLAY_BONE_SET_VAR);
     }
 
     if (hipsEnabled) {
@@ -2368,19 +2472,19 @@ void Rig::updateFromControllerParameters(const ControllerParameters& params, flo
 
         AnimPose hips = _hipsBlendHelper.update(params.primaryControllerPoses[PrimaryControllerType_Hips], dt);
 
-        _animVars.set("hipsType", (int)IKTarget::Type::RotationAndPosition);
-        _animVars.set("hipsPosition", hips.trans());
-        _animVars.set("hipsRotation", hips.rot());
+        _animVars.set(HIPS_TYPE_VAR, (int)IKTarget::Type::RotationAndPosition);
+        _animVars.set(HIPS_POSITION_VAR, hips.trans());
+        _animVars.set(HIPS_ROTATION_VAR, hips.rot());
     } else {
-        _animVars.set("hipsType", (int)IKTarget::Type::Unknown);
+        _animVars.set(HIPS_TYPE_VAR, (int)IKTarget::Type::Unknown);
     }
 
     if (hipsEnabled && spine2Enabled) {
-        _animVars.set("spine2Type", (int)IKTarget::Type::Spline);
-        _animVars.set("spine2Position", params.primaryControllerPoses[PrimaryControllerType_Spine2].trans());
-        _animVars.set("spine2Rotation", params.primaryControllerPoses[PrimaryControllerType_Spine2].rot());
+        _animVars.set(SPINE2_TYPE_VAR, (int)IKTarget::Type::Spline);
+        _animVars.set(SPINE2_POSITION_VAR, params.primaryControllerPoses[PrimaryControllerType_Spine2].trans());
+        _animVars.set(SPINE2_ROTATION_VAR, params.primaryControllerPoses[PrimaryControllerType_Spine2].rot());
     } else {
-        _animVars.set("spine2Type", (int)IKTarget::Type::Unknown);
+        _animVars.set(SPINE2_TYPE_VAR, (int)IKTarget::Type::Unknown);
     }
 
     // set secondary targets
@@ -2678,6 +2782,11 @@ void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
     _externalPoseSet = _internalPoseSet;
 }
 
+void Rig::computePosesFromJointData(const QVector<JointData>& jointDataVec, const glm::mat4& modelOffsetMat) {
+    copyJointsFromJointData(jointDataVec);
+    computeExternalPoses(modelOffsetMat);
+}
+
 void Rig::computeAvatarBoundingCapsule(
         const HFMModel& hfmModel,
         float& radiusOut,
@@ -2796,7 +2905,8 @@ float Rig::getUnscaledEyeHeight() const {
     }
 }
 
-void Rig::setDirectionalBlending(const QString& targetName, const glm::vec3& blendingTarget, const QString& alphaName, float alpha) {
+void Rig::setDirectionalBlending(const AnimVariantKey& targetName, const glm::vec3& blendingTarget, const AnimVariantKey& alphaName,
+                                 float alpha) {
     _animVars.set(targetName, blendingTarget);
     _animVars.set(alphaName, alpha);
 }
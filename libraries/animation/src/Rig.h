@@ -225,6 +225,9 @@ public:
     void copyJointsIntoJointData(QVector<JointData>& jointDataVec) const;
     void copyJointsFromJointData(const QVector<JointData>& jointDataVec);
     void computeExternalPoses(const glm::mat4& modelOffsetMat);
+    // poses a rig that doesn't run its anim graph, such as another avatar's, from its network joint data.
+    // touches nothing outside this rig, so different rigs may be posed on different threads at once.
+    void computePosesFromJointData(const QVector<JointData>& jointDataVec, const glm::mat4& modelOffsetMat);
 
     void computeAvatarBoundingCapsule(const HFMModel& hfmModel, float& radiusOut, float& heightOut, glm::vec3& offsetOut) const;
 
@@ -256,7 +259,8 @@ public:
     int getOverrideJointCount() const;
     bool getFlowActive() const;
     bool getNetworkGraphActive() const;
-    void setDirectionalBlending(const QString& targetName, const glm::vec3& blendingTarget, const QString& alphaName, float alpha);
+    void setDirectionalBlending(const AnimVariantKey& targetName, const glm::vec3& blendingTarget, const AnimVariantKey& alphaName,
+                                float alpha);
 
 signals:
     void onLoadComplete();
@@ -110,7 +110,6 @@ void SkeletonModel::updateRig(float deltaTime, glm::mat4 parentTransform) {
     assert(!_owningAvatar->isMyAvatar());
 
     Head* head = _owningAvatar->getHead();
-    glm::vec3 lookAt = avoidCrossedEyes(head->getCorrectedLookAtPosition());
 
     // no need to call Model::updateRig() because otherAvatars get their joint state
     // copied directly from AvtarData::_jointData (there are no Rig animations to blend)
@@ -133,8 +132,12 @@ void SkeletonModel::updateRig(float deltaTime, glm::mat4 parentTransform) {
     head->setBaseYaw(glm::degrees(eulers.y));
     head->setBaseRoll(glm::degrees(-eulers.z));
 
+    if (!_enableEyeLookAt) {
+        return;
+    }
+
     Rig::EyeParameters eyeParams;
-    eyeParams.eyeLookAt = lookAt;
+    eyeParams.eyeLookAt = avoidCrossedEyes(head->getCorrectedLookAtPosition());
     eyeParams.eyeSaccade = glm::vec3(0.0f);
     eyeParams.modelRotation = getRotation();
     eyeParams.modelTranslation = getTranslation();
@@ -41,6 +41,9 @@ public:
     void updateRig(float deltaTime, glm::mat4 parentTransform) override;
     void updateAttitude(const glm::quat& orientation);
 
+    /// When disabled, the eyes keep the rotations from the network joint data instead of looking at the corrected lookAt
+    void setEnableEyeLookAt(bool enabled) { _enableEyeLookAt = enabled; }
+
     bool getIsJointOverridden(int jointIndex) const;
 
     /// Returns the index of the left hand joint, or -1 if not found.
@@ -114,6 +117,7 @@ protected:
 
 private:
     bool _texturesLoaded { false };
+    bool _enableEyeLookAt { true };
 };
 
 #endif // hifi_SkeletonModel_h
@@ -1287,6 +1287,8 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
 
     // Nothing else to do unless the model is loaded
     if (!model->isLoaded()) {
+        // Keep the download priority in step with how big the entity now looks from where we are
+        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
         withWriteLock([&] {
             _prevModelLoaded = false;
         });
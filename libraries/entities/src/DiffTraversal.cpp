@@ -193,6 +193,13 @@ DiffTraversal::DiffTraversal() {
     _path.reserve(MIN_PATH_DEPTH);
 }
 
+bool DiffTraversal::wouldRepeat(const DiffTraversal::View& view) const {
+    if (_completedView.startTime == 0 || _currentView.usesViewFrustums() != _completedView.usesViewFrustums()) {
+        return false;
+    }
+    return !_currentView.usesViewFrustums() || _completedView.isVerySimilar(view);
+}
+
 DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
                                                        bool forceFirstPass) {
     assert(root);
@@ -68,6 +68,9 @@ public:
     uint64_t getStartOfCompletedTraversal() const { return _completedView.startTime; }
     bool finished() const { return _path.empty(); }
 
+    // true if prepareNewTraversal() with this view (and no forced first pass) would start a Repeat traversal
+    bool wouldRepeat(const View& view) const;
+
     void setScanCallback(std::function<void (VisibleElement&)> cb);
     void traverse(uint64_t timeBudget);
 
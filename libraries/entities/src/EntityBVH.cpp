@@ -0,0 +1,494 @@
+//
+//  EntityBVH.cpp
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBVH.h"
+
+#include <algorithm>
+
+const EntityBVH::NodeIndex EntityBVH::NULL_NODE;
+
+// leaf bounds are grown by this fraction of their largest dimension (but at least the minimum) so that
+// entities can move a little without the tree being restructured
+static const float FAT_MARGIN_RATIO = 0.1f;
+static const float MIN_FAT_MARGIN = 0.05f; // meters
+
+// keeps the reciprocal finite so the slab test never produces 0 * inf
+static const float MIN_DIRECTION_COMPONENT = 1.0e-20f;
+
+static glm::vec3 safeReciprocal(const glm::vec3& v) {
+    return glm::vec3(1.0f / (v.x == 0.0f ? MIN_DIRECTION_COMPONENT : v.x),
+                     1.0f / (v.y == 0.0f ? MIN_DIRECTION_COMPONENT : v.y),
+                     1.0f / (v.z == 0.0f ? MIN_DIRECTION_COMPONENT : v.z));
+}
+
+EntityBVH::NodeIndex EntityBVH::allocateNode() {
+    if (_freeList != NULL_NODE) {
+        NodeIndex node = _freeList;
+        _freeList = _nodes[node].parent;
+        _nodes[node] = Node();
+        return node;
+    }
+    _nodes.push_back(Node());
+    _mins.push_back(glm::vec3(0.0f));
+    _maxs.push_back(glm::vec3(0.0f));
+    return (NodeIndex)_nodes.size() - 1;
+}
+
+void EntityBVH::freeNode(NodeIndex node) {
+    // free nodes are chained through their parent index
+    _nodes[node] = Node();
+    _nodes[node].parent = _freeList;
+    _nodes[node].height = -1;
+    _freeList = node;
+}
+
+void EntityBVH::clear() {
+    _nodes.clear();
+    _mins.clear();
+    _maxs.clear();
+    _leaves.clear();
+    _root = NULL_NODE;
+    _freeList = NULL_NODE;
+}
+
+int EntityBVH::getHeight() const {
+    return _root == NULL_NODE ? 0 : _nodes[_root].height;
+}
+
+float EntityBVH::surfaceArea(NodeIndex node) const {
+    glm::vec3 d = _maxs[node] - _mins[node];
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+static float unionSurfaceArea(const glm::vec3& minA, const glm::vec3& maxA, const glm::vec3& minB, const glm::vec3& maxB) {
+    glm::vec3 d = glm::max(maxA, maxB) - glm::min(minA, minB);
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+void EntityBVH::refit(NodeIndex node) {
+    NodeIndex child0 = _nodes[node].child0;
+    NodeIndex child1 = _nodes[node].child1;
+    _mins[node] = glm::min(_mins[child0], _mins[child1]);
+    _maxs[node] = glm::max(_maxs[child0], _maxs[child1]);
+    _nodes[node].height = 1 + std::max(_nodes[child0].height, _nodes[child1].height);
+}
+
+void EntityBVH::insert(const EntityItemPointer& entity, const AABox& bounds) {
+    const EntityItemID& id = entity->getEntityItemID();
+    if (_leaves.contains(id)) {
+        update(entity, bounds);
+        return;
+    }
+
+    NodeIndex leaf = allocateNode();
+    _nodes[leaf].entity = entity;
+    float margin = std::max(FAT_MARGIN_RATIO * bounds.getLargestDimension(), MIN_FAT_MARGIN);
+    _mins[leaf] = bounds.getMinimumPoint() - glm::vec3(margin);
+    _maxs[leaf] = bounds.getMaximumPoint() + glm::vec3(margin);
+    insertLeaf(leaf);
+    _leaves.insert(id, leaf);
+}
+
+bool EntityBVH::update(const EntityItemPointer& entity, const AABox& bounds) {
+    auto itr = _leaves.find(entity->getEntityItemID());
+    if (itr == _leaves.end()) {
+        insert(entity, bounds);
+        return true;
+    }
+
+    NodeIndex leaf = itr.value();
+    if (glm::all(glm::lessThanEqual(_mins[leaf], bounds.getMinimumPoint())) &&
+        glm::all(glm::greaterThanEqual(_maxs[leaf], bounds.getMaximumPoint()))) {
+        return false;
+    }
+
+    removeLeaf(leaf);
+    float margin = std::max(FAT_MARGIN_RATIO * bounds.getLargestDimension(), MIN_FAT_MARGIN);
+    _mins[leaf] = bounds.getMinimumPoint() - glm::vec3(margin);
+    _maxs[leaf] = bounds.getMaximumPoint() + glm::vec3(margin);
+    insertLeaf(leaf);
+    return true;
+}
+
+void EntityBVH::remove(const EntityItemID& id) {
+    auto itr = _leaves.find(id);
+    if (itr == _leaves.end()) {
+        return;
+    }
+    NodeIndex leaf = itr.value();
+    _leaves.erase(itr);
+    removeLeaf(leaf);
+    freeNode(leaf);
+}
+
+void EntityBVH::insertLeaf(NodeIndex leaf) {
+    if (_root == NULL_NODE) {
+        _root = leaf;
+        _nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // walk down to the sibling that minimizes the surface area heuristic
+    glm::vec3 leafMin = _mins[leaf];
+    glm::vec3 leafMax = _maxs[leaf];
+    NodeIndex index = _root;
+    while (!_nodes[index].isLeaf()) {
+        NodeIndex child0 = _nodes[index].child0;
+        NodeIndex child1 = _nodes[index].child1;
+
+        float area = surfaceArea(index);
+        float combinedArea = unionSurfaceArea(_mins[index], _maxs[index], leafMin, leafMax);
+
+        // cost of creating a new parent for this node and the new leaf
+        float cost = 2.0f * combinedArea;
+        // minimum cost of pushing the leaf further down the tree
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float cost0 = unionSurfaceArea(_mins[child0], _maxs[child0], leafMin, leafMax) + inheritanceCost;
+        if (!_nodes[child0].isLeaf()) {
+            cost0 -= surfaceArea(child0);
+        }
+        float cost1 = unionSurfaceArea(_mins[child1], _maxs[child1], leafMin, leafMax) + inheritanceCost;
+        if (!_nodes[child1].isLeaf()) {
+            cost1 -= surfaceArea(child1);
+        }
+
+        if (cost < cost0 && cost < cost1) {
+            break;
+        }
+        index = (cost0 < cost1) ? child0 : child1;
+    }
+
+    NodeIndex sibling = index;
+    NodeIndex oldParent = _nodes[sibling].parent;
+    NodeIndex newParent = allocateNode();
+    _nodes[newParent].parent = oldParent;
+    _nodes[newParent].child0 = sibling;
+    _nodes[newParent].child1 = leaf;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+    refit(newParent);
+
+    if (oldParent != NULL_NODE) {
+        if (_nodes[oldParent].child0 == sibling) {
+            _nodes[oldParent].child0 = newParent;
+        } else {
+            _nodes[oldParent].child1 = newParent;
+        }
+    } else {
+        _root = newParent;
+    }
+
+    // walk back up, fixing heights and bounds
+    index = _nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+        refit(index);
+        index = _nodes[index].parent;
+    }
+}
+
+void EntityBVH::removeLeaf(NodeIndex leaf) {
+    if (leaf == _root) {
+        _root = NULL_NODE;
+        return;
+    }
+
+    NodeIndex parent = _nodes[leaf].parent;
+    NodeIndex grandParent = _nodes[parent].parent;
+    NodeIndex sibling = (_nodes[parent].child0 == leaf) ? _nodes[parent].child1 : _nodes[parent].child0;
+
+    if (grandParent != NULL_NODE) {
+        // replace the parent with the sibling
+        if (_nodes[grandParent].child0 == parent) {
+            _nodes[grandParent].child0 = sibling;
+        } else {
+            _nodes[grandParent].child1 = sibling;
+        }
+        _nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        NodeIndex index = grandParent;
+        while (index != NULL_NODE) {
+            index = balance(index);
+            refit(index);
+            index = _nodes[index].parent;
+        }
+    } else {
+        _root = sibling;
+        _nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+    _nodes[leaf].parent = NULL_NODE;
+}
+
+// Performs a left or right rotation if node A is imbalanced, returns the new root of the subtree.
+EntityBVH::NodeIndex EntityBVH::balance(NodeIndex iA) {
+    if (_nodes[iA].isLeaf() || _nodes[iA].height < 2) {
+        return iA;
+    }
+
+    NodeIndex iB = _nodes[iA].child0;
+    NodeIndex iC = _nodes[iA].child1;
+    int32_t imbalance = _nodes[iC].height - _nodes[iB].height;
+
+    // rotate C up
+    if (imbalance > 1) {
+        NodeIndex iF = _nodes[iC].child0;
+        NodeIndex iG = _nodes[iC].child1;
+
+        _nodes[iC].child0 = iA;
+        _nodes[iC].parent = _nodes[iA].parent;
+        _nodes[iA].parent = iC;
+
+        NodeIndex cParent = _nodes[iC].parent;
+        if (cParent != NULL_NODE) {
+            if (_nodes[cParent].child0 == iA) {
+                _nodes[cParent].child0 = iC;
+            } else {
+                _nodes[cParent].child1 = iC;
+            }
+        } else {
+            _root = iC;
+        }
+
+        if (_nodes[iF].height > _nodes[iG].height) {
+            _nodes[iC].child1 = iF;
+            _nodes[iA].child1 = iG;
+            _nodes[iG].parent = iA;
+        } else {
+            _nodes[iC].child1 = iG;
+            _nodes[iA].child1 = iF;
+            _nodes[iF].parent = iA;
+        }
+        refit(iA);
+        refit(iC);
+        return iC;
+    }
+
+    // rotate B up
+    if (imbalance < -1) {
+        NodeIndex iD = _nodes[iB].child0;
+        NodeIndex iE = _nodes[iB].child1;
+
+        _nodes[iB].child0 = iA;
+        _nodes[iB].parent = _nodes[iA].parent;
+        _nodes[iA].parent = iB;
+
+        NodeIndex bParent = _nodes[iB].parent;
+        if (bParent != NULL_NODE) {
+            if (_nodes[bParent].child0 == iA) {
+                _nodes[bParent].child0 = iB;
+            } else {
+                _nodes[bParent].child1 = iB;
+            }
+        } else {
+            _root = iB;
+        }
+
+        if (_nodes[iD].height > _nodes[iE].height) {
+            _nodes[iB].child1 = iD;
+            _nodes[iA].child0 = iE;
+            _nodes[iE].parent = iA;
+        } else {
+            _nodes[iB].child1 = iE;
+            _nodes[iA].child0 = iD;
+            _nodes[iD].parent = iA;
+        }
+        refit(iA);
+        refit(iB);
+        return iB;
+    }
+
+    return iA;
+}
+
+bool EntityBVH::rayHitsNode(NodeIndex node, const glm::vec3& origin, const glm::vec3& invDirection, float& entryDistance) const {
+    // slab test, done on all three axes at once
+    glm::vec3 t0 = (_mins[node] - origin) * invDirection;
+    glm::vec3 t1 = (_maxs[node] - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float tExit = std::min(std::min(tFar.x, tFar.y), tFar.z);
+    entryDistance = tEnter;
+    return tEnter <= tExit;
+}
+
+bool EntityBVH::parabolaHitsNode(NodeIndex node, const glm::vec3& origin, const glm::vec3& velocity,
+                                 const glm::vec3& acceleration, float& entryDistance) const {
+    AABox box(_mins[node], _maxs[node] - _mins[node]);
+    if (box.contains(origin)) {
+        entryDistance = 0.0f;
+        return true;
+    }
+    BoxFace face;
+    glm::vec3 surfaceNormal;
+    return box.findParabolaIntersection(origin, velocity, acceleration, entryDistance, face, surfaceNormal);
+}
+
+template <typename HitTest>
+void EntityBVH::traverseNearestFirst(float maxDistance, const HitTest& hitTest, const DistanceVisitor& visitor) const {
+    if (_root == NULL_NODE) {
+        return;
+    }
+
+    float entryDistance;
+    if (!hitTest(_root, entryDistance) || entryDistance > maxDistance) {
+        return;
+    }
+
+    using NodeDistance = std::pair<float, NodeIndex>;
+    std::vector<NodeDistance> stack;
+    stack.reserve(2 * (_nodes[_root].height + 1));
+    stack.emplace_back(entryDistance, _root);
+    while (!stack.empty()) {
+        NodeDistance top = stack.back();
+        stack.pop_back();
+        if (top.first > maxDistance) {
+            continue;
+        }
+
+        const Node& node = _nodes[top.second];
+        if (node.isLeaf()) {
+            maxDistance = visitor(node.entity, maxDistance);
+            continue;
+        }
+
+        float distance0, distance1;
+        bool hit0 = hitTest(node.child0, distance0) && distance0 <= maxDistance;
+        bool hit1 = hitTest(node.child1, distance1) && distance1 <= maxDistance;
+        if (hit0 && hit1) {
+            // push the farther child first so the nearer one is opened next
+            if (distance0 < distance1) {
+                stack.emplace_back(distance1, node.child1);
+                stack.emplace_back(distance0, node.child0);
+            } else {
+                stack.emplace_back(distance0, node.child0);
+                stack.emplace_back(distance1, node.child1);
+            }
+        } else if (hit0) {
+            stack.emplace_back(distance0, node.child0);
+        } else if (hit1) {
+            stack.emplace_back(distance1, node.child1);
+        }
+    }
+}
+
+void EntityBVH::findRayIntersections(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                     const DistanceVisitor& visitor) const {
+    glm::vec3 invDirection = safeReciprocal(direction);
+    traverseNearestFirst(maxDistance, [&](NodeIndex node, float& entryDistance) {
+        return rayHitsNode(node, origin, invDirection, entryDistance);
+    }, visitor);
+}
+
+void EntityBVH::findParabolaIntersections(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                                          float maxDistance, const DistanceVisitor& visitor) const {
+    traverseNearestFirst(maxDistance, [&](NodeIndex node, float& entryDistance) {
+        return parabolaHitsNode(node, origin, velocity, acceleration, entryDistance);
+    }, visitor);
+}
+
+void EntityBVH::findRayIntersections(std::vector<Ray>& rays, const BatchDistanceVisitor& visitor) const {
+    if (_root == NULL_NODE || rays.empty()) {
+        return;
+    }
+
+    std::vector<glm::vec3> invDirections;
+    invDirections.reserve(rays.size());
+    for (const auto& ray : rays) {
+        invDirections.push_back(safeReciprocal(ray.direction));
+    }
+
+    std::vector<uint8_t> hits(rays.size());
+    std::vector<NodeIndex> stack;
+    stack.reserve(2 * (_nodes[_root].height + 1));
+    stack.push_back(_root);
+    while (!stack.empty()) {
+        NodeIndex index = stack.back();
+        stack.pop_back();
+
+        // test the whole batch against this node, open it if any ray could still find a closer hit inside
+        bool anyHit = false;
+        for (size_t i = 0; i < rays.size(); ++i) {
+            float entryDistance;
+            hits[i] = rayHitsNode(index, rays[i].origin, invDirections[i], entryDistance) &&
+                entryDistance <= rays[i].maxDistance;
+            anyHit = anyHit || hits[i];
+        }
+        if (!anyHit) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.isLeaf()) {
+            for (size_t i = 0; i < rays.size(); ++i) {
+                if (hits[i]) {
+                    rays[i].maxDistance = visitor(i, node.entity, rays[i].maxDistance);
+                }
+            }
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child0);
+        }
+    }
+}
+
+void EntityBVH::findEntitiesInSphere(const glm::vec3& center, float radius, const EntityVisitor& visitor) const {
+    if (_root == NULL_NODE) {
+        return;
+    }
+    float radiusSquared = radius * radius;
+    std::vector<NodeIndex> stack;
+    stack.reserve(2 * (_nodes[_root].height + 1));
+    stack.push_back(_root);
+    while (!stack.empty()) {
+        NodeIndex index = stack.back();
+        stack.pop_back();
+        glm::vec3 closestPoint = glm::clamp(center, _mins[index], _maxs[index]);
+        glm::vec3 offset = closestPoint - center;
+        if (glm::dot(offset, offset) > radiusSquared) {
+            continue;
+        }
+        const Node& node = _nodes[index];
+        if (node.isLeaf()) {
+            visitor(node.entity);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child0);
+        }
+    }
+}
+
+void EntityBVH::findEntitiesInBox(const AABox& box, const EntityVisitor& visitor) const {
+    if (_root == NULL_NODE) {
+        return;
+    }
+    glm::vec3 boxMin = box.getMinimumPoint();
+    glm::vec3 boxMax = box.getMaximumPoint();
+    std::vector<NodeIndex> stack;
+    stack.reserve(2 * (_nodes[_root].height + 1));
+    stack.push_back(_root);
+    while (!stack.empty()) {
+        NodeIndex index = stack.back();
+        stack.pop_back();
+        if (glm::any(glm::greaterThan(_mins[index], boxMax)) || glm::any(glm::lessThan(_maxs[index], boxMin))) {
+            continue;
+        }
+        const Node& node = _nodes[index];
+        if (node.isLeaf()) {
+            visitor(node.entity);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child0);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+//
+//  EntityBVH.h
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBVH_h
+#define hifi_EntityBVH_h
+
+#include <cfloat>
+#include <functional>
+#include <vector>
+
+#include <QHash>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+
+#include "EntityItem.h"
+
+/// Incrementally maintained bounding volume hierarchy over entity world bounds, used to accelerate picking.
+///
+/// This is a dynamic AABB tree: leaves hold one entity each, bounds are fattened on insert so that small moves
+/// don't restructure the tree, and insertions pick the sibling with the lowest surface area cost and then rotate
+/// to keep the tree balanced.  Node bounds are stored structure-of-arrays apart from the topology so that the
+/// slab tests during traversal only touch the min/max arrays.
+///
+/// EntityBVH does no locking of its own, the owner is responsible for guarding it.
+class EntityBVH {
+public:
+    using NodeIndex = int32_t;
+    static const NodeIndex NULL_NODE = -1;
+
+    /// Called for every entity whose bounds are hit, in roughly nearest-first order.
+    /// \param entity candidate entity
+    /// \param maxDistance distance of the closest hit found so far
+    /// \return the new distance of the closest hit (return maxDistance if entity was not hit or was farther)
+    using DistanceVisitor = std::function<float(const EntityItemPointer& entity, float maxDistance)>;
+
+    /// Batched variant, called with the index of the ray in the batch
+    using BatchDistanceVisitor = std::function<float(size_t rayIndex, const EntityItemPointer& entity, float maxDistance)>;
+
+    using EntityVisitor = std::function<void(const EntityItemPointer& entity)>;
+
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        float maxDistance { FLT_MAX };
+    };
+
+    void insert(const EntityItemPointer& entity, const AABox& bounds);
+
+    /// Moves an entity's leaf to new bounds, cheap when the new bounds are still inside the fattened leaf
+    /// \return true if the tree had to be modified
+    bool update(const EntityItemPointer& entity, const AABox& bounds);
+    void remove(const EntityItemID& id);
+    void clear();
+
+    bool contains(const EntityItemID& id) const { return _leaves.contains(id); }
+    size_t size() const { return _leaves.size(); }
+    int getHeight() const;
+
+    void findRayIntersections(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                              const DistanceVisitor& visitor) const;
+
+    /// Traces many rays in a single pass over the tree: a node is opened when any ray of the batch hits it
+    /// closer than that ray's best hit so far.  Each ray's maxDistance is updated with its closest hit.
+    void findRayIntersections(std::vector<Ray>& rays, const BatchDistanceVisitor& visitor) const;
+
+    void findParabolaIntersections(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                                   float maxDistance, const DistanceVisitor& visitor) const;
+
+    void findEntitiesInSphere(const glm::vec3& center, float radius, const EntityVisitor& visitor) const;
+    void findEntitiesInBox(const AABox& box, const EntityVisitor& visitor) const;
+
+private:
+    struct Node {
+        EntityItemPointer entity; // leaves only
+        NodeIndex parent { NULL_NODE };
+        NodeIndex child0 { NULL_NODE };
+        NodeIndex child1 { NULL_NODE };
+        int32_t height { 0 }; // leaves are 0, free nodes are -1
+        bool isLeaf() const { return child0 == NULL_NODE; }
+    };
+
+    NodeIndex allocateNode();
+    void freeNode(NodeIndex node);
+    void insertLeaf(NodeIndex leaf);
+    void removeLeaf(NodeIndex leaf);
+    NodeIndex balance(NodeIndex node);
+    void refit(NodeIndex node);
+
+    float surfaceArea(NodeIndex node) const;
+    bool rayHitsNode(NodeIndex node, const glm::vec3& origin, const glm::vec3& invDirection, float& entryDistance) const;
+    bool parabolaHitsNode(NodeIndex node, const glm::vec3& origin, const glm::vec3& velocity,
+                          const glm::vec3& acceleration, float& entryDistance) const;
+
+    template <typename HitTest>
+    void traverseNearestFirst(float maxDistance, const HitTest& hitTest, const DistanceVisitor& visitor) const;
+
+    std::vector<Node> _nodes;
+    std::vector<glm::vec3> _mins;
+    std::vector<glm::vec3> _maxs;
+    NodeIndex _root { NULL_NODE };
+    NodeIndex _freeList { NULL_NODE };
+    QHash<EntityItemID, NodeIndex> _leaves;
+};
+
+#endif // hifi_EntityBVH_h
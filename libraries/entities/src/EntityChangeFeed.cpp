@@ -0,0 +1,104 @@
+//
+//  EntityChangeFeed.cpp
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityChangeFeed.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include <SharedUtil.h>
+
+static_assert(std::is_trivially_copyable<EntityChange>::value, "EntityChange is copied out of the ring without locks");
+
+const size_t EntityChangeFeed::DEFAULT_CAPACITY = 4096;
+
+EntityPropertyFlags EntityChange::getChangedProperties() const {
+    EntityPropertyFlags flags;
+    for (size_t i = 0; i < properties.size(); ++i) {
+        if (properties.test(i)) {
+            flags.setHasProperty((EntityPropertyList)i);
+        }
+    }
+    return flags;
+}
+
+static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+EntityChangeFeed::EntityChangeFeed(size_t capacity) :
+    _slots(roundUpToPowerOfTwo(std::max(capacity, (size_t)2))),
+    _mask(_slots.size() - 1)
+{
+}
+
+void EntityChangeFeed::publish(EntityChange::Type type, const EntityItemID& entityID, const EntityPropertyFlags& properties) {
+    EntityChange change;
+    change.timestamp = usecTimestampNow();
+    change.entityID = entityID;
+    change.type = type;
+    if (!properties.isEmpty()) {
+        int last = std::min((int)properties.lastFlag(), (int)PROP_AFTER_LAST_ITEM - 1);
+        for (int i = std::max((int)properties.firstFlag(), 0); i <= last; ++i) {
+            if (properties.getHasProperty((EntityPropertyList)i)) {
+                change.properties.set(i);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_publishMutex);
+    change.sequence = _nextSequence++;
+    Slot& slot = _slots[change.sequence & _mask];
+
+    // mark the slot as being written so readers that raced us see a mismatch after copying
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&slot.change, &change, sizeof(EntityChange));
+    slot.sequence.store(change.sequence, std::memory_order_release);
+
+    _publishedSequence.store(change.sequence, std::memory_order_release);
+}
+
+EntityChangeFeed::ReadResult EntityChangeFeed::read(Sequence& cursor, std::vector<EntityChange>& changes,
+                                                    size_t maxChanges) const {
+    Sequence latest = getLatestSequence();
+    if (latest - cursor > _slots.size()) {
+        cursor = latest;
+        return Overrun;
+    }
+
+    while (cursor < latest && maxChanges > 0) {
+        Sequence wanted = cursor + 1;
+        const Slot& slot = _slots[wanted & _mask];
+        if (slot.sequence.load(std::memory_order_acquire) != wanted) {
+            cursor = latest;
+            return Overrun;
+        }
+
+        EntityChange change;
+        memcpy(&change, &slot.change, sizeof(EntityChange));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != wanted) {
+            // a writer lapped us while we were copying
+            cursor = latest;
+            return Overrun;
+        }
+
+        changes.push_back(change);
+        cursor = wanted;
+        --maxChanges;
+    }
+    return Ok;
+}
@@ -0,0 +1,98 @@
+//
+//  EntityChangeFeed.h
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityChangeFeed_h
+#define hifi_EntityChangeFeed_h
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "EntityItemID.h"
+#include "EntityPropertyFlags.h"
+
+/// One entry of the EntityChangeFeed.  Kept trivially copyable so readers can copy it out of the ring without locking.
+class EntityChange {
+public:
+    using Sequence = uint64_t;
+    using PropertyBits = std::bitset<PROP_AFTER_LAST_ITEM>;
+
+    enum Type : uint8_t {
+        Add,
+        Edit,
+        Delete
+    };
+
+    /// For Edit, the properties that changed.  An edit with no properties set means the change is not
+    /// known in detail (e.g. it came in from the network) and consumers should assume anything changed.
+    EntityPropertyFlags getChangedProperties() const;
+    bool hasChangedProperty(EntityPropertyList property) const { return properties.test(property); }
+
+    Sequence sequence { 0 };
+    quint64 timestamp { 0 };
+    EntityItemID entityID;
+    PropertyBits properties;
+    Type type { Edit };
+};
+
+/// Ordered, sequence-numbered log of entity adds, edits and deletes.
+///
+/// Producers append under a mutex, readers are lock-free: every slot of the ring carries the sequence number it holds,
+/// which a writer clears before overwriting the slot and sets again once done (a per-slot seqlock).  A reader copies the
+/// entry and then checks the slot's sequence again, so it either sees a consistent entry or learns it was lapped.
+///
+/// Each consumer keeps its own cursor, the sequence number of the last change it has seen.  Start one with
+/// getLatestSequence() and pass it to read() to collect everything newer.  When a consumer falls more than
+/// getCapacity() changes behind read() returns Overrun and the consumer must resynchronize from the tree itself.
+class EntityChangeFeed {
+public:
+    using Sequence = EntityChange::Sequence;
+
+    enum ReadResult {
+        Ok,
+        Overrun
+    };
+
+    static const size_t DEFAULT_CAPACITY;
+
+    /// \param capacity number of changes retained, rounded up to a power of two
+    explicit EntityChangeFeed(size_t capacity = DEFAULT_CAPACITY);
+
+    void publish(EntityChange::Type type, const EntityItemID& entityID,
+                 const EntityPropertyFlags& properties = EntityPropertyFlags());
+
+    /// Sequence number of the most recently published change, 0 if nothing was published yet
+    Sequence getLatestSequence() const { return _publishedSequence.load(std::memory_order_acquire); }
+    bool hasChangesSince(Sequence cursor) const { return getLatestSequence() > cursor; }
+    size_t getCapacity() const { return _slots.size(); }
+
+    /// Appends the changes published after 'cursor' to 'changes', oldest first, and advances 'cursor' past them.
+    /// \param maxChanges stop after this many changes, the rest are picked up by the next read
+    /// \return Overrun if some of the changes after 'cursor' were already overwritten; 'cursor' is then moved to
+    ///     the latest sequence and 'changes' is left with whatever was read before the gap was detected
+    ReadResult read(Sequence& cursor, std::vector<EntityChange>& changes, size_t maxChanges = SIZE_MAX) const;
+
+private:
+    struct Slot {
+        std::atomic<Sequence> sequence { 0 };
+        EntityChange change;
+    };
+
+    std::vector<Slot> _slots;
+    size_t _mask;
+    std::mutex _publishMutex;
+    Sequence _nextSequence { 1 };
+    std::atomic<Sequence> _publishedSequence { 0 };
+};
+
+#endif // hifi_EntityChangeFeed_h
@@ -36,6 +36,8 @@ void EntityEditPacketSender::processEntityEditNackPacket(QSharedPointer<Received
 void EntityEditPacketSender::adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) {
     if (type == PacketType::EntityAdd || type == PacketType::EntityEdit || type == PacketType::EntityPhysics) {
         EntityItem::adjustEditPacketForClockSkew(buffer, clockSkew);
+    } else if (type == PacketType::EntityPhysicsBatch) {
+        PhysicsStateBatch::adjustForClockSkew(buffer, clockSkew);
     }
 }
 
@@ -150,6 +152,40 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
     }
 }
 
+bool EntityEditPacketSender::queuePhysicsState(EntityTreePointer entityTree, PhysicsStateBatch::Record& record) {
+    if ((entityTree && entityTree->isServerlessMode()) || !PhysicsStateBatch::canEncode(record)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_physicsStatesMutex);
+    // entities tend to be simulated in clusters, so a few batches (each with its own origin) cover them
+    for (auto& batch : _physicsStateBatches) {
+        if (batch.append(record)) {
+            return true;
+        }
+    }
+    // the sequence number and timestamp of the edit packet come before the message
+    const int MAX_MESSAGE_SIZE = (int)(NLPacket::maxPayloadSize(PacketType::EntityPhysicsBatch) -
+        sizeof(quint16) - sizeof(quint64)) - 1;
+    _physicsStateBatches.emplace_back(MAX_MESSAGE_SIZE);
+    return _physicsStateBatches.back().append(record);
+}
+
+void EntityEditPacketSender::releaseQueuedPhysicsStates() {
+    std::vector<PhysicsStateBatch> batches;
+    {
+        std::lock_guard<std::mutex> lock(_physicsStatesMutex);
+        batches.swap(_physicsStateBatches);
+    }
+    quint64 now = usecTimestampNow();
+    for (const auto& batch : batches) {
+        if (!batch.isEmpty()) {
+            QByteArray bufferOut = batch.encode(now);
+            queueOctreeEditMessage(PacketType::EntityPhysicsBatch, bufferOut);
+        }
+    }
+}
+
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
 
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
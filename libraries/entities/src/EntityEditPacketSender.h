@@ -15,9 +15,11 @@
 #include <OctreeEditPacketSender.h>
 
 #include <mutex>
+#include <vector>
 
 #include "EntityItem.h"
 #include "AvatarData.h"
+#include "PhysicsStateBatch.h"
 
 /// Utility for processing, packing, queueing and sending of outbound edit voxel messages.
 class EntityEditPacketSender :  public OctreeEditPacketSender {
@@ -36,6 +38,14 @@ public:
                                 EntityItemID entityItemID, const EntityItemProperties& properties);
 
 
+    /// Queues the physical state of an entity we simulate for the next EntityPhysicsBatch message, and rounds the
+    /// record to what the entity-server will decode.  \return false if the state has to go in a full EntityPhysics
+    /// edit instead (e.g. velocities out of the batch's range).
+    bool queuePhysicsState(EntityTreePointer entityTree, PhysicsStateBatch::Record& record);
+
+    /// Packs the physics states queued since the last call into EntityPhysicsBatch messages
+    void releaseQueuedPhysicsStates();
+
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
     void queueCloneEntityMessage(const EntityItemID& entityIDToClone, const EntityItemID& newEntityID);
 
@@ -56,5 +66,8 @@ private:
 private:
     std::mutex _mutex;
     AvatarData* _myAvatar { nullptr };
+
+    std::mutex _physicsStatesMutex;
+    std::vector<PhysicsStateBatch> _physicsStateBatches;
 };
 #endif // hifi_EntityEditPacketSender_h
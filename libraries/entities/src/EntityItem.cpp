@@ -34,6 +34,7 @@
 #include <Extents.h>
 #include <QVariantGLM.h>
 #include <Grab.h>
+#include <shared/StringInterner.h>
 
 #include "EntityScriptingInterface.h"
 #include "EntitiesLogging.h"
@@ -1091,7 +1092,7 @@ void EntityItem::setCollisionSoundURL(const QString& value) {
     bool modified = false;
     withWriteLock([&] {
         if (_collisionSoundURL != value) {
-            _collisionSoundURL = value;
+            _collisionSoundURL = StringInterner::intern(value);
             modified = true;
         }
     });
@@ -2845,8 +2846,9 @@ QString EntityItem::getScript() const {
 }
 
 void EntityItem::setScript(const QString& value) {
+    QString script = StringInterner::intern(value);
     withWriteLock([&] {
-        _script = value;
+        _script = script;
     });
 }
 
@@ -2873,8 +2875,9 @@ QString EntityItem::getServerScripts() const {
 }
 
 void EntityItem::setServerScripts(const QString& serverScripts) {
+    QString internedServerScripts = StringInterner::intern(serverScripts);
     withWriteLock([&] {
-        _serverScripts = serverScripts;
+        _serverScripts = internedServerScripts;
         _serverScriptsChangedTimestamp = usecTimestampNow();
     });
 }
@@ -3116,11 +3119,13 @@ void EntityItem::setPrivateUserData(const QString& value) {
 }
 
 // Certifiable Properties
+const EntityItem::CertifiableProperties EntityItem::DEFAULT_CERTIFIABLE_PROPERTIES;
+
 #define DEFINE_PROPERTY_GETTER(type, accessor, var) \
 type EntityItem::get##accessor() const {            \
     type result;         \
     withReadLock([&] {   \
-        result = _##var; \
+        result = getCertifiablePropertiesInternal().var; \
     });                  \
     return result;       \
 }
@@ -3128,7 +3133,13 @@ type EntityItem::get##accessor() const {            \
 #define DEFINE_PROPERTY_SETTER(type, accessor, var)   \
 void EntityItem::set##accessor(const type & value) { \
     withWriteLock([&] {                               \
-       _##var = value;                                \
+        if (!_certifiableProperties) {                \
+            if (value == DEFAULT_CERTIFIABLE_PROPERTIES.var) { \
+                return;                               \
+            }                                         \
+            _certifiableProperties.reset(new CertifiableProperties()); \
+        }                                             \
+        _certifiableProperties->var = value;          \
     });                                               \
 }
 #define DEFINE_PROPERTY_ACCESSOR(type, accessor, var) DEFINE_PROPERTY_GETTER(type, accessor, var) DEFINE_PROPERTY_SETTER(type, accessor, var)
@@ -3145,6 +3156,31 @@ DEFINE_PROPERTY_ACCESSOR(QString, CertificateID, certificateID)
 DEFINE_PROPERTY_ACCESSOR(QString, CertificateType, certificateType)
 DEFINE_PROPERTY_ACCESSOR(quint32, StaticCertificateVersion, staticCertificateVersion)
 
+static size_t stringMemoryUsage(const QString& value) {
+    return value.isEmpty() ? 0 : value.capacity() * sizeof(QChar);
+}
+
+size_t EntityItem::getApproximateMemoryUsage() const {
+    size_t result = EntityTypes::getInstanceSize(getType());
+    if (result == 0) {
+        result = sizeof(EntityItem);
+    }
+    withReadLock([&] {
+        result += stringMemoryUsage(_script) + stringMemoryUsage(_serverScripts) +
+            stringMemoryUsage(_collisionSoundURL) + stringMemoryUsage(_userData) + stringMemoryUsage(_privateUserData) +
+            stringMemoryUsage(_name) + stringMemoryUsage(_href) + stringMemoryUsage(_description);
+        if (_certifiableProperties) {
+            const CertifiableProperties& certifiable = *_certifiableProperties;
+            result += sizeof(CertifiableProperties) + stringMemoryUsage(certifiable.itemName) +
+                stringMemoryUsage(certifiable.itemDescription) + stringMemoryUsage(certifiable.itemCategories) +
+                stringMemoryUsage(certifiable.itemArtist) + stringMemoryUsage(certifiable.itemLicense) +
+                stringMemoryUsage(certifiable.certificateID) + stringMemoryUsage(certifiable.certificateType) +
+                stringMemoryUsage(certifiable.marketplaceID);
+        }
+    });
+    return result;
+}
+
 uint32_t EntityItem::getDirtyFlags() const {
     uint32_t result;
     withReadLock([&] {
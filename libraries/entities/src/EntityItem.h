@@ -579,6 +579,11 @@ public:
 
     bool stillHasMyGrab() const;
 
+    /// Rough heap footprint of this entity: the instance itself, out-of-line property blocks and string payloads.
+    /// Strings shared between entities are counted for every entity holding them.
+    virtual size_t getApproximateMemoryUsage() const;
+    bool hasCertifiableProperties() const { return resultWithReadLock<bool>([&] { return (bool)_certifiableProperties; }); }
+
     bool needsRenderUpdate() const { return resultWithReadLock<bool>([&] { return _needsRenderUpdate; }); }
     void setNeedsRenderUpdate(bool needsRenderUpdate) { withWriteLock([&] { _needsRenderUpdate = needsRenderUpdate; }); }
 
@@ -666,18 +671,28 @@ protected:
     QString _description; //Hyperlink description
 
     // Certifiable Properties
-    QString _itemName { ENTITY_ITEM_DEFAULT_ITEM_NAME };
-    QString _itemDescription { ENTITY_ITEM_DEFAULT_ITEM_DESCRIPTION };
-    QString _itemCategories { ENTITY_ITEM_DEFAULT_ITEM_CATEGORIES };
-    QString _itemArtist { ENTITY_ITEM_DEFAULT_ITEM_ARTIST };
-    QString _itemLicense { ENTITY_ITEM_DEFAULT_ITEM_LICENSE };
-    quint32 _limitedRun { ENTITY_ITEM_DEFAULT_LIMITED_RUN };
-    QString _certificateID { ENTITY_ITEM_DEFAULT_CERTIFICATE_ID };
-    QString _certificateType { ENTITY_ITEM_DEFAULT_CERTIFICATE_TYPE };
-    quint32 _editionNumber { ENTITY_ITEM_DEFAULT_EDITION_NUMBER };
-    quint32 _entityInstanceNumber { ENTITY_ITEM_DEFAULT_ENTITY_INSTANCE_NUMBER };
-    QString _marketplaceID { ENTITY_ITEM_DEFAULT_MARKETPLACE_ID };
-    quint32 _staticCertificateVersion { ENTITY_ITEM_DEFAULT_STATIC_CERTIFICATE_VERSION };
+    // Only marketplace items set these, so they live out of line and are allocated the first time one of them
+    // is given a non-default value.
+    class CertifiableProperties {
+    public:
+        QString itemName { ENTITY_ITEM_DEFAULT_ITEM_NAME };
+        QString itemDescription { ENTITY_ITEM_DEFAULT_ITEM_DESCRIPTION };
+        QString itemCategories { ENTITY_ITEM_DEFAULT_ITEM_CATEGORIES };
+        QString itemArtist { ENTITY_ITEM_DEFAULT_ITEM_ARTIST };
+        QString itemLicense { ENTITY_ITEM_DEFAULT_ITEM_LICENSE };
+        quint32 limitedRun { ENTITY_ITEM_DEFAULT_LIMITED_RUN };
+        QString certificateID { ENTITY_ITEM_DEFAULT_CERTIFICATE_ID };
+        QString certificateType { ENTITY_ITEM_DEFAULT_CERTIFICATE_TYPE };
+        quint32 editionNumber { ENTITY_ITEM_DEFAULT_EDITION_NUMBER };
+        quint32 entityInstanceNumber { ENTITY_ITEM_DEFAULT_ENTITY_INSTANCE_NUMBER };
+        QString marketplaceID { ENTITY_ITEM_DEFAULT_MARKETPLACE_ID };
+        quint32 staticCertificateVersion { ENTITY_ITEM_DEFAULT_STATIC_CERTIFICATE_VERSION };
+    };
+    static const CertifiableProperties DEFAULT_CERTIFIABLE_PROPERTIES;
+    const CertifiableProperties& getCertifiablePropertiesInternal() const {
+        return _certifiableProperties ? *_certifiableProperties : DEFAULT_CERTIFIABLE_PROPERTIES;
+    }
+    std::unique_ptr<CertifiableProperties> _certifiableProperties;
 
 
     // NOTE: Damping is applied like this:  v *= pow(1 - damping, dt)
@@ -0,0 +1,133 @@
+//
+//  EntityPropertySnapshot.cpp
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPropertySnapshot.h"
+
+#include <QtCore/QThreadStorage>
+
+static QThreadStorage<EntityPropertySnapshot*> threadSnapshots;
+
+EntityPropertySnapshot* EntityPropertySnapshot::getCurrent() {
+    return threadSnapshots.hasLocalData() ? threadSnapshots.localData() : nullptr;
+}
+
+bool EntityPropertySnapshot::isEnabled() {
+    return getCurrent() != nullptr;
+}
+
+void EntityPropertySnapshot::setEnabled(bool enabled) {
+    if (enabled == isEnabled()) {
+        return;
+    }
+    // QThreadStorage deletes the previous snapshot
+    threadSnapshots.setLocalData(enabled ? new EntityPropertySnapshot() : nullptr);
+}
+
+void EntityPropertySnapshot::beginFrame() {
+    EntityPropertySnapshot* snapshot = getCurrent();
+    if (snapshot) {
+        snapshot->clear();
+    }
+}
+
+bool EntityPropertySnapshot::find(const EntityItemID& entityID, const EntityPropertyFlags& desiredProperties,
+                                  EntityItemProperties& properties, bool& scalesWithParent) {
+    auto itr = _entries.constFind(entityID);
+    if (itr != _entries.constEnd()) {
+        for (const auto& entry : *itr) {
+            if (entry.desiredProperties == desiredProperties) {
+                properties = entry.properties;
+                scalesWithParent = entry.scalesWithParent;
+                ++_numHits;
+                return true;
+            }
+        }
+    }
+    ++_numMisses;
+    return false;
+}
+
+void EntityPropertySnapshot::insert(const EntityItemID& entityID, const EntityPropertyFlags& desiredProperties,
+                                    const EntityItemProperties& properties, bool scalesWithParent) {
+    Entry entry;
+    entry.desiredProperties = desiredProperties;
+    entry.properties = properties;
+    entry.scalesWithParent = scalesWithParent;
+    _entries[entityID].push_back(entry);
+}
+
+void EntityPropertySnapshot::invalidate(const EntityItemID& entityID) {
+    QSet<EntityItemID> entityIDs;
+    entityIDs.insert(entityID);
+    invalidate(entityIDs);
+}
+
+void EntityPropertySnapshot::invalidate(QSet<EntityItemID> entityIDs) {
+    for (const auto& entityID : entityIDs) {
+        _entries.remove(entityID);
+    }
+
+    // world properties of children were read relative to their parent, so they go too, level by level
+    bool removedChildren = true;
+    while (removedChildren && !_entries.isEmpty()) {
+        removedChildren = false;
+        for (auto itr = _entries.begin(); itr != _entries.end();) {
+            bool isChild = false;
+            for (const auto& entry : *itr) {
+                if (entityIDs.contains(entry.properties.getParentID())) {
+                    isChild = true;
+                    break;
+                }
+            }
+            if (isChild) {
+                entityIDs.insert(itr.key());
+                itr = _entries.erase(itr);
+                removedChildren = true;
+            } else {
+                ++itr;
+            }
+        }
+    }
+}
+
+void EntityPropertySnapshot::catchUp(const EntityChangeFeed& feed) {
+    if (_feed != &feed) {
+        // entries read from another tree tell nothing about this one
+        _entries.clear();
+        _feed = &feed;
+        _feedCursor = feed.getLatestSequence();
+        return;
+    }
+    if (_entries.isEmpty()) {
+        // nothing to invalidate
+        _feedCursor = feed.getLatestSequence();
+        return;
+    }
+    if (!feed.hasChangesSince(_feedCursor)) {
+        return;
+    }
+
+    _changes.clear();
+    if (feed.read(_feedCursor, _changes) == EntityChangeFeed::Overrun) {
+        _entries.clear();
+        return;
+    }
+    QSet<EntityItemID> changedIDs;
+    for (const auto& change : _changes) {
+        changedIDs.insert(change.entityID);
+    }
+    invalidate(changedIDs);
+}
+
+void EntityPropertySnapshot::clear() {
+    _entries.clear();
+    _numHits = 0;
+    _numMisses = 0;
+}
@@ -0,0 +1,77 @@
+//
+//  EntityPropertySnapshot.h
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPropertySnapshot_h
+#define hifi_EntityPropertySnapshot_h
+
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+
+#include "EntityChangeFeed.h"
+#include "EntityItemID.h"
+#include "EntityItemProperties.h"
+#include "EntityPropertyFlags.h"
+
+/// Entity properties a script has read during the current script frame.  Reading the same entity and properties again
+/// in the frame is served from the copy, without taking the entity tree lock or copying out of the entity again, so
+/// scripts that poll the same entities from several places pay for one read per frame.
+///
+/// Snapshots are per thread, i.e. per script engine, and off unless the script turns them on with
+/// Entities.setPropertySnapshotsEnabled().  The script engine starts a new frame before its timers and update signal.
+/// Before each read the snapshot catches up with the tree's change feed, so adds, edits, deletes and moves of an entity
+/// drop it from the snapshot, together with its descendants, whose world properties depend on it.  Changes that don't
+/// reach the feed (joints, voxels, line points and actions set through the Entities API) invalidate the entity directly,
+/// and entities with an avatar among their ancestors, which move with the avatar, are never kept.
+class EntityPropertySnapshot {
+public:
+    /// The calling thread's snapshot, nullptr while snapshots are off on the thread
+    static EntityPropertySnapshot* getCurrent();
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+    /// Discards the calling thread's snapshot, if any, so the next reads see the current state of the entities
+    static void beginFrame();
+
+    /// \param desiredProperties the properties as read from the entity, empty for all of them
+    bool find(const EntityItemID& entityID, const EntityPropertyFlags& desiredProperties,
+              EntityItemProperties& properties, bool& scalesWithParent);
+    void insert(const EntityItemID& entityID, const EntityPropertyFlags& desiredProperties,
+                const EntityItemProperties& properties, bool scalesWithParent);
+    /// Drops the entity and its descendants
+    void invalidate(const EntityItemID& entityID);
+    /// Invalidates what changed in the feed since the last call, or everything if the feed was lapped
+    void catchUp(const EntityChangeFeed& feed);
+    void clear();
+
+    int getNumHits() const { return _numHits; }
+    int getNumMisses() const { return _numMisses; }
+
+private:
+    class Entry {
+    public:
+        EntityPropertyFlags desiredProperties;
+        EntityItemProperties properties;
+        bool scalesWithParent { false };
+    };
+
+    void invalidate(QSet<EntityItemID> entityIDs);
+
+    // scripts tend to read an entity with one or two property lists, so a short list per entity does
+    QHash<EntityItemID, QVector<Entry>> _entries;
+    const EntityChangeFeed* _feed { nullptr };
+    EntityChangeFeed::Sequence _feedCursor { 0 };
+    std::vector<EntityChange> _changes;
+    int _numHits { 0 };
+    int _numMisses { 0 };
+};
+
+#endif // hifi_EntityPropertySnapshot_h
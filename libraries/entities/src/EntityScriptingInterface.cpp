@@ -28,6 +28,7 @@
 
 #include "EntityItemID.h"
 #include "EntitiesLogging.h"
+#include "EntityPropertySnapshot.h"
 #include "EntityDynamicFactoryInterface.h"
 #include "EntityDynamicInterface.h"
 #include "EntitySimulation.h"
@@ -602,48 +603,109 @@ EntityItemProperties EntityScriptingInterface::getEntityProperties(const QUuid&
     return getEntityProperties(entityID, noSpecificProperties);
 }
 
+// if we are explicitly getting position or rotation, we need parent information to make sense of them.
+static bool addParentPropertiesIfNeeded(EntityPropertyFlags& desiredProperties) {
+    if (desiredProperties.getHasProperty(PROP_POSITION) ||
+        desiredProperties.getHasProperty(PROP_ROTATION) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_ROTATION) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_VELOCITY) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_ANGULAR_VELOCITY) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_DIMENSIONS)) {
+        desiredProperties.setHasProperty(PROP_PARENT_ID);
+        desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
+        return true;
+    }
+    return false;
+}
+
+// Must be called with the tree read locked.  Empty desiredProperties means all of them, unless allowEmptyDesiredProperties.
+static EntityItemProperties readEntityProperties(const EntityItemPointer& entity, const EntityPropertyFlags& desiredProperties,
+                                                 bool allowEmptyDesiredProperties = false) {
+    if (desiredProperties.isEmpty() && !allowEmptyDesiredProperties) {
+        // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
+        // don't end up in json saves, etc.  We still want them here, though.
+        EncodeBitstreamParams params; // unknown
+        EntityPropertyFlags allProperties = entity->getEntityProperties(params);
+        allProperties.setHasProperty(PROP_LOCAL_POSITION);
+        allProperties.setHasProperty(PROP_LOCAL_ROTATION);
+        allProperties.setHasProperty(PROP_LOCAL_VELOCITY);
+        allProperties.setHasProperty(PROP_LOCAL_ANGULAR_VELOCITY);
+        allProperties.setHasProperty(PROP_LOCAL_DIMENSIONS);
+        return entity->getProperties(allProperties);
+    }
+    return entity->getProperties(desiredProperties, true);
+}
+
+// The calling thread's snapshot, caught up with the changes made to the tree since it was last used
+static EntityPropertySnapshot* getPropertySnapshot(const EntityTreePointer& tree) {
+    EntityPropertySnapshot* snapshot = EntityPropertySnapshot::getCurrent();
+    if (snapshot && tree) {
+        snapshot->catchUp(tree->getChangeFeed());
+    }
+    return snapshot;
+}
+
+// entities riding on an avatar move with it, which the change feed doesn't see
+static bool canSnapshot(const EntityItemPointer& entity) {
+    return !entity->hasAncestorOfType(NestableType::Avatar);
+}
+
+// The script's own changes that don't go through the change feed
+static void invalidatePropertySnapshot(const QUuid& entityID) {
+    EntityPropertySnapshot* snapshot = EntityPropertySnapshot::getCurrent();
+    if (snapshot) {
+        snapshot->invalidate(entityID);
+    }
+}
+
 EntityItemProperties EntityScriptingInterface::getEntityProperties(const QUuid& entityID, EntityPropertyFlags desiredProperties) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
+    addParentPropertiesIfNeeded(desiredProperties);
+
     bool scalesWithParent { false };
     EntityItemProperties results;
+    EntityPropertySnapshot* snapshot = getPropertySnapshot(_entityTree);
+    if (snapshot && snapshot->find(entityID, desiredProperties, results, scalesWithParent)) {
+        return convertPropertiesToScriptSemantics(results, scalesWithParent);
+    }
+
     if (_entityTree) {
+        bool found { false };
         _entityTree->withReadLock([&] {
             EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityID));
             if (entity) {
                 scalesWithParent = entity->getScalesWithParent();
-                if (desiredProperties.getHasProperty(PROP_POSITION) ||
-                    desiredProperties.getHasProperty(PROP_ROTATION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_ROTATION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_VELOCITY) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_ANGULAR_VELOCITY) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_DIMENSIONS)) {
-                    // if we are explicitly getting position or rotation, we need parent information to make sense of them.
-                    desiredProperties.setHasProperty(PROP_PARENT_ID);
-                    desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
-                }
-
-                if (desiredProperties.isEmpty()) {
-                    // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
-                    // don't end up in json saves, etc.  We still want them here, though.
-                    EncodeBitstreamParams params; // unknown
-                    desiredProperties = entity->getEntityProperties(params);
-                    desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
-                    desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
-                    desiredProperties.setHasProperty(PROP_LOCAL_VELOCITY);
-                    desiredProperties.setHasProperty(PROP_LOCAL_ANGULAR_VELOCITY);
-                    desiredProperties.setHasProperty(PROP_LOCAL_DIMENSIONS);
-                }
-
-                results = entity->getProperties(desiredProperties);
+                results = readEntityProperties(entity, desiredProperties);
+                found = snapshot && canSnapshot(entity);
             }
         });
+        if (found) {
+            snapshot->insert(entityID, desiredProperties, results, scalesWithParent);
+        }
     }
 
     return convertPropertiesToScriptSemantics(results, scalesWithParent);
 }
 
+bool EntityScriptingInterface::getPropertySnapshotsEnabled() const {
+    return EntityPropertySnapshot::isEnabled();
+}
+
+void EntityScriptingInterface::setPropertySnapshotsEnabled(bool enabled) {
+    EntityPropertySnapshot::setEnabled(enabled);
+}
+
+QVariantMap EntityScriptingInterface::getPropertySnapshotStats() const {
+    QVariantMap stats;
+    EntityPropertySnapshot* snapshot = EntityPropertySnapshot::getCurrent();
+    stats["enabled"] = snapshot != nullptr;
+    stats["hits"] = snapshot ? snapshot->getNumHits() : 0;
+    stats["misses"] = snapshot ? snapshot->getNumMisses() : 0;
+    return stats;
+}
+
 
 struct EntityPropertiesResult {
     EntityPropertiesResult(const EntityItemProperties& properties, bool scalesWithParent) :
@@ -713,64 +775,86 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
     }
 
     EntityPropertyFlags desiredProperties = qscriptvalue_cast<EntityPropertyFlags>(extendedDesiredProperties);
-    bool needsScriptSemantics = desiredProperties.getHasProperty(PROP_POSITION) ||
-        desiredProperties.getHasProperty(PROP_ROTATION) ||
-        desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
-        desiredProperties.getHasProperty(PROP_LOCAL_ROTATION) ||
-        desiredProperties.getHasProperty(PROP_LOCAL_VELOCITY) ||
-        desiredProperties.getHasProperty(PROP_LOCAL_ANGULAR_VELOCITY) ||
-        desiredProperties.getHasProperty(PROP_LOCAL_DIMENSIONS);
-    if (needsScriptSemantics) {
-        // if we are explicitly getting position or rotation, we need parent information to make sense of them.
-        desiredProperties.setHasProperty(PROP_PARENT_ID);
-        desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
+    bool needsScriptSemantics = addParentPropertiesIfNeeded(desiredProperties);
+    bool onlyPsuedoProperties = false;
+    if (desiredProperties.isEmpty()) {
+        if (psuedoPropertyFlags.none()) {
+            // nothing asked for in particular, so everything is returned
+            psuedoPropertyFlags.set();
+            needsScriptSemantics = true;
+        } else {
+            onlyPsuedoProperties = true;
+        }
+    }
+
+    // entities not found are left out, so read into slots and compact afterwards
+    int size = entityIDs.size();
+    QVector<EntityPropertiesResult> resultProperties(size);
+    QVector<bool> found(size, false);
+    QVector<int> toRead;
+    // reads of only psuedo properties have an empty desiredProperties too, which the snapshot takes for all properties
+    EntityPropertySnapshot* snapshot = onlyPsuedoProperties ? nullptr : getPropertySnapshot(_entityTree);
+    if (snapshot) {
+        PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Snapshot");
+        for (int i = 0; i < size; ++i) {
+            EntityPropertiesResult& result = resultProperties[i];
+            found[i] = snapshot->find(entityIDs.at(i), desiredProperties, result.properties, result.scalesWithParent);
+            if (!found[i]) {
+                toRead.push_back(i);
+            }
+        }
+    } else {
+        toRead.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            toRead.push_back(i);
+        }
     }
-    QVector<EntityPropertiesResult> resultProperties;
-    if (_entityTree) {
+
+    if (_entityTree && !toRead.isEmpty()) {
         PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Obtaining Properties");
-        int i = 0;
+        int next = 0;
         const int lockAmount = 500;
-        int size = entityIDs.size();
-        while (i < size) {
+        QVector<int> toSnapshot;
+        while (next < toRead.size()) {
             _entityTree->withReadLock([&] {
-                for (int j = 0; j < lockAmount && i < size; ++i, ++j) {
-                    const auto& entityID = entityIDs.at(i);
-                    const EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityID));
+                for (int j = 0; j < lockAmount && next < toRead.size(); ++next, ++j) {
+                    int i = toRead[next];
+                    const EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityIDs.at(i)));
                     if (entity) {
-                        if (psuedoPropertyFlags.none() && desiredProperties.isEmpty()) {
-                            // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
-                            // don't end up in json saves, etc.  We still want them here, though.
-                            EncodeBitstreamParams params; // unknown
-                            desiredProperties = entity->getEntityProperties(params);
-                            desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
-                            desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
-                            desiredProperties.setHasProperty(PROP_LOCAL_VELOCITY);
-                            desiredProperties.setHasProperty(PROP_LOCAL_ANGULAR_VELOCITY);
-                            desiredProperties.setHasProperty(PROP_LOCAL_DIMENSIONS);
-                            psuedoPropertyFlags.set();
-                            needsScriptSemantics = true;
+                        auto properties = readEntityProperties(entity, desiredProperties, onlyPsuedoProperties);
+                        resultProperties[i] = EntityPropertiesResult(properties, entity->getScalesWithParent());
+                        found[i] = true;
+                        if (snapshot && canSnapshot(entity)) {
+                            toSnapshot.push_back(i);
                         }
-
-                        auto properties = entity->getProperties(desiredProperties, true);
-                        EntityPropertiesResult result(properties, entity->getScalesWithParent());
-                        resultProperties.append(result);
                     }
                 }
             });
         }
+        for (int i : toSnapshot) {
+            snapshot->insert(entityIDs.at(i), desiredProperties, resultProperties[i].properties,
+                             resultProperties[i].scalesWithParent);
+        }
     }
-    QScriptValue finalResult = engine->newArray(resultProperties.size());
-    quint32 i = 0;
+
+    QScriptValue finalResult = engine->newArray(found.count(true));
+    quint32 index = 0;
     if (needsScriptSemantics) {
         PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Script Semantics");
-        foreach(const auto& result, resultProperties) {
-            finalResult.setProperty(i++, convertPropertiesToScriptSemantics(result.properties, result.scalesWithParent)
-                .copyToScriptValue(engine, false, false, false, psuedoPropertyFlags));
+        for (int i = 0; i < size; ++i) {
+            if (found[i]) {
+                const auto& result = resultProperties[i];
+                finalResult.setProperty(index++, convertPropertiesToScriptSemantics(result.properties, result.scalesWithParent)
+                    .copyToScriptValue(engine, false, false, false, psuedoPropertyFlags));
+            }
         }
     } else {
         PROFILE_RANGE(script_entities, "EntityScriptingInterface::getMultipleEntityProperties>Skip Script Semantics");
-        foreach(const auto& result, resultProperties) {
-            finalResult.setProperty(i++, result.properties.copyToScriptValue(engine, false, false, false, psuedoPropertyFlags));
+        for (int i = 0; i < size; ++i) {
+            if (found[i]) {
+                finalResult.setProperty(index++, resultProperties[i].properties.copyToScriptValue(engine, false, false, false,
+                                                                                                  psuedoPropertyFlags));
+            }
         }
     }
     return finalResult;
@@ -786,6 +870,7 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
     EntityItemProperties properties = scriptSideProperties;
 
     EntityItemID entityID(id);
+    invalidatePropertySnapshot(entityID);
     if (!_entityTree) {
         properties.setLastEditedBy(sessionID);
         queueEntityMessage(PacketType::EntityEdit, entityID, properties);
@@ -971,6 +1056,7 @@ void EntityScriptingInterface::deleteEntity(const QUuid& id) {
     }
 
     EntityItemID entityID(id);
+    invalidatePropertySnapshot(entityID);
 
     // If we have a local entity tree set, then also update it.
     std::vector<EntityItemPointer> entitiesToDeleteImmediately;
@@ -1515,6 +1601,7 @@ bool EntityScriptingInterface::polyVoxWorker(QUuid entityID, std::function<bool(
     _entityTree->withWriteLock([&] {
         result = actor(*polyVoxEntity);
     });
+    invalidatePropertySnapshot(entityID);
     return result;
 }
 
@@ -1545,6 +1632,7 @@ bool EntityScriptingInterface::setPoints(QUuid entityID, std::function<bool(Line
         entity->setLastEdited(now);
         entity->setLastBroadcast(now);
     });
+    invalidatePropertySnapshot(entityID);
 
     EntityItemProperties properties;
     _entityTree->withReadLock([&] {
@@ -1671,6 +1759,7 @@ bool EntityScriptingInterface::actionWorker(const QUuid& entityID,
         doTransmit = actor(simulation, entity);
         _entityTree->entityChanged(entity);
     });
+    invalidatePropertySnapshot(entityID);
 
     // transmit the change
     if (doTransmit) {
@@ -1870,6 +1959,7 @@ bool EntityScriptingInterface::setAbsoluteJointTranslationInObjectFrame(const QU
 
             properties.setJointTranslationsDirty();
             properties.setLastEdited(now);
+            invalidatePropertySnapshot(entityID);
             queueEntityMessage(PacketType::EntityEdit, entityID, properties);
             return true;
         }
@@ -1892,6 +1982,7 @@ bool EntityScriptingInterface::setAbsoluteJointRotationInObjectFrame(const QUuid
 
             properties.setJointRotationsDirty();
             properties.setLastEdited(now);
+            invalidatePropertySnapshot(entityID);
             queueEntityMessage(PacketType::EntityEdit, entityID, properties);
             return true;
         }
@@ -1931,6 +2022,7 @@ bool EntityScriptingInterface::setLocalJointTranslation(const QUuid& entityID, i
 
             properties.setJointTranslationsDirty();
             properties.setLastEdited(now);
+            invalidatePropertySnapshot(entityID);
             queueEntityMessage(PacketType::EntityEdit, entityID, properties);
             return true;
         }
@@ -1952,6 +2044,7 @@ bool EntityScriptingInterface::setLocalJointRotation(const QUuid& entityID, int
 
             properties.setJointRotationsDirty();
             properties.setLastEdited(now);
+            invalidatePropertySnapshot(entityID);
             queueEntityMessage(PacketType::EntityEdit, entityID, properties);
             return true;
         }
@@ -1980,6 +2073,7 @@ bool EntityScriptingInterface::setLocalJointRotations(const QUuid& entityID, con
 
             properties.setJointRotationsDirty();
             properties.setLastEdited(now);
+            invalidatePropertySnapshot(entityID);
             queueEntityMessage(PacketType::EntityEdit, entityID, properties);
             return true;
         }
@@ -2007,6 +2101,7 @@ bool EntityScriptingInterface::setLocalJointTranslations(const QUuid& entityID,
 
             properties.setJointTranslationsDirty();
             properties.setLastEdited(now);
+            invalidatePropertySnapshot(entityID);
             queueEntityMessage(PacketType::EntityEdit, entityID, properties);
             return true;
         }
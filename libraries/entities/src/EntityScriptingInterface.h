@@ -391,6 +391,39 @@ public slots:
     Q_INVOKABLE EntityItemProperties getEntityProperties(const QUuid& entityID);
     Q_INVOKABLE EntityItemProperties getEntityProperties(const QUuid& entityID, EntityPropertyFlags desiredProperties);
 
+    /**jsdoc
+     * Turns per-frame property snapshots on or off for this script. While they are on, reading the same properties of an 
+     * entity again in the same script frame, with {@link Entities.getEntityProperties|getEntityProperties} or 
+     * {@link Entities.getMultipleEntityProperties|getMultipleEntityProperties}, returns the values read the first time 
+     * instead of reading the entity again. When an entity changes, whether by this script or elsewhere, it and its 
+     * children are read again. Off by default.
+     * @function Entities.setPropertySnapshotsEnabled
+     * @param {boolean} enabled - <code>true</code> to turn snapshots on, <code>false</code> to turn them off.
+     * @example <caption>Poll many entities cheaply from several places in a script.</caption>
+     * Entities.setPropertySnapshotsEnabled(true);
+     * Script.update.connect(function () {
+     *     var entityIDs = Entities.findEntities(MyAvatar.position, 10);
+     *     var properties = Entities.getMultipleEntityProperties(entityIDs, ["position", "name"]);
+     *     // Further reads of the same entities and properties in this frame are served from the snapshot.
+     * });
+     */
+    Q_INVOKABLE void setPropertySnapshotsEnabled(bool enabled);
+
+    /**jsdoc
+     * Checks whether per-frame property snapshots are on for this script.
+     * @function Entities.getPropertySnapshotsEnabled
+     * @returns {boolean} <code>true</code> if snapshots are on, <code>false</code> if they are off.
+     */
+    Q_INVOKABLE bool getPropertySnapshotsEnabled() const;
+
+    /**jsdoc
+     * Gets how many property reads the snapshot has served in the current script frame.
+     * @function Entities.getPropertySnapshotStats
+     * @returns {object} An object with <code>enabled</code>, <code>hits</code> (reads served from the snapshot) and 
+     *     <code>misses</code> (reads of the entity tree).
+     */
+    Q_INVOKABLE QVariantMap getPropertySnapshotStats() const;
+
     /**jsdoc
      * Edits an entity, changing one or more of its property values.
      * @function Entities.editEntity
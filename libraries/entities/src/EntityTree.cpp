@@ -40,6 +40,7 @@
 #include "LogHandler.h"
 #include "EntityEditFilters.h"
 #include "EntityDynamicFactoryInterface.h"
+#include "PhysicsStateBatch.h"
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
@@ -111,6 +112,12 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
             }
         }
         _entityMap.swap(savedEntities);
+
+        QWriteLocker bvhLocker(&_pickBVHLock);
+        _pickBVH.clear();
+        foreach(EntityItemPointer entity, _entityMap) {
+            insertPickBounds(entity);
+        }
     });
 
     resetClientEditStats();
@@ -139,6 +146,10 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     }
     QHash<EntityItemID, EntityItemPointer> localMap;
     localMap.swap(_entityMap);
+    {
+        QWriteLocker bvhLocker(&_pickBVHLock);
+        _pickBVH.clear();
+    }
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -220,6 +231,8 @@ int EntityTree::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
                     if (entity->getDirtyFlags()) {
                         entityChanged(entity);
                     }
+                    // the stream doesn't tell us which properties were actually newer, so publish an unspecified edit
+                    publishEntityChange(EntityChange::Edit, entityItemID);
                     _entityMover.addEntityToMoveList(entity, entity->getQueryAACube());
 
                     QString entityScriptAfter = entity->getScript();
@@ -279,6 +292,7 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
         case PacketType::EntityEdit:
         case PacketType::EntityErase:
         case PacketType::EntityPhysics:
+        case PacketType::EntityPhysicsBatch:
             return true;
         default:
             return false;
@@ -307,6 +321,8 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     // find and hook up any entities with this entity as a (previously) missing parent
     fixupNeedsParentFixups();
 
+    publishEntityChange(EntityChange::Add, entity->getEntityItemID());
+
     emit addingEntity(entity->getEntityItemID());
     emit addingEntityPointer(entity.get());
 }
@@ -366,6 +382,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                 UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, queryCube);
                 recurseTreeWithOperator(&theOperator);
                 if (entity->setProperties(tempProperties)) {
+                    publishEntityChange(EntityChange::Edit, entity->getEntityItemID(), EntityPropertyFlags(PROP_LOCKED));
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
@@ -463,6 +480,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
         recurseTreeWithOperator(&theOperator);
         if (entity->setProperties(properties)) {
+            publishEntityChange(EntityChange::Edit, entity->getEntityItemID(), properties.getChangedProperties());
             emit editingEntityPointer(entity);
         }
 
@@ -582,6 +600,29 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     return result;
 }
 
+QMap<EntityTypes::EntityType, EntityTree::TypeMemoryStats> EntityTree::getMemoryStatsByType() const {
+    QVector<EntityItemPointer> entities;
+    {
+        QReadLocker locker(&_entityMapLock);
+        entities.reserve(_entityMap.size());
+        foreach(EntityItemPointer entity, _entityMap) {
+            entities.push_back(entity);
+        }
+    }
+
+    // measure outside of the map lock, each entity takes its own read lock
+    QMap<EntityTypes::EntityType, TypeMemoryStats> stats;
+    for (const auto& entity : entities) {
+        TypeMemoryStats& typeStats = stats[entity->getType()];
+        ++typeStats.numEntities;
+        typeStats.numBytes += entity->getApproximateMemoryUsage();
+        if (entity->hasCertifiableProperties()) {
+            ++typeStats.numWithCertifiableProperties;
+        }
+    }
+    return stats;
+}
+
 void EntityTree::emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload) {
     emit entityScriptChanging(entityItemID, reload);
 }
@@ -760,6 +801,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
     const RemovedEntities& entities = theOperator.getEntities();
     foreach(const EntityToDeleteDetails& details, entities) {
         EntityItemPointer theEntity = details.entity;
+        publishEntityChange(EntityChange::Delete, theEntity->getEntityItemID());
         if (getIsServer()) {
             removeCertifiedEntityOnServer(theEntity);
 
@@ -788,140 +830,80 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
     }
 }
 
-class RayArgs {
-public:
-    // Inputs
-    glm::vec3 origin;
-    glm::vec3 direction;
-    glm::vec3 invDirection;
-    const QVector<EntityItemID>& entityIdsToInclude;
-    const QVector<EntityItemID>& entityIdsToDiscard;
-    PickFilter searchFilter;
-
-    // Outputs
-    OctreeElementPointer& element;
-    float& distance;
-    BoxFace& face;
-    glm::vec3& surfaceNormal;
-    QVariantMap& extraInfo;
-    EntityItemID entityID;
-};
-
-bool evalRayIntersectionOp(const OctreeElementPointer& element, void* extraData) {
-    RayArgs* args = static_cast<RayArgs*>(extraData);
-    bool keepSearching = true;
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    EntityItemID entityID = entityTreeElementPointer->evalRayIntersection(args->origin, args->direction,
-        args->element, args->distance, args->face, args->surfaceNormal, args->entityIdsToInclude,
-        args->entityIdsToDiscard, args->searchFilter, args->extraInfo);
-    if (!entityID.isNull()) {
-        args->entityID = entityID;
-        // We recurse OctreeElements in order, so if we hit something, we can stop immediately
-        keepSearching = false;
-    }
-    return keepSearching;
-}
-
-float evalRayIntersectionSortingOp(const OctreeElementPointer& element, void* extraData) {
-    RayArgs* args = static_cast<RayArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    float distance = FLT_MAX;
-    // If origin is inside the cube, always check this element first
-    if (entityTreeElementPointer->getAACube().contains(args->origin)) {
-        distance = 0.0f;
-    } else {
-        float boundDistance = FLT_MAX;
-        BoxFace face;
-        glm::vec3 surfaceNormal;
-        if (entityTreeElementPointer->getAACube().findRayIntersection(args->origin, args->direction, args->invDirection, boundDistance, face, surfaceNormal)) {
-            // Don't add this cell if it's already farther than our best distance so far
-            if (boundDistance < args->distance) {
-                distance = boundDistance;
-            }
-        }
-    }
-    return distance;
-}
-
 EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
                                     QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
                                     PickFilter searchFilter, OctreeElementPointer& element, float& distance,
                                     BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
                                     Octree::lockType lockType, bool* accurateResult) {
-
-    // calculate dirReciprocal like this rather than with glm's scalar / vec3 template to avoid NaNs.
-    vec3 dirReciprocal = glm::vec3(direction.x == 0.0f ? 0.0f : 1.0f / direction.x,
-                                   direction.y == 0.0f ? 0.0f : 1.0f / direction.y,
-                                   direction.z == 0.0f ? 0.0f : 1.0f / direction.z);
-    RayArgs args = { origin, direction, dirReciprocal, entityIdsToInclude, entityIdsToDiscard,
-            searchFilter, element, distance, face, surfaceNormal, extraInfo, EntityItemID() };
+    EntityItemID entityID;
     distance = FLT_MAX;
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        // the BVH hands us entities nearest-first and skips anything whose bounds start beyond our best hit so far
+        QReadLocker bvhLocker(&_pickBVHLock);
+        _pickBVH.findRayIntersections(origin, direction, distance, [&](const EntityItemPointer& entity, float maxDistance) {
+            if (EntityTreeElement::evalEntityRayIntersection(entity, origin, direction, element, distance, face,
+                    surfaceNormal, entityIdsToInclude, entityIdsToDiscard, searchFilter, extraInfo)) {
+                entityID = entity->getEntityItemID();
+            }
+            return distance;
+        });
     }, requireLock);
 
     if (accurateResult) {
         *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
     }
 
-    return args.entityID;
+    return entityID;
 }
 
-class ParabolaArgs {
-public:
-    // Inputs
-    glm::vec3 origin;
-    glm::vec3 velocity;
-    glm::vec3 acceleration;
-    const QVector<EntityItemID>& entityIdsToInclude;
-    const QVector<EntityItemID>& entityIdsToDiscard;
-    PickFilter searchFilter;
+void EntityTree::evalRayIntersections(const QVector<PickRay>& rays,
+                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+                                    PickFilter searchFilter, QVector<EntityRayIntersection>& results,
+                                    Octree::lockType lockType, bool* accurateResult) {
+    results.clear();
+    results.resize(rays.size());
 
-    // Outputs
-    OctreeElementPointer& element;
-    float& parabolicDistance;
-    BoxFace& face;
-    glm::vec3& surfaceNormal;
-    QVariantMap& extraInfo;
-    EntityItemID entityID;
-};
+    std::vector<EntityBVH::Ray> bvhRays;
+    bvhRays.reserve(rays.size());
+    for (const auto& ray : rays) {
+        EntityBVH::Ray bvhRay;
+        bvhRay.origin = ray.origin;
+        bvhRay.direction = ray.direction;
+        bvhRays.push_back(bvhRay);
+    }
 
-bool evalParabolaIntersectionOp(const OctreeElementPointer& element, void* extraData) {
-    ParabolaArgs* args = static_cast<ParabolaArgs*>(extraData);
-    bool keepSearching = true;
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    EntityItemID entityID = entityTreeElementPointer->evalParabolaIntersection(args->origin, args->velocity, args->acceleration,
-        args->element, args->parabolicDistance, args->face, args->surfaceNormal, args->entityIdsToInclude,
-        args->entityIdsToDiscard, args->searchFilter, args->extraInfo);
-    if (!entityID.isNull()) {
-        args->entityID = entityID;
-        // We recurse OctreeElements in order, so if we hit something, we can stop immediately
-        keepSearching = false;
+    bool requireLock = lockType == Octree::Lock;
+    bool lockResult = withReadLock([&] {
+        QReadLocker bvhLocker(&_pickBVHLock);
+        _pickBVH.findRayIntersections(bvhRays, [&](size_t rayIndex, const EntityItemPointer& entity, float maxDistance) {
+            const PickRay& ray = rays[(int)rayIndex];
+            EntityRayIntersection& result = results[(int)rayIndex];
+            if (EntityTreeElement::evalEntityRayIntersection(entity, ray.origin, ray.direction, result.element,
+                    result.distance, result.face, result.surfaceNormal, entityIdsToInclude, entityIdsToDiscard,
+                    searchFilter, result.extraInfo)) {
+                result.entityID = entity->getEntityItemID();
+            }
+            return result.distance;
+        });
+    }, requireLock);
+
+    if (accurateResult) {
+        *accurateResult = lockResult;
     }
-    return keepSearching;
 }
 
-float evalParabolaIntersectionSortingOp(const OctreeElementPointer& element, void* extraData) {
-    ParabolaArgs* args = static_cast<ParabolaArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    float distance = FLT_MAX;
-    // If origin is inside the cube, always check this element first
-    if (entityTreeElementPointer->getAACube().contains(args->origin)) {
-        distance = 0.0f;
-    } else {
-        float boundDistance = FLT_MAX;
-        BoxFace face;
-        glm::vec3 surfaceNormal;
-        if (entityTreeElementPointer->getAACube().findParabolaIntersection(args->origin, args->velocity, args->acceleration, boundDistance, face, surfaceNormal)) {
-            // Don't add this cell if it's already farther than our best distance so far
-            if (boundDistance < args->parabolicDistance) {
-                distance = boundDistance;
-            }
-        }
+// The plane that contains the parabola, used for a cheap bounding sphere rejection of each entity
+static glm::vec3 parabolaPlaneNormal(const glm::vec3& velocity, const glm::vec3& acceleration) {
+    glm::vec3 vectorOnPlane = velocity;
+    if (glm::dot(glm::normalize(velocity), glm::normalize(acceleration)) > 1.0f - EPSILON) {
+        // Handle the degenerate case where velocity is parallel to acceleration
+        // We pick t = 1 and calculate a second point on the plane
+        vectorOnPlane = velocity + 0.5f * acceleration;
     }
-    return distance;
+    // Get the normal of the plane, the cross product of two vectors on the plane
+    return glm::normalize(glm::cross(vectorOnPlane, acceleration));
 }
 
 EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
@@ -930,26 +912,35 @@ EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
                                     OctreeElementPointer& element, glm::vec3& intersection, float& distance, float& parabolicDistance,
                                     BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
                                     Octree::lockType lockType, bool* accurateResult) {
-    ParabolaArgs args = { parabola.origin, parabola.velocity, parabola.acceleration, entityIdsToInclude, entityIdsToDiscard,
-        searchFilter, element, parabolicDistance, face, surfaceNormal, extraInfo, EntityItemID() };
+    EntityItemID entityID;
     parabolicDistance = FLT_MAX;
     distance = FLT_MAX;
 
+    glm::vec3 normal = parabolaPlaneNormal(parabola.velocity, parabola.acceleration);
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&] {
-        recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
+        QReadLocker bvhLocker(&_pickBVHLock);
+        _pickBVH.findParabolaIntersections(parabola.origin, parabola.velocity, parabola.acceleration, parabolicDistance,
+                [&](const EntityItemPointer& entity, float maxDistance) {
+            if (EntityTreeElement::evalEntityParabolaIntersection(entity, parabola.origin, parabola.velocity,
+                    parabola.acceleration, normal, element, parabolicDistance, face, surfaceNormal, entityIdsToInclude,
+                    entityIdsToDiscard, searchFilter, extraInfo)) {
+                entityID = entity->getEntityItemID();
+            }
+            return parabolicDistance;
+        });
     }, requireLock);
 
     if (accurateResult) {
         *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
     }
 
-    if (!args.entityID.isNull()) {
+    if (!entityID.isNull()) {
         intersection = parabola.origin + parabola.velocity * parabolicDistance + 0.5f * parabola.acceleration * parabolicDistance * parabolicDistance;
         distance = glm::distance(intersection, parabola.origin);
     }
 
-    return args.entityID;
+    return entityID;
 }
 
 class FindClosestEntityArgs {
@@ -1002,7 +993,7 @@ bool evalClosestEntityOperation(const OctreeElementPointer& element, void* extra
 // NOTE: assumes caller has handled locking
 QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadius, PickFilter searchFilter) {
     FindClosestEntityArgs args = { position, targetRadius, searchFilter, QUuid(), FLT_MAX };
-    recurseTreeWithOperation(evalClosestEntityOperation, &args);
+    recurseTreeWithOperationFlat(evalClosestEntityOperation, &args);
     return args.closestEntity;
 }
 
@@ -1036,7 +1027,7 @@ bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData)
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
+    recurseTreeWithOperationFlat(evalInSphereOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1071,7 +1062,7 @@ bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* ex
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
+    recurseTreeWithOperationFlat(evalInSphereWithTypeOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1107,7 +1098,7 @@ bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* ex
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
+    recurseTreeWithOperationFlat(evalInSphereWithNameOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1134,7 +1125,7 @@ bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
+    recurseTreeWithOperationFlat(findInCubeOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1162,7 +1153,7 @@ bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
+    recurseTreeWithOperationFlat(findInBoxOperation, &args);
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
@@ -1191,7 +1182,7 @@ bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData
 void EntityTree::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInFrustumArgs args = { frustum, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInFrustumOperation, &args);
+    recurseTreeWithOperationFlat(findInFrustumOperation, &args);
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
@@ -1789,6 +1780,10 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             break;
         }
 
+        case PacketType::EntityPhysicsBatch:
+            processedBytes = processPhysicsStateBatch(editData, maxLength, senderNode);
+            break;
+
         case PacketType::EntityClone:
             isClone = true; // fall through to next case
             // FALLTHRU
@@ -2098,6 +2093,73 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     return processedBytes;
 }
 
+// NOTE: Caller must lock the tree before calling this.
+int EntityTree::processPhysicsStateBatch(const unsigned char* editData, int maxLength,
+                                         const SharedNodePointer& senderNode) {
+    quint64 startDecode = usecTimestampNow();
+    int processedBytes = 0;
+    quint64 lastEdited = 0;
+    std::vector<PhysicsStateBatch::Record> records;
+    if (!PhysicsStateBatch::decode(editData, maxLength, processedBytes, lastEdited, records)) {
+        qCWarning(entities) << "EntityTree::processPhysicsStateBatch() invalid batch from" << senderNode->getUUID();
+        // skip the rest of the packet, there is no telling where the next message starts
+        return maxLength;
+    }
+    quint64 endDecode = usecTimestampNow();
+    _totalDecodeTime += endDecode - startDecode;
+
+    for (const auto& record : records) {
+        _totalEditMessages++;
+
+        quint64 startLookup = usecTimestampNow();
+        EntityItemPointer existingEntity = findEntityByEntityItemID(record.id);
+        _totalLookupTime += usecTimestampNow() - startLookup;
+        if (!existingEntity) {
+            HIFI_FCDEBUG(entities(), "Edit failed. [" << PacketType::EntityPhysicsBatch << "] " <<
+                         "entity id:" << record.id);
+            continue;
+        }
+
+        // the same edit as an EntityPhysics message would carry
+        EntityItemProperties properties;
+        properties.setPosition(record.position);
+        properties.setRotation(record.rotation);
+        properties.setVelocity(record.velocity);
+        properties.setAngularVelocity(record.angularVelocity);
+        properties.setAcceleration(record.acceleration);
+        if (record.hasQueryAACube) {
+            properties.setQueryAACube(record.queryAACube);
+        }
+        properties.setLastEdited(lastEdited);
+
+        quint64 startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        bool allowed = filterProperties(existingEntity, properties, properties, wasChanged, FilterType::Physics);
+        if (!allowed) {
+            // re-assert the current properties, as for a filtered EntityPhysics edit
+            properties = EntityItemProperties();
+            properties.setLastEdited(lastEdited);
+        }
+        if (!allowed || wasChanged) {
+            bumpTimestamp(properties);
+            properties.clearSimulationOwner();
+        }
+        _totalFilterTime += usecTimestampNow() - startFilter;
+
+        if (wantTerseEditLogging()) {
+            QList<QString> changedProperties = properties.listChangedProperties();
+            fixupTerseEditLogging(properties, changedProperties);
+            qCDebug(entities) << senderNode->getUUID() << "edit" << existingEntity->getDebugName() << changedProperties;
+        }
+
+        quint64 startUpdate = usecTimestampNow();
+        updateEntity(existingEntity, properties, senderNode);
+        existingEntity->markAsChangedOnServer();
+        _totalUpdateTime += usecTimestampNow() - startUpdate;
+        _totalUpdates++;
+    }
+    return processedBytes;
+}
 
 void EntityTree::notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
     _newlyCreatedHooksLock.lockForRead();
@@ -2198,6 +2260,9 @@ void EntityTree::fixupNeedsParentFixups() {
                                                      Simulation::DIRTY_COLLISION_GROUP |
                                                      Simulation::DIRTY_TRANSFORM);
                     entityChanged(descendantEntity);
+                    // descendants move with their parent without being re-sorted here
+                    publishEntityChange(EntityChange::Edit, descendantEntity->getEntityItemID(),
+                                        EntityPropertyFlags(PROP_POSITION));
                 }
                 object->locationChanged(true, false);
             });
@@ -2508,11 +2573,37 @@ void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
         return;
     }
     _entityMap.insert(id, entity);
+    locker.unlock();
+
+    QWriteLocker bvhLocker(&_pickBVHLock);
+    insertPickBounds(entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
-    QWriteLocker locker(&_entityMapLock);
-    _entityMap.remove(id);
+    {
+        QWriteLocker locker(&_entityMapLock);
+        _entityMap.remove(id);
+    }
+    QWriteLocker bvhLocker(&_pickBVHLock);
+    _pickBVH.remove(id);
+}
+
+void EntityTree::insertPickBounds(const EntityItemPointer& entity) {
+    // the pick BVH uses the same query cube that places the entity in the octree
+    bool success;
+    AACube queryCube = entity->getQueryAACube(success);
+    if (!success) {
+        // we don't know where it is yet, make sure it can still be picked once it gets moved
+        queryCube = AACube(glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE);
+    }
+    _pickBVH.insert(entity, AABox(queryCube));
+}
+
+void EntityTree::updateEntityPickBounds(const EntityItemPointer& entity, const AACube& newQueryAACube) {
+    QWriteLocker bvhLocker(&_pickBVHLock);
+    if (_pickBVH.contains(entity->getEntityItemID())) {
+        _pickBVH.update(entity, AABox(newQueryAACube));
+    }
 }
 
 void EntityTree::debugDumpMap() {
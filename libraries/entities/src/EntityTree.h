@@ -19,6 +19,8 @@
 #include <SpatialParentFinder.h>
 
 #include "AddEntityOperator.h"
+#include "EntityBVH.h"
+#include "EntityChangeFeed.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
@@ -45,6 +47,16 @@ public:
     QHash<EntityItemID, EntityItemID>* map;
 };
 
+class EntityRayIntersection {
+public:
+    EntityItemID entityID;
+    OctreeElementPointer element;
+    float distance { FLT_MAX };
+    BoxFace face { UNKNOWN_FACE };
+    glm::vec3 surfaceNormal;
+    QVariantMap extraInfo;
+};
+
 class EntityTree : public Octree, public SpatialParentTree {
     Q_OBJECT
 public:
@@ -99,6 +111,12 @@ public:
         BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
         Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
 
+    /// Traces several rays in one pass over the pick BVH, results are in the same order as rays
+    void evalRayIntersections(const QVector<PickRay>& rays,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        PickFilter searchFilter, QVector<EntityRayIntersection>& results,
+        Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
+
     virtual EntityItemID evalParabolaIntersection(const PickParabola& parabola,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
         PickFilter searchFilter, OctreeElementPointer& element, glm::vec3& intersection,
@@ -164,12 +182,14 @@ public:
 
     int processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
     int processEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode);
+    int processPhysicsStateBatch(const unsigned char* editData, int maxLength, const SharedNodePointer& senderNode);
     bool shouldEraseEntity(EntityItemID entityID, const SharedNodePointer& sourceNode);
 
 
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
     void addEntityMapEntry(EntityItemPointer entity);
     void clearEntityMapEntry(const EntityItemID& id);
+    void updateEntityPickBounds(const EntityItemPointer& entity, const AACube& newQueryAACube);
     void debugDumpMap();
     virtual void dumpTree() override;
     virtual void pruneTree() override;
@@ -181,6 +201,23 @@ public:
 
     void entityChanged(EntityItemPointer entity);
 
+    /// Ordered log of entity adds, edits and deletes on this tree, consumers read it with their own cursor.  Moves made
+    /// by the simulation or by parent fixups are published as edits of PROP_POSITION.
+    const EntityChangeFeed& getChangeFeed() const { return _changeFeed; }
+    void publishEntityChange(EntityChange::Type type, const EntityItemID& entityID,
+                             const EntityPropertyFlags& properties = EntityPropertyFlags()) {
+        _changeFeed.publish(type, entityID, properties);
+    }
+
+    class TypeMemoryStats {
+    public:
+        int numEntities { 0 };
+        int numWithCertifiableProperties { 0 };
+        size_t numBytes { 0 };
+    };
+    /// Approximate memory held by the entities of each type, see EntityItem::getApproximateMemoryUsage
+    QMap<EntityTypes::EntityType, TypeMemoryStats> getMemoryStatsByType() const;
+
     void emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload);
     void emitEntityServerScriptChanging(const EntityItemID& entityItemID, bool reload);
 
@@ -329,6 +366,13 @@ protected:
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
 
+    // bounding volume hierarchy over entity query cubes, used for ray and parabola picks
+    void insertPickBounds(const EntityItemPointer& entity);
+    mutable QReadWriteLock _pickBVHLock;
+    EntityBVH _pickBVH;
+
+    EntityChangeFeed _changeFeed;
+
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
 
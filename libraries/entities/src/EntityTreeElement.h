@@ -84,6 +84,7 @@ class EntityTreeElement : public OctreeElement, ReadWriteLockable {
     EntityTreeElement(unsigned char* octalCode = NULL);
 
     virtual OctreeElementPointer createNewElement(unsigned char* octalCode = NULL) override;
+    virtual Octree* getOctree() const override;
 
 public:
     virtual ~EntityTreeElement();
@@ -144,6 +145,11 @@ public:
                          OctreeElementPointer& element, float& distance,
                          BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
                          const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
+    /// Tests a single entity, returns true and updates the outputs if it is hit closer than distance
+    static bool evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin, const glm::vec3& direction,
+        OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        PickFilter searchFilter, QVariantMap& extraInfo);
     virtual bool findSpherePenetration(const glm::vec3& center, float radius,
                         glm::vec3& penetration, void** penetratedObject) const override;
 
@@ -155,6 +161,11 @@ public:
         const glm::vec3& normal, const glm::vec3& acceleration, OctreeElementPointer& element, float& parabolicDistance,
         BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
+    /// Tests a single entity, returns true and updates the outputs if it is hit closer than parabolicDistance
+    static bool evalEntityParabolaIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+        const glm::vec3& velocity, const glm::vec3& acceleration, const glm::vec3& normal, OctreeElementPointer& element,
+        float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+        const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
 
     template <typename F>
     void forEachEntity(F f) const {
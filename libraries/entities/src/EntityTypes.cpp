@@ -157,3 +157,40 @@ EntityItemPointer EntityTypes::constructEntityItem(const unsigned char* data, in
 EntityItemPointer EntityTypes::constructEntityItem(const QUuid& id, const EntityItemProperties& properties) {
     return constructEntityItem(properties.getType(), id, properties);
 }
+
+size_t EntityTypes::getInstanceSize(EntityType entityType) {
+    switch (entityType) {
+        case Box:
+        case Sphere:
+        case Shape:
+            return sizeof(ShapeEntityItem);
+        case Model:
+            return sizeof(ModelEntityItem);
+        case Text:
+            return sizeof(TextEntityItem);
+        case Image:
+            return sizeof(ImageEntityItem);
+        case Web:
+            return sizeof(WebEntityItem);
+        case ParticleEffect:
+            return sizeof(ParticleEffectEntityItem);
+        case Line:
+            return sizeof(LineEntityItem);
+        case PolyLine:
+            return sizeof(PolyLineEntityItem);
+        case PolyVox:
+            return sizeof(PolyVoxEntityItem);
+        case Grid:
+            return sizeof(GridEntityItem);
+        case Gizmo:
+            return sizeof(GizmoEntityItem);
+        case Light:
+            return sizeof(LightEntityItem);
+        case Zone:
+            return sizeof(ZoneEntityItem);
+        case Material:
+            return sizeof(MaterialEntityItem);
+        default:
+            return 0;
+    }
+}
@@ -119,6 +119,8 @@ public:
     static EntityItemPointer constructEntityItem(EntityType entityType, const EntityItemID& entityID, const EntityItemProperties& properties);
     static EntityItemPointer constructEntityItem(const unsigned char* data, int bytesToRead);
     static EntityItemPointer constructEntityItem(const QUuid& id, const EntityItemProperties& properties);
+    /// sizeof the class implementing the type, 0 for unknown types
+    static size_t getInstanceSize(EntityType entityType);
 
 private:
     static QMap<EntityType, QString> _typeToNameMap;
@@ -8,6 +8,8 @@
 
 #include "ImageEntityItem.h"
 
+#include <shared/StringInterner.h>
+
 #include "EntityItemProperties.h"
 
 EntityItemPointer ImageEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
@@ -215,8 +217,10 @@ QString ImageEntityItem::getImageURL() const {
 
 void ImageEntityItem::setImageURL(const QString& url) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _imageURL != url;
-        _imageURL = url;
+        if (_imageURL != url) {
+            _imageURL = StringInterner::intern(url);
+            _needsRenderUpdate = true;
+        }
     });
 }
 
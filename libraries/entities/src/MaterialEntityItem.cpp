@@ -8,6 +8,8 @@
 
 #include "MaterialEntityItem.h"
 
+#include <shared/StringInterner.h>
+
 #include "EntityItemProperties.h"
 
 #include "QJsonDocument"
@@ -154,8 +156,10 @@ QString MaterialEntityItem::getMaterialURL() const {
 
 void MaterialEntityItem::setMaterialURL(const QString& materialURL) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _materialURL != materialURL;
-        _materialURL = materialURL;
+        if (_materialURL != materialURL) {
+            _materialURL = StringInterner::intern(materialURL);
+            _needsRenderUpdate = true;
+        }
     });
 }
 
@@ -17,6 +17,7 @@
 
 #include <ByteCountCoding.h>
 #include <GLMHelpers.h>
+#include <shared/StringInterner.h>
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
@@ -50,8 +51,10 @@ const QString ModelEntityItem::getTextures() const {
 
 void ModelEntityItem::setTextures(const QString& textures) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _textures != textures;
-        _textures = textures;
+        if (_textures != textures) {
+            _textures = StringInterner::intern(textures);
+            _needsRenderUpdate = true;
+        }
     });
 }
 
@@ -294,7 +297,7 @@ ShapeType ModelEntityItem::computeTrueShapeType() const {
 void ModelEntityItem::setModelURL(const QString& url) {
     withWriteLock([&] {
         if (_modelURL != url) {
-            _modelURL = url;
+            _modelURL = StringInterner::intern(url);
             _flags |= Simulation::DIRTY_SHAPE | Simulation::DIRTY_MASS;
             _needsRenderUpdate = true;
         }
@@ -63,6 +63,14 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
         return; // bail without adding.
     }
 
+    // the pick BVH tracks the query cube even when the containing element doesn't change, and every move goes
+    // through here (simulation, parent fixups, edits) so it is also where moves reach the change feed
+    EntityTreePointer tree = oldContainingElement->getTree();
+    if (tree) {
+        tree->updateEntityPickBounds(entity, newCube);
+        tree->publishEntityChange(EntityChange::Edit, entity->getEntityItemID(), EntityPropertyFlags(PROP_POSITION));
+    }
+
     // If the original containing element is the best fit for the requested newCube locations then
     // we don't actually need to add the entity for moving and we can short circuit all this work
     if (!oldContainingElement->bestFitBounds(newCubeClamped)) {
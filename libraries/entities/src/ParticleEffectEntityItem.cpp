@@ -34,6 +34,7 @@
 #include <ByteCountCoding.h>
 #include <GeometryUtil.h>
 #include <Interpolate.h>
+#include <shared/StringInterner.h>
 
 #include "EntityTree.h"
 #include "EntityTreeElement.h"
@@ -1031,8 +1032,10 @@ quint32 ParticleEffectEntityItem::getMaxParticles() const {
 
 void ParticleEffectEntityItem::setTextures(const QString& textures) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _particleProperties.textures != textures;
-        _particleProperties.textures = textures;
+        if (_particleProperties.textures != textures) {
+            _particleProperties.textures = StringInterner::intern(textures);
+            _needsRenderUpdate = true;
+        }
     });
 }
 
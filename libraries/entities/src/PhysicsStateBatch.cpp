@@ -0,0 +1,183 @@
+//
+//  PhysicsStateBatch.cpp
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsStateBatch.h"
+
+#include <cassert>
+#include <limits>
+
+#include <GLMHelpers.h>
+#include <UUID.h>
+
+const int PhysicsStateBatch::POSITION_RADIX = 10;
+const float PhysicsStateBatch::POSITION_RANGE = 32.0f;
+const int PhysicsStateBatch::VELOCITY_RADIX = 6;
+const float PhysicsStateBatch::VELOCITY_RANGE = 512.0f;
+
+enum RecordFlags : uint8_t {
+    HAS_QUERY_AA_CUBE = 0x01
+};
+
+// lastEdited, origin, number of records
+const int HEADER_SIZE = (int)(sizeof(quint64) + sizeof(glm::vec3) + sizeof(quint16));
+// id, flags, position, rotation, velocity, angular velocity, acceleration
+const int RECORD_SIZE = NUM_BYTES_RFC4122_UUID + (int)sizeof(uint8_t) + 6 + 6 + 6 + 6 + 6;
+// corner and scale
+const int QUERY_AA_CUBE_SIZE = (int)(sizeof(glm::vec3) + sizeof(float));
+
+static int getRecordSize(const PhysicsStateBatch::Record& record) {
+    return RECORD_SIZE + (record.hasQueryAACube ? QUERY_AA_CUBE_SIZE : 0);
+}
+
+static bool isInRange(const glm::vec3& value, float range) {
+    // the fixed point maximum is one step short of the range
+    return glm::all(glm::lessThan(glm::abs(value), glm::vec3(range * 0.999f)));
+}
+
+static glm::vec3 roundTrip(const glm::vec3& value, int radix) {
+    unsigned char buffer[6];
+    packFloatVec3ToSignedTwoByteFixed(buffer, value, radix);
+    glm::vec3 result;
+    unpackFloatVec3FromSignedTwoByteFixed(buffer, result, radix);
+    return result;
+}
+
+bool PhysicsStateBatch::canEncode(const Record& record) {
+    return isInRange(record.velocity, VELOCITY_RANGE) && isInRange(record.angularVelocity, VELOCITY_RANGE) &&
+        isInRange(record.acceleration, VELOCITY_RANGE);
+}
+
+PhysicsStateBatch::PhysicsStateBatch(int maxMessageSize) :
+    _maxMessageSize(maxMessageSize),
+    _size(HEADER_SIZE)
+{
+}
+
+bool PhysicsStateBatch::append(Record& record) {
+    if (!canEncode(record) || _size + getRecordSize(record) > _maxMessageSize ||
+            _records.size() >= std::numeric_limits<quint16>::max()) {
+        return false;
+    }
+    glm::vec3 origin = _records.empty() ? glm::round(record.position) : _origin;
+    if (!isInRange(record.position - origin, POSITION_RANGE)) {
+        return false;
+    }
+    _origin = origin;
+
+    record.position = origin + roundTrip(record.position - origin, POSITION_RADIX);
+    unsigned char buffer[6];
+    packOrientationQuatToSixBytes(buffer, record.rotation);
+    unpackOrientationQuatFromSixBytes(buffer, record.rotation);
+    record.velocity = roundTrip(record.velocity, VELOCITY_RADIX);
+    record.angularVelocity = roundTrip(record.angularVelocity, VELOCITY_RADIX);
+    record.acceleration = roundTrip(record.acceleration, VELOCITY_RADIX);
+
+    _records.push_back(record);
+    _size += getRecordSize(record);
+    return true;
+}
+
+QByteArray PhysicsStateBatch::encode(quint64 lastEdited) const {
+    QByteArray buffer(_size, 0);
+    unsigned char* dataAt = reinterpret_cast<unsigned char*>(buffer.data());
+
+    memcpy(dataAt, &lastEdited, sizeof(lastEdited));
+    dataAt += sizeof(lastEdited);
+    memcpy(dataAt, &_origin, sizeof(_origin));
+    dataAt += sizeof(_origin);
+    quint16 numRecords = (quint16)_records.size();
+    memcpy(dataAt, &numRecords, sizeof(numRecords));
+    dataAt += sizeof(numRecords);
+
+    for (const auto& record : _records) {
+        QByteArray id = record.id.toRfc4122();
+        memcpy(dataAt, id.constData(), NUM_BYTES_RFC4122_UUID);
+        dataAt += NUM_BYTES_RFC4122_UUID;
+        *dataAt++ = record.hasQueryAACube ? HAS_QUERY_AA_CUBE : 0;
+        dataAt += packFloatVec3ToSignedTwoByteFixed(dataAt, record.position - _origin, POSITION_RADIX);
+        dataAt += packOrientationQuatToSixBytes(dataAt, record.rotation);
+        dataAt += packFloatVec3ToSignedTwoByteFixed(dataAt, record.velocity, VELOCITY_RADIX);
+        dataAt += packFloatVec3ToSignedTwoByteFixed(dataAt, record.angularVelocity, VELOCITY_RADIX);
+        dataAt += packFloatVec3ToSignedTwoByteFixed(dataAt, record.acceleration, VELOCITY_RADIX);
+        if (record.hasQueryAACube) {
+            glm::vec3 corner = record.queryAACube.getCorner();
+            float scale = record.queryAACube.getScale();
+            memcpy(dataAt, &corner, sizeof(corner));
+            dataAt += sizeof(corner);
+            memcpy(dataAt, &scale, sizeof(scale));
+            dataAt += sizeof(scale);
+        }
+    }
+    assert(dataAt == reinterpret_cast<unsigned char*>(buffer.data()) + buffer.size());
+    return buffer;
+}
+
+bool PhysicsStateBatch::decode(const unsigned char* data, int maxLength, int& processedBytes, quint64& lastEdited,
+                               std::vector<Record>& records) {
+    processedBytes = 0;
+    if (maxLength < HEADER_SIZE) {
+        return false;
+    }
+    const unsigned char* dataAt = data;
+    const unsigned char* end = data + maxLength;
+
+    glm::vec3 origin;
+    quint16 numRecords;
+    memcpy(&lastEdited, dataAt, sizeof(lastEdited));
+    dataAt += sizeof(lastEdited);
+    memcpy(&origin, dataAt, sizeof(origin));
+    dataAt += sizeof(origin);
+    memcpy(&numRecords, dataAt, sizeof(numRecords));
+    dataAt += sizeof(numRecords);
+
+    records.reserve(records.size() + numRecords);
+    for (quint16 i = 0; i < numRecords; ++i) {
+        if (end - dataAt < RECORD_SIZE) {
+            return false;
+        }
+        Record record;
+        record.id = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(dataAt),
+                                                               NUM_BYTES_RFC4122_UUID));
+        dataAt += NUM_BYTES_RFC4122_UUID;
+        uint8_t flags = *dataAt++;
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, record.position, POSITION_RADIX);
+        record.position += origin;
+        dataAt += unpackOrientationQuatFromSixBytes(dataAt, record.rotation);
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, record.velocity, VELOCITY_RADIX);
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, record.angularVelocity, VELOCITY_RADIX);
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, record.acceleration, VELOCITY_RADIX);
+        if (flags & HAS_QUERY_AA_CUBE) {
+            if (end - dataAt < QUERY_AA_CUBE_SIZE) {
+                return false;
+            }
+            glm::vec3 corner;
+            float scale;
+            memcpy(&corner, dataAt, sizeof(corner));
+            dataAt += sizeof(corner);
+            memcpy(&scale, dataAt, sizeof(scale));
+            dataAt += sizeof(scale);
+            record.hasQueryAACube = true;
+            record.queryAACube = AACube(corner, scale);
+        }
+        records.push_back(record);
+    }
+    processedBytes = (int)(dataAt - data);
+    return true;
+}
+
+void PhysicsStateBatch::adjustForClockSkew(QByteArray& buffer, qint64 clockSkew) {
+    if (buffer.size() < (int)sizeof(quint64)) {
+        return;
+    }
+    quint64 lastEditedInLocalTime;
+    memcpy(&lastEditedInLocalTime, buffer.constData(), sizeof(lastEditedInLocalTime));
+    quint64 lastEditedInServerTime = lastEditedInLocalTime > 0 ? lastEditedInLocalTime + clockSkew : 0;
+    memcpy(buffer.data(), &lastEditedInServerTime, sizeof(lastEditedInServerTime));
+}
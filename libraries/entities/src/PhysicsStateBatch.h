@@ -0,0 +1,81 @@
+//
+//  PhysicsStateBatch.h
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsStateBatch_h
+#define hifi_PhysicsStateBatch_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AACube.h>
+
+#include "EntityItemID.h"
+
+/// The physical state of many entities in one PacketType::EntityPhysicsBatch message, sent by a simulation owner
+/// instead of one EntityPhysics edit per entity.
+///
+/// Positions are 16 bit fixed point offsets from an origin shared by the batch, rotations use the six byte
+/// smallest-three encoding and velocities are 16 bit fixed point.  append() rounds each record to what the server
+/// will decode, so the owner's prediction of the server state matches what the server really has.
+class PhysicsStateBatch {
+public:
+    class Record {
+    public:
+        EntityItemID id;
+        // relative to the parent, as in EntityPhysics edits
+        glm::vec3 position;
+        glm::quat rotation;
+        glm::vec3 velocity;
+        glm::vec3 angularVelocity;
+        glm::vec3 acceleration;
+        // only when the owner updated it, the server can't compute it for parented entities
+        bool hasQueryAACube { false };
+        AACube queryAACube;
+    };
+
+    static const int POSITION_RADIX; // 1/1024 m
+    static const float POSITION_RANGE; // meters from the origin along each axis
+    static const int VELOCITY_RADIX; // 1/64 m/s, rad/s and m/s^2
+    static const float VELOCITY_RANGE;
+
+    /// \return false when the record's velocities are out of range and it must be sent as a full edit
+    static bool canEncode(const Record& record);
+
+    /// \param maxMessageSize bytes available for the message
+    explicit PhysicsStateBatch(int maxMessageSize);
+
+    /// Adds the record and rounds it to the values the receiver will decode.
+    /// \return false, leaving the record as it was, if it doesn't fit or is too far from the batch's origin
+    bool append(Record& record);
+
+    bool isEmpty() const { return _records.empty(); }
+    int getNumRecords() const { return (int)_records.size(); }
+    const glm::vec3& getOrigin() const { return _origin; }
+
+    QByteArray encode(quint64 lastEdited) const;
+
+    /// \return false if the data is not a valid batch
+    static bool decode(const unsigned char* data, int maxLength, int& processedBytes, quint64& lastEdited,
+                       std::vector<Record>& records);
+
+    static void adjustForClockSkew(QByteArray& buffer, qint64 clockSkew);
+
+private:
+    std::vector<Record> _records;
+    glm::vec3 _origin;
+    int _maxMessageSize;
+    int _size;
+};
+
+#endif // hifi_PhysicsStateBatch_h
@@ -37,6 +37,7 @@ void SimpleEntitySimulation::clearOwnership(const QUuid& ownerID) {
             // remove ownership and dirty all the tree elements that contain the it
             entity->clearSimulationOwnership();
             entity->markAsChangedOnServer();
+            getEntityTree()->publishEntityChange(EntityChange::Edit, entity->getEntityItemID(), PROP_SIMULATION_OWNER);
             if (auto element = entity->getElement()) {
                 DirtyOctreeElementOperator op(element);
                 getEntityTree()->recurseTreeWithOperator(&op);
@@ -173,6 +174,7 @@ void SimpleEntitySimulation::expireStaleOwnerships(uint64_t now) {
                 // remove ownership and dirty all the tree elements that contain the it
                 entity->clearSimulationOwnership();
                 entity->markAsChangedOnServer();
+                getEntityTree()->publishEntityChange(EntityChange::Edit, entity->getEntityItemID(), PROP_SIMULATION_OWNER);
                 DirtyOctreeElementOperator op(entity->getElement());
                 getEntityTree()->recurseTreeWithOperator(&op);
             } else {
@@ -204,6 +206,11 @@ void SimpleEntitySimulation::stopOwnerlessEntities(uint64_t now) {
 
                     // dirty all the tree elements that contain it
                     entity->markAsChangedOnServer();
+                    EntityPropertyFlags changedProperties;
+                    changedProperties += PROP_VELOCITY;
+                    changedProperties += PROP_ANGULAR_VELOCITY;
+                    changedProperties += PROP_ACCELERATION;
+                    getEntityTree()->publishEntityChange(EntityChange::Edit, entity->getEntityItemID(), changedProperties);
                     DirtyOctreeElementOperator op(entity->getElement());
                     getEntityTree()->recurseTreeWithOperator(&op);
                 }
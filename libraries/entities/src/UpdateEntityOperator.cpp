@@ -45,6 +45,8 @@ UpdateEntityOperator::UpdateEntityOperator(EntityTreePointer tree,
     _newEntityCube = newQueryAACube;
     _newEntityBox = _newEntityCube.clamp((float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE); // clamp to domain bounds
 
+    _tree->updateEntityPickBounds(_existingEntity, _newEntityCube);
+
     // set oldElementBestFit true if the entity was in the correct element before this operator was run.
     bool oldElementBestFit = _containingElement->bestFitBounds(_oldEntityBox);
 
@@ -16,6 +16,7 @@
 #include <ByteCountCoding.h>
 #include <GeometryUtil.h>
 #include <shared/LocalFileAccessGate.h>
+#include <shared/StringInterner.h>
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
@@ -279,8 +280,10 @@ void WebEntityItem::setBillboardMode(BillboardMode value) {
 
 void WebEntityItem::setSourceUrl(const QString& value) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _sourceUrl != value;
-        _sourceUrl = value;
+        if (_sourceUrl != value) {
+            _sourceUrl = StringInterner::intern(value);
+            _needsRenderUpdate = true;
+        }
     });
 }
 
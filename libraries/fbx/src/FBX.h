@@ -20,7 +20,7 @@
 
 #include <shared/HifiTypes.h>
 
-// See comment in FBXSerializer::parseFBX().
+// See comment in FBXBinaryReader::readHeader().
 static const int FBX_HEADER_BYTES_BEFORE_VERSION = 23;
 static const hifi::ByteArray FBX_BINARY_PROLOG("Kaydara FBX Binary  ");
 static const hifi::ByteArray FBX_BINARY_PROLOG2("\0\x1a\0", 3);
@@ -0,0 +1,219 @@
+//
+//  FBXBinaryReader.cpp
+//  libraries/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXBinaryReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <zlib.h>
+
+template<class T>
+static void fromLittleEndian(T& value) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    char* bytes = reinterpret_cast<char*>(&value);
+    std::reverse(bytes, bytes + sizeof(T));
+#else
+    Q_UNUSED(value);
+#endif
+}
+
+FBXBinaryReader::FBXBinaryReader(const char* data, size_t size) :
+    _data(data),
+    _size(size)
+{
+}
+
+bool FBXBinaryReader::isBinaryFBX(const hifi::ByteArray& data) {
+    return data.startsWith(FBX_BINARY_PROLOG);
+}
+
+void FBXBinaryReader::require(quint64 numBytes) const {
+    if (numBytes > _size - _position) {
+        throw QString("FBX file most likely corrupt: unexpected end of data");
+    }
+}
+
+template<class T>
+T FBXBinaryReader::read() {
+    require(sizeof(T));
+    T value;
+    memcpy(&value, _data + _position, sizeof(T));
+    _position += sizeof(T);
+    fromLittleEndian(value);
+    return value;
+}
+
+template<class T>
+QVariant FBXBinaryReader::readArray() {
+    quint32 arrayLength = read<quint32>();
+    quint32 encoding = read<quint32>();
+    quint32 compressedLength = read<quint32>();
+    // byte containers are limited to max signed int
+    if (arrayLength > std::numeric_limits<int>::max() / sizeof(T)) {
+        throw QString("FBX file most likely corrupt: binary data exceeds data limits");
+    }
+    if (compressedLength > std::numeric_limits<int>::max() / sizeof(T)) {
+        throw QString("FBX file most likely corrupt: compressed binary data exceeds data limits");
+    }
+
+    QVector<T> values;
+    quint64 numBytes = (quint64)arrayLength * sizeof(T);
+    if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        require(compressedLength);
+        if (arrayLength > 0) {
+            values.resize(arrayLength);
+            uLongf inflatedLength = (uLongf)numBytes;
+            int status = uncompress(reinterpret_cast<Bytef*>(values.data()), &inflatedLength,
+                                    reinterpret_cast<const Bytef*>(_data + _position), (uLong)compressedLength);
+            if (status != Z_OK || inflatedLength != numBytes) {
+                throw QString("corrupt fbx file");
+            }
+        }
+        _position += compressedLength;
+    } else {
+        require(numBytes);
+        if (arrayLength > 0) {
+            values.resize(arrayLength);
+            memcpy(values.data(), _data + _position, numBytes);
+        }
+        _position += numBytes;
+    }
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    for (auto& value : values) {
+        fromLittleEndian(value);
+    }
+#endif
+    return QVariant::fromValue(values);
+}
+
+void FBXBinaryReader::readHeader() {
+    if (_size < (quint64)FBX_BINARY_PROLOG.size() || memcmp(_data, FBX_BINARY_PROLOG.constData(), FBX_BINARY_PROLOG.size())) {
+        throw QString("not a binary fbx file");
+    }
+
+    // The first 27 bytes contain the header.
+    //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
+    //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
+    //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
+    _position = FBX_HEADER_BYTES_BEFORE_VERSION;
+    _version = read<quint32>();
+    // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
+    _has64BitPositions = (_version >= FBX_VERSION_2016);
+}
+
+FBXBinaryReader::NodeHeader FBXBinaryReader::readNodeHeader() {
+    NodeHeader header;
+    if (_has64BitPositions) {
+        header.endOffset = read<quint64>();
+        header.propertyCount = read<quint64>();
+        read<quint64>(); // property list length
+    } else {
+        header.endOffset = read<quint32>();
+        header.propertyCount = read<quint32>();
+        read<quint32>(); // property list length
+    }
+    quint8 nameLength = read<quint8>();
+
+    const quint64 MIN_VALID_OFFSET = 40;
+    if (header.endOffset < MIN_VALID_OFFSET || nameLength == 0) {
+        // use a null name to indicate a null node
+        return header;
+    }
+    require(nameLength);
+    header.name = hifi::ByteArray(_data + _position, nameLength);
+    _position += nameLength;
+    return header;
+}
+
+QVariant FBXBinaryReader::readProperty() {
+    char type = read<char>();
+    switch (type) {
+        case 'Y':
+            return QVariant::fromValue(read<qint16>());
+        case 'C':
+            return QVariant::fromValue(read<quint8>() != 0);
+        case 'I':
+            return QVariant::fromValue(read<qint32>());
+        case 'F':
+            return QVariant::fromValue(read<float>());
+        case 'D':
+            return QVariant::fromValue(read<double>());
+        case 'L':
+            return QVariant::fromValue(read<qint64>());
+        case 'f':
+            return readArray<float>();
+        case 'd':
+            return readArray<double>();
+        case 'l':
+            return readArray<qint64>();
+        case 'i':
+            return readArray<qint32>();
+        case 'b':
+            return readArray<bool>();
+        case 'S':
+        case 'R': {
+            quint32 length = read<quint32>();
+            require(length);
+            hifi::ByteArray value(_data + _position, (int)length);
+            _position += length;
+            return QVariant::fromValue(value);
+        }
+        default:
+            throw QString("Unknown property type: ") + type;
+    }
+}
+
+void FBXBinaryReader::skipTo(quint64 endOffset) {
+    if (endOffset > _size) {
+        throw QString("FBX file most likely corrupt: unexpected end of data");
+    }
+    _position = std::max(_position, endOffset);
+}
+
+FBXNode FBXBinaryReader::readNode() {
+    FBXNode node;
+    NodeHeader header = readNodeHeader();
+    if (header.name.isNull()) {
+        return node;
+    }
+    node.name = header.name;
+
+    // every property takes at least a byte, which bounds a corrupt count
+    node.properties.reserve((int)std::min<quint64>(header.propertyCount, _size - _position));
+    for (quint64 i = 0; i < header.propertyCount; i++) {
+        node.properties.append(readProperty());
+    }
+
+    while (header.endOffset > _position) {
+        FBXNode child = readNode();
+        if (!child.name.isNull()) {
+            node.children.append(child);
+        }
+    }
+    return node;
+}
+
+FBXNode FBXBinaryReader::readDocument() {
+    readHeader();
+
+    // parse the top-level node
+    FBXNode top;
+    while (!atEnd()) {
+        FBXNode next = readNode();
+        if (next.name.isNull()) {
+            return top;
+        }
+        top.children.append(next);
+    }
+    return top;
+}
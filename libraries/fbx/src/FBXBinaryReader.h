@@ -0,0 +1,75 @@
+//
+//  FBXBinaryReader.h
+//  libraries/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXBinaryReader_h
+#define hifi_FBXBinaryReader_h
+
+#include <QVariant>
+#include <QVector>
+
+#include <shared/HifiTypes.h>
+
+#include "FBX.h"
+
+// Streams the nodes of a binary FBX file straight out of the buffer holding it.
+//
+// Node headers and scalar properties are decoded in place.  Array properties are read once, into the QVector that ends
+// up in the node: uncompressed arrays are copied from the buffer and zlib arrays are inflated directly into it, without
+// staging the compressed or inflated bytes elsewhere.
+//
+// The buffer must outlive the reader but not the nodes read from it.  Errors throw a QString, like FBXSerializer.
+//
+// See http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for the format.
+class FBXBinaryReader {
+public:
+    class NodeHeader {
+    public:
+        hifi::ByteArray name; // null for the record that ends a list of nodes
+        quint64 endOffset { 0 };
+        quint64 propertyCount { 0 };
+    };
+
+    FBXBinaryReader(const char* data, size_t size);
+    FBXBinaryReader(const hifi::ByteArray& data) : FBXBinaryReader(data.constData(), (size_t)data.size()) {}
+
+    static bool isBinaryFBX(const hifi::ByteArray& data);
+
+    /// Reads the prolog and version, leaving the reader at the first top level node
+    void readHeader();
+    quint32 getVersion() const { return _version; }
+
+    bool atEnd() const { return _position >= _size; }
+    quint64 getPosition() const { return _position; }
+
+    /// Reads the header of the node at the current position, leaving the reader at its first property
+    NodeHeader readNodeHeader();
+    /// Reads the property at the current position
+    QVariant readProperty();
+    /// Leaves the reader at the end of a node, skipping whatever of its properties and children are left
+    void skipTo(quint64 endOffset);
+
+    /// Reads the node at the current position, with all of its properties and children
+    FBXNode readNode();
+    /// Reads every top level node, from the header on
+    FBXNode readDocument();
+
+private:
+    template<class T> T read();
+    template<class T> QVariant readArray();
+    void require(quint64 numBytes) const;
+
+    const char* _data;
+    quint64 _size;
+    quint64 _position { 0 };
+    quint32 _version { 0 };
+    bool _has64BitPositions { false };
+};
+
+#endif // hifi_FBXBinaryReader_h
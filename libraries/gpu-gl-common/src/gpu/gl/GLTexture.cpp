@@ -219,6 +219,20 @@ void GLVariableAllocationSupport::sanityCheck() const {
     }
 }
 
+// Mips backed by a KTX file are views of its mapping, so reading them may page fault.  Touching every page here, on
+// the buffering thread, keeps that disk IO out of the transfer.
+static void faultInPages(const storage::StoragePointer& storage) {
+    // the smallest page size we run with (not named PAGE_SIZE, which is a macro on macOS and Android)
+    static const size_t FAULT_IN_STRIDE = 4096;
+    const uint8_t* data = storage->data();
+    const size_t size = storage->size();
+    volatile uint8_t sink = 0;
+    for (size_t offset = 0; offset < size; offset += FAULT_IN_STRIDE) {
+        sink = data[offset];
+    }
+    (void)sink;
+}
+
 TransferJob::TransferJob(const Texture& texture,
     uint16_t sourceMip,
     uint16_t targetMip,
@@ -255,6 +269,9 @@ TransferJob::TransferJob(const Texture& texture,
         auto mipStorage = texture->accessStoredMipFace(sourceMip, face);
         if (mipStorage) {
             _mipData = mipStorage->createView(_transferSize, _transferOffset);
+            if (_mipData) {
+                faultInPages(_mipData);
+            }
         } else {
             qCWarning(gpugllogging) << "Buffering failed because mip could not be retrieved from texture "
                 << texture->source().c_str();
@@ -38,12 +38,12 @@ static const int MAX_NUM_UNIFORM_BUFFERS = 14;
 static const int MAX_NUM_RESOURCE_BUFFERS = 16;
 static const int MAX_NUM_RESOURCE_TEXTURES = 16;
 
-size_t Batch::_commandsMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_commandOffsetsMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_paramsMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_dataMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_objectsMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_drawCallInfosMax{ BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_commandsMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_commandOffsetsMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_paramsMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_dataMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_objectsMax { BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_drawCallInfosMax { BATCH_PREALLOCATE_MIN };
 
 Batch::Batch(const std::string& name) {
     _name = name;
@@ -56,12 +56,12 @@ Batch::Batch(const std::string& name) {
 }
 
 Batch::~Batch() {
-    _commandsMax = std::max(_commands.size(), _commandsMax);
-    _commandOffsetsMax = std::max(_commandOffsets.size(), _commandOffsetsMax);
-    _paramsMax = std::max(_params.size(), _paramsMax);
-    _dataMax = std::max(_data.size(), _dataMax);
-    _objectsMax = std::max(_objects.size(), _objectsMax);
-    _drawCallInfosMax = std::max(_drawCallInfos.size(), _drawCallInfosMax);
+    growMax(_commandsMax, _commands.size());
+    growMax(_commandOffsetsMax, _commandOffsets.size());
+    growMax(_paramsMax, _params.size());
+    growMax(_dataMax, _data.size());
+    growMax(_objectsMax, _objects.size());
+    growMax(_drawCallInfosMax, _drawCallInfos.size());
 }
 
 void Batch::setName(const std::string& name) {
@@ -69,12 +69,12 @@ void Batch::setName(const std::string& name) {
 }
 
 void Batch::clear() {
-    _commandsMax = std::max(_commands.size(), _commandsMax);
-    _commandOffsetsMax = std::max(_commandOffsets.size(), _commandOffsetsMax);
-    _paramsMax = std::max(_params.size(), _paramsMax);
-    _dataMax = std::max(_data.size(), _dataMax);
-    _objectsMax = std::max(_objects.size(), _objectsMax);
-    _drawCallInfosMax = std::max(_drawCallInfos.size(), _drawCallInfosMax);
+    growMax(_commandsMax, _commands.size());
+    growMax(_commandOffsetsMax, _commandOffsets.size());
+    growMax(_paramsMax, _params.size());
+    growMax(_dataMax, _data.size());
+    growMax(_objectsMax, _objects.size());
+    growMax(_drawCallInfosMax, _drawCallInfos.size());
 
     _commands.clear();
     _commandOffsets.clear();
@@ -190,7 +190,7 @@ KtxStorage::KtxStorage(const cache::FilePointer& cacheEntry) : KtxStorage(cacheE
 KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
     {
         // We are doing a lot of work here just to get descriptor data
-        ktx::StoragePointer storage{ new storage::FileStorage(_filename.c_str()) };
+        ktx::StoragePointer storage{ new storage::FileStorage(_filename.c_str(), true) };
         auto ktxPointer = ktx::KTX::create(storage);
         _ktxDescriptor.reset(new ktx::KTXDescriptor(ktxPointer->toDescriptor()));
         if (_ktxDescriptor->images.size() < _ktxDescriptor->header.numberOfMipmapLevels) {
@@ -224,8 +224,10 @@ std::shared_ptr<storage::FileStorage> KtxStorage::maybeOpenFile() const {
         return file;
     }
 
-    // If the file isn't open, create it and save a weak_ptr to it
-    file = std::make_shared<storage::FileStorage>(_filename.c_str());
+    // If the file isn't open, create it and save a weak_ptr to it.  Once every mip is in the file nothing will write to
+    // it again, so it can be mapped read only.
+    bool readOnly = (_minMipLevelAvailable == 0);
+    file = std::make_shared<storage::FileStorage>(_filename.c_str(), readOnly);
     _cacheFile = file;
 
     {
@@ -269,8 +271,11 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
     if (!storageView) {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
+        return PixelsPointer();
     }
-    return storageView->toMemoryStorage();
+    // The view keeps the file mapped for as long as the mip is in use, so uploads read the texels straight out of the
+    // page cache instead of out of a copy on the heap
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -347,7 +352,7 @@ bool validKtx(const storage::StoragePointer& storage) {
 }
 
 bool validKtx(const std::string& filename) {
-    ktx::StoragePointer storage{ new storage::FileStorage(filename.c_str()) };
+    ktx::StoragePointer storage{ new storage::FileStorage(filename.c_str(), true) };
     return validKtx(storage);
 }
 
@@ -573,7 +578,7 @@ TexturePointer Texture::build(const ktx::KTXDescriptor& descriptor) {
 }
 
 TexturePointer Texture::unserialize(const cache::FilePointer& cacheEntry, const std::string& source) {
-    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(cacheEntry->getFilepath().c_str()));
+    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(cacheEntry->getFilepath().c_str(), true));
     if (!ktxPointer) {
         return nullptr;
     }
@@ -590,7 +595,7 @@ TexturePointer Texture::unserialize(const cache::FilePointer& cacheEntry, const
 }
 
 TexturePointer Texture::unserialize(const std::string& ktxfile) {
-    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(ktxfile.c_str()));
+    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(ktxfile.c_str(), true));
     if (!ktxPointer) {
         return nullptr;
     }
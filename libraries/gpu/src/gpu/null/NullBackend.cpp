@@ -0,0 +1,350 @@
+//
+//  NullBackend.cpp
+//  libraries/gpu/src/gpu/null
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NullBackend.h"
+
+#include <chrono>
+#include <cstring>
+
+#include <Profile.h>
+
+using namespace gpu;
+using namespace gpu::null;
+
+const std::string& Backend::getVersion() const {
+    static const std::string VERSION { "null" };
+    return VERSION;
+}
+
+void Backend::resetReplayStats() {
+    _commandsStats = CommandsStats();
+    _replayStats = ReplayStats();
+}
+
+void Backend::render(const Batch& batch) {
+    PROFILE_RANGE(render_gpu, batch.getName().c_str());
+
+    _stereo._skybox = batch.isSkyboxEnabled();
+    // Allow the batch to override the rendering stereo settings
+    bool savedStereo = _stereo._enable;
+    if (!batch.isStereoEnabled()) {
+        _stereo._enable = false;
+    }
+    // Reset jitter
+    _projectionJitter = Vec2(0.0f, 0.0f);
+
+    _replayStats.numBatches++;
+    _replayStats.numCommands += batch.getCommands().size();
+
+    renderPassTransfer(batch);
+    renderPassDraw(batch);
+
+    // Restore the saved stereo state for the next batch
+    _stereo._enable = savedStereo;
+}
+
+void Backend::renderPassTransfer(const Batch& batch) {
+    const size_t numCommands = batch.getCommands().size();
+    const Batch::Commands::value_type* command = batch.getCommands().data();
+    const Batch::CommandOffsets::value_type* offset = batch.getCommandOffsets().data();
+
+    // Resolve the camera of every draw
+    _cameras.clear();
+    for (size_t commandIndex = 0; commandIndex < numCommands; ++commandIndex) {
+        switch (*command) {
+            case Batch::COMMAND_draw:
+            case Batch::COMMAND_drawIndexed:
+            case Batch::COMMAND_drawInstanced:
+            case Batch::COMMAND_drawIndexedInstanced:
+            case Batch::COMMAND_multiDrawIndirect:
+            case Batch::COMMAND_multiDrawIndexedIndirect: {
+                Vec2u outputSize { 1, 1 };
+                if (_framebuffer) {
+                    outputSize.x = _framebuffer->getWidth();
+                    outputSize.y = _framebuffer->getHeight();
+                }
+                updateCamera(outputSize);
+                break;
+            }
+
+            case Batch::COMMAND_disableContextStereo:
+            case Batch::COMMAND_restoreContextStereo:
+            case Batch::COMMAND_setFramebuffer:
+            case Batch::COMMAND_setFramebufferSwapChain:
+            case Batch::COMMAND_setViewportTransform:
+            case Batch::COMMAND_setViewTransform:
+            case Batch::COMMAND_setProjectionTransform:
+            case Batch::COMMAND_setProjectionJitter:
+                executeCommand(batch, *command, *offset);
+                break;
+
+            default:
+                break;
+        }
+        command++;
+        offset++;
+    }
+
+    // Stage the transform buffers, the GL backend uploads the same bytes
+    size_t cameraBufferSize = _cameras.size() * sizeof(TransformCamera);
+    size_t objectBufferSize = batch._objects.size() * sizeof(Batch::TransformObject);
+    size_t drawCallInfoBufferSize = 0;
+    for (const auto& data : batch._namedData) {
+        drawCallInfoBufferSize += data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+    }
+
+    _transformData.resize(objectBufferSize + drawCallInfoBufferSize);
+    if (objectBufferSize > 0) {
+        memcpy(_transformData.data(), batch._objects.data(), objectBufferSize);
+    }
+    size_t drawCallInfoOffset = objectBufferSize;
+    for (const auto& data : batch._namedData) {
+        size_t bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+        if (bytesToCopy > 0) {
+            memcpy(_transformData.data() + drawCallInfoOffset, data.second.drawCallInfos.data(), bytesToCopy);
+            drawCallInfoOffset += bytesToCopy;
+        }
+    }
+
+    _replayStats.numCameras += _cameras.size();
+    _replayStats.cameraBufferSize += cameraBufferSize;
+    _replayStats.objectBufferSize += objectBufferSize;
+    _replayStats.drawCallInfoBufferSize += drawCallInfoBufferSize;
+}
+
+void Backend::renderPassDraw(const Batch& batch) {
+    const size_t numCommands = batch.getCommands().size();
+    const Batch::Commands::value_type* command = batch.getCommands().data();
+    const Batch::CommandOffsets::value_type* offset = batch.getCommandOffsets().data();
+
+    for (size_t commandIndex = 0; commandIndex < numCommands; ++commandIndex) {
+        auto& commandStats = _commandsStats[*command];
+        commandStats.count++;
+        if (_profileCommands) {
+            auto start = std::chrono::high_resolution_clock::now();
+            executeCommand(batch, *command, *offset);
+            auto end = std::chrono::high_resolution_clock::now();
+            commandStats.nsecs += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        } else {
+            executeCommand(batch, *command, *offset);
+        }
+        command++;
+        offset++;
+    }
+}
+
+void Backend::updateCamera(const Vec2u& framebufferSize) {
+    if (_invalidViewport) {
+        _camera._viewport = glm::vec4(_viewport);
+    }
+    if (_invalidProj) {
+        _camera._projection = _projection;
+    }
+    if (_invalidView) {
+        _view.getInverseMatrix(_camera._view);
+    }
+
+    if (_invalidView || _invalidProj || _invalidViewport) {
+        Vec2 finalJitter = _projectionJitter / Vec2(framebufferSize);
+        if (_stereo.isStereo()) {
+            _cameras.push_back(_camera.getEyeCamera(0, _stereo, _view, finalJitter));
+            _cameras.push_back(_camera.getEyeCamera(1, _stereo, _view, finalJitter));
+        } else {
+            _cameras.push_back(_camera.getMonoCamera(_view, finalJitter));
+        }
+    }
+
+    _invalidView = _invalidProj = _invalidViewport = false;
+}
+
+void Backend::draw(uint32 numVertices, uint32 numInstances) {
+    uint32 trueNumInstances = _stereo.isStereo() ? 2 * numInstances : numInstances;
+    _stats._DSNumTriangles += (trueNumInstances * numVertices) / 3;
+    _stats._DSNumDrawcalls += trueNumInstances;
+    _stats._DSNumAPIDrawcalls++;
+}
+
+void Backend::executeCommand(const Batch& batch, Batch::Command command, size_t paramOffset) {
+    const auto& params = batch._params;
+    switch (command) {
+        case Batch::COMMAND_draw:
+        case Batch::COMMAND_drawIndexed:
+            draw(params[paramOffset + 1]._uint, 1);
+            break;
+
+        case Batch::COMMAND_drawInstanced:
+        case Batch::COMMAND_drawIndexedInstanced:
+            draw(params[paramOffset + 2]._uint, params[paramOffset + 4]._uint);
+            break;
+
+        case Batch::COMMAND_multiDrawIndirect:
+        case Batch::COMMAND_multiDrawIndexedIndirect:
+            _stats._DSNumDrawcalls += params[paramOffset]._uint;
+            _stats._DSNumAPIDrawcalls++;
+            break;
+
+        case Batch::COMMAND_setInputFormat: {
+            const auto& format = batch._streamFormats.get(params[paramOffset]._uint);
+            if (_format != format) {
+                _format = format;
+                _stats._ISNumFormatChanges++;
+            }
+            break;
+        }
+
+        case Batch::COMMAND_setInputBuffer: {
+            const auto& buffer = batch._buffers.get(params[paramOffset + 2]._uint);
+            uint32 channel = params[paramOffset + 3]._uint;
+            if (channel < MAX_NUM_SLOTS && _inputBuffers[channel] != buffer) {
+                _inputBuffers[channel] = buffer;
+                _stats._ISNumInputBufferChanges++;
+            }
+            break;
+        }
+
+        case Batch::COMMAND_setIndexBuffer: {
+            const auto& buffer = batch._buffers.get(params[paramOffset + 1]._uint);
+            if (_indexBuffer != buffer) {
+                _indexBuffer = buffer;
+                _stats._ISNumIndexBufferChanges++;
+            }
+            break;
+        }
+
+        case Batch::COMMAND_setIndirectBuffer:
+            _indirectBuffer = batch._buffers.get(params[paramOffset]._uint);
+            break;
+
+        case Batch::COMMAND_setViewTransform:
+            _view = batch._transforms.get(params[paramOffset]._uint);
+            _invalidView = true;
+            break;
+
+        case Batch::COMMAND_setProjectionTransform:
+            memcpy(&_projection, batch.readData(params[paramOffset]._uint), sizeof(Mat4));
+            _invalidProj = true;
+            break;
+
+        case Batch::COMMAND_setProjectionJitter:
+            _projectionJitter.x = params[paramOffset]._float;
+            _projectionJitter.y = params[paramOffset + 1]._float;
+            _invalidProj = true;
+            break;
+
+        case Batch::COMMAND_setViewportTransform:
+            memcpy(&_viewport, batch.readData(params[paramOffset]._uint), sizeof(Vec4i));
+            _invalidViewport = true;
+            break;
+
+        case Batch::COMMAND_setPipeline: {
+            const auto& pipeline = batch._pipelines.get(params[paramOffset]._uint);
+            if (_pipeline != pipeline) {
+                _pipeline = pipeline;
+                _stats._PSNumSetPipelines++;
+            }
+            break;
+        }
+
+        case Batch::COMMAND_setUniformBuffer: {
+            uint32 slot = params[paramOffset + 3]._uint;
+            if (slot < MAX_NUM_SLOTS) {
+                _uniformBuffers[slot] = batch._buffers.get(params[paramOffset + 2]._uint);
+            }
+            break;
+        }
+
+        case Batch::COMMAND_setResourceBuffer: {
+            uint32 slot = params[paramOffset + 1]._uint;
+            if (slot < MAX_NUM_SLOTS) {
+                const auto& buffer = batch._buffers.get(params[paramOffset]._uint);
+                if (_resourceBuffers[slot] != buffer) {
+                    _resourceBuffers[slot] = buffer;
+                    _stats._RSNumResourceBufferBounded++;
+                }
+            }
+            break;
+        }
+
+        case Batch::COMMAND_setResourceTexture: {
+            uint32 slot = params[paramOffset + 1]._uint;
+            if (slot < MAX_NUM_SLOTS) {
+                const auto& texture = batch._textures.get(params[paramOffset]._uint);
+                if (_resourceTextures[slot] != texture) {
+                    _resourceTextures[slot] = texture;
+                    if (texture) {
+                        _stats._RSNumTextureBounded++;
+                        _stats._RSAmountTextureMemoryBounded += texture->getSize();
+                    }
+                }
+            }
+            break;
+        }
+
+        case Batch::COMMAND_setResourceTextureTable: {
+            const auto& textureTable = batch._textureTables.get(params[paramOffset]._uint);
+            if (textureTable) {
+                _stats._RSNumTextureBounded++;
+            }
+            break;
+        }
+
+        case Batch::COMMAND_setFramebuffer:
+            _framebuffer = batch._framebuffers.get(params[paramOffset]._uint);
+            break;
+
+        case Batch::COMMAND_setFramebufferSwapChain: {
+            auto swapChain = std::static_pointer_cast<FramebufferSwapChain>(batch._swapChains.get(params[paramOffset]._uint));
+            if (swapChain) {
+                _framebuffer = swapChain->get(params[paramOffset + 1]._uint);
+            }
+            break;
+        }
+
+        case Batch::COMMAND_disableContextStereo:
+            _stereo._contextDisable = true;
+            break;
+
+        case Batch::COMMAND_restoreContextStereo:
+            _stereo._contextDisable = false;
+            break;
+
+        case Batch::COMMAND_runLambda: {
+            const auto& lambda = batch._lambdas.get(params[paramOffset]._uint);
+            if (lambda) {
+                lambda();
+            }
+            break;
+        }
+
+        case Batch::COMMAND_startNamedCall:
+            batch._currentNamedCall = batch._names.get(params[paramOffset]._uint);
+            break;
+
+        case Batch::COMMAND_stopNamedCall:
+            batch._currentNamedCall.clear();
+            break;
+
+        case Batch::COMMAND_resetStages:
+            _pipeline.reset();
+            _format.reset();
+            _indexBuffer.reset();
+            _indirectBuffer.reset();
+            _inputBuffers.fill(nullptr);
+            _uniformBuffers.fill(nullptr);
+            _resourceBuffers.fill(nullptr);
+            _resourceTextures.fill(nullptr);
+            _framebuffer.reset();
+            break;
+
+        default:
+            // the rest only translate into API calls
+            break;
+    }
+}
@@ -22,12 +22,18 @@
 
 namespace gpu { namespace null {
 
+// A backend without a graphics API behind it.
+//
+// Batches still go through the backend independent part of their execution, the way the GL backend does it: a transfer
+// pass resolving the camera of every draw and staging the transform buffers, then a draw pass resolving the parameters
+// of every command and tracking the bound state to fill the ContextStats.  Only the API calls are missing, which makes it
+// a measure of the CPU cost of executing a frame on machines without a GPU.
 class Backend : public gpu::Backend {
     using Parent = gpu::Backend;
     // Context Backend static interface required
     friend class gpu::Context;
     static void init() {}
-    static gpu::Backend* createBackend() { return new Backend(); }
+    static BackendPointer createBackend() { return BackendPointer(new Backend()); }
 
 protected:
     explicit Backend(bool syncCache) : Parent() { }
@@ -35,7 +41,28 @@ protected:
 public:
     ~Backend() { }
 
-    void render(const Batch& batch) final { }
+    // Executed commands per type, with the time spent in them when command profiling is enabled
+    class CommandStats {
+    public:
+        uint64_t count { 0 };
+        uint64_t nsecs { 0 };
+    };
+    using CommandsStats = std::array<CommandStats, Batch::NUM_COMMANDS>;
+
+    // Size of what was executed, the buffers in bytes
+    class ReplayStats {
+    public:
+        uint64_t numBatches { 0 };
+        uint64_t numCommands { 0 };
+        uint64_t numCameras { 0 };
+        uint64_t cameraBufferSize { 0 };
+        uint64_t objectBufferSize { 0 };
+        uint64_t drawCallInfoBufferSize { 0 };
+    };
+
+    const std::string& getVersion() const final;
+
+    void render(const Batch& batch) final;
 
     // This call synchronize the Full Backend cache with the current GLState
     // THis is only intended to be used when mixing raw gl calls with the gpu api usage in order to sync
@@ -45,9 +72,56 @@ public:
 
     void syncProgram(const gpu::ShaderPointer& program) final {}
 
+    void recycle() const final {}
+
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) final { }
+
+    bool supportedTextureFormat(const gpu::Element& format) final { return true; }
+    bool isTextureManagementSparseEnabled() const final { return false; }
+
+    // Timing every command has a cost of its own, so it is off by default
+    void enableCommandProfiling(bool enable) { _profileCommands = enable; }
+    const CommandsStats& getCommandsStats() const { return _commandsStats; }
+    const ReplayStats& getReplayStats() const { return _replayStats; }
+    void resetReplayStats();
+
+protected:
+    static const uint32_t MAX_NUM_SLOTS { 32 };
+
+    void renderPassTransfer(const Batch& batch);
+    void renderPassDraw(const Batch& batch);
+    void executeCommand(const Batch& batch, Batch::Command command, size_t paramOffset);
+    void updateCamera(const Vec2u& framebufferSize);
+    void draw(uint32 numVertices, uint32 numInstances);
+
+    bool _profileCommands { false };
+    CommandsStats _commandsStats;
+    ReplayStats _replayStats;
+
+    // Transform state, as in the transfer pass of the GL backend
+    Transform _view;
+    Mat4 _projection;
+    Vec4i _viewport;
+    Vec2 _projectionJitter;
+    bool _invalidView { false };
+    bool _invalidProj { false };
+    bool _invalidViewport { false };
+    TransformCamera _camera;
+    std::vector<TransformCamera> _cameras;
+    std::vector<uint8_t> _transformData; // staging copy of the object and draw call info buffers
+
+    // Bound state, as in the draw pass of the GL backend
+    PipelinePointer _pipeline;
+    Stream::FormatPointer _format;
+    std::array<BufferPointer, MAX_NUM_SLOTS> _inputBuffers;
+    BufferPointer _indexBuffer;
+    BufferPointer _indirectBuffer;
+    std::array<BufferPointer, MAX_NUM_SLOTS> _uniformBuffers;
+    std::array<BufferPointer, MAX_NUM_SLOTS> _resourceBuffers;
+    std::array<TexturePointer, MAX_NUM_SLOTS> _resourceTextures;
+    FramebufferPointer _framebuffer;
 };
 
 } }
@@ -19,10 +19,17 @@
 #include <QBuffer>
 #include <QImageReader>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <Finally.h>
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <TBBHelpers.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -46,6 +53,12 @@ bool DEV_DECIMATE_TEXTURES = false;
 std::atomic<size_t> DECIMATED_TEXTURE_COUNT{ 0 };
 std::atomic<size_t> RECTIFIED_TEXTURE_COUNT{ 0 };
 
+static std::atomic<uint32_t> PROCESSED_IMAGE_COUNT{ 0 };
+static std::atomic<uint64_t> CONVERT_USECS{ 0 };
+static std::atomic<uint64_t> MIP_USECS{ 0 };
+static std::atomic<uint64_t> COMPRESS_USECS{ 0 };
+static std::atomic<bool> PARALLEL_COMPRESSION{ true };
+
 // we use a ref here to work around static order initialization
 // possibly causing the element not to be constructed yet
 static const auto& GPU_CUBEMAP_DEFAULT_FORMAT = gpu::Element::COLOR_SRGBA_32;
@@ -53,6 +66,38 @@ static const auto& GPU_CUBEMAP_HDR_FORMAT = gpu::Element::COLOR_R11G11B10;
 
 namespace image {
 
+TextureProcessingTimings getTextureProcessingTimings() {
+    TextureProcessingTimings timings;
+    timings.numImages = PROCESSED_IMAGE_COUNT;
+    timings.convertUsecs = CONVERT_USECS;
+    timings.mipUsecs = MIP_USECS;
+    timings.compressUsecs = COMPRESS_USECS;
+    return timings;
+}
+
+void setParallelTextureCompression(bool enabled) {
+    PARALLEL_COMPRESSION = enabled;
+}
+
+bool isParallelTextureCompression() {
+    return PARALLEL_COMPRESSION;
+}
+
+// Adds the time since the last call (or construction) to a stage counter
+class StageTimer {
+public:
+    StageTimer() : _start(usecTimestampNow()) {}
+
+    void lap(std::atomic<uint64_t>& stageUsecs) {
+        auto now = usecTimestampNow();
+        stageUsecs += now - _start;
+        _start = now;
+    }
+
+private:
+    quint64 _start;
+};
+
 uint rectifyDimension(const uint& dimension) {
     if (dimension == 0) {
         return 0;
@@ -421,14 +466,36 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
 }
 
 #if defined(NVTT_API)
+// A thread keeps its scratch buffer between textures up to the size of the first mip of a 1024x1024 RGBA8 texture
+static const size_t MAX_KEPT_SCRATCH_SIZE = MB_TO_BYTES(4);
+
 struct OutputHandler : public nvtt::OutputHandler {
     OutputHandler(gpu::Texture* texture, int face) : _texture(texture), _face(face) {}
 
+    // the handler lives on the thread that calls compress, so this is the scratch buffer it wrote to
+    virtual ~OutputHandler() {
+        auto& scratch = getScratch();
+        if (scratch.capacity() > MAX_KEPT_SCRATCH_SIZE) {
+            std::vector<gpu::Byte>().swap(scratch);
+        }
+    }
+
+    // nvtt writes every mip from the thread that called compress, and assignStoredMip copies the bytes out, so
+    // one scratch buffer per thread serves every mip of the textures that thread processes
+    static std::vector<gpu::Byte>& getScratch() {
+        static thread_local std::vector<gpu::Byte> scratch;
+        return scratch;
+    }
+
     virtual void beginImage(int size, int width, int height, int depth, int face, int miplevel) override {
         _size = size;
         _miplevel = miplevel;
 
-        _data = static_cast<gpu::Byte*>(malloc(size));
+        auto& scratch = getScratch();
+        if (scratch.size() < (size_t)size) {
+            scratch.resize(size);
+        }
+        _data = scratch.data();
         _current = _data;
     }
 
@@ -445,7 +512,6 @@ struct OutputHandler : public nvtt::OutputHandler {
         } else {
             _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
         }
-        free(_data);
         _data = nullptr;
     }
 
@@ -501,23 +567,66 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
 };
 
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// Spreads the blocks of a compressed mip over the TBB worker pool.  nvtt collects the blocks in its own buffer and
+// hands them to the OutputHandler once every task is done, so only the calling thread touches the output.
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
-            if (!_abortProcessing.load()) {
+        if (!PARALLEL_COMPRESSION) {
+            for (int i = 0; i < count && !_abortProcessing.load(); i++) {
+                task(context, i);
+            }
+            return;
+        }
+        tbb::parallel_for(tbb::blocked_range<int>(0, count), [&](const tbb::blocked_range<int>& range) {
+            for (int i = range.begin(); i < range.end(); i++) {
+                if (_abortProcessing.load()) {
+                    break;
+                }
                 task(context, i);
-            } else {
-                break;
             }
+        });
+    }
+};
+
+// etc2comp starts threads of its own for every image it encodes, and images are processed on several threads at once.
+// So the encodes share one budget of as many threads as the machine has cores, instead of each starting one per core.
+class EncoderThreadBudget {
+public:
+    EncoderThreadBudget() : _numFree((int)std::max(std::thread::hardware_concurrency(), 1u)) {}
+
+    // waits for a free thread, then takes half of those free, so an image that starts meanwhile gets a share too
+    int acquire() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _freed.wait(lock, [this] { return _numFree > 0; });
+        int numThreads = (_numFree + 1) / 2;
+        _numFree -= numThreads;
+        return numThreads;
+    }
+
+    void release(int numThreads) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _numFree += numThreads;
         }
+        _freed.notify_all();
     }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _freed;
+    int _numFree;
 };
+
+static EncoderThreadBudget& getEncoderThreadBudget() {
+    static EncoderThreadBudget budget;
+    return budget;
+}
 #endif
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
@@ -599,6 +708,7 @@ nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture
 void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
     assert(image.hasFloatFormat());
 
+    StageTimer timer;
     Image localCopy = image.getConvertedToFormat(Image::Format_RGBAF);
 
     const int width = localCopy.getWidth();
@@ -622,15 +732,18 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     context.setTaskDispatcher(&dispatcher);
+    timer.lap(CONVERT_USECS);
 
     context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
+    timer.lap(COMPRESS_USECS);
     if (buildMips) {
         while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
             surface.buildNextMipmap(nvtt::MipmapFilter_Box);
+            timer.lap(MIP_USECS);
             context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
+            timer.lap(COMPRESS_USECS);
         }
     }
 }
@@ -643,6 +756,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     const int width = localCopy.getWidth(), height = localCopy.getHeight();
     auto mipFormat = texture->getStoredMipFormat();
     int mipLevel = baseMipLevel;
+    StageTimer timer;
 
     if (target != BackendTarget::GLES32) {
         if (localCopy.getFormat() != Image::Format_ARGB32) {
@@ -759,14 +873,19 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         MyErrorHandler errorHandler;
         outputOptions.setErrorHandler(&errorHandler);
 
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
+        ParallelTaskDispatcher dispatcher(abortProcessing);
+        nvtt::Context context;
+        context.setTaskDispatcher(&dispatcher);
+        timer.lap(CONVERT_USECS);
 
         context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
+        timer.lap(COMPRESS_USECS);
         if (buildMips) {
             while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
                 surface.buildNextMipmap(nvtt::MipmapFilter_Box);
+                timer.lap(MIP_USECS);
                 context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
+                timer.lap(COMPRESS_USECS);
             }
         }
     } else {
@@ -807,20 +926,32 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
         const float effort = 1.0f;
-        const int numEncodeThreads = 4;
         int encodingTime;
 
         if (localCopy.getFormat() != Image::Format_RGBAF) {
             localCopy = localCopy.getConvertedToFormat(Image::Format_RGBAF);
         }
-
-        Etc::EncodeMipmaps(
-            (float *)localCopy.editBits(), width, height,
-            etcFormat, errorMetric, effort,
-            numEncodeThreads, numEncodeThreads,
-            numMips, Etc::FILTER_WRAP_NONE,
-            mipMaps, &encodingTime
-        );
+        timer.lap(CONVERT_USECS);
+
+        {
+            auto& budget = getEncoderThreadBudget();
+            const bool parallel = PARALLEL_COMPRESSION;
+            const int numEncodeThreads = parallel ? budget.acquire() : 1;
+            Finally releaseThreads([&] {
+                if (parallel) {
+                    budget.release(numEncodeThreads);
+                }
+            });
+            Etc::EncodeMipmaps(
+                (float *)localCopy.editBits(), width, height,
+                etcFormat, errorMetric, effort,
+                numEncodeThreads, numEncodeThreads,
+                numMips, Etc::FILTER_WRAP_NONE,
+                mipMaps, &encodingTime
+            );
+        }
+        // etc2comp filters and encodes the mips in the same pass
+        timer.lap(COMPRESS_USECS);
 
         for (int i = 0; i < numMips; i++) {
             if (mipMaps[i].paucEncodingBits.get()) {
@@ -840,6 +971,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
 void convertImageToTexture(gpu::Texture* texture, Image& image, BackendTarget target, int face, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing) {
     PROFILE_RANGE(resource_parse, "convertToTextureWithMips");
+    ++PROCESSED_IMAGE_COUNT;
 
     if (target == BackendTarget::GLES32) {
         convertImageToLDRTexture(texture, std::move(image), target, baseMipLevel, buildMips, abortProcessing, face);
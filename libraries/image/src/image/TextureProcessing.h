@@ -28,6 +28,22 @@ namespace image {
     void convertToPackedFromFloat(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
                           const glm::vec4* source, size_t srcLinePixelStride);
 
+    // Time spent turning images into texture mips, summed over every image this process has converted (each face of a
+    // cube map counts as an image).  Compression is spread over the TBB pool, so these are wall times, not CPU times.
+    class TextureProcessingTimings {
+    public:
+        uint32_t numImages { 0 };
+        uint64_t convertUsecs { 0 }; // pixel format conversion and nvtt setup
+        uint64_t mipUsecs { 0 }; // mip downsampling
+        uint64_t compressUsecs { 0 }; // encoding to the stored mip format
+    };
+    TextureProcessingTimings getTextureProcessingTimings();
+
+    // On by default: the blocks of each mip are compressed on the TBB pool, or by a share of a process-wide budget of
+    // etc2comp encoder threads.  Off, each image is compressed on the thread that processes it.  The bytes are the same.
+    void setParallelTextureCompression(bool enabled);
+    bool isParallelTextureCompression();
+
 namespace TextureUsage {
 
 /**jsdoc
@@ -63,11 +63,11 @@ namespace baker {
             indexedTrianglesMeshOut.clear();
             indexedTrianglesMeshOut.resize(meshesIn.size());
 
-            for (size_t i = 0; i < meshesIn.size(); i++) {
+            parallelFor(meshesIn.size(), [&](size_t i) {
                 auto& mesh = meshesIn[i];
                 const auto verticesStd = mesh.vertices.toStdVector();
                 indexedTrianglesMeshOut[i] = hfm::generateTriangleListMesh(verticesStd, mesh.parts);
-            }
+            });
         }
     };
 
@@ -237,6 +237,8 @@ namespace baker {
         }
     };
 
+    const int Baker::VERSION = 1;
+
     Baker::Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL) :
         _engine(std::make_shared<Engine>(BakerEngineBuilder::JobModel::create("Baker"), std::make_shared<BakeContext>())) {
         _engine->feedInput<BakerEngineBuilder::Input>(0, hfmModel);
@@ -23,6 +23,10 @@
 namespace baker {
     class Baker {
     public:
+        // Increment whenever a change to the baker changes its output, so that models baked and cached by an older
+        // version are baked again
+        static const int VERSION;
+
         Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL);
 
         std::shared_ptr<TaskConfig> getConfiguration();
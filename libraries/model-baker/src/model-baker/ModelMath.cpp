@@ -117,5 +117,14 @@ namespace baker {
             }
         }
     }
-}
 
+    std::vector<std::pair<size_t, size_t>> getBlendshapeIndices(const BlendshapesPerMesh& blendshapesPerMesh) {
+        std::vector<std::pair<size_t, size_t>> blendshapeIndices;
+        for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+            for (size_t j = 0; j < blendshapesPerMesh[i].size(); j++) {
+                blendshapeIndices.emplace_back(i, j);
+            }
+        }
+        return blendshapeIndices;
+    }
+}
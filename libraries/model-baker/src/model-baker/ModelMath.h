@@ -10,6 +10,7 @@
 //
 
 #include <hfm/HFM.h>
+#include <TBBHelpers.h>
 
 #include "BakerTypes.h"
 
@@ -36,6 +37,20 @@ namespace baker {
         }
     }
 
+    // Calls body(i) for every i in [0, count) on the shared worker pool.  Each call must only write the outputs for its
+    // own index, so the result is the same as that of a serial loop.
+    template<typename F>
+    void parallelFor(size_t count, const F& body) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, count, 1), [&body](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                body(i);
+            }
+        });
+    }
+
+    // The (mesh index, blendshape index) of every blendshape of every mesh, to process them all in one parallelFor
+    std::vector<std::pair<size_t, size_t>> getBlendshapeIndices(const BlendshapesPerMesh& blendshapesPerMesh);
+
     // Returns a reference to the normal at the specified index, or nullptr if it cannot be accessed
     using NormalAccessor = std::function<glm::vec3*(int index)>;
 
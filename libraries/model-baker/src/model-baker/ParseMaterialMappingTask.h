@@ -20,6 +20,9 @@
 
 #include <procedural/ProceduralMaterialCache.h>
 
+// Parses the "materialMap" of an FST mapping, resolving material urls against url
+MaterialMapping parseMaterialMapping(const hifi::VariantHash& mapping, const hifi::URL& url);
+
 class ParseMaterialMappingTask {
 public:
     using Input = baker::VaryingSet2<hifi::VariantHash, hifi::URL>;
@@ -88,8 +88,9 @@ namespace std {
 class GeometryReader : public QRunnable {
 public:
     GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
-                   const QByteArray& data, bool combineParts, const QString& webMediaType) :
-        _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType) {
+                   const QByteArray& data, bool combineParts, const QString& webMediaType, const ProcessedModelCachePointer& processedModelCache) :
+        _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType),
+        _processedModelCache(processedModelCache) {
 
         DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
@@ -104,6 +105,7 @@ private:
     QByteArray _data;
     bool _combineParts;
     QString _webMediaType;
+    ProcessedModelCachePointer _processedModelCache;
 };
 
 void GeometryReader::run() {
@@ -144,6 +146,19 @@ void GeometryReader::run() {
         serializerMapping["combineParts"] = _combineParts;
         serializerMapping["deduplicateIndices"] = true;
 
+        // A model processed in an earlier session skips the serializer and the baker altogether
+        ProcessedModelCache::Key processedModelKey;
+        if (_processedModelCache) {
+            processedModelKey = ProcessedModelCache::computeKey(_data, _url, _webMediaType, serializerMapping);
+            auto processedHFMModel = _processedModelCache->load(processedModelKey);
+            if (processedHFMModel) {
+                auto materialMapping = parseMaterialMapping(_mapping.second, _mapping.first);
+                QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
+                        Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
+                return;
+            }
+        }
+
         if (_url.path().toLower().endsWith(".gz")) {
             QByteArray uncompressedData;
             if (!gunzip(_data, uncompressedData)) {
@@ -183,6 +198,11 @@ void GeometryReader::run() {
 
         QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
                 Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
+
+        // The model is immutable from here on, so it is written out after the resource has it
+        if (_processedModelCache) {
+            _processedModelCache->store(processedModelKey, *processedHFMModel);
+        }
     } catch (const std::exception&) {
         auto resource = _resource.toStrongRef();
         if (resource) {
@@ -271,6 +291,7 @@ void ModelResource::downloadFinished(const QByteArray& data) {
             _modelResource = modelCache->getResource(url, QUrl(), &extra, std::hash<GeometryExtra>()(extra)).staticCast<ModelResource>();
             // Avoid caching nested resources - their references will be held by the parent
             _modelResource->_isCacheable = false;
+            _modelResource->setLoadPriorities(_loadPriorities);
 
             if (_modelResource->isLoaded()) {
                 onGeometryMappingLoaded(!_modelResource->getURL().isEmpty());
@@ -287,7 +308,9 @@ void ModelResource::downloadFinished(const QByteArray& data) {
             _url = _effectiveBaseURL;
             _textureBaseURL = _effectiveBaseURL;
         }
-        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+        auto processedModelCache = DependencyManager::get<ModelCache>()->getProcessedModelCache();
+        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts,
+            _request->getWebMediaType(), processedModelCache));
     }
 }
 
@@ -308,6 +331,13 @@ void ModelResource::onGeometryMappingLoaded(bool success) {
     finishedLoading(success);
 }
 
+void ModelResource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    Resource::setLoadPriority(owner, priority);
+    if (_modelResource) {
+        _modelResource->setLoadPriority(owner, priority);
+    }
+}
+
 void ModelResource::setExtra(void* extra) {
     const GeometryExtra* geometryExtra = static_cast<const GeometryExtra*>(extra);
     _mappingPair = geometryExtra ? geometryExtra->mapping : GeometryMappingPair(QUrl(), QVariantHash());
@@ -525,6 +555,12 @@ void ModelResourceWatcher::setResource(ModelResource::Pointer resource) {
     }
 }
 
+void ModelResourceWatcher::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    if (_resource && !_resource->isLoaded()) {
+        _resource->setLoadPriority(owner, priority);
+    }
+}
+
 void ModelResourceWatcher::resourceFinished(bool success) {
     if (success) {
         _networkModelRef = std::make_shared<NetworkModel>(*_resource);
@@ -21,6 +21,7 @@
 #include <procedural/ProceduralMaterialCache.h>
 #include <material-networking/TextureCache.h>
 #include "ModelLoader.h"
+#include "ProcessedModelCache.h"
 
 using GeometryMappingPair = std::pair<QUrl, QVariantHash>;
 Q_DECLARE_METATYPE(GeometryMappingPair)
@@ -87,6 +88,9 @@ public:
     virtual void downloadFinished(const QByteArray& data) override;
     void setExtra(void* extra) override;
 
+    // An FST loads its model through a nested resource, which has to follow the FST's priority
+    void setLoadPriority(const QPointer<QObject>& owner, float priority) override;
+
     virtual bool areTexturesLoaded() const override { return isLoaded() && NetworkModel::areTexturesLoaded(); }
 
 private slots:
@@ -128,6 +132,7 @@ public:
     void setResource(ModelResource::Pointer resource);
 
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
+    void setLoadPriority(const QPointer<QObject>& owner, float priority);
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
 
@@ -164,6 +169,10 @@ public:
                                                                  GeometryMappingPair(QUrl(), QVariantHash()),
                                                            const QUrl& textureBaseUrl = QUrl());
 
+    // Set before any model loads: GeometryReaders read it without locking
+    void setProcessedModelCache(const ProcessedModelCachePointer& processedModelCache) { _processedModelCache = processedModelCache; }
+    const ProcessedModelCachePointer& getProcessedModelCache() const { return _processedModelCache; }
+
 protected:
     friend class ModelResource;
 
@@ -174,6 +183,7 @@ private:
     ModelCache();
     virtual ~ModelCache() = default;
     ModelLoader _modelLoader;
+    ProcessedModelCachePointer _processedModelCache;
 };
 
 #endif // hifi_ModelCache_h
@@ -14,3 +14,18 @@
 ModelCacheScriptingInterface::ModelCacheScriptingInterface() :
     ScriptableResourceCache::ScriptableResourceCache(DependencyManager::get<ModelCache>())
 { }
+
+uint ModelCacheScriptingInterface::getNumProcessedHits() const {
+    auto processedModelCache = DependencyManager::get<ModelCache>()->getProcessedModelCache();
+    return processedModelCache ? processedModelCache->getNumHits() : 0;
+}
+
+uint ModelCacheScriptingInterface::getNumProcessedMisses() const {
+    auto processedModelCache = DependencyManager::get<ModelCache>()->getProcessedModelCache();
+    return processedModelCache ? processedModelCache->getNumMisses() : 0;
+}
+
+uint ModelCacheScriptingInterface::getNumProcessedWrites() const {
+    auto processedModelCache = DependencyManager::get<ModelCache>()->getProcessedModelCache();
+    return processedModelCache ? processedModelCache->getNumWrites() : 0;
+}
@@ -24,6 +24,10 @@ class ModelCacheScriptingInterface : public ScriptableResourceCache, public Depe
 
     // Properties are copied over from ResourceCache (see ResourceCache.h for reason).
 
+    Q_PROPERTY(uint numProcessedHits READ getNumProcessedHits NOTIFY dirty)
+    Q_PROPERTY(uint numProcessedMisses READ getNumProcessedMisses NOTIFY dirty)
+    Q_PROPERTY(uint numProcessedWrites READ getNumProcessedWrites NOTIFY dirty)
+
     /**jsdoc
      * The <code>ModelCache</code> API manages model cache resources.
      *
@@ -41,6 +45,13 @@ class ModelCacheScriptingInterface : public ScriptableResourceCache, public Depe
      *     <em>Read-only.</em>
      * @property {number} numGlobalQueriesLoading - Total number of global queries loading (across all resource cache managers).
      *     <em>Read-only.</em>
+     * @property {number} numGlobalBytesReceived - Total number of bytes downloaded (across all resource cache managers).
+     *     <em>Read-only.</em>
+     * @property {number} numProcessedHits - Number of models loaded from the on-disk cache of processed models, skipping
+     *     their parsing and processing. <em>Read-only.</em>
+     * @property {number} numProcessedMisses - Number of models that had to be parsed and processed because the on-disk cache
+     *     of processed models did not have them. <em>Read-only.</em>
+     * @property {number} numProcessedWrites - Number of processed models written to the on-disk cache. <em>Read-only.</em>
      *
      * @borrows ResourceCache.getResourceList as getResourceList
      * @borrows ResourceCache.updateTotalSize as updateTotalSize
@@ -50,6 +61,11 @@ class ModelCacheScriptingInterface : public ScriptableResourceCache, public Depe
 
 public:
     ModelCacheScriptingInterface();
+
+private:
+    uint getNumProcessedHits() const;
+    uint getNumProcessedMisses() const;
+    uint getNumProcessedWrites() const;
 };
 
 #endif // hifi_ModelCacheScriptingInterface_h
@@ -0,0 +1,1018 @@
+//
+//  ProcessedModelCache.cpp
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProcessedModelCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+
+#include <Finally.h>
+#include <NumericalConstants.h>
+#include <SettingHandle.h>
+#include <model-baker/Baker.h>
+
+#include "ModelNetworkingLogging.h"
+
+using File = cache::File;
+
+const int ProcessedModelCache::CURRENT_VERSION = 0x01;
+const int ProcessedModelCache::INVALID_VERSION = 0x00;
+const char* ProcessedModelCache::SETTING_VERSION_NAME = "hifi.processedModels.cache_version";
+const size_t ProcessedModelCache::DEFAULT_MAX_SIZE { GB_TO_BYTES(2) };
+
+static const char* PROCESSED_MODEL_CACHE_EXTENSION = "hfm";
+static const uint32_t ENTRY_MAGIC = 0x4d464848; // "HHFM"
+
+// the payload is written in host byte order: the cache never leaves the machine that wrote it
+class EntryHeader {
+public:
+    uint32_t magic { ENTRY_MAGIC };
+    uint32_t version { (uint32_t)ProcessedModelCache::CURRENT_VERSION };
+    uint32_t bakerVersion { (uint32_t)baker::Baker::VERSION };
+    uint32_t padding { 0 };
+    uint64_t payloadSize { 0 };
+};
+
+class EntryWriter {
+public:
+    template<class T>
+    void write(const T& value) {
+        _data.append(reinterpret_cast<const char*>(&value), (int)sizeof(T));
+    }
+
+    // a count followed by the elements
+    template<class T>
+    void writeArray(const T* values, size_t count) {
+        write((uint32_t)count);
+        _data.append(reinterpret_cast<const char*>(values), (int)(count * sizeof(T)));
+    }
+
+    template<class C>
+    void writeVector(const C& values) { writeArray(values.data(), (size_t)values.size()); }
+
+    void writeBytes(const QByteArray& bytes) { writeArray(bytes.constData(), (size_t)bytes.size()); }
+    void writeString(const QString& string) { writeBytes(string.toUtf8()); }
+    void writeString(const std::string& string) { writeArray(string.data(), string.size()); }
+
+    void writeVariant(const QVariant& variant) {
+        QByteArray bytes;
+        QDataStream stream(&bytes, QIODevice::WriteOnly);
+        stream << variant;
+        writeBytes(bytes);
+    }
+
+    QByteArray& getData() { return _data; }
+
+private:
+    QByteArray _data;
+};
+
+// Reads an entry straight out of the mapped file.  A truncated or corrupt entry throws a QString.
+class EntryReader {
+public:
+    EntryReader(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    bool atEnd() const { return _position == _size; }
+
+    template<class T>
+    T read() {
+        T value;
+        require(sizeof(T));
+        memcpy(&value, _data + _position, sizeof(T));
+        _position += sizeof(T);
+        return value;
+    }
+
+    template<class T>
+    void read(T& value) { value = read<T>(); }
+
+    /// \return the count of a list whose elements take at least minElementSize bytes each, once the entry is known to
+    /// be large enough to hold them, so a corrupt count can't make the reader allocate more than the entry holds
+    uint32_t readCount(size_t minElementSize) {
+        uint32_t count = read<uint32_t>();
+        require((uint64_t)count * minElementSize);
+        return count;
+    }
+
+    /// \return the elements of an array written by EntryWriter::writeArray, in place in the entry
+    const uint8_t* readArray(size_t elementSize, uint32_t& count) {
+        count = read<uint32_t>();
+        uint64_t numBytes = (uint64_t)count * elementSize;
+        require(numBytes);
+        const uint8_t* values = _data + _position;
+        _position += numBytes;
+        return values;
+    }
+
+    template<class C>
+    void readVector(C& values) {
+        using T = typename C::value_type;
+        uint32_t count;
+        const uint8_t* source = readArray(sizeof(T), count);
+        values.resize(count);
+        if (count > 0) {
+            memcpy(values.data(), source, count * sizeof(T));
+        }
+    }
+
+    QByteArray readBytes() {
+        uint32_t size;
+        const uint8_t* bytes = readArray(1, size);
+        return QByteArray(reinterpret_cast<const char*>(bytes), (int)size);
+    }
+
+    QString readString() { return QString::fromUtf8(readBytes()); }
+
+    std::string readStdString() {
+        uint32_t size;
+        const uint8_t* bytes = readArray(1, size);
+        return std::string(reinterpret_cast<const char*>(bytes), size);
+    }
+
+    QVariant readVariant() {
+        QByteArray bytes = readBytes();
+        QDataStream stream(bytes);
+        QVariant variant;
+        stream >> variant;
+        if (stream.status() != QDataStream::Ok) {
+            throw QString("corrupt variant");
+        }
+        return variant;
+    }
+
+private:
+    void require(uint64_t numBytes) const {
+        if (numBytes > _size - _position) {
+            throw QString("unexpected end of entry");
+        }
+    }
+
+    const uint8_t* _data;
+    uint64_t _size;
+    uint64_t _position { 0 };
+};
+
+// Lower bounds on what the elements of each list take in an entry, for EntryReader::readCount
+static const size_t MIN_EXTENTS_SIZE = 2 * sizeof(glm::vec3);
+static const size_t MIN_TRANSFORM_SIZE = 2 * sizeof(glm::vec3) + sizeof(glm::quat);
+static const size_t MIN_ATTRIBUTE_SIZE = 2 * sizeof(gpu::Stream::Slot) + 3 * sizeof(uint8_t) + sizeof(uint64_t) +
+                                         sizeof(uint32_t);
+static const size_t MIN_VERTEX_BUFFER_SIZE = sizeof(uint32_t) + 2 * sizeof(uint64_t);
+static const size_t MIN_TEXTURE_SIZE = 5 * sizeof(uint32_t) + MIN_TRANSFORM_SIZE;
+static const size_t MIN_MATERIAL_SIZE = 11 * MIN_TEXTURE_SIZE;
+static const size_t MIN_PART_SIZE = 3 * sizeof(uint32_t);
+static const size_t MIN_BLENDSHAPE_SIZE = 4 * sizeof(uint32_t);
+static const size_t MIN_MESH_SIZE = 16 * sizeof(uint32_t) + MIN_EXTENTS_SIZE + sizeof(glm::mat4);
+static const size_t MIN_SHAPE_SIZE = 5 * sizeof(uint32_t) + MIN_EXTENTS_SIZE;
+static const size_t MIN_SKIN_DEFORMER_SIZE = sizeof(uint32_t);
+static const size_t MIN_CLUSTER_SIZE = sizeof(uint32_t) + sizeof(glm::mat4) + MIN_TRANSFORM_SIZE;
+static const size_t MIN_JOINT_SIZE = 7 * sizeof(glm::mat4);
+static const size_t MIN_STRING_SIZE = sizeof(uint32_t);
+static const size_t MIN_ANIMATION_FRAME_SIZE = 2 * sizeof(uint32_t);
+
+static void checkIndex(uint32_t index, size_t size, const char* what) {
+    if ((size_t)index >= size) {
+        throw QString("%1 index %2 out of range").arg(what).arg(index);
+    }
+}
+
+// for the references the baker leaves as hfm::UNDEFINED_KEY when there is nothing to point to
+static void checkOptionalIndex(uint32_t index, size_t size, const char* what) {
+    if (index != hfm::UNDEFINED_KEY) {
+        checkIndex(index, size, what);
+    }
+}
+
+static void writeExtents(EntryWriter& writer, const Extents& extents) {
+    writer.write(extents.minimum);
+    writer.write(extents.maximum);
+}
+
+static void readExtents(EntryReader& reader, Extents& extents) {
+    reader.read(extents.minimum);
+    reader.read(extents.maximum);
+}
+
+static void writeTransform(EntryWriter& writer, const Transform& transform) {
+    writer.write(transform.getTranslation());
+    writer.write(transform.getRotation());
+    writer.write(transform.getScale());
+}
+
+static void readTransform(EntryReader& reader, Transform& transform) {
+    // the setters restore the flags that let an identity transform skip its math
+    transform.setTranslation(reader.read<glm::vec3>());
+    transform.setRotation(reader.read<glm::quat>());
+    transform.setScale(reader.read<glm::vec3>());
+}
+
+static void writeElement(EntryWriter& writer, const gpu::Element& element) {
+    writer.write((uint8_t)element.getDimension());
+    writer.write((uint8_t)element.getType());
+    writer.write((uint8_t)element.getSemantic());
+}
+
+static gpu::Element readElement(EntryReader& reader) {
+    uint8_t dimension = reader.read<uint8_t>();
+    uint8_t type = reader.read<uint8_t>();
+    uint8_t semantic = reader.read<uint8_t>();
+    if (dimension >= gpu::NUM_DIMENSIONS || type >= gpu::NUM_TYPES || semantic >= gpu::NUM_SEMANTICS) {
+        throw QString("invalid gpu element");
+    }
+    return gpu::Element((gpu::Dimension)dimension, (gpu::Type)type, (gpu::Semantic)semantic);
+}
+
+static void writeBuffer(EntryWriter& writer, const gpu::BufferPointer& buffer) {
+    writer.writeArray(buffer->getData(), (size_t)buffer->getSize());
+}
+
+static gpu::BufferPointer readBuffer(EntryReader& reader) {
+    uint32_t size;
+    const uint8_t* data = reader.readArray(1, size);
+    auto buffer = std::make_shared<gpu::Buffer>();
+    buffer->setData(size, data);
+    return buffer;
+}
+
+static void writeBufferView(EntryWriter& writer, const gpu::BufferView& view) {
+    bool hasBuffer = (bool)view._buffer;
+    writer.write((uint8_t)hasBuffer);
+    if (hasBuffer) {
+        writeBuffer(writer, view._buffer);
+        writer.write((uint64_t)view._offset);
+        writer.write((uint64_t)view._size);
+        writer.write((uint16_t)view._stride);
+        writeElement(writer, view._element);
+    }
+}
+
+static gpu::BufferView readBufferView(EntryReader& reader, const gpu::Element& defaultElement) {
+    if (!reader.read<uint8_t>()) {
+        return gpu::BufferView(defaultElement);
+    }
+    auto buffer = readBuffer(reader);
+    uint64_t offset = reader.read<uint64_t>();
+    uint64_t size = reader.read<uint64_t>();
+    uint16_t stride = reader.read<uint16_t>();
+    gpu::Element element = readElement(reader);
+    if (offset > buffer->getSize() || size > buffer->getSize() - offset) {
+        throw QString("buffer view out of range");
+    }
+    return gpu::BufferView(buffer, offset, size, stride, element);
+}
+
+static void writeGraphicsMesh(EntryWriter& writer, const graphics::Mesh& mesh) {
+    const auto& vertexFormat = mesh.getVertexFormat();
+    writer.write((uint32_t)(vertexFormat ? vertexFormat->getAttributes().size() : 0));
+    if (vertexFormat) {
+        for (const auto& slotAndAttribute : vertexFormat->getAttributes()) {
+            const auto& attribute = slotAndAttribute.second;
+            writer.write(attribute._slot);
+            writer.write(attribute._channel);
+            writeElement(writer, attribute._element);
+            writer.write((uint64_t)attribute._offset);
+            writer.write(attribute._frequency);
+        }
+    }
+
+    const auto& vertexStream = mesh.getVertexStream();
+    writer.write((uint32_t)vertexStream.getBuffers().size());
+    for (size_t i = 0; i < vertexStream.getBuffers().size(); ++i) {
+        writeBuffer(writer, vertexStream.getBuffers()[i]);
+        writer.write((uint64_t)vertexStream.getOffsets()[i]);
+        writer.write((uint64_t)vertexStream.getStrides()[i]);
+    }
+
+    writeBufferView(writer, mesh.getIndexBuffer());
+    writeBufferView(writer, mesh.getPartBuffer());
+    writer.writeString(mesh.displayName);
+    writer.writeString(mesh.modelName);
+}
+
+static graphics::MeshPointer readGraphicsMesh(EntryReader& reader) {
+    auto vertexFormat = std::make_shared<gpu::Stream::Format>();
+    uint32_t numAttributes = reader.readCount(MIN_ATTRIBUTE_SIZE);
+    for (uint32_t i = 0; i < numAttributes; ++i) {
+        auto slot = reader.read<gpu::Stream::Slot>();
+        auto channel = reader.read<gpu::Stream::Slot>();
+        auto element = readElement(reader);
+        auto offset = (gpu::Offset)reader.read<uint64_t>();
+        auto frequency = (gpu::Stream::Frequency)reader.read<uint32_t>();
+        vertexFormat->setAttribute(slot, channel, element, offset, frequency);
+    }
+
+    auto vertexStream = std::make_shared<gpu::BufferStream>();
+    uint32_t numBuffers = reader.readCount(MIN_VERTEX_BUFFER_SIZE);
+    for (uint32_t i = 0; i < numBuffers; ++i) {
+        auto buffer = readBuffer(reader);
+        auto offset = (gpu::Offset)reader.read<uint64_t>();
+        auto stride = (gpu::Offset)reader.read<uint64_t>();
+        vertexStream->addBuffer(buffer, offset, stride);
+    }
+    if (!vertexFormat->hasAttribute(gpu::Stream::POSITION) ||
+            vertexFormat->getAttribute(gpu::Stream::POSITION)._channel >= numBuffers) {
+        throw QString("mesh without positions");
+    }
+
+    auto mesh = std::make_shared<graphics::Mesh>();
+    mesh->setVertexFormatAndStream(vertexFormat, vertexStream);
+    mesh->setIndexBuffer(readBufferView(reader, mesh->getIndexBuffer()._element));
+    mesh->setPartBuffer(readBufferView(reader, mesh->getPartBuffer()._element));
+    mesh->displayName = reader.readStdString();
+    mesh->modelName = reader.readStdString();
+    return mesh;
+}
+
+static void writeGraphicsMaterial(EntryWriter& writer, const graphics::Material& material) {
+    writer.writeString(material.getName());
+    writer.writeString(material.getModel());
+    writer.write((uint64_t)material.getKey()._flags.to_ullong());
+    writer.write(material.getEmissive(false));
+    writer.write(material.getOpacity());
+    writer.write(material.getAlbedo(false));
+    writer.write(material.getRoughness());
+    writer.write(material.getMetallic());
+    writer.write(material.getScattering());
+    writer.write(material.getOpacityCutoff());
+    writer.write((uint8_t)material.getCullFaceMode());
+}
+
+static graphics::MaterialPointer readGraphicsMaterial(EntryReader& reader) {
+    auto material = std::make_shared<graphics::Material>();
+    material->setName(reader.readStdString());
+    material->setModel(reader.readStdString());
+    graphics::MaterialKey key { graphics::MaterialKey::Flags(reader.read<uint64_t>()) };
+
+    // The key has no setter, so it is rebuilt through the same setters the serializers call.  Those derive most bits
+    // from the values; the others are replayed from the stored key.
+    material->setEmissive(reader.read<glm::vec3>(), false);
+    material->setOpacity(reader.read<float>());
+    glm::vec3 albedo = reader.read<glm::vec3>();
+    if (key.isAlbedo()) {
+        material->setAlbedo(albedo, false);
+    }
+    material->setRoughness(reader.read<float>());
+    material->setMetallic(reader.read<float>());
+    material->setScattering(reader.read<float>());
+    material->setOpacityCutoff(reader.read<float>());
+    material->setCullFaceMode((graphics::MaterialKey::CullFaceMode)reader.read<uint8_t>());
+    material->setUnlit(key.isUnlit());
+    if (key.isOpacityMapMode()) {
+        material->setOpacityMapMode(key.getOpacityMapMode());
+    }
+
+    if (material->getKey()._flags != key._flags) {
+        throw QString("material key could not be restored");
+    }
+    return material;
+}
+
+static void writeTexture(EntryWriter& writer, const hfm::Texture& texture) {
+    writer.writeString(texture.id);
+    writer.writeString(texture.name);
+    writer.writeBytes(texture.filename);
+    writer.writeBytes(texture.content);
+    writer.write((uint8_t)texture.sourceChannel);
+    writeTransform(writer, texture.transform);
+    writer.write((int32_t)texture.maxNumPixels);
+    writer.write((int32_t)texture.texcoordSet);
+    writer.writeString(texture.texcoordSetName);
+    writer.write(texture.isBumpmap);
+}
+
+static void readTexture(EntryReader& reader, hfm::Texture& texture) {
+    texture.id = reader.readString();
+    texture.name = reader.readString();
+    texture.filename = reader.readBytes();
+    texture.content = reader.readBytes();
+    texture.sourceChannel = (image::ColorChannel)reader.read<uint8_t>();
+    readTransform(reader, texture.transform);
+    texture.maxNumPixels = reader.read<int32_t>();
+    texture.texcoordSet = reader.read<int32_t>();
+    texture.texcoordSetName = reader.readString();
+    reader.read(texture.isBumpmap);
+}
+
+static void writeMaterial(EntryWriter& writer, const hfm::Material& material) {
+    writer.write(material.diffuseColor);
+    writer.write(material.diffuseFactor);
+    writer.write(material.specularColor);
+    writer.write(material.specularFactor);
+    writer.write(material.emissiveColor);
+    writer.write(material.emissiveFactor);
+    writer.write(material.shininess);
+    writer.write(material.opacity);
+    writer.write(material.metallic);
+    writer.write(material.roughness);
+    writer.write(material.emissiveIntensity);
+    writer.write(material.ambientFactor);
+    writer.write(material.bumpMultiplier);
+    writer.write((uint8_t)material.alphaMode);
+    writer.write(material.alphaCutoff);
+    writer.writeString(material.materialID);
+    writer.writeString(material.name);
+    writer.writeString(material.shadingModel);
+
+    writeTexture(writer, material.normalTexture);
+    writeTexture(writer, material.albedoTexture);
+    writeTexture(writer, material.opacityTexture);
+    writeTexture(writer, material.glossTexture);
+    writeTexture(writer, material.roughnessTexture);
+    writeTexture(writer, material.specularTexture);
+    writeTexture(writer, material.metallicTexture);
+    writeTexture(writer, material.emissiveTexture);
+    writeTexture(writer, material.occlusionTexture);
+    writeTexture(writer, material.scatteringTexture);
+    writeTexture(writer, material.lightmapTexture);
+    writer.write(material.lightmapParams);
+
+    writer.write(material.isPBSMaterial);
+    writer.write(material.useNormalMap);
+    writer.write(material.useAlbedoMap);
+    writer.write(material.useOpacityMap);
+    writer.write(material.useRoughnessMap);
+    writer.write(material.useSpecularMap);
+    writer.write(material.useMetallicMap);
+    writer.write(material.useEmissiveMap);
+    writer.write(material.useOcclusionMap);
+
+    writer.write((uint8_t)(bool)material._material);
+    if (material._material) {
+        writeGraphicsMaterial(writer, *material._material);
+    }
+}
+
+static void readMaterial(EntryReader& reader, hfm::Material& material) {
+    reader.read(material.diffuseColor);
+    reader.read(material.diffuseFactor);
+    reader.read(material.specularColor);
+    reader.read(material.specularFactor);
+    reader.read(material.emissiveColor);
+    reader.read(material.emissiveFactor);
+    reader.read(material.shininess);
+    reader.read(material.opacity);
+    reader.read(material.metallic);
+    reader.read(material.roughness);
+    reader.read(material.emissiveIntensity);
+    reader.read(material.ambientFactor);
+    reader.read(material.bumpMultiplier);
+    material.alphaMode = (graphics::MaterialKey::OpacityMapMode)reader.read<uint8_t>();
+    reader.read(material.alphaCutoff);
+    material.materialID = reader.readString();
+    material.name = reader.readString();
+    material.shadingModel = reader.readString();
+
+    readTexture(reader, material.normalTexture);
+    readTexture(reader, material.albedoTexture);
+    readTexture(reader, material.opacityTexture);
+    readTexture(reader, material.glossTexture);
+    readTexture(reader, material.roughnessTexture);
+    readTexture(reader, material.specularTexture);
+    readTexture(reader, material.metallicTexture);
+    readTexture(reader, material.emissiveTexture);
+    readTexture(reader, material.occlusionTexture);
+    readTexture(reader, material.scatteringTexture);
+    readTexture(reader, material.lightmapTexture);
+    reader.read(material.lightmapParams);
+
+    reader.read(material.isPBSMaterial);
+    reader.read(material.useNormalMap);
+    reader.read(material.useAlbedoMap);
+    reader.read(material.useOpacityMap);
+    reader.read(material.useRoughnessMap);
+    reader.read(material.useSpecularMap);
+    reader.read(material.useMetallicMap);
+    reader.read(material.useEmissiveMap);
+    reader.read(material.useOcclusionMap);
+
+    if (reader.read<uint8_t>()) {
+        material._material = readGraphicsMaterial(reader);
+    }
+}
+
+static void writeMesh(EntryWriter& writer, const hfm::Mesh& mesh) {
+    writer.write((uint32_t)mesh.parts.size());
+    for (const auto& part : mesh.parts) {
+        writer.writeVector(part.quadIndices);
+        writer.writeVector(part.quadTrianglesIndices);
+        writer.writeVector(part.triangleIndices);
+    }
+
+    writer.writeVector(mesh.vertices);
+    writer.writeVector(mesh.normals);
+    writer.writeVector(mesh.tangents);
+    writer.writeVector(mesh.colors);
+    writer.writeVector(mesh.texCoords);
+    writer.writeVector(mesh.texCoords1);
+    writeExtents(writer, mesh.meshExtents);
+    writer.write(mesh.modelTransform);
+
+    writer.writeVector(mesh.clusterIndices);
+    writer.writeVector(mesh.clusterWeights);
+    writer.write(mesh.clusterWeightsPerVertex);
+
+    writer.write((uint32_t)mesh.blendshapes.size());
+    for (const auto& blendshape : mesh.blendshapes) {
+        writer.writeVector(blendshape.indices);
+        writer.writeVector(blendshape.vertices);
+        writer.writeVector(blendshape.normals);
+        writer.writeVector(blendshape.tangents);
+    }
+
+    const auto& triangleListMesh = mesh.triangleListMesh;
+    writer.writeVector(triangleListMesh.vertices);
+    writer.writeVector(triangleListMesh.indices);
+    writer.writeVector(triangleListMesh.parts);
+    writer.write((uint32_t)triangleListMesh.partExtents.size());
+    for (const auto& extents : triangleListMesh.partExtents) {
+        writeExtents(writer, extents);
+    }
+
+    writer.writeVector(mesh.originalIndices);
+    writer.write((uint32_t)mesh.meshIndex);
+    writer.write(mesh.wasCompressed);
+
+    writer.write((uint8_t)(bool)mesh._mesh);
+    if (mesh._mesh) {
+        writeGraphicsMesh(writer, *mesh._mesh);
+    }
+}
+
+static void readMesh(EntryReader& reader, hfm::Mesh& mesh) {
+    mesh.parts.resize(reader.readCount(MIN_PART_SIZE));
+    for (auto& part : mesh.parts) {
+        reader.readVector(part.quadIndices);
+        reader.readVector(part.quadTrianglesIndices);
+        reader.readVector(part.triangleIndices);
+    }
+
+    reader.readVector(mesh.vertices);
+    reader.readVector(mesh.normals);
+    reader.readVector(mesh.tangents);
+    reader.readVector(mesh.colors);
+    reader.readVector(mesh.texCoords);
+    reader.readVector(mesh.texCoords1);
+    readExtents(reader, mesh.meshExtents);
+    reader.read(mesh.modelTransform);
+
+    reader.readVector(mesh.clusterIndices);
+    reader.readVector(mesh.clusterWeights);
+    reader.read(mesh.clusterWeightsPerVertex);
+
+    mesh.blendshapes.resize(reader.readCount(MIN_BLENDSHAPE_SIZE));
+    for (auto& blendshape : mesh.blendshapes) {
+        reader.readVector(blendshape.indices);
+        reader.readVector(blendshape.vertices);
+        reader.readVector(blendshape.normals);
+        reader.readVector(blendshape.tangents);
+    }
+
+    auto& triangleListMesh = mesh.triangleListMesh;
+    reader.readVector(triangleListMesh.vertices);
+    reader.readVector(triangleListMesh.indices);
+    reader.readVector(triangleListMesh.parts);
+    triangleListMesh.partExtents.resize(reader.readCount(MIN_EXTENTS_SIZE));
+    for (auto& extents : triangleListMesh.partExtents) {
+        readExtents(reader, extents);
+    }
+    for (auto index : triangleListMesh.indices) {
+        checkIndex(index, triangleListMesh.vertices.size(), "triangle list vertex");
+    }
+    for (const auto& part : triangleListMesh.parts) {
+        if (part.x < 0 || part.y < 0 || (size_t)part.x + (size_t)part.y > triangleListMesh.indices.size()) {
+            throw QString("triangle list part out of range");
+        }
+    }
+
+    reader.readVector(mesh.originalIndices);
+    mesh.meshIndex = reader.read<uint32_t>();
+    reader.read(mesh.wasCompressed);
+
+    if (reader.read<uint8_t>()) {
+        mesh._mesh = readGraphicsMesh(reader);
+    }
+}
+
+static void writeJoint(EntryWriter& writer, const hfm::Joint& joint) {
+    writer.write(joint.shapeInfo.avgPoint);
+    writer.writeVector(joint.shapeInfo.dots);
+    writer.writeVector(joint.shapeInfo.points);
+    writer.writeVector(joint.shapeInfo.debugLines);
+    writer.write((int32_t)joint.parentIndex);
+    writer.write(joint.distanceToParent);
+    writer.write(joint.translation);
+    writer.write(joint.preTransform);
+    writer.write(joint.preRotation);
+    writer.write(joint.rotation);
+    writer.write(joint.postRotation);
+    writer.write(joint.postTransform);
+    writer.write(joint.transform);
+    writer.write(joint.rotationMin);
+    writer.write(joint.rotationMax);
+    writer.write(joint.inverseDefaultRotation);
+    writer.write(joint.inverseBindRotation);
+    writer.write(joint.bindTransform);
+    writer.writeString(joint.name);
+    writer.write(joint.isSkeletonJoint);
+    writer.write(joint.bindTransformFoundInCluster);
+    writer.write(joint.geometricOffset);
+    writer.write(joint.localTransform);
+    writer.write(joint.globalTransform);
+}
+
+static void readJoint(EntryReader& reader, hfm::Joint& joint) {
+    reader.read(joint.shapeInfo.avgPoint);
+    reader.readVector(joint.shapeInfo.dots);
+    reader.readVector(joint.shapeInfo.points);
+    reader.readVector(joint.shapeInfo.debugLines);
+    joint.parentIndex = reader.read<int32_t>();
+    reader.read(joint.distanceToParent);
+    reader.read(joint.translation);
+    reader.read(joint.preTransform);
+    reader.read(joint.preRotation);
+    reader.read(joint.rotation);
+    reader.read(joint.postRotation);
+    reader.read(joint.postTransform);
+    reader.read(joint.transform);
+    reader.read(joint.rotationMin);
+    reader.read(joint.rotationMax);
+    reader.read(joint.inverseDefaultRotation);
+    reader.read(joint.inverseBindRotation);
+    reader.read(joint.bindTransform);
+    joint.name = reader.readString();
+    reader.read(joint.isSkeletonJoint);
+    reader.read(joint.bindTransformFoundInCluster);
+    reader.read(joint.geometricOffset);
+    reader.read(joint.localTransform);
+    reader.read(joint.globalTransform);
+}
+
+static void writeModel(EntryWriter& writer, const hfm::Model& model) {
+    writer.writeString(model.originalURL);
+    writer.writeString(model.author);
+    writer.writeString(model.applicationName);
+
+    writer.write((uint32_t)model.shapes.size());
+    for (const auto& shape : model.shapes) {
+        writer.write(shape.mesh);
+        writer.write(shape.meshPart);
+        writer.write(shape.material);
+        writer.write(shape.joint);
+        writeExtents(writer, shape.transformedExtents);
+        writer.write(shape.skinDeformer);
+    }
+
+    writer.write((uint32_t)model.meshes.size());
+    for (const auto& mesh : model.meshes) {
+        writeMesh(writer, mesh);
+    }
+
+    writer.write((uint32_t)model.materials.size());
+    for (const auto& material : model.materials) {
+        writeMaterial(writer, material);
+    }
+
+    writer.write((uint32_t)model.skinDeformers.size());
+    for (const auto& skinDeformer : model.skinDeformers) {
+        writer.write((uint32_t)skinDeformer.clusters.size());
+        for (const auto& cluster : skinDeformer.clusters) {
+            writer.write(cluster.jointIndex);
+            writer.write(cluster.inverseBindMatrix);
+            writeTransform(writer, cluster.inverseBindTransform);
+        }
+    }
+
+    writer.write((uint32_t)model.joints.size());
+    for (const auto& joint : model.joints) {
+        writeJoint(writer, joint);
+    }
+    writer.write((uint32_t)model.jointIndices.size());
+    for (auto it = model.jointIndices.cbegin(); it != model.jointIndices.cend(); ++it) {
+        writer.writeString(it.key());
+        writer.write((int32_t)it.value());
+    }
+    writer.write(model.hasSkeletonJoints);
+
+    writer.write((uint32_t)model.scripts.size());
+    for (const auto& script : model.scripts) {
+        writer.writeString(script);
+    }
+
+    writer.write(model.offset);
+    writer.write(model.neckPivot);
+    writeExtents(writer, model.bindExtents);
+    writeExtents(writer, model.meshExtents);
+
+    writer.write((uint32_t)model.animationFrames.size());
+    for (const auto& frame : model.animationFrames) {
+        writer.writeVector(frame.rotations);
+        writer.writeVector(frame.translations);
+    }
+
+    writer.write((uint32_t)model.meshIndicesToModelNames.size());
+    for (auto it = model.meshIndicesToModelNames.cbegin(); it != model.meshIndicesToModelNames.cend(); ++it) {
+        writer.write((int32_t)it.key());
+        writer.writeString(it.value());
+    }
+
+    writer.write((uint32_t)model.blendshapeChannelNames.size());
+    for (const auto& name : model.blendshapeChannelNames) {
+        writer.writeString(name);
+    }
+
+    writer.write((uint32_t)model.jointRotationOffsets.size());
+    for (auto it = model.jointRotationOffsets.cbegin(); it != model.jointRotationOffsets.cend(); ++it) {
+        writer.write((int32_t)it.key());
+        writer.write(it.value());
+    }
+
+    writer.write((uint32_t)model.shapeVertices.size());
+    for (const auto& vertices : model.shapeVertices) {
+        writer.writeVector(vertices);
+    }
+
+    writer.writeVariant(model.flowData._physicsConfig);
+    writer.writeVariant(model.flowData._collisionsConfig);
+}
+
+static void readModel(EntryReader& reader, hfm::Model& model) {
+    model.originalURL = reader.readString();
+    model.author = reader.readString();
+    model.applicationName = reader.readString();
+
+    model.shapes.resize(reader.readCount(MIN_SHAPE_SIZE));
+    for (auto& shape : model.shapes) {
+        reader.read(shape.mesh);
+        reader.read(shape.meshPart);
+        reader.read(shape.material);
+        reader.read(shape.joint);
+        readExtents(reader, shape.transformedExtents);
+        reader.read(shape.skinDeformer);
+    }
+
+    model.meshes.resize(reader.readCount(MIN_MESH_SIZE));
+    for (auto& mesh : model.meshes) {
+        readMesh(reader, mesh);
+    }
+
+    model.materials.resize(reader.readCount(MIN_MATERIAL_SIZE));
+    for (auto& material : model.materials) {
+        readMaterial(reader, material);
+    }
+
+    model.skinDeformers.resize(reader.readCount(MIN_SKIN_DEFORMER_SIZE));
+    for (auto& skinDeformer : model.skinDeformers) {
+        skinDeformer.clusters.resize(reader.readCount(MIN_CLUSTER_SIZE));
+        for (auto& cluster : skinDeformer.clusters) {
+            reader.read(cluster.jointIndex);
+            reader.read(cluster.inverseBindMatrix);
+            readTransform(reader, cluster.inverseBindTransform);
+        }
+    }
+
+    model.joints.resize(reader.readCount(MIN_JOINT_SIZE));
+    for (auto& joint : model.joints) {
+        readJoint(reader, joint);
+    }
+    uint32_t numJointIndices = reader.readCount(MIN_STRING_SIZE + sizeof(int32_t));
+    for (uint32_t i = 0; i < numJointIndices; ++i) {
+        QString name = reader.readString();
+        model.jointIndices.insert(name, reader.read<int32_t>());
+    }
+    reader.read(model.hasSkeletonJoints);
+
+    uint32_t numScripts = reader.readCount(MIN_STRING_SIZE);
+    for (uint32_t i = 0; i < numScripts; ++i) {
+        model.scripts.push_back(reader.readString());
+    }
+
+    reader.read(model.offset);
+    reader.read(model.neckPivot);
+    readExtents(reader, model.bindExtents);
+    readExtents(reader, model.meshExtents);
+
+    model.animationFrames.resize(reader.readCount(MIN_ANIMATION_FRAME_SIZE));
+    for (auto& frame : model.animationFrames) {
+        reader.readVector(frame.rotations);
+        reader.readVector(frame.translations);
+    }
+
+    uint32_t numModelNames = reader.readCount(sizeof(int32_t) + MIN_STRING_SIZE);
+    for (uint32_t i = 0; i < numModelNames; ++i) {
+        int meshIndex = reader.read<int32_t>();
+        model.meshIndicesToModelNames.insert(meshIndex, reader.readString());
+    }
+
+    uint32_t numChannelNames = reader.readCount(MIN_STRING_SIZE);
+    for (uint32_t i = 0; i < numChannelNames; ++i) {
+        model.blendshapeChannelNames.push_back(reader.readString());
+    }
+
+    uint32_t numRotationOffsets = reader.readCount(sizeof(int32_t) + sizeof(glm::quat));
+    for (uint32_t i = 0; i < numRotationOffsets; ++i) {
+        int jointIndex = reader.read<int32_t>();
+        model.jointRotationOffsets.insert(jointIndex, reader.read<glm::quat>());
+    }
+
+    model.shapeVertices.resize(reader.readCount(sizeof(uint32_t)));
+    for (auto& vertices : model.shapeVertices) {
+        reader.readVector(vertices);
+    }
+
+    model.flowData._physicsConfig = reader.readVariant().toMap();
+    model.flowData._collisionsConfig = reader.readVariant().toMap();
+}
+
+// The indices into the other lists of the model are checked, so a corrupt entry is a miss rather than a model that reads
+// out of bounds once it is rendered or skinned.  jointIndices and meshIndicesToModelNames are only looked up by value, and
+// the serializers don't keep them in range, so they are left alone.
+static void checkModel(const hfm::Model& model) {
+    const size_t numJoints = model.joints.size();
+    for (const auto& shape : model.shapes) {
+        checkIndex(shape.mesh, model.meshes.size(), "shape mesh");
+        checkIndex(shape.meshPart, model.meshes[shape.mesh].parts.size(), "shape mesh part");
+        checkOptionalIndex(shape.material, model.materials.size(), "shape material");
+        checkOptionalIndex(shape.joint, numJoints, "shape joint");
+        checkOptionalIndex(shape.skinDeformer, model.skinDeformers.size(), "shape skin deformer");
+    }
+    for (const auto& skinDeformer : model.skinDeformers) {
+        for (const auto& cluster : skinDeformer.clusters) {
+            if (cluster.jointIndex != hfm::Cluster::INVALID_JOINT_INDEX) {
+                checkIndex(cluster.jointIndex, numJoints, "cluster joint");
+            }
+        }
+    }
+    for (const auto& joint : model.joints) {
+        if (joint.parentIndex != -1) {
+            checkIndex((uint32_t)joint.parentIndex, numJoints, "parent joint");
+        }
+    }
+    for (auto it = model.jointRotationOffsets.cbegin(); it != model.jointRotationOffsets.cend(); ++it) {
+        checkIndex((uint32_t)it.key(), numJoints, "rotation offset joint");
+    }
+}
+
+static void addBytes(QCryptographicHash& hash, const QByteArray& bytes) {
+    int size = bytes.size();
+    hash.addData(reinterpret_cast<const char*>(&size), (int)sizeof(size));
+    hash.addData(bytes);
+}
+
+// QHash iterates in a per-process order, so hashes and maps are hashed with their keys sorted
+static void addVariant(QCryptographicHash& hash, const QVariant& variant) {
+    int type = (int)variant.type();
+    hash.addData(reinterpret_cast<const char*>(&type), (int)sizeof(type));
+    switch (variant.type()) {
+        case QVariant::Hash: {
+            auto values = variant.toHash();
+            auto keys = values.uniqueKeys();
+            std::sort(keys.begin(), keys.end());
+            for (const auto& key : keys) {
+                addBytes(hash, key.toUtf8());
+                for (const auto& value : values.values(key)) {
+                    addVariant(hash, value);
+                }
+            }
+            break;
+        }
+        case QVariant::Map: {
+            auto values = variant.toMap();
+            for (const auto& key : values.uniqueKeys()) {
+                addBytes(hash, key.toUtf8());
+                for (const auto& value : values.values(key)) {
+                    addVariant(hash, value);
+                }
+            }
+            break;
+        }
+        case QVariant::List: {
+            for (const auto& value : variant.toList()) {
+                addVariant(hash, value);
+            }
+            break;
+        }
+        default: {
+            QByteArray bytes;
+            QDataStream stream(&bytes, QIODevice::WriteOnly);
+            stream << variant;
+            addBytes(hash, bytes);
+            break;
+        }
+    }
+}
+
+ProcessedModelCache::ProcessedModelCache(const std::string& dirname) :
+    FileCache(dirname, PROCESSED_MODEL_CACHE_EXTENSION)
+{
+    setMaxSize(DEFAULT_MAX_SIZE);
+}
+
+void ProcessedModelCache::initialize() {
+    FileCache::initialize();
+    Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, INVALID_VERSION);
+    auto cacheVersion = cacheVersionHandle.get();
+    if (cacheVersion != CURRENT_VERSION) {
+        wipe();
+        cacheVersionHandle.set(CURRENT_VERSION);
+    }
+}
+
+std::unique_ptr<File> ProcessedModelCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCDebug(modelnetworking) << "Wrote processed model" << metadata.key.c_str();
+    return FileCache::createFile(std::move(metadata), filepath);
+}
+
+ProcessedModelCache::Key ProcessedModelCache::computeKey(const hifi::ByteArray& data, const hifi::URL& url,
+        const QString& webMediaType, const hifi::VariantHash& serializerMapping) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const int versions[] = { CURRENT_VERSION, baker::Baker::VERSION };
+    hash.addData(reinterpret_cast<const char*>(versions), (int)sizeof(versions));
+    // the url matters as well as the bytes: serializers resolve texture paths and the baker names meshes with it
+    addBytes(hash, url.toEncoded());
+    addBytes(hash, webMediaType.toUtf8());
+    addVariant(hash, serializerMapping);
+    addBytes(hash, data);
+    return hash.result().toHex().toStdString();
+}
+
+hfm::Model::Pointer ProcessedModelCache::load(const Key& key) {
+    auto file = getFile(key);
+    if (!file) {
+        ++_numMisses;
+        return hfm::Model::Pointer();
+    }
+
+    try {
+        auto hfmModel = readEntry(file);
+        ++_numHits;
+        return hfmModel;
+    } catch (const QString& error) {
+        // the caller bakes the model again and stores the result in its place
+        qCWarning(modelnetworking) << "Removing processed model" << key.c_str() << "--" << error;
+        removeFile(file);
+        ++_numMisses;
+        return hfm::Model::Pointer();
+    }
+}
+
+hfm::Model::Pointer ProcessedModelCache::readEntry(const cache::FilePointer& file) {
+    // the file stays out of eviction for as long as it is mapped
+    QFile qFile(QString::fromStdString(file->getFilepath()));
+    if (!qFile.open(QIODevice::ReadOnly)) {
+        throw QString("could not open the entry");
+    }
+    size_t size = (size_t)qFile.size();
+    if (size < sizeof(EntryHeader)) {
+        throw QString("entry too short");
+    }
+    uchar* data = qFile.map(0, size);
+    if (!data) {
+        throw QString("could not map the entry");
+    }
+    Finally unmap([&] {
+        qFile.unmap(data);
+    });
+
+    EntryHeader header;
+    memcpy(&header, data, sizeof(EntryHeader));
+    if (header.magic != ENTRY_MAGIC || header.version != (uint32_t)CURRENT_VERSION ||
+            header.bakerVersion != (uint32_t)baker::Baker::VERSION || header.payloadSize != size - sizeof(EntryHeader)) {
+        throw QString("invalid header");
+    }
+
+    EntryReader reader(data + sizeof(EntryHeader), (size_t)header.payloadSize);
+    auto hfmModel = std::make_shared<hfm::Model>();
+    readModel(reader, *hfmModel);
+    if (!reader.atEnd()) {
+        throw QString("unexpected data after the model");
+    }
+    checkModel(*hfmModel);
+    return hfmModel;
+}
+
+void ProcessedModelCache::store(const Key& key, const hfm::Model& hfmModel) {
+    EntryWriter writer;
+    writer.write(EntryHeader());
+    writeModel(writer, hfmModel);
+
+    QByteArray& data = writer.getData();
+    EntryHeader header;
+    header.payloadSize = (uint64_t)(data.size() - sizeof(EntryHeader));
+    memcpy(data.data(), &header, sizeof(EntryHeader));
+
+    // overwrite: an entry left by a failed or older write is stale
+    if (writeFile(data.constData(), Metadata(key, (size_t)data.size()), true)) {
+        ++_numWrites;
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  ProcessedModelCache.h
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ProcessedModelCache_h
+#define hifi_ProcessedModelCache_h
+
+#include <atomic>
+#include <memory>
+
+#include <shared/FileCache.h>
+#include <shared/HifiTypes.h>
+#include <hfm/HFM.h>
+
+// The ProcessedModelCache keeps models on disk after the serializer and the model baker have run on them, so loading a
+// model the client has seen before skips both.
+//
+// An entry holds the baked hfm::Model, including the vertex, index and part buffers of its graphics meshes, in a flat
+// binary layout that is read straight out of the mapped file.  Entries are content addressed: the key hashes the source
+// bytes, the url and media type they were read with, the serializer mapping and baker::Baker::VERSION, so an edited
+// model, a different FST or a newer baker is a miss rather than a stale hit.  The cache is safe to use from the
+// GeometryReader threads.
+
+class ProcessedModelCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format that isn't backward compatible,
+    // this value should be incremented.  This will force the cache to be wiped
+    static const int CURRENT_VERSION;
+    static const int INVALID_VERSION;
+    static const char* SETTING_VERSION_NAME;
+    static const size_t DEFAULT_MAX_SIZE;
+
+    ProcessedModelCache(const std::string& dirname = "processed_models");
+
+    void initialize() override;
+
+    static Key computeKey(const hifi::ByteArray& data, const hifi::URL& url, const QString& webMediaType,
+                          const hifi::VariantHash& serializerMapping);
+
+    /// \return the model stored under key, or nullptr on a miss.  An entry that can't be read back is removed.
+    hfm::Model::Pointer load(const Key& key);
+    void store(const Key& key, const hfm::Model& hfmModel);
+
+    uint32_t getNumHits() const { return _numHits; }
+    uint32_t getNumMisses() const { return _numMisses; }
+    uint32_t getNumWrites() const { return _numWrites; }
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+
+private:
+    // throws a QString when the entry is truncated or inconsistent
+    hfm::Model::Pointer readEntry(const cache::FilePointer& file);
+
+    std::atomic<uint32_t> _numHits { 0 };
+    std::atomic<uint32_t> _numMisses { 0 };
+    std::atomic<uint32_t> _numWrites { 0 };
+};
+
+using ProcessedModelCachePointer = std::shared_ptr<ProcessedModelCache>;
+
+#endif // hifi_ProcessedModelCache_h
@@ -25,13 +25,43 @@
 #include <Profile.h>
 
 #include "NetworkAccessManager.h"
+#include "NetworkingConstants.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+static int defaultPort(const QString& scheme) {
+    if (scheme == HIFI_URL_SCHEME_HTTP) {
+        return 80;
+    } else if (scheme == HIFI_URL_SCHEME_HTTPS) {
+        return 443;
+    } else if (scheme == HIFI_URL_SCHEME_FTP) {
+        return 21;
+    }
+    return -1;
+}
+
+QString ResourceCacheSharedItems::getOrigin(const QUrl& url) {
+    auto scheme = url.scheme();
+    if (scheme.isEmpty() || scheme == HIFI_URL_SCHEME_FILE || scheme == URL_SCHEME_QRC) {
+        return QString();
+    }
+    // http://host/ and http://host:80/ are the same origin
+    return scheme + "://" + url.host() + ":" + QString::number(url.port(defaultPort(scheme)));
+}
+
+bool ResourceCacheSharedItems::isOriginFull(const QString& origin) const {
+    return !origin.isEmpty() && _loadingRequestsPerOrigin.value(origin) >= _originRequestLimit;
+}
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
-        _loadingRequests.append(resource);
+    auto locked = resource.lock();
+    QString origin = locked ? getOrigin(locked->getURL()) : QString();
+    if ((uint32_t)_loadingRequests.size() < _requestLimit && !isOriginFull(origin)) {
+        _loadingRequests.append({ resource, origin });
+        if (!origin.isEmpty()) {
+            ++_loadingRequestsPerOrigin[origin];
+        }
         return true;
     } else {
         _pendingRequests.append(resource);
@@ -49,6 +79,16 @@ uint32_t ResourceCacheSharedItems::getRequestLimit() const {
     return _requestLimit;
 }
 
+void ResourceCacheSharedItems::setOriginRequestLimit(uint32_t limit) {
+    Lock lock(_mutex);
+    _originRequestLimit = limit;
+}
+
+uint32_t ResourceCacheSharedItems::getOriginRequestLimit() const {
+    Lock lock(_mutex);
+    return _originRequestLimit;
+}
+
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
@@ -72,8 +112,8 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() c
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
-        auto locked = resource.lock();
+    foreach(const LoadingRequest& request, _loadingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -87,6 +127,11 @@ uint32_t ResourceCacheSharedItems::getLoadingRequestsCount() const {
     return _loadingRequests.size();
 }
 
+uint32_t ResourceCacheSharedItems::getLoadingRequestsCount(const QString& origin) const {
+    Lock lock(_mutex);
+    return _loadingRequestsPerOrigin.value(origin);
+}
+
 void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
 
@@ -94,9 +139,12 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        const auto& request = _loadingRequests.at(i);
         // Clear our resource and any freed resources
-        if (!request || request.data() == resource.data()) {
+        if (!request.resource || request.resource.data() == resource.data()) {
+            if (!request.origin.isEmpty() && --_loadingRequestsPerOrigin[request.origin] == 0) {
+                _loadingRequestsPerOrigin.remove(request.origin);
+            }
             _loadingRequests.removeAt(i);
             continue;
         }
@@ -105,7 +153,8 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
 }
 
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
+    // look for the highest priority pending request whose origin has a free slot.  Priorities are read here, when a slot
+    // opens, so owners that update them every frame (see Model::setLoadingPriority) reorder the queue as the user moves.
     int highestIndex = -1;
     float highestPriority = -FLT_MAX;
     QSharedPointer<Resource> highestResource;
@@ -121,6 +170,11 @@ QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
             continue;
         }
 
+        if (isOriginFull(getOrigin(resource->getURL()))) {
+            i++;
+            continue;
+        }
+
         // Check load priority
         float priority = resource->getLoadPriority();
         bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
@@ -144,6 +198,7 @@ void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
     _pendingRequests.clear();
     _loadingRequests.clear();
+    _loadingRequestsPerOrigin.clear();
 }
 
 ScriptableResourceCache::ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache) {
@@ -345,7 +400,21 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
 
     // Now go fill any new request spots
     while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
+    }
+}
+
+void ResourceCache::setOriginRequestLimit(uint32_t limit) {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->setOriginRequestLimit(limit);
+
+    // A higher limit may unblock pending requests
+    while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -545,9 +614,11 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
 
     sharedItems->removeRequest(resource);
 
-    // Now go fill any new request spots
+    // Now go fill any new request spots.  Stop when every pending request is waiting on a full origin.
     while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -771,6 +842,9 @@ void Resource::makeRequest() {
 }
 
 void Resource::handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTotal) {
+    if ((qint64)bytesReceived > _bytesReceived) {
+        DependencyManager::get<ResourceCacheSharedItems>()->addBytesReceived(bytesReceived - _bytesReceived);
+    }
     _bytesReceived = bytesReceived;
     _bytesTotal = bytesTotal;
 }
@@ -70,21 +70,42 @@ public:
     void removeRequest(QWeakPointer<Resource> doneRequest);
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
+    void setOriginRequestLimit(uint32_t limit);
+    uint32_t getOriginRequestLimit() const;
     QList<QSharedPointer<Resource>> getPendingRequests() const;
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests() const;
     uint32_t getLoadingRequestsCount() const;
+    uint32_t getLoadingRequestsCount(const QString& origin) const;
     void clear();
 
+    void addBytesReceived(quint64 bytes) { _bytesReceived += bytes; }
+    quint64 getBytesReceived() const { return _bytesReceived; }
+
+    /// Requests to the same origin share a cap, so one slow host can't hold every download slot.  Local files have no origin.
+    static QString getOrigin(const QUrl& url);
+
 private:
     ResourceCacheSharedItems() = default;
 
+    class LoadingRequest {
+    public:
+        QWeakPointer<Resource> resource;
+        QString origin; // kept so the slot can be released after the resource is gone
+    };
+
+    bool isOriginFull(const QString& origin) const;
+
     mutable Mutex _mutex;
     QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    QList<LoadingRequest> _loadingRequests;
+    QHash<QString, uint32_t> _loadingRequestsPerOrigin;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
+    const uint32_t DEFAULT_ORIGIN_REQUEST_LIMIT = 12;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+    uint32_t _originRequestLimit { DEFAULT_ORIGIN_REQUEST_LIMIT };
+    std::atomic<quint64> _bytesReceived { 0 };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -211,6 +232,9 @@ public:
 
     static void setRequestLimit(uint32_t limit);
     static uint32_t getRequestLimit() { return DependencyManager::get<ResourceCacheSharedItems>()->getRequestLimit(); }
+
+    static void setOriginRequestLimit(uint32_t limit);
+    static uint32_t getOriginRequestLimit() { return DependencyManager::get<ResourceCacheSharedItems>()->getOriginRequestLimit(); }
     
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
     qint64 getUnusedResourceCacheSize() const { return _unusedResourcesMaxSize; }
@@ -218,6 +242,7 @@ public:
     static QList<QSharedPointer<Resource>> getLoadingRequests();
     static uint32_t getPendingRequestCount();
     static uint32_t getLoadingRequestCount();
+    static quint64 getBytesReceived() { return DependencyManager::get<ResourceCacheSharedItems>()->getBytesReceived(); }
 
     ResourceCache(QObject* parent = nullptr);
     virtual ~ResourceCache();
@@ -322,9 +347,12 @@ class ScriptableResourceCache : public QObject {
      *     <em>Read-only.</em>
      * @property {number} numGlobalQueriesLoading - Total number of global queries loading (across all resource cache managers).
      *     <em>Read-only.</em>
+     * @property {number} numGlobalBytesReceived - Total number of bytes downloaded (across all resource cache managers).
+     *     <em>Read-only.</em>
      */
     Q_PROPERTY(size_t numGlobalQueriesPending READ getNumGlobalQueriesPending NOTIFY dirty)
     Q_PROPERTY(size_t numGlobalQueriesLoading READ getNumGlobalQueriesLoading NOTIFY dirty)
+    Q_PROPERTY(quint64 numGlobalBytesReceived READ getNumGlobalBytesReceived NOTIFY dirty)
 
 public:
     ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache);
@@ -402,6 +430,7 @@ private:
 
     size_t getNumGlobalQueriesPending() const { return ResourceCache::getPendingRequestCount(); }
     size_t getNumGlobalQueriesLoading() const { return ResourceCache::getLoadingRequestCount(); }
+    quint64 getNumGlobalBytesReceived() const { return ResourceCache::getBytesReceived(); }
 };
 
 /// Base class for resources.
@@ -136,6 +136,7 @@ public:
         BulkAvatarTraitsAck,
         StopInjector,
         AvatarZonePresence,
+        EntityPhysicsBatch,
         NUM_PACKET_TYPE
     };
 
@@ -278,6 +279,7 @@ enum class EntityVersion : PacketVersion {
     TextEntityFonts,
     ScriptServerKinematicMotion,
     ScreenshareZone,
+    PhysicsStateBatch,
 
     // Add new versions above here
     NUM_PACKET_TYPE,
@@ -92,6 +92,27 @@ void Octree::recurseElementWithOperation(const OctreeElementPointer& element, co
     }
 }
 
+void Octree::recurseTreeWithOperationFlat(const RecurseOctreeOperation& operation, void* extraData) {
+    ConstOctreeElementStorePointer store = getElementStore();
+    store->traverse([&](OctreeElementStore::Handle handle) {
+        return operation(store->getElement(handle), extraData);
+    });
+}
+
+ConstOctreeElementStorePointer Octree::getElementStore() {
+    std::lock_guard<std::mutex> lock(_elementStoreMutex);
+    uint64_t generation = _structureGeneration;
+    bool rootChanged = !_elementStore || _elementStore->isEmpty() != !_rootElement ||
+        (_rootElement && _elementStore->getElement(_elementStore->getRoot()) != _rootElement);
+    if (rootChanged || _elementStore->isStale(generation)) {
+        // build into a fresh store so readers holding the previous snapshot are unaffected
+        auto store = std::make_shared<OctreeElementStore>();
+        store->rebuild(_rootElement, generation);
+        _elementStore = store;
+    }
+    return _elementStore;
+}
+
 void Octree::recurseTreeWithOperationSorted(const RecurseOctreeOperation& operation, const RecurseOctreeSortingOperation& sortingOperation, void* extraData) {
     recurseElementWithOperationSorted(_rootElement, operation, sortingOperation, extraData);
 }
@@ -405,6 +426,12 @@ void Octree::readBitstreamToTree(const unsigned char * bitstream, uint64_t buffe
 }
 
 void Octree::eraseAllOctreeElements(bool createNewRoot) {
+    {
+        // the flat store holds references to every element, drop it so the old tree can be freed
+        std::lock_guard<std::mutex> lock(_elementStoreMutex);
+        _elementStore.reset();
+    }
+
     if (createNewRoot) {
         _rootElement = createNewElement();
     } else {
@@ -12,7 +12,9 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <stdint.h>
 
@@ -26,6 +28,7 @@
 
 #include "OctreeElement.h"
 #include "OctreeElementBag.h"
+#include "OctreeElementStore.h"
 #include "OctreePacketData.h"
 #include "OctreeSceneStats.h"
 #include "OctreeUtils.h"
@@ -174,6 +177,18 @@ public:
 
     void recurseTreeWithOperator(RecurseOctreeOperator* operatorObject);
 
+    /// Same visiting order as recurseTreeWithOperation() but walks the flat element store instead of chasing child
+    /// pointers. The operation must not add or remove elements, use recurseTreeWithOperation() for that.
+    void recurseTreeWithOperationFlat(const RecurseOctreeOperation& operation, void* extraData = NULL);
+
+    /// Returns an up to date flat snapshot of the tree structure, rebuilding it if elements were added or removed
+    /// since the last call. Callers should hold at least a read lock on the tree.
+    ConstOctreeElementStorePointer getElementStore();
+
+    /// Bumped every time an element of this tree gains or loses a child, used to detect stale element stores
+    void bumpStructureGeneration() { _structureGeneration++; }
+    uint64_t getStructureGeneration() const { return _structureGeneration; }
+
     bool isDirty() const { return _isDirty; }
     void clearDirtyBit() { _isDirty = false; }
     void setDirtyBit() { _isDirty = true; }
@@ -274,6 +289,10 @@ protected:
 
     OctreeElementPointer _rootElement = nullptr;
 
+    std::mutex _elementStoreMutex;
+    ConstOctreeElementStorePointer _elementStore;
+    std::atomic<uint64_t> _structureGeneration { 0 };
+
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
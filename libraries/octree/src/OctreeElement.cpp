@@ -302,6 +302,11 @@ void OctreeElement::deleteAllChildren() {
 }
 
 void OctreeElement::setChildAtIndex(int childIndex, const OctreeElementPointer& child) {
+    Octree* tree = getOctree();
+    if (tree) {
+        tree->bumpStructureGeneration();
+    }
+
 #ifdef SIMPLE_CHILD_ARRAY
     int previousChildCount = getChildCount();
     if (child) {
@@ -50,6 +50,9 @@ protected:
 
     virtual OctreeElementPointer createNewElement(unsigned char * octalCode = NULL) = 0;
 
+    /// The tree this element belongs to, told when the element gains or loses a child
+    virtual Octree* getOctree() const = 0;
+
 public:
     virtual void init(unsigned char * octalCode); /// Your subclass must call init on construction.
     virtual ~OctreeElement();
@@ -0,0 +1,158 @@
+//
+//  OctreeElementStore.cpp
+//  libraries/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeElementStore.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <SharedUtil.h>
+
+const OctreeElementStore::Handle OctreeElementStore::INVALID_HANDLE = std::numeric_limits<uint32_t>::max();
+
+void OctreeElementStore::clear() {
+    _elements.clear();
+    _corners.clear();
+    _scales.clear();
+    _childMasks.clear();
+    _firstChildren.clear();
+    _structureGeneration = 0;
+}
+
+void OctreeElementStore::rebuild(const OctreeElementPointer& root, uint64_t generation) {
+    _elements.clear();
+    _corners.clear();
+    _scales.clear();
+    _childMasks.clear();
+    _firstChildren.clear();
+
+    if (!root) {
+        _structureGeneration = generation;
+        return;
+    }
+
+    _elements.push_back(root);
+
+    // breadth-first: each parent appends its children contiguously to the end of the pool
+    for (Handle handle = 0; handle < (Handle)_elements.size(); ++handle) {
+        // copy the pointer, push_back below may reallocate _elements
+        OctreeElementPointer element = _elements[handle];
+        const AACube& cube = element->getAACube();
+        _corners.push_back(cube.getCorner());
+        _scales.push_back(cube.getScale());
+
+        uint8_t childMask = 0;
+        Handle firstChild = (Handle)_elements.size();
+        for (int i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+            OctreeElementPointer child = element->getChildAtIndex(i);
+            if (child) {
+                childMask |= (uint8_t)(1 << i);
+                _elements.push_back(child);
+            }
+        }
+        _childMasks.push_back(childMask);
+        _firstChildren.push_back(childMask ? firstChild : INVALID_HANDLE);
+    }
+
+    _structureGeneration = generation;
+}
+
+OctreeElementStore::Handle OctreeElementStore::getChild(Handle handle, int childIndex) const {
+    uint8_t childMask = _childMasks[handle];
+    uint8_t childBit = (uint8_t)(1 << childIndex);
+    if (!(childMask & childBit)) {
+        return INVALID_HANDLE;
+    }
+    return _firstChildren[handle] + numberOfOnes(childMask & (childBit - 1));
+}
+
+void OctreeElementStore::traverse(const Visitor& visitor) const {
+    if (_elements.empty()) {
+        return;
+    }
+
+    std::vector<Handle> stack;
+    stack.reserve(NUMBER_OF_CHILDREN * UNREASONABLY_DEEP_RECURSION);
+    stack.push_back(getRoot());
+    while (!stack.empty()) {
+        Handle handle = stack.back();
+        stack.pop_back();
+        if (!visitor(handle)) {
+            continue;
+        }
+        uint8_t childMask = _childMasks[handle];
+        if (childMask) {
+            // push in reverse so the lowest child index is popped first
+            Handle child = _firstChildren[handle] + numberOfOnes(childMask);
+            while (child-- > _firstChildren[handle]) {
+                stack.push_back(child);
+            }
+        }
+    }
+}
+
+bool OctreeElementStore::rayHitsCube(Handle handle, const glm::vec3& origin, const glm::vec3& invDirection,
+                                     float& entryDistance) const {
+    // slab test against the cube, IEEE infinities in invDirection take care of axis-parallel rays
+    const glm::vec3& corner = _corners[handle];
+    glm::vec3 farCorner = corner + glm::vec3(_scales[handle]);
+    glm::vec3 t0 = (corner - origin) * invDirection;
+    glm::vec3 t1 = (farCorner - origin) * invDirection;
+    glm::vec3 tMin = glm::min(t0, t1);
+    glm::vec3 tMax = glm::max(t0, t1);
+    float tEnter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+    float tExit = std::min(std::min(tMax.x, tMax.y), tMax.z);
+    entryDistance = tEnter;
+    return tEnter <= tExit;
+}
+
+void OctreeElementStore::findRayIntersectedElements(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                                    std::vector<HandleDistance>& hits) const {
+    if (_elements.empty()) {
+        return;
+    }
+
+    glm::vec3 invDirection = 1.0f / direction;
+    size_t firstHit = hits.size();
+    std::vector<Handle> stack;
+    stack.reserve(NUMBER_OF_CHILDREN * UNREASONABLY_DEEP_RECURSION);
+    stack.push_back(getRoot());
+    while (!stack.empty()) {
+        Handle handle = stack.back();
+        stack.pop_back();
+
+        float entryDistance;
+        if (!rayHitsCube(handle, origin, invDirection, entryDistance) || entryDistance > maxDistance) {
+            continue;
+        }
+        hits.emplace_back(entryDistance, handle);
+
+        uint8_t childMask = _childMasks[handle];
+        if (childMask) {
+            Handle firstChild = _firstChildren[handle];
+            Handle endChild = firstChild + numberOfOnes(childMask);
+            for (Handle child = firstChild; child < endChild; ++child) {
+                stack.push_back(child);
+            }
+        }
+    }
+
+    std::sort(hits.begin() + firstHit, hits.end(), [](const HandleDistance& a, const HandleDistance& b) {
+        return a.first < b.first;
+    });
+}
+
+size_t OctreeElementStore::getMemoryUsage() const {
+    return _elements.capacity() * sizeof(OctreeElementPointer) +
+        _corners.capacity() * sizeof(glm::vec3) +
+        _scales.capacity() * sizeof(float) +
+        _childMasks.capacity() * sizeof(uint8_t) +
+        _firstChildren.capacity() * sizeof(Handle);
+}
@@ -0,0 +1,91 @@
+//
+//  OctreeElementStore.h
+//  libraries/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeElementStore_h
+#define hifi_OctreeElementStore_h
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "OctreeElement.h"
+
+/// A flattened, read-only snapshot of an octree's structure.
+///
+/// Elements are laid out breadth-first in one contiguous pool and addressed by 32-bit handles.  The children of an
+/// element are always stored next to each other, so a child handle is found from the parent's first-child handle plus
+/// the number of set bits below the child index in the parent's child mask.  Bounds and child masks are kept in
+/// separate arrays (structure-of-arrays) so that traversals only touch the data they test against.
+///
+/// The store keeps a strong reference to every element so traversals can hand out OctreeElementPointer references
+/// without bumping reference counts at every level.  It does not track edits: the owning tree passes its structure
+/// generation to rebuild(), and isStale() reports whether the tree has moved past it since, in which case the owner
+/// should rebuild the store.
+class OctreeElementStore {
+public:
+    using Handle = uint32_t;
+    static const Handle INVALID_HANDLE;
+
+    /// Called for each visited element, return true to descend into its children
+    using Visitor = std::function<bool(Handle)>;
+    using HandleDistance = std::pair<float, Handle>;
+
+    /// \param generation structure generation of the tree, sampled before walking it so that an edit racing with
+    /// the rebuild leaves the store stale rather than silently wrong
+    void rebuild(const OctreeElementPointer& root, uint64_t generation);
+    void clear();
+
+    bool isStale(uint64_t generation) const { return _structureGeneration != generation; }
+
+    uint32_t size() const { return (uint32_t)_elements.size(); }
+    bool isEmpty() const { return _elements.empty(); }
+    Handle getRoot() const { return _elements.empty() ? INVALID_HANDLE : 0; }
+
+    const OctreeElementPointer& getElement(Handle handle) const { return _elements[handle]; }
+    uint8_t getChildMask(Handle handle) const { return _childMasks[handle]; }
+    bool isLeaf(Handle handle) const { return _childMasks[handle] == 0; }
+    Handle getChild(Handle handle, int childIndex) const;
+
+    const glm::vec3& getCorner(Handle handle) const { return _corners[handle]; }
+    float getScale(Handle handle) const { return _scales[handle]; }
+    AACube getAACube(Handle handle) const { return AACube(_corners[handle], _scales[handle]); }
+
+    /// Depth-first pre-order traversal, children visited in child index order (same order as
+    /// Octree::recurseTreeWithOperation).  Uses an explicit stack, no recursion.
+    void traverse(const Visitor& visitor) const;
+
+    /// Collects the elements whose bounds are hit by the ray, sorted by entry distance (nearest first).
+    /// \param origin ray origin in world-frame (meters)
+    /// \param direction ray direction, need not be normalized; distances are in units of direction's length
+    /// \param maxDistance elements entered beyond this distance are skipped along with their descendants
+    /// \param[out] hits (entry distance, handle) pairs
+    void findRayIntersectedElements(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                    std::vector<HandleDistance>& hits) const;
+
+    /// Bytes held by the pool arrays (not counting the elements themselves)
+    size_t getMemoryUsage() const;
+
+private:
+    bool rayHitsCube(Handle handle, const glm::vec3& origin, const glm::vec3& invDirection, float& entryDistance) const;
+
+    std::vector<OctreeElementPointer> _elements;
+    std::vector<glm::vec3> _corners;
+    std::vector<float> _scales;
+    std::vector<uint8_t> _childMasks;
+    std::vector<Handle> _firstChildren;
+    uint64_t _structureGeneration { 0 };
+};
+
+using OctreeElementStorePointer = std::shared_ptr<OctreeElementStore>;
+using ConstOctreeElementStorePointer = std::shared_ptr<const OctreeElementStore>;
+
+#endif // hifi_OctreeElementStore_h
@@ -0,0 +1,348 @@
+//
+//  CollisionShapeCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CollisionShapeCache.h"
+
+#include <cmath>
+
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
+
+#include <NumericalConstants.h>
+#include <SettingHandle.h>
+
+#include "PhysicsLogging.h"
+
+using File = cache::File;
+using FilePointer = cache::FilePointer;
+
+const int CollisionShapeCache::CURRENT_VERSION = 0x02;
+const int CollisionShapeCache::INVALID_VERSION = 0x00;
+const char* CollisionShapeCache::SETTING_VERSION_NAME = "hifi.collisionShapes.cache_version";
+const size_t CollisionShapeCache::DEFAULT_MAX_SIZE { GB_TO_BYTES(1) };
+
+static const char* COLLISION_SHAPE_CACHE_EXTENSION = "shape";
+static const uint32_t ENTRY_MAGIC = 0x48435343; // "HCSC"
+
+enum EntryKind : uint32_t {
+    HULLS = 1,
+    BVH = 2
+};
+
+// the bvh payload follows the header and must stay 16 byte aligned in the (page aligned) mapping
+class EntryHeader {
+public:
+    uint32_t magic { ENTRY_MAGIC };
+    uint32_t version { (uint32_t)CollisionShapeCache::CURRENT_VERSION };
+    uint64_t contentHash { 0 };
+    uint32_t kind { 0 };
+    uint32_t count { 0 };
+    uint64_t payloadSize { 0 };
+};
+static_assert(sizeof(EntryHeader) % 16 == 0, "EntryHeader must keep the payload 16 byte aligned");
+
+// The content hash is part of the key, so an entry that went stale is replaced by a file of its own rather than
+// rewritten: the stale file may still be mapped by shapes that use it, and Windows can't replace a mapped file.
+static std::string getEntryKey(const ShapeInfo& info, uint64_t contentHash) {
+    return QString("%1-%2").arg((qulonglong)info.getHash(), 0, 16).arg((qulonglong)contentHash, 0, 16).toStdString();
+}
+
+// FNV-1a
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    const uint64_t FNV_PRIME = 0x100000001b3ULL;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+CollisionShapeCache::MappedFile::MappedFile(const FilePointer& file) :
+    _file(file),
+    _qFile(QString::fromStdString(file->getFilepath()))
+{
+    if (_qFile.open(QIODevice::ReadOnly)) {
+        _size = (size_t)_qFile.size();
+        // private: Bullet fixes up pointers inside a bvh it loads in place, which must not reach the file
+        _data = _qFile.map(0, _size, QFileDevice::MapPrivateOption);
+    }
+}
+
+CollisionShapeCache::MappedFile::~MappedFile() {
+    if (_data) {
+        _qFile.unmap(_data);
+        _data = nullptr;
+    }
+}
+
+CollisionShapeCache::CollisionShapeCache(const std::string& dirname) :
+    FileCache(dirname, COLLISION_SHAPE_CACHE_EXTENSION)
+{
+    setMaxSize(DEFAULT_MAX_SIZE);
+}
+
+void CollisionShapeCache::initialize() {
+    FileCache::initialize();
+    Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, INVALID_VERSION);
+    auto cacheVersion = cacheVersionHandle.get();
+    if (cacheVersion != CURRENT_VERSION) {
+        wipe();
+        cacheVersionHandle.set(CURRENT_VERSION);
+    }
+}
+
+std::unique_ptr<File> CollisionShapeCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCDebug(physics) << "Wrote collision shape" << metadata.key.c_str();
+    return FileCache::createFile(std::move(metadata), filepath);
+}
+
+uint64_t CollisionShapeCache::computeContentHash(const ShapeInfo& info) {
+    const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (const auto& points : info.getPointCollection()) {
+        uint64_t numPoints = points.size();
+        hash = hashBytes(hash, &numPoints, sizeof(numPoints));
+        hash = hashBytes(hash, points.data(), points.size() * sizeof(glm::vec3));
+    }
+    const auto& indices = info.getTriangleIndices();
+    hash = hashBytes(hash, indices.data(), indices.size() * sizeof(int32_t));
+    return hash;
+}
+
+CollisionShapeCache::MappedFilePointer CollisionShapeCache::mapEntry(const FilePointer& file, uint64_t contentHash,
+        uint32_t kind, uint32_t& count, uint8_t*& payload, size_t& payloadSize) {
+    auto mapped = std::make_shared<MappedFile>(file);
+    if (!mapped->getData()) {
+        throw QString("could not map the entry");
+    }
+    if (mapped->getSize() < sizeof(EntryHeader)) {
+        throw QString("entry too short");
+    }
+    EntryHeader header;
+    memcpy(&header, mapped->getData(), sizeof(EntryHeader));
+    if (header.magic != ENTRY_MAGIC || header.version != (uint32_t)CURRENT_VERSION) {
+        throw QString("not a current entry");
+    }
+    if (header.kind != kind || header.contentHash != contentHash) {
+        throw QString("entry for another shape");
+    }
+    if (header.payloadSize != mapped->getSize() - sizeof(EntryHeader)) {
+        throw QString("entry size doesn't match its header");
+    }
+    count = header.count;
+    payload = mapped->getData() + sizeof(EntryHeader);
+    payloadSize = (size_t)header.payloadSize;
+    return mapped;
+}
+
+void CollisionShapeCache::discardEntry(const FilePointer& file, const QString& error) {
+    // the shape is built from scratch, and stored in place of the entry
+    qCWarning(physics) << "Removing collision shape" << file->getKey().c_str() << "--" << error;
+    removeFile(file);
+    ++_numMisses;
+}
+
+void CollisionShapeCache::writeEntry(const ShapeInfo& info, uint64_t contentHash, uint32_t kind, uint32_t count,
+        const QByteArray& payload) {
+    EntryHeader header;
+    header.contentHash = contentHash;
+    header.kind = kind;
+    header.count = count;
+    header.payloadSize = (uint64_t)payload.size();
+
+    QByteArray data;
+    data.reserve((int)sizeof(EntryHeader) + payload.size());
+    data.append(reinterpret_cast<const char*>(&header), (int)sizeof(EntryHeader));
+    data.append(payload);
+    // FileCache writes to a temporary file and renames it into place.  Another worker may have stored the same
+    // entry in the meantime, which is left alone.
+    auto key = getEntryKey(info, contentHash);
+    if (getFile(key)) {
+        return;
+    }
+    if (writeFile(data.data(), Metadata(key, (size_t)data.size()))) {
+        ++_numWrites;
+    }
+}
+
+static void readHulls(const uint8_t* payload, size_t payloadSize, uint32_t numHulls,
+                      std::vector<btConvexHullShape*>& hulls) {
+    const size_t MIN_HULL_SIZE = sizeof(float) + sizeof(uint32_t) + sizeof(glm::vec3);
+    if (numHulls == 0 || numHulls > payloadSize / MIN_HULL_SIZE) {
+        throw QString("bad number of hulls");
+    }
+    const uint8_t* cursor = payload;
+    const uint8_t* end = payload + payloadSize;
+    hulls.reserve(numHulls);
+    for (uint32_t i = 0; i < numHulls; ++i) {
+        float margin;
+        uint32_t numPoints;
+        if ((size_t)(end - cursor) < sizeof(margin) + sizeof(numPoints)) {
+            throw QString("truncated hull");
+        }
+        memcpy(&margin, cursor, sizeof(margin));
+        cursor += sizeof(margin);
+        memcpy(&numPoints, cursor, sizeof(numPoints));
+        cursor += sizeof(numPoints);
+        if (numPoints == 0 || (size_t)(end - cursor) / sizeof(glm::vec3) < (size_t)numPoints) {
+            throw QString("truncated hull points");
+        }
+        if (!std::isfinite(margin) || margin < 0.0f) {
+            throw QString("bad hull margin");
+        }
+
+        btConvexHullShape* hull = new btConvexHullShape();
+        hulls.push_back(hull);
+        hull->setMargin(margin);
+        for (uint32_t j = 0; j < numPoints; ++j) {
+            glm::vec3 point;
+            memcpy(&point, cursor, sizeof(glm::vec3));
+            cursor += sizeof(glm::vec3);
+            if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+                throw QString("bad hull point");
+            }
+            hull->addPoint(btVector3(point.x, point.y, point.z), false);
+        }
+        hull->recalcLocalAabb();
+    }
+    if (cursor != end) {
+        throw QString("trailing bytes after the hulls");
+    }
+}
+
+bool CollisionShapeCache::loadHulls(const ShapeInfo& info, uint64_t contentHash, std::vector<btConvexHullShape*>& hulls) {
+    FilePointer file = getFile(getEntryKey(info, contentHash));
+    if (!file) {
+        ++_numMisses;
+        return false;
+    }
+
+    std::vector<btConvexHullShape*> loaded;
+    try {
+        uint32_t numHulls = 0;
+        uint8_t* payload = nullptr;
+        size_t payloadSize = 0;
+        auto mapped = mapEntry(file, contentHash, HULLS, numHulls, payload, payloadSize);
+        readHulls(payload, payloadSize, numHulls, loaded);
+    } catch (const QString& error) {
+        for (auto hull : loaded) {
+            delete hull;
+        }
+        discardEntry(file, error);
+        return false;
+    }
+    ++_numHits;
+    hulls.insert(hulls.end(), loaded.begin(), loaded.end());
+    return true;
+}
+
+void CollisionShapeCache::storeHulls(const ShapeInfo& info, uint64_t contentHash,
+                                     const std::vector<btConvexHullShape*>& hulls) {
+    QByteArray payload;
+    for (auto hull : hulls) {
+        float margin = (float)hull->getMargin();
+        uint32_t numPoints = (uint32_t)hull->getNumPoints();
+        payload.append(reinterpret_cast<const char*>(&margin), (int)sizeof(margin));
+        payload.append(reinterpret_cast<const char*>(&numPoints), (int)sizeof(numPoints));
+        const btVector3* points = hull->getUnscaledPoints();
+        for (uint32_t i = 0; i < numPoints; ++i) {
+            glm::vec3 point((float)points[i].getX(), (float)points[i].getY(), (float)points[i].getZ());
+            payload.append(reinterpret_cast<const char*>(&point), (int)sizeof(glm::vec3));
+        }
+    }
+    writeEntry(info, contentHash, HULLS, (uint32_t)hulls.size(), payload);
+}
+
+// Bullet follows the node and triangle indices of the bvh without checking them, those of a bvh read from a damaged
+// file must stay within its nodes and the triangles of the mesh
+static void checkBvh(btOptimizedBvh* bvh, size_t bvhSize, const btTriangleIndexVertexArray* meshes) {
+    // the shapes always build quantized bvhs
+    if (!bvh->isQuantized()) {
+        throw QString("bvh isn't quantized");
+    }
+    const QuantizedNodeArray& nodes = bvh->getQuantizedNodeArray();
+    const BvhSubtreeInfoArray& subtrees = bvh->getSubtreeInfoArray();
+    int numNodes = nodes.size();
+    int numSubtrees = subtrees.size();
+    if (numNodes <= 0 || numSubtrees < 0 ||
+            (size_t)numNodes * sizeof(btQuantizedBvhNode) + (size_t)numSubtrees * sizeof(btBvhSubtreeInfo) > bvhSize) {
+        throw QString("bvh nodes don't fit in the entry");
+    }
+
+    const IndexedMeshArray& parts = meshes->getIndexedMeshArray();
+    for (int i = 0; i < numNodes; ++i) {
+        const btQuantizedBvhNode& node = nodes[i];
+        if (node.isLeafNode()) {
+            int part = node.getPartId();
+            int triangle = node.getTriangleIndex();
+            if (part < 0 || part >= parts.size() || triangle < 0 || triangle >= parts[part].m_numTriangles) {
+                throw QString("bvh leaf %1 past the triangles of the mesh").arg(i);
+            }
+        } else {
+            int escapeIndex = node.getEscapeIndex();
+            if (escapeIndex < 1 || escapeIndex > numNodes - i) {
+                throw QString("bvh node %1 skips past the nodes").arg(i);
+            }
+        }
+    }
+    for (int i = 0; i < numSubtrees; ++i) {
+        const btBvhSubtreeInfo& subtree = subtrees[i];
+        if (subtree.m_rootNodeIndex < 0 || subtree.m_subtreeSize < 1 ||
+                subtree.m_subtreeSize > numNodes - subtree.m_rootNodeIndex) {
+            throw QString("bvh subtree %1 past the nodes").arg(i);
+        }
+    }
+
+    // the traversal mode is read from the file too, the checks above are for the one a built bvh uses
+    bvh->setTraversalMode(btQuantizedBvh::TRAVERSAL_STACKLESS);
+}
+
+CollisionShapeCache::MappedFilePointer CollisionShapeCache::loadBvh(const ShapeInfo& info, uint64_t contentHash,
+        const btTriangleIndexVertexArray* meshes, btOptimizedBvh*& bvh) {
+    FilePointer file = getFile(getEntryKey(info, contentHash));
+    if (!file) {
+        ++_numMisses;
+        return MappedFilePointer();
+    }
+
+    try {
+        uint32_t count = 0;
+        uint8_t* bvhData = nullptr;
+        size_t bvhSize = 0;
+        auto mapped = mapEntry(file, contentHash, BVH, count, bvhData, bvhSize);
+        // deSerializeInPlace reads the node counts from the object itself, and only asserts they fit
+        if (bvhSize < sizeof(btOptimizedBvh) ||
+                reinterpret_cast<btOptimizedBvh*>(bvhData)->calculateSerializeBufferSize() > bvhSize) {
+            throw QString("bvh doesn't fit in the entry");
+        }
+        btOptimizedBvh* loaded = btOptimizedBvh::deSerializeInPlace(bvhData, (unsigned int)bvhSize, false);
+        if (!loaded) {
+            throw QString("bvh doesn't fit in the entry");
+        }
+        checkBvh(loaded, bvhSize, meshes);
+        ++_numHits;
+        bvh = loaded;
+        return mapped;
+    } catch (const QString& error) {
+        discardEntry(file, error);
+        return MappedFilePointer();
+    }
+}
+
+void CollisionShapeCache::storeBvh(const ShapeInfo& info, uint64_t contentHash, const btOptimizedBvh* bvh) {
+    unsigned int size = bvh->calculateSerializeBufferSize();
+    const size_t BVH_ALIGNMENT = 16;
+    void* buffer = btAlignedAlloc(size, BVH_ALIGNMENT);
+    if (bvh->serializeInPlace(buffer, size, false)) {
+        writeEntry(info, contentHash, BVH, 0, QByteArray::fromRawData(static_cast<const char*>(buffer), (int)size));
+    }
+    btAlignedFree(buffer);
+}
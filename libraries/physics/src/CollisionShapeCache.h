@@ -0,0 +1,103 @@
+//
+//  CollisionShapeCache.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CollisionShapeCache_h
+#define hifi_CollisionShapeCache_h
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <ShapeInfo.h>
+#include <shared/FileCache.h>
+
+// The CollisionShapeCache keeps the expensive parts of collision shapes on disk between sessions:
+//
+// Convex hulls are stored after the hull reduction pass of the ShapeFactory, so loading one is a copy of a few dozen
+// points.  Static meshes store the serialized bvh of their btBvhTriangleMeshShape, which is mapped copy-on-write and
+// used in place, so only the pages Bullet touches are read.
+//
+// Entries are keyed by ShapeInfo::getHash() and a hash of the points and indices the shape was built from, because
+// ShapeInfo::getHash() leaves out the points of model-based shapes (it covers type, dimensions and url).  When the
+// model at a url changes its new shapes get entries of their own, entries are never rewritten, and the stale ones
+// age out.  Loading maps or reads files, so the cache is meant to be used from the shape worker threads.
+//
+// Bullet trusts the bvh it is handed, so a loaded bvh is checked against the mesh it is for before it is used.  An
+// entry that doesn't read back whole is a miss, and is removed so that the shape built in its stead takes its place.
+
+class CollisionShapeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format that isn't backward compatible,
+    // this value should be incremented.  This will force the cache to be wiped
+    static const int CURRENT_VERSION;
+    static const int INVALID_VERSION;
+    static const char* SETTING_VERSION_NAME;
+    static const size_t DEFAULT_MAX_SIZE;
+
+    /// A cache file mapped into memory, kept alive (and out of eviction) by the shapes that use it
+    class MappedFile {
+    public:
+        MappedFile(const cache::FilePointer& file);
+        ~MappedFile();
+        uint8_t* getData() const { return _data; }
+        size_t getSize() const { return _size; }
+    private:
+        cache::FilePointer _file;
+        QFile _qFile;
+        uint8_t* _data { nullptr };
+        size_t _size { 0 };
+    };
+    using MappedFilePointer = std::shared_ptr<MappedFile>;
+
+    CollisionShapeCache(const std::string& dirname = "collision_shapes");
+
+    void initialize() override;
+
+    /// Hash of the points and indices a shape is built from
+    static uint64_t computeContentHash(const ShapeInfo& info);
+
+    /// \return true and new hulls, in the order they were stored, when the cache has them for this info
+    bool loadHulls(const ShapeInfo& info, uint64_t contentHash, std::vector<btConvexHullShape*>& hulls);
+    void storeHulls(const ShapeInfo& info, uint64_t contentHash, const std::vector<btConvexHullShape*>& hulls);
+
+    /// \return the mapped file holding the bvh for this info, nullptr on a miss.  The bvh is loaded in place in the
+    /// mapping (pages written to are private to the process) and checked against 'meshes', the triangles it is for.
+    MappedFilePointer loadBvh(const ShapeInfo& info, uint64_t contentHash, const btTriangleIndexVertexArray* meshes,
+                              btOptimizedBvh*& bvh);
+    void storeBvh(const ShapeInfo& info, uint64_t contentHash, const btOptimizedBvh* bvh);
+
+    uint32_t getNumHits() const { return _numHits; }
+    uint32_t getNumMisses() const { return _numMisses; }
+    uint32_t getNumWrites() const { return _numWrites; }
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+
+private:
+    // these throw a QString describing what is wrong with the entry
+    MappedFilePointer mapEntry(const cache::FilePointer& file, uint64_t contentHash, uint32_t kind, uint32_t& count,
+                               uint8_t*& payload, size_t& payloadSize);
+    void discardEntry(const cache::FilePointer& file, const QString& error);
+    void writeEntry(const ShapeInfo& info, uint64_t contentHash, uint32_t kind, uint32_t count, const QByteArray& payload);
+
+    std::atomic<uint32_t> _numHits { 0 };
+    std::atomic<uint32_t> _numMisses { 0 };
+    std::atomic<uint32_t> _numWrites { 0 };
+};
+
+using CollisionShapeCachePointer = std::shared_ptr<CollisionShapeCache>;
+
+#endif // hifi_CollisionShapeCache_h
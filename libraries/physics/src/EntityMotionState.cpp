@@ -579,7 +579,32 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
     properties.setEntityHostType(_entity->getEntityHostType());
     properties.setOwningAvatarID(_entity->getOwningAvatarID());
 
-    entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree, id, properties);
+    // a plain state update of a domain entity goes out in the EntityPhysicsBatch released at the end of the frame
+    bool batched = false;
+    if (_entity->getEntityHostType() == entity::HostType::DOMAIN &&
+            !properties.simulationOwnerChanged() && !properties.actionDataChanged()) {
+        PhysicsStateBatch::Record record;
+        record.id = id;
+        record.position = properties.getPosition();
+        record.rotation = properties.getRotation();
+        record.velocity = properties.getVelocity();
+        record.angularVelocity = properties.getAngularVelocity();
+        record.acceleration = properties.getAcceleration();
+        record.hasQueryAACube = properties.queryAACubeChanged();
+        record.queryAACube = properties.getQueryAACube();
+        batched = entityPacketSender->queuePhysicsState(tree, record);
+        if (batched) {
+            // the server gets the quantized state, so predict from that
+            _serverPosition = record.position;
+            _serverRotation = record.rotation;
+            _serverVelocity = record.velocity;
+            _serverAngularVelocity = record.angularVelocity;
+            _serverAcceleration = record.acceleration;
+        }
+    }
+    if (!batched) {
+        entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree, id, properties);
+    }
     _entity->setLastBroadcast(now); // for debug/physics status icons
 
     // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
@@ -427,41 +427,28 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
 
         bool needsNewShape = object->needsNewShape();
         if (needsNewShape) {
-            ShapeType shapeType = object->getShapeType();
-            if (shapeType == SHAPE_TYPE_STATIC_MESH) {
-                ShapeRequest shapeRequest(object->_entity);
-                ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
-                if (requestItr == _shapeRequests.end()) {
-                    ShapeInfo shapeInfo;
-                    object->_entity->computeShapeInfo(shapeInfo);
-                    uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
-                    if (shape) {
-                        object->setShape(shape);
-                        handledFlags |= Simulation::DIRTY_SHAPE;
-                        needsNewShape = false;
-                    } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
-                        // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
-                        shapeRequest.shapeHash = shapeInfo.getHash();
-                        _shapeRequests.insert(shapeRequest);
-                    } else {
-                        // failed to build shape --> will not be added/updated
-                        handledFlags |= Simulation::DIRTY_SHAPE;
-                    }
-                } else {
-                    // continue waiting for shape request
-                }
-            } else {
+            // the shape may be built on a worker thread (static meshes, and hulls when there is a disk cache)
+            ShapeRequest shapeRequest(object->_entity);
+            ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
+            if (requestItr == _shapeRequests.end()) {
                 ShapeInfo shapeInfo;
                 object->_entity->computeShapeInfo(shapeInfo);
+                uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
                 btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
                 if (shape) {
                     object->setShape(shape);
                     handledFlags |= Simulation::DIRTY_SHAPE;
                     needsNewShape = false;
+                } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
+                    // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
+                    shapeRequest.shapeHash = shapeInfo.getHash();
+                    _shapeRequests.insert(shapeRequest);
                 } else {
-                    // failed to build shape --> will not be added
+                    // failed to build shape --> will not be added/updated
+                    handledFlags |= Simulation::DIRTY_SHAPE;
                 }
+            } else {
+                // continue waiting for shape request
             }
         }
         if (!isInPhysicsSimulation) {
@@ -568,6 +555,9 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
         // send updates before bids, because this simplifies the logic thasuccessful bids will immediately send an update when added to the 'owned' list
         sendOwnedUpdates(numSubsteps);
         sendOwnershipBids(numSubsteps);
+        if (_entityPacketSender) {
+            _entityPacketSender->releaseQueuedPhysicsStates();
+        }
     }
 }
 
@@ -11,7 +11,9 @@
 
 #include "PhysicsEngine.h"
 
+#include <algorithm>
 #include <functional>
+#include <mutex>
 
 #include <QFile>
 
@@ -19,6 +21,9 @@
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <LinearMath/btThreads.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
@@ -27,6 +32,49 @@
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
+// Bullet's own thread pool, created on first use and kept for the life of the process.
+// nullptr when Bullet was built without BT_THREADSAFE, in which case we only ever step on one thread.
+static btITaskScheduler* getThreadedTaskScheduler() {
+    static btITaskScheduler* scheduler = btCreateDefaultTaskScheduler();
+    return scheduler;
+}
+
+// new contact points may be reported from several of Bullet's threads at once,
+// so the one ContactAddedCallback we support is called under a lock
+static std::mutex contactAddedCallbackMutex;
+static PhysicsEngine::ContactAddedCallback contactAddedCallback { nullptr };
+
+static bool lockedContactAddedCallback(btManifoldPoint& cp,
+        const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0,
+        const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1) {
+    std::lock_guard<std::mutex> lock(contactAddedCallbackMutex);
+    if (!contactAddedCallback) {
+        return false;
+    }
+    return contactAddedCallback(cp, colObj0Wrap, partId0, index0, colObj1Wrap, partId1, index1);
+}
+
+void PhysicsEngine::setNumSimulationThreads(int numThreads) {
+    btITaskScheduler* scheduler = getThreadedTaskScheduler();
+    if (numThreads > 1 && scheduler) {
+        scheduler->setNumThreads(std::min(numThreads, scheduler->getMaxNumThreads()));
+        btSetTaskScheduler(scheduler);
+    } else {
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
+    }
+    qCDebug(physics) << "PhysicsEngine: simulation threads =" << getNumSimulationThreads();
+}
+
+int PhysicsEngine::getNumSimulationThreads() {
+    btITaskScheduler* scheduler = btGetTaskScheduler();
+    return scheduler ? scheduler->getNumThreads() : 1;
+}
+
+int PhysicsEngine::getMaxNumSimulationThreads() {
+    btITaskScheduler* scheduler = getThreadedTaskScheduler();
+    return scheduler ? scheduler->getMaxNumThreads() : 1;
+}
+
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
         _myAvatarController(nullptr) {
@@ -38,6 +86,7 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionDispatcher;
     delete _broadphaseFilter;
     delete _constraintSolver;
+    delete _constraintSolverMt;
     delete _dynamicsWorld;
     delete _ghostPairCallback;
 }
@@ -45,10 +94,14 @@ PhysicsEngine::~PhysicsEngine() {
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+        // the Mt dispatcher and solvers run in parallel when the task scheduler has more than one thread
+        // (see setNumSimulationThreads()) and on this thread otherwise
+        _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        _constraintSolver = new btConstraintSolverPoolMt(BT_MAX_THREAD_COUNT);
+        _constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter,
+                                                     _constraintSolver, _constraintSolverMt, _collisionConfig);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -823,7 +876,9 @@ void PhysicsEngine::setContactAddedCallback(PhysicsEngine::ContactAddedCallback
     // gContactAddedCallback is a special feature hook in Bullet
     // if non-null AND one of the colliding objects has btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK flag set
     // then it is called whenever a new candidate contact point is created
-    gContactAddedCallback = newCb;
+    std::lock_guard<std::mutex> lock(contactAddedCallbackMutex);
+    contactAddedCallback = newCb;
+    gContactAddedCallback = newCb ? lockedContactAddedCallback : nullptr;
 }
 
 struct AllContactsCallback : public btCollisionWorld::ContactResultCallback {
@@ -914,6 +969,10 @@ std::vector<ContactTestResult> PhysicsEngine::contactTest(uint16_t mask, const S
     }
 
     auto contactCallback = AllContactsCallback((int32_t)mask, (int32_t)group, regionShapeInfo, regionTransform, myAvatarCollisionObject, threshold);
+    if (!contactCallback.collisionObject.getCollisionShape()) {
+        // the shape is still being built on a worker thread, it will be there for a later test
+        return contactCallback.contacts;
+    }
     _dynamicsWorld->contactTest(&contactCallback.collisionObject, contactCallback);
 
     return contactCallback.contacts;
@@ -92,6 +92,13 @@ public:
         std::vector<ObjectMotionState*> activeStaticObjects;
     };
 
+    /// Threads Bullet may use to step every PhysicsEngine (collision pairs, islands and constraint solving).
+    /// 1 steps on the calling thread only, and is all we get when Bullet was built without thread support.
+    /// May be changed between steps.
+    static void setNumSimulationThreads(int numThreads);
+    static int getNumSimulationThreads();
+    static int getMaxNumSimulationThreads();
+
     PhysicsEngine(const glm::vec3& offset);
     ~PhysicsEngine();
     void init();
@@ -172,7 +179,8 @@ private:
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolverPoolMt* _constraintSolver = NULL;
+    btConstraintSolver* _constraintSolverMt = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
@@ -11,6 +11,8 @@
 
 #include "ShapeFactory.h"
 
+#include <algorithm>
+
 #include <glm/gtx/norm.hpp>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
@@ -27,6 +29,14 @@ public:
         assert(_dataArray);
     }
 
+    // uses a bvh that was loaded in place from a cache file, rather than building one
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh,
+                    const CollisionShapeCache::MappedFilePointer& bvhFile)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhFile(bvhFile) {
+        assert(_dataArray);
+        setOptimizedBvh(bvh);
+    }
+
     ~StaticMeshShape() {
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
@@ -47,6 +57,8 @@ public:
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    // holds the memory of a bvh loaded from the cache, the base class doesn't own such a bvh
+    CollisionShapeCache::MappedFilePointer _bvhFile;
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -270,7 +282,98 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+// util method
+std::vector<btConvexHullShape*> createHulls(const ShapeInfo& info) {
+    std::vector<btConvexHullShape*> hulls;
+    const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
+    if (info.getType() != SHAPE_TYPE_SIMPLE_COMPOUND) {
+        if (info.getNumSubShapes() == 1) {
+            if (!pointCollection.empty()) {
+                hulls.push_back(createConvexHull(pointCollection[0]));
+            }
+        } else {
+            foreach (const ShapeInfo::PointList& hullPoints, pointCollection) {
+                hulls.push_back(createConvexHull(hullPoints));
+            }
+        }
+        return hulls;
+    }
+
+    const ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
+    uint32_t numIndices = (uint32_t)triangleIndices.size();
+    uint32_t i = 0;
+    for (auto& points : pointCollection) {
+        // build a hull around each part
+        while (i < numIndices) {
+            ShapeInfo::PointList hullPoints;
+            hullPoints.reserve(points.size());
+            while (i < numIndices) {
+                int32_t j = triangleIndices[i];
+                ++i;
+                if (j == END_OF_MESH_PART) {
+                    // end of part
+                    break;
+                }
+                hullPoints.push_back(points[j]);
+            }
+            if (hullPoints.size() > 0) {
+                btConvexHullShape* hull = createConvexHull(hullPoints);
+                hulls.push_back(hull);
+            }
+
+            assert(i < numIndices);
+            if (triangleIndices[i] == END_OF_MESH) {
+                // end of mesh
+                ++i;
+                break;
+            }
+        }
+    }
+    return hulls;
+}
+
+// util method
+std::vector<btConvexHullShape*> createHulls(const ShapeInfo& info, CollisionShapeCache* cache) {
+    std::vector<btConvexHullShape*> hulls;
+    if (!cache) {
+        return createHulls(info);
+    }
+    uint64_t contentHash = CollisionShapeCache::computeContentHash(info);
+    if (!cache->loadHulls(info, contentHash, hulls)) {
+        hulls = createHulls(info);
+        bool valid = !hulls.empty() && std::find(hulls.begin(), hulls.end(), nullptr) == hulls.end();
+        if (valid) {
+            cache->storeHulls(info, contentHash, hulls);
+        }
+    }
+    return hulls;
+}
+
+// util method
+btCollisionShape* createStaticMeshShape(const ShapeInfo& info, CollisionShapeCache* cache) {
+    btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
+    if (!dataArray) {
+        return nullptr;
+    }
+    if (!cache) {
+        return new StaticMeshShape(dataArray);
+    }
+
+    uint64_t contentHash = CollisionShapeCache::computeContentHash(info);
+    btOptimizedBvh* bvh = nullptr;
+    auto bvhFile = cache->loadBvh(info, contentHash, dataArray, bvh);
+    if (bvhFile) {
+        return new StaticMeshShape(dataArray, bvh, bvhFile);
+    }
+
+    StaticMeshShape* shape = new StaticMeshShape(dataArray);
+    if (shape->getOptimizedBvh()) {
+        cache->storeBvh(info, contentHash, shape->getOptimizedBvh());
+    }
+    return shape;
+}
+
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, CollisionShapeCache* cache) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
     switch(type) {
@@ -359,18 +462,16 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         break;
         case SHAPE_TYPE_COMPOUND:
         case SHAPE_TYPE_SIMPLE_HULL: {
-            const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
-            uint32_t numSubShapes = info.getNumSubShapes();
-            if (numSubShapes == 1) {
-                if (!pointCollection.empty()) {
-                    shape = createConvexHull(pointCollection[0]);
+            std::vector<btConvexHullShape*> hulls = createHulls(info, cache);
+            if (info.getNumSubShapes() == 1) {
+                if (!hulls.empty()) {
+                    shape = hulls[0];
                 }
             } else {
                 auto compound = new btCompoundShape();
                 btTransform trans;
                 trans.setIdentity();
-                foreach (const ShapeInfo::PointList& hullPoints, pointCollection) {
-                    btConvexHullShape* hull = createConvexHull(hullPoints);
+                for (auto hull : hulls) {
                     compound->addChildShape(trans, hull);
                 }
                 shape = compound;
@@ -384,35 +485,7 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
             uint32_t numMeshes = info.getNumSubShapes();
             const uint32_t MIN_NUM_SIMPLE_COMPOUND_INDICES = 2; // END_OF_MESH_PART + END_OF_MESH
             if (numMeshes > 0 && numIndices > MIN_NUM_SIMPLE_COMPOUND_INDICES) {
-                uint32_t i = 0;
-                std::vector<btConvexHullShape*> hulls;
-                for (auto& points : pointCollection) {
-                    // build a hull around each part
-                    while (i < numIndices) {
-                        ShapeInfo::PointList hullPoints;
-                        hullPoints.reserve(points.size());
-                        while (i < numIndices) {
-                            int32_t j = triangleIndices[i];
-                            ++i;
-                            if (j == END_OF_MESH_PART) {
-                                // end of part
-                                break;
-                            }
-                            hullPoints.push_back(points[j]);
-                        }
-                        if (hullPoints.size() > 0) {
-                            btConvexHullShape* hull = createConvexHull(hullPoints);
-                            hulls.push_back(hull);
-                        }
-
-                        assert(i < numIndices);
-                        if (triangleIndices[i] == END_OF_MESH) {
-                            // end of mesh
-                            ++i;
-                            break;
-                        }
-                    }
-                }
+                std::vector<btConvexHullShape*> hulls = createHulls(info, cache);
                 uint32_t numHulls = (uint32_t)hulls.size();
                 if (numHulls == 1) {
                     shape = hulls[0];
@@ -429,10 +502,7 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         }
         break;
         case SHAPE_TYPE_STATIC_MESH: {
-            btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
-            if (dataArray) {
-                shape = new StaticMeshShape(dataArray);
-            }
+            shape = createStaticMeshShape(info, cache);
         }
         break;
         default:
@@ -489,6 +559,6 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
 }
 
 void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    shape = ShapeFactory::createShapeFromInfo(shapeInfo, cache.get());
     emit submitWork(this);
 }
@@ -19,10 +19,13 @@
 
 #include <ShapeInfo.h>
 
+#include "CollisionShapeCache.h"
+
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
 
 namespace ShapeFactory {
-    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
+    // when a cache is given, hulls and static mesh bvhs are loaded from it or stored in it
+    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info, CollisionShapeCache* cache = nullptr);
     void deleteShape(const btCollisionShape* shape);
 
     class Worker : public QObject, public QRunnable {
@@ -31,6 +34,7 @@ namespace ShapeFactory {
         Worker(const ShapeInfo& info) : shapeInfo(info), shape(nullptr) {}
         void run() override;
         ShapeInfo shapeInfo;
+        CollisionShapeCachePointer cache;
         const btCollisionShape* shape;
     signals:
         void submitWork(Worker*);
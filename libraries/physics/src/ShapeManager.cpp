@@ -18,6 +18,11 @@
 
 const int MAX_RING_SIZE = 256;
 
+// shapes built from convex hulls, which the disk cache keeps
+static bool isHullShapeType(int type) {
+    return type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_HULL || type == SHAPE_TYPE_SIMPLE_COMPOUND;
+}
+
 ShapeManager::ShapeManager() {
     _garbageRing.reserve(MAX_RING_SIZE);
     _nextOrphanExpiry = std::chrono::steady_clock::now();
@@ -36,6 +41,22 @@ ShapeManager::~ShapeManager() {
     }
 }
 
+void ShapeManager::setCollisionShapeCache(const CollisionShapeCachePointer& cache) {
+    _collisionShapeCache = cache;
+}
+
+uint32_t ShapeManager::getNumDiskCacheHits() const {
+    return _collisionShapeCache ? _collisionShapeCache->getNumHits() : 0;
+}
+
+uint32_t ShapeManager::getNumDiskCacheMisses() const {
+    return _collisionShapeCache ? _collisionShapeCache->getNumMisses() : 0;
+}
+
+uint32_t ShapeManager::getNumDiskCacheWrites() const {
+    return _collisionShapeCache ? _collisionShapeCache->getNumWrites() : 0;
+}
+
 const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
@@ -44,20 +65,25 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     ShapeReference* shapeRef = _shapeMap.find(hashKey);
     if (shapeRef) {
         shapeRef->refCount++;
+        ++_numSharedShapeHits;
         return shapeRef->shape;
     }
+    ++_numSharedShapeMisses;
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    // static meshes take long to build, and the disk cache is only read from worker threads
+    bool buildOnWorker = info.getType() == SHAPE_TYPE_STATIC_MESH ||
+        (_collisionShapeCache && isHullShapeType(info.getType()));
+    if (buildOnWorker) {
         uint64_t hash = info.getHash();
 
         // bump the request count to the caller knows we're 
         // starting or waiting on a thread.
         ++_workRequestCount;
 
-        const auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), hash);
-        if (itr == _pendingMeshShapes.end()) {
+        const auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), hash);
+        if (itr == _pendingShapes.end()) {
             // start a worker
-            _pendingMeshShapes.push_back(hash);
+            _pendingShapes.push_back(hash);
             // try to recycle old deadWorker
             ShapeFactory::Worker* worker = _deadWorker;
             if (!worker) {
@@ -66,6 +92,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
                 worker->shapeInfo = info;
                 _deadWorker = nullptr;
             }
+            worker->cache = _collisionShapeCache;
             // we will delete worker manually later
             worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
@@ -208,8 +235,8 @@ bool ShapeManager::hasShape(const btCollisionShape* shape) const {
 
 // slot: called when ShapeFactory::Worker is done building shape
 void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
-    auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), worker->shapeInfo.getHash());
-    if (itr == _pendingMeshShapes.end()) {
+    auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), worker->shapeInfo.getHash());
+    if (itr == _pendingShapes.end()) {
         // we've received a shape but don't remember asking for it
         // (should not fall in here, but if we do: delete the unwanted shape)
         if (worker->shape) {
@@ -217,8 +244,8 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
         }
     } else {
         // clear pending status
-        *itr = _pendingMeshShapes.back();
-        _pendingMeshShapes.pop_back();
+        *itr = _pendingShapes.back();
+        _pendingShapes.pop_back();
 
         // cache the new shape
         if (worker->shape) {
@@ -276,6 +303,7 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
     }
     // save this dead worker for later
     worker->shapeInfo.clear();
+    worker->cache.reset();
     worker->shape = nullptr;
     _deadWorker = worker;
     ++_workDeliveryCount;
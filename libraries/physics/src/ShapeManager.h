@@ -46,6 +46,10 @@
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
 // later.  When that list grows big enough the ShapeManager will remove any matching
 // entries that still have zero ref-count.
+//
+// Shapes the ShapeManager doesn't have yet are built by the ShapeFactory.  With the optional
+// CollisionShapeCache on disk, hulls and static meshes are built on worker threads, which
+// load their hulls or bvh from the cache when they can.
 
 
 class ShapeManager : public QObject {
@@ -55,7 +59,11 @@ public:
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
+    /// shapes built after this call load from and store to the cache, nullptr to stop using it
+    void setCollisionShapeCache(const CollisionShapeCachePointer& cache);
+
+    /// \return pointer to shape, or nullptr while it is built on a worker thread, which is the case for static meshes and,
+    /// when there is a disk cache, for hulls.  getWorkRequestCount() goes up when a shape is requested from a worker.
     const btCollisionShape* getShape(const ShapeInfo& info);
     const btCollisionShape* getShapeByKey(uint64_t key);
     bool hasShapeWithKey(uint64_t key) const;
@@ -74,6 +82,13 @@ public:
     uint32_t getWorkRequestCount() const { return _workRequestCount; }
     uint32_t getWorkDeliveryCount() const { return _workDeliveryCount; }
 
+    // hit rates: shapes shared in memory, and shapes built from the disk cache
+    uint32_t getNumSharedShapeHits() const { return _numSharedShapeHits; }
+    uint32_t getNumSharedShapeMisses() const { return _numSharedShapeMisses; }
+    uint32_t getNumDiskCacheHits() const;
+    uint32_t getNumDiskCacheMisses() const;
+    uint32_t getNumDiskCacheWrites() const;
+
 protected slots:
     void acceptWork(ShapeFactory::Worker* worker);
 
@@ -100,13 +115,16 @@ private:
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     std::vector<uint64_t> _garbageRing;
-    std::vector<uint64_t> _pendingMeshShapes;
+    std::vector<uint64_t> _pendingShapes;
     std::vector<KeyExpiry> _orphans;
     ShapeFactory::Worker* _deadWorker { nullptr };
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
     std::atomic_uint _workDeliveryCount { 0 };
+    std::atomic_uint _numSharedShapeHits { 0 };
+    std::atomic_uint _numSharedShapeMisses { 0 };
+    CollisionShapeCachePointer _collisionShapeCache;
 };
 
 #endif // hifi_ShapeManager_h
@@ -18,15 +18,17 @@
 #include "ThreadSafeDynamicsWorld.h"
 
 #include <LinearMath/btQuickprof.h>
+#include <LinearMath/btThreads.h>
 
 #include "Profile.h"
 
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
-        btConstraintSolver* constraintSolver,
+        btConstraintSolverPoolMt* solverPool,
+        btConstraintSolver* constraintSolverMt,
         btCollisionConfiguration* collisionConfiguration)
-    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache, solverPool, constraintSolverMt, collisionConfiguration) {
 }
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
@@ -78,6 +80,11 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
             internalSingleStepSimulation(fixedTimeStep);
             onSubStep();
         }
+
+        // as in btDiscreteDynamicsWorldMt::stepSimulation(): let Bullet's worker threads sleep until the next step
+        if (btITaskScheduler* scheduler = btGetTaskScheduler()) {
+            scheduler->sleepWorkerThreadsHint();
+        }
     }
 
     // NOTE: We do NOT call synchronizeMotionStates() after each substep (to avoid multiple locks on the
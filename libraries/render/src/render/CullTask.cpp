@@ -13,9 +13,11 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <limits>
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
@@ -175,6 +177,72 @@ void CullSpatialSelection::configure(const Config& config) {
     _overrideSkipCulling = config.skipCulling;
 }
 
+// The planes of a view frustum laid out component by component, so testing a box against all six of them is a
+// branch free loop the compiler can vectorize
+class FrustumPlanes {
+public:
+    FrustumPlanes(const ViewFrustum& frustum) {
+        const ::Plane* planes = frustum.getPlanes();
+        for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+            const glm::vec3& normal = planes[i].getNormal();
+            _normalX[i] = normal.x;
+            _normalY[i] = normal.y;
+            _normalZ[i] = normal.z;
+            _distance[i] = planes[i].getDCoefficient();
+        }
+    }
+
+    // Same result as ViewFrustum::boxIntersectsFrustum: the box is out when its farthest vertex along the normal of
+    // any plane is behind that plane
+    bool boxIntersects(const AABox& box) const {
+        const glm::vec3 halfScale = 0.5f * box.getScale();
+        const glm::vec3 center = box.getCorner() + halfScale;
+        float minDistance = std::numeric_limits<float>::max();
+        for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+            float centerDistance = _normalX[i] * center.x + _normalY[i] * center.y + _normalZ[i] * center.z +
+                _distance[i];
+            float radius = fabsf(_normalX[i]) * halfScale.x + fabsf(_normalY[i]) * halfScale.y +
+                fabsf(_normalZ[i]) * halfScale.z;
+            minDistance = std::min(minDistance, centerDistance + radius);
+        }
+        return minDistance >= 0.0f;
+    }
+
+private:
+    float _normalX[NUM_FRUSTUM_PLANES];
+    float _normalY[NUM_FRUSTUM_PLANES];
+    float _normalZ[NUM_FRUSTUM_PLANES];
+    float _distance[NUM_FRUSTUM_PLANES];
+};
+
+// A run of one of the id lists of a selection, with the tests its items still need
+class CullChunk {
+public:
+    const ItemIDs* ids { nullptr };
+    size_t begin { 0 };
+    size_t end { 0 };
+    bool testFrustum { false };
+    bool testSolidAngle { false };
+
+    ItemBounds outItems;
+    int outOfView { 0 };
+    int tooSmall { 0 };
+};
+
+static const size_t CULL_CHUNK_SIZE = 1024;
+
+static void appendCullChunks(std::vector<CullChunk>& chunks, const ItemIDs& ids, bool testFrustum, bool testSolidAngle) {
+    for (size_t begin = 0; begin < ids.size(); begin += CULL_CHUNK_SIZE) {
+        CullChunk chunk;
+        chunk.ids = &ids;
+        chunk.begin = begin;
+        chunk.end = std::min(begin + CULL_CHUNK_SIZE, ids.size());
+        chunk.testFrustum = testFrustum;
+        chunk.testSolidAngle = testSolidAngle;
+        chunks.push_back(std::move(chunk));
+    }
+}
+
 void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                                const Inputs& inputs, ItemBounds& outItems) {
     assert(renderContext->args);
@@ -195,150 +263,63 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
 
     const auto srcFilter = inputs.get1();
     if (!srcFilter.selectsNothing()) {
+        PerformanceTimer perfTimer("cullSpatialSelection");
         auto filter = render::ItemFilter::Builder(srcFilter).withoutSubMetaCulled().build();
 
         // Now get the bound, and
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
+        // When culling is disabled every item is only filtered.
+        bool cull = !(_skipCulling || _overrideSkipCulling);
+        std::vector<CullChunk> chunks;
+        chunks.reserve(inSelection.numItems() / CULL_CHUNK_SIZE + 4);
+        appendCullChunks(chunks, inSelection.insideItems, false, false);
+        appendCullChunks(chunks, inSelection.insideSubcellItems, false, cull);
+        appendCullChunks(chunks, inSelection.partialItems, cull, false);
+        appendCullChunks(chunks, inSelection.partialSubcellItems, cull, cull);
+
+        // The chunks are culled concurrently, reading the scene only, then appended in selection order so the result
+        // is the same as culling them one after the other
+        const FrustumPlanes frustumPlanes(args->getViewFrustum());
+        const CullFunctor& cullFunctor = _cullFunctor;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t c = range.begin(); c != range.end(); c++) {
+                CullChunk& chunk = chunks[c];
+                chunk.outItems.reserve(chunk.end - chunk.begin);
+                for (size_t i = chunk.begin; i < chunk.end; i++) {
+                    auto id = (*chunk.ids)[i];
                     auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
+                    if (!filter.test(item.getKey())) {
+                        continue;
                     }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
+                    ItemBound itemBound(id, item.getBound());
+                    if (chunk.testFrustum && !frustumPlanes.boxIntersects(itemBound.bound)) {
+                        chunk.outOfView++;
+                        continue;
                     }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
+                    if (chunk.testSolidAngle && !cullFunctor(args, itemBound.bound)) {
+                        chunk.tooSmall++;
+                        continue;
                     }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
+                    chunk.outItems.emplace_back(itemBound);
+                    if (item.getKey().isMetaCullGroup()) {
+                        item.fetchMetaSubItemBounds(chunk.outItems, (*scene));
                     }
                 }
             }
+        });
 
-        } else {
-
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            if (test.solidAngleTest(itemBound.bound)) {
-                                outItems.emplace_back(itemBound);
-                                if (item.getKey().isMetaCullGroup()) {
-                                    item.fetchMetaSubItemBounds(outItems, (*scene));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+        for (auto& chunk : chunks) {
+            outItems.insert(outItems.end(), chunk.outItems.begin(), chunk.outItems.end());
+            details._outOfView += chunk.outOfView;
+            details._tooSmall += chunk.tooSmall;
         }
     }
 
@@ -13,9 +13,11 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <thread>
 
 #include <LogHandler.h>
 #include <PerfStat.h>
+#include <TBBHelpers.h>
 #include <ViewFrustum.h>
 #include <gpu/Context.h>
 #include <shaders/Shaders.h>
@@ -80,22 +82,17 @@ void render::renderShapes(const RenderContextPointer& renderContext,
     }
 }
 
-void render::renderStateSortShapes(const RenderContextPointer& renderContext,
-    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
-    auto& scene = renderContext->_scene;
-    RenderArgs* args = renderContext->args;
+using SortedPipelines = std::vector<render::ShapeKey>;
+using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<Item>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
+using OwnPipelineBucket = std::vector< std::tuple<Item,ShapeKey> >;
 
+static void sortShapesByPipeline(const ScenePointer& scene, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey,
+                                 SortedPipelines& sortedPipelines, SortedShapes& sortedShapes, OwnPipelineBucket& ownPipelineBucket) {
     int numItemsToDraw = (int)inItems.size();
     if (maxDrawnItems != -1) {
         numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
     }
 
-    using SortedPipelines = std::vector<render::ShapeKey>;
-    using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<Item>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
-    SortedPipelines sortedPipelines;
-    SortedShapes sortedShapes;
-    std::vector< std::tuple<Item,ShapeKey> > ownPipelineBucket;
-
     for (auto i = 0; i < numItemsToDraw; ++i) {
         auto& item = scene->getItem(inItems[i].id);
         {
@@ -116,6 +113,17 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
             }
         }
     }
+}
+
+void render::renderStateSortShapes(const RenderContextPointer& renderContext,
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
+    auto& scene = renderContext->_scene;
+    RenderArgs* args = renderContext->args;
+
+    SortedPipelines sortedPipelines;
+    SortedShapes sortedShapes;
+    OwnPipelineBucket ownPipelineBucket;
+    sortShapesByPipeline(scene, inItems, maxDrawnItems, globalKey, sortedPipelines, sortedShapes, ownPipelineBucket);
 
     // Then render
     for (auto& pipelineKey : sortedPipelines) {
@@ -139,6 +147,94 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
     args->_itemShapeKey = 0;
 }
 
+// Below this many items a shard costs more to set up than it saves
+const size_t MIN_ITEMS_PER_SHARD = 256;
+
+void render::renderStateSortShapesInParallel(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext,
+    const ItemBounds& inItems, const char* batchName, const BatchSetup& setupBatch, int maxDrawnItems, const ShapeKey& globalKey) {
+    auto& scene = renderContext->_scene;
+    RenderArgs* args = renderContext->args;
+
+    SortedPipelines sortedPipelines;
+    SortedShapes sortedShapes;
+    OwnPipelineBucket ownPipelineBucket;
+    sortShapesByPipeline(scene, inItems, maxDrawnItems, globalKey, sortedPipelines, sortedShapes, ownPipelineBucket);
+
+    // Resolve the pipelines first, the plumber creates the custom ones it is missing
+    class Bucket {
+    public:
+        ShapeKey key;
+        ShapePipelinePointer pipeline;
+        const std::vector<Item>* items;
+    };
+    std::vector<Bucket> buckets;
+    size_t numItems = ownPipelineBucket.size();
+    for (auto& pipelineKey : sortedPipelines) {
+        auto pipeline = shapeContext->findPipeline(args, pipelineKey);
+        if (pipeline) {
+            const auto& items = sortedShapes[pipelineKey];
+            buckets.push_back({ pipelineKey, pipeline, &items });
+            numItems += items.size();
+        }
+    }
+
+    // Split the buckets, in order, into shards of about the same number of items.  The own pipeline items go last.
+    const size_t maxShards = std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t numShards = std::min(std::max(numItems / MIN_ITEMS_PER_SHARD, (size_t)1), maxShards);
+    const size_t itemsPerShard = (numItems + numShards - 1) / numShards;
+    std::vector<std::pair<size_t, size_t>> shardBuckets;
+    size_t shardBegin = 0;
+    size_t shardItems = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        shardItems += buckets[i].items->size();
+        if (shardItems >= itemsPerShard && shardBuckets.size() + 1 < numShards) {
+            shardBuckets.emplace_back(shardBegin, i + 1);
+            shardBegin = i + 1;
+            shardItems = 0;
+        }
+    }
+    shardBuckets.emplace_back(shardBegin, buckets.size());
+
+    std::vector<gpu::BatchPointer> batches(shardBuckets.size());
+    std::vector<RenderDetails> shardDetails(shardBuckets.size());
+    tbb::parallel_for((size_t)0, shardBuckets.size(), [&](size_t shard) {
+        auto batch = gpu::Context::acquireBatch(batchName);
+        RenderArgs shardArgs(*args);
+        shardArgs._details = RenderDetails();
+        shardArgs._batch = batch.get();
+        setupBatch(*batch);
+
+        for (size_t b = shardBuckets[shard].first; b < shardBuckets[shard].second; b++) {
+            const auto& bucket = buckets[b];
+            ShapePlumber::bindPipeline(&shardArgs, bucket.pipeline);
+            shardArgs._shapePipeline = bucket.pipeline;
+            shardArgs._itemShapeKey = bucket.key._flags.to_ulong();
+            for (auto& item : *bucket.items) {
+                bucket.pipeline->prepareShapeItem(&shardArgs, bucket.key, item);
+                item.render(&shardArgs);
+            }
+        }
+        shardArgs._shapePipeline = nullptr;
+        if (shard + 1 == shardBuckets.size()) {
+            for (auto& itemAndKey : ownPipelineBucket) {
+                auto& item = std::get<0>(itemAndKey);
+                shardArgs._itemShapeKey = std::get<1>(itemAndKey)._flags.to_ulong();
+                item.render(&shardArgs);
+            }
+        }
+        shardArgs._itemShapeKey = 0;
+        shardArgs._batch = nullptr;
+
+        batches[shard] = batch;
+        shardDetails[shard] = shardArgs._details;
+    });
+
+    for (size_t shard = 0; shard < batches.size(); shard++) {
+        args->_context->appendFrameBatch(batches[shard]);
+        args->_details += shardDetails[shard];
+    }
+}
+
 void DrawLight::run(const RenderContextPointer& renderContext, const ItemBounds& inLights) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
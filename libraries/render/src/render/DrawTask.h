@@ -20,6 +20,16 @@ void renderItems(const RenderContextPointer& renderContext, const ItemBounds& in
 void renderShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 
+// Same as renderStateSortShapes, but recorded across the worker pool instead of into args->_batch.  The pipeline buckets
+// are split in order into shards of about the same number of items, each shard is recorded into its own batch starting
+// with setupBatch, and the batches are appended to the frame in order.  The item setters and payload render() calls
+// must be safe to run concurrently for different items.  The render-utils payloads are not: their pipeline setters
+// lazily create the shared default textures and their render() updates shared materials, so the deferred task still
+// records its shapes serially.
+using BatchSetup = std::function<void(gpu::Batch& batch)>;
+void renderStateSortShapesInParallel(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems,
+                                     const char* batchName, const BatchSetup& setupBatch, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
+
 class DrawLightConfig : public Job::Config {
     Q_OBJECT
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
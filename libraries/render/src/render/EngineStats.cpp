@@ -64,5 +64,14 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
 
+    if (renderContext->_scene) {
+        auto transactionStats = renderContext->_scene->getTransactionStats();
+        config->frameTransactionCount = transactionStats.numTransactions;
+        config->frameTransactionUpdateCount = transactionStats.numUpdates;
+        config->frameTransactionCoalescedUpdateCount = transactionStats.numCoalescedUpdates;
+        config->frameTransactionAllocationCount = transactionStats.numAllocations;
+        config->frameTransactionProcessTime = transactionStats.processUsecs;
+    }
+
     // These new stat values are notified with the "newStats" signal triggered by the timer
 }
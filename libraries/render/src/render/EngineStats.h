@@ -61,6 +61,12 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY newStats)
 
+        Q_PROPERTY(quint32 frameTransactionCount MEMBER frameTransactionCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameTransactionUpdateCount MEMBER frameTransactionUpdateCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameTransactionCoalescedUpdateCount MEMBER frameTransactionCoalescedUpdateCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameTransactionAllocationCount MEMBER frameTransactionAllocationCount NOTIFY newStats)
+        Q_PROPERTY(quint64 frameTransactionProcessTime MEMBER frameTransactionProcessTime NOTIFY newStats)
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -101,6 +107,12 @@ namespace render {
         quint32 frameSetPipelineCount{ 0 };
 
         quint32 frameSetInputFormatCount{ 0 };
+
+        quint32 frameTransactionCount{ 0 };
+        quint32 frameTransactionUpdateCount{ 0 };
+        quint32 frameTransactionCoalescedUpdateCount{ 0 };
+        quint32 frameTransactionAllocationCount{ 0 };
+        quint64 frameTransactionProcessTime{ 0 }; // usecs
     };
 
     class EngineStats {
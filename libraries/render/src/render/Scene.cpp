@@ -11,6 +11,7 @@
 #include "Scene.h"
 
 #include <numeric>
+#include <SharedUtil.h>
 #include <gpu/Batch.h>
 #include "Logging.h"
 #include "TransitionStage.h"
@@ -126,44 +127,67 @@ void Transaction::merge(std::vector<Transaction>&& transactionContainer) {
 }
 
 
+// Both return 1 if target had to grow, 0 otherwise
 template <typename T>
-void moveElements(T& target, T& source) {
+uint32_t moveElements(T& target, T& source) {
+    if (source.empty()) {
+        return 0;
+    }
+    auto capacity = target.capacity();
     target.insert(target.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
     source.clear();
+    return (target.capacity() != capacity) ? 1 : 0;
 }
 
 template <typename T>
-void copyElements(T& target, const T& source) {
+uint32_t copyElements(T& target, const T& source) {
+    if (source.empty()) {
+        return 0;
+    }
+    auto capacity = target.capacity();
     target.insert(target.end(), source.begin(), source.end());
+    return (target.capacity() != capacity) ? 1 : 0;
+}
+
+
+uint32_t Transaction::moveFrom(Transaction& transaction) {
+    uint32_t numAllocations = 0;
+    numAllocations += moveElements(_resetItems, transaction._resetItems);
+    numAllocations += moveElements(_removedItems, transaction._removedItems);
+    numAllocations += moveElements(_updatedItems, transaction._updatedItems);
+    numAllocations += moveElements(_resetSelections, transaction._resetSelections);
+    numAllocations += moveElements(_resetTransitions, transaction._resetTransitions);
+    numAllocations += moveElements(_removeTransitions, transaction._removeTransitions);
+    numAllocations += moveElements(_queriedTransitions, transaction._queriedTransitions);
+    numAllocations += moveElements(_transitionFinishedOperators, transaction._transitionFinishedOperators);
+    numAllocations += moveElements(_highlightResets, transaction._highlightResets);
+    numAllocations += moveElements(_highlightRemoves, transaction._highlightRemoves);
+    numAllocations += moveElements(_highlightQueries, transaction._highlightQueries);
+    return numAllocations;
+}
+
+uint32_t Transaction::copyFrom(const Transaction& transaction) {
+    uint32_t numAllocations = 0;
+    numAllocations += copyElements(_resetItems, transaction._resetItems);
+    numAllocations += copyElements(_removedItems, transaction._removedItems);
+    numAllocations += copyElements(_updatedItems, transaction._updatedItems);
+    numAllocations += copyElements(_resetSelections, transaction._resetSelections);
+    numAllocations += copyElements(_resetTransitions, transaction._resetTransitions);
+    numAllocations += copyElements(_removeTransitions, transaction._removeTransitions);
+    numAllocations += copyElements(_queriedTransitions, transaction._queriedTransitions);
+    numAllocations += copyElements(_transitionFinishedOperators, transaction._transitionFinishedOperators);
+    numAllocations += copyElements(_highlightResets, transaction._highlightResets);
+    numAllocations += copyElements(_highlightRemoves, transaction._highlightRemoves);
+    numAllocations += copyElements(_highlightQueries, transaction._highlightQueries);
+    return numAllocations;
 }
 
-
 void Transaction::merge(Transaction&& transaction) {
-    moveElements(_resetItems, transaction._resetItems);
-    moveElements(_removedItems, transaction._removedItems);
-    moveElements(_updatedItems, transaction._updatedItems);
-    moveElements(_resetSelections, transaction._resetSelections);
-    moveElements(_resetTransitions, transaction._resetTransitions);
-    moveElements(_removeTransitions, transaction._removeTransitions);
-    moveElements(_queriedTransitions, transaction._queriedTransitions);
-    moveElements(_transitionFinishedOperators, transaction._transitionFinishedOperators);
-    moveElements(_highlightResets, transaction._highlightResets);
-    moveElements(_highlightRemoves, transaction._highlightRemoves);
-    moveElements(_highlightQueries, transaction._highlightQueries);
+    moveFrom(transaction);
 }
 
 void Transaction::merge(const Transaction& transaction) {
-    copyElements(_resetItems, transaction._resetItems);
-    copyElements(_removedItems, transaction._removedItems);
-    copyElements(_updatedItems, transaction._updatedItems);
-    copyElements(_resetSelections, transaction._resetSelections);
-    copyElements(_resetTransitions, transaction._resetTransitions);
-    copyElements(_removeTransitions, transaction._removeTransitions);
-    copyElements(_queriedTransitions, transaction._queriedTransitions);
-    copyElements(_transitionFinishedOperators, transaction._transitionFinishedOperators);
-    copyElements(_highlightResets, transaction._highlightResets);
-    copyElements(_highlightRemoves, transaction._highlightRemoves);
-    copyElements(_highlightQueries, transaction._highlightQueries);
+    copyFrom(transaction);
 }
 
 void Transaction::clear() {
@@ -200,30 +224,65 @@ bool Scene::isAllocatedID(const ItemID& id) const {
     return Item::isValidID(id) && (id < _numAllocatedItems.load());
 }
 
+Scene::TransactionBuffer& Scene::getTransactionBuffer() {
+    // A thread keeps the buffer it was handed the first time it enqueued, the buffers being handed out in turn
+    static std::atomic<uint32_t> nextBufferIndex { 0 };
+    static thread_local uint32_t bufferIndex = nextBufferIndex.fetch_add(1) % NUM_TRANSACTION_BUFFERS;
+    return _transactionBuffers[bufferIndex];
+}
+
 /// Enqueue change batch to the scene
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    auto& buffer = getTransactionBuffer();
+    uint32_t numAllocations;
+    {
+        std::unique_lock<std::mutex> lock(buffer.mutex);
+        numAllocations = buffer.transaction.copyFrom(transaction);
+    }
+    _numEnqueuedTransactions++;
+    _numTransactionAllocations += numAllocations;
 }
 
 void Scene::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    auto& buffer = getTransactionBuffer();
+    uint32_t numAllocations;
+    {
+        std::unique_lock<std::mutex> lock(buffer.mutex);
+        numAllocations = buffer.transaction.moveFrom(transaction);
+    }
+    _numEnqueuedTransactions++;
+    _numTransactionAllocations += numAllocations;
 }
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
-    TransactionQueue localTransactionQueue;
+    Transaction consolidatedTransaction;
     {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+        std::unique_lock<std::mutex> lock(_transactionFramesMutex);
+        if (!_freeTransactionFrames.empty()) {
+            consolidatedTransaction = std::move(_freeTransactionFrames.back());
+            _freeTransactionFrames.pop_back();
+        }
     }
 
-    Transaction consolidatedTransaction;
-    consolidatedTransaction.merge(std::move(localTransactionQueue));
+    // All the buffers are held while they are drained, so the frame is the same cut across every producer:
+    // what a thread enqueued before another thread's enqueue is never left to a later frame than it.
+    // Producers only ever hold their own buffer, taking the locks in order can't deadlock.
+    uint32_t numAllocations = 0;
+    {
+        std::array<std::unique_lock<std::mutex>, NUM_TRANSACTION_BUFFERS> locks;
+        for (uint32_t i = 0; i < NUM_TRANSACTION_BUFFERS; ++i) {
+            locks[i] = std::unique_lock<std::mutex>(_transactionBuffers[i].mutex);
+        }
+        for (auto& buffer : _transactionBuffers) {
+            numAllocations += consolidatedTransaction.moveFrom(buffer.transaction);
+        }
+    }
+    _numTransactionAllocations += numAllocations;
+
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        _transactionFrames.push_back(consolidatedTransaction);
+        _transactionFrames.push_back(std::move(consolidatedTransaction));
     }
 
     return ++_transactionFrameNumber;
@@ -232,20 +291,47 @@ uint32_t Scene::enqueueFrame() {
  
 void Scene::processTransactionQueue() {
     PROFILE_RANGE(render, __FUNCTION__);
+    auto startTime = usecTimestampNow();
 
-    static TransactionFrames queuedFrames;
     {
         // capture the queued frames and clear the queue
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        queuedFrames.swap(_transactionFrames);
+        _processedTransactionFrames.swap(_transactionFrames);
     }
 
     // go through the queue of frames and process them
-    for (auto& frame : queuedFrames) {
+    uint32_t numUpdates = 0;
+    _numCoalescedUpdates = 0;
+    for (auto& frame : _processedTransactionFrames) {
+        numUpdates += (uint32_t)frame._updatedItems.size();
         processTransactionFrame(frame);
+        frame.clear();
     }
 
-    queuedFrames.clear();
+    {
+        // hand the frames back to enqueueFrame, with their memory
+        const size_t MAX_FREE_TRANSACTION_FRAMES = 4;
+        std::unique_lock<std::mutex> lock(_transactionFramesMutex);
+        for (auto& frame : _processedTransactionFrames) {
+            if (_freeTransactionFrames.size() >= MAX_FREE_TRANSACTION_FRAMES) {
+                break;
+            }
+            _freeTransactionFrames.push_back(std::move(frame));
+        }
+    }
+    _processedTransactionFrames.clear();
+
+    std::unique_lock<std::mutex> lock(_transactionStatsMutex);
+    _transactionStats.numTransactions = _numEnqueuedTransactions.exchange(0);
+    _transactionStats.numUpdates = numUpdates;
+    _transactionStats.numCoalescedUpdates = _numCoalescedUpdates;
+    _transactionStats.numAllocations = _numTransactionAllocations.exchange(0);
+    _transactionStats.processUsecs = usecTimestampNow() - startTime;
+}
+
+Scene::TransactionStats Scene::getTransactionStats() const {
+    std::unique_lock<std::mutex> lock(_transactionStatsMutex);
+    return _transactionStats;
 }
 
 void Scene::processTransactionFrame(const Transaction& transaction) {
@@ -336,6 +422,17 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
 }
 
 void Scene::updateItems(const Transaction::Updates& transactions) {
+    // An item can be updated many times in a frame. Every update is applied to it, in order, but the item is moved
+    // in its container once, after the last of them, from where it was before the first.
+    if (++_updatePass == 0) {
+        std::fill(_itemUpdatePasses.begin(), _itemUpdatePasses.end(), 0);
+        _updatePass = 1;
+    }
+    if (_itemUpdatePasses.size() < _items.size()) {
+        _itemUpdatePasses.resize(_items.size(), 0);
+    }
+    _pendingUpdates.clear();
+
     for (auto& update : transactions) {
         auto updateID = std::get<0>(update);
         if (updateID == Item::INVALID_ITEM_ID) {
@@ -351,11 +448,22 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
         }
 
         // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+        if (_itemUpdatePasses[updateID] != _updatePass) {
+            _itemUpdatePasses[updateID] = _updatePass;
+            _pendingUpdates.push_back({ updateID, item.getKey(), item.getCell() });
+        } else {
+            _numCoalescedUpdates++;
+        }
 
         // Update the item
         item.update(std::get<1>(update));
+    }
+
+    for (auto& pending : _pendingUpdates) {
+        auto updateID = pending.id;
+        auto& item = _items[updateID];
+        auto oldCell = pending.oldCell;
+        auto oldKey = pending.oldKey;
         auto newKey = item.getKey();
 
         // Update the item's container
@@ -12,6 +12,8 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <array>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -45,6 +47,10 @@ public:
 
     Transaction() {}
     ~Transaction() {}
+    Transaction(const Transaction& transaction) = default;
+    Transaction(Transaction&& transaction) = default;
+    Transaction& operator=(const Transaction& transaction) = default;
+    Transaction& operator=(Transaction&& transaction) = default;
 
     // Item transactions
     void resetItem(ItemID id, const PayloadPointer& payload);
@@ -78,6 +84,10 @@ public:
 
 protected:
 
+    // Append the commands of transaction, returning how many of the command lists had to grow to hold them
+    uint32_t moveFrom(Transaction& transaction);
+    uint32_t copyFrom(const Transaction& transaction);
+
     using Reset = std::tuple<ItemID, PayloadPointer>;
     using Remove = ItemID;
     using Update = std::tuple<ItemID, UpdateFunctorPointer>;
@@ -158,6 +168,19 @@ public:
     // Process the pending transactions queued
     void processTransactionQueue();
 
+    // What the last processTransactionQueue went through
+    class TransactionStats {
+    public:
+        uint32_t numTransactions { 0 }; // enqueued since the previous processing
+        uint32_t numUpdates { 0 };
+        uint32_t numCoalescedUpdates { 0 }; // updates to an item already updated in the same frame
+        uint32_t numAllocations { 0 }; // transaction command lists that had to grow
+        uint64_t processUsecs { 0 };
+    };
+
+    // Thread safe
+    TransactionStats getTransactionStats() const;
+
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
     Selection getSelection(const Selection::Name& name) const;
@@ -199,15 +222,35 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
 
-    
+    // Each producer thread enqueues into one of a few buffers, each behind its own mutex, so producers rarely wait on
+    // each other and the lock they take is almost never contended.  The buffers are not lock free: a transaction is
+    // a handful of vectors of shared pointers, and an uncontended lock costs little next to appending it.
+    // The buffers keep their memory from frame to frame, like the frames themselves once processed.
+    // enqueueFrame drains them all under all their locks, so a frame cuts every producer at the same point.
+    // workload::Collection buffers its transactions the same way.
+    static const uint32_t NUM_TRANSACTION_BUFFERS { 16 };
+    class TransactionBuffer {
+    public:
+        std::mutex mutex;
+        Transaction transaction;
+    };
+    std::array<TransactionBuffer, NUM_TRANSACTION_BUFFERS> _transactionBuffers;
+    TransactionBuffer& getTransactionBuffer();
+
     std::mutex _transactionFramesMutex;
     using TransactionFrames = std::vector<Transaction>;
     TransactionFrames _transactionFrames;
+    TransactionFrames _freeTransactionFrames; // processed frames, cleared, recycled by enqueueFrame
+    TransactionFrames _processedTransactionFrames;
     uint32_t _transactionFrameNumber{ 0 };
 
+    std::atomic<uint32_t> _numEnqueuedTransactions { 0 };
+    std::atomic<uint32_t> _numTransactionAllocations { 0 };
+    uint32_t _numCoalescedUpdates { 0 };
+    mutable std::mutex _transactionStatsMutex;
+    TransactionStats _transactionStats;
+
     // Process one transaction frame 
     void processTransactionFrame(const Transaction& transaction);
 
@@ -223,6 +266,17 @@ protected:
     void removeItems(const Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
 
+    // The items touched by the updates of a frame, with where they were before the first of them
+    class PendingUpdate {
+    public:
+        ItemID id;
+        ItemKey oldKey;
+        ItemCell oldCell;
+    };
+    std::vector<PendingUpdate> _pendingUpdates;
+    std::vector<uint32_t> _itemUpdatePasses; // per item, the last updateItems pass it was touched in
+    uint32_t _updatePass { 0 };
+
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
     void queryTransitionItems(const Transaction::TransitionQueries& transactions);
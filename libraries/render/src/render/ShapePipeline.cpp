@@ -126,6 +126,17 @@ const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Ke
 
     PerformanceTimer perfTimer("ShapePlumber::pickPipeline");
 
+    PipelinePointer shapePipeline = findPipeline(args, key);
+    if (shapePipeline) {
+        bindPipeline(args, shapePipeline);
+    }
+    return shapePipeline;
+}
+
+const ShapePipelinePointer ShapePlumber::findPipeline(RenderArgs* args, const Key& key) const {
+    assert(!_pipelineMap.empty());
+    assert(args);
+
     auto pipelineIterator = _pipelineMap.find(key);
     if (pipelineIterator == _pipelineMap.end()) {
         // The first time we can't find a pipeline, we should try things to solve that
@@ -136,7 +147,7 @@ const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Ke
                     // found a factory for the custom key, can now generate a shape pipeline for this case:
                     addPipelineHelper(Filter(key), key, 0, (factoryIt)->second(*this, key, args));
 
-                    return pickPipeline(args, key);
+                    return findPipeline(args, key);
                 } else {
                     qCDebug(renderlogging) << "ShapePlumber::Couldn't find a custom pipeline factory for " << key.getCustom() << " key is: " << key;
                 }
@@ -148,7 +159,11 @@ const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Ke
         return PipelinePointer(nullptr);
     }
 
-    PipelinePointer shapePipeline(pipelineIterator->second);
+    return pipelineIterator->second;
+}
+
+void ShapePlumber::bindPipeline(RenderArgs* args, const PipelinePointer& shapePipeline) {
+    assert(args->_batch);
 
     // Setup the one pipeline (to rule them all)
     args->_batch->setPipeline(shapePipeline->pipeline);
@@ -157,6 +172,4 @@ const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Ke
     if (shapePipeline->_batchSetter) {
         shapePipeline->_batchSetter(*shapePipeline, *(args->_batch), args);
     }
-
-    return shapePipeline;
 }
@@ -343,6 +343,12 @@ public:
 
     const PipelinePointer pickPipeline(RenderArgs* args, const Key& key) const;
 
+    // pickPipeline in two steps, for recording the same pipeline into several batches.  findPipeline resolves the key,
+    // creating a custom pipeline the first time one is needed, and must run on the render thread.  bindPipeline only
+    // sets the pipeline up in args->_batch, so it can run on any thread with its own args.
+    const PipelinePointer findPipeline(RenderArgs* args, const Key& key) const;
+    static void bindPipeline(RenderArgs* args, const PipelinePointer& shapePipeline);
+
 protected:
     void addPipelineHelper(const Filter& filter, Key key, int bit, const PipelinePointer& pipeline) const;
     mutable PipelineMap _pipelineMap;
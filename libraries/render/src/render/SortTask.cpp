@@ -13,86 +13,105 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <cstring>
+
+#include <Radix2InplaceSort.h>
+#include <TBBHelpers.h>
 #include <ViewFrustum.h>
 
 using namespace render;
 
-struct ItemBoundSort {
-    float _centerDepth = 0.0f;
-    float _nearDepth = 0.0f;
-    float _farDepth = 0.0f;
-    ItemID _id = 0;
-    AABox _bounds;
-
-    ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
+// The depth of an item and its id packed into one key, depth in the high bits, so items sort by depth and the
+// duplicates of an item end up next to each other
+struct DepthSortKey {
+    uint64_t key;
+    uint32_t index; // in the input items
 };
 
-struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
-    }
+class DepthSortKeyScanner {
+public:
+    using state_type = uint64_t;
+
+    state_type initial_state() const { return (state_type)1 << 63; }
+    bool advance(state_type& state) const { return (state >>= 1) != 0; }
+    bool bit(const DepthSortKey& value, state_type state) const { return (value.key & state) != 0; }
 };
 
-struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
+static const size_t PARALLEL_SORT_GRAIN = 4096;
+
+// Splits the keys on the current bit as radix2InplaceSort does, but sorts the two halves concurrently until they are
+// small enough to finish inline
+using DepthSortKeyIterator = std::vector<DepthSortKey>::iterator;
+static void parallelDepthSort(DepthSortKeyIterator from, DepthSortKeyIterator to, const DepthSortKeyScanner& scanner,
+                              DepthSortKeyScanner::state_type state) {
+    if ((size_t)(to - from) <= PARALLEL_SORT_GRAIN) {
+        radix2InplaceSort_impl<DepthSortKeyScanner, DepthSortKeyIterator>(scanner).go(from, to, state);
+        return;
     }
-};
+    auto middle = std::partition(from, to, [&](const DepthSortKey& value) {
+        return !scanner.bit(value, state);
+    });
+    if (!scanner.advance(state)) {
+        return;
+    }
+    tbb::parallel_invoke([&] { parallelDepthSort(from, middle, scanner, state); },
+                         [&] { parallelDepthSort(middle, to, scanner, state); });
+}
 
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
                             const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
-
+    const glm::vec3 eyePosition = args->getViewFrustum().getPosition();
 
     // Allocate and simply copy
     outItems.clear();
     outItems.reserve(inItems.size());
 
-
-    // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
-    }
+    // Make a local dataset of the keys, the squared distance to the center of the bound is positive so its bits order
+    // like the float
+    std::vector<DepthSortKey> sortKeys(inItems.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, inItems.size(), PARALLEL_SORT_GRAIN),
+                      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); i++) {
+            glm::vec3 eyeToCenter = inItems[i].bound.calcCenter() - eyePosition;
+            float distanceSquared = glm::dot(eyeToCenter, eyeToCenter);
+            uint32_t depthBits;
+            memcpy(&depthBits, &distanceSquared, sizeof(depthBits));
+            if (!frontToBack) {
+                depthBits = ~depthBits;
+            }
+            sortKeys[i].key = ((uint64_t)depthBits << 32) | inItems[i].id;
+            sortKeys[i].index = (uint32_t)i;
+        }
+    });
 
     // sort against Z
-    if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
-    } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
-    }
+    DepthSortKeyScanner scanner;
+    parallelDepthSort(sortKeys.begin(), sortKeys.end(), scanner, scanner.initial_state());
 
     // Finally once sorted result to a list of itemID and keep uniques
     render::ItemID previousID = Item::INVALID_ITEM_ID;
     if (!bounds) {
-        for (auto& item : itemBoundSorts) {
-            if (item._id != previousID) {
-                outItems.emplace_back(ItemBound(item._id, item._bounds));
-                previousID = item._id;
+        for (auto& sortKey : sortKeys) {
+            const auto& item = inItems[sortKey.index];
+            if (item.id != previousID) {
+                outItems.emplace_back(item);
+                previousID = item.id;
             }
         }
-    } else if (!itemBoundSorts.empty()) {
+    } else if (!sortKeys.empty()) {
         if (bounds->isNull()) {
-            *bounds = itemBoundSorts.front()._bounds;
+            *bounds = inItems[sortKeys.front().index].bound;
         }
-        for (auto& item : itemBoundSorts) {
-            if (item._id != previousID) {
-                outItems.emplace_back(ItemBound(item._id, item._bounds));
-                previousID = item._id;
-                *bounds += item._bounds;
+        for (auto& sortKey : sortKeys) {
+            const auto& item = inItems[sortKey.index];
+            if (item.id != previousID) {
+                outItems.emplace_back(item);
+                previousID = item.id;
+                *bounds += item.bound;
             }
         }
     }
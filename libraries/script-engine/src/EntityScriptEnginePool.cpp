@@ -0,0 +1,222 @@
+//
+//  EntityScriptEnginePool.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEnginePool.h"
+
+#include <algorithm>
+
+#include <QtCore/QFutureInterface>
+
+#include <SharedUtil.h>
+
+// weight of the newest sample in the smoothed run time per second
+const float RUN_TIME_SMOOTHING = 0.5f;
+
+void EntityScriptEnginePool::setEngines(const std::vector<ScriptEnginePointer>& engines) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _engines = engines;
+    _assignments.clear();
+}
+
+void EntityScriptEnginePool::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _engines.clear();
+    _assignments.clear();
+    _runTimes.clear();
+    _lastRunTimeUpdate = 0;
+}
+
+std::vector<ScriptEnginePointer> EntityScriptEnginePool::getEngines() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _engines;
+}
+
+int EntityScriptEnginePool::getNumEngines() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (int)_engines.size();
+}
+
+ScriptEnginePointer EntityScriptEnginePool::getEngine(int index) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (index < 0 || index >= (int)_engines.size()) {
+        return ScriptEnginePointer();
+    }
+    return _engines[index];
+}
+
+int EntityScriptEnginePool::selectEngine(const EntityItemID& entityID, Assignment assignment) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    int numEngines = (int)_engines.size();
+    if (numEngines <= 1) {
+        return numEngines - 1;
+    }
+
+    if (assignment == Assignment::Hash) {
+        return (int)(qHash(entityID) % (uint)numEngines);
+    }
+
+    std::vector<float> loads(numEngines, 0.0f);
+    std::vector<int> numScripts(numEngines, 0);
+    for (auto itr = _assignments.cbegin(); itr != _assignments.cend(); ++itr) {
+        if (itr.key() != entityID) {
+            loads[itr.value()] += _runTimes.value(itr.key()).runTimePerSecond;
+            ++numScripts[itr.value()];
+        }
+    }
+
+    int selected = 0;
+    for (int i = 1; i < numEngines; ++i) {
+        if (loads[i] < loads[selected] || (loads[i] == loads[selected] && numScripts[i] < numScripts[selected])) {
+            selected = i;
+        }
+    }
+    return selected;
+}
+
+void EntityScriptEnginePool::assign(const EntityItemID& entityID, int engineIndex) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _assignments[entityID] = engineIndex;
+    // the script starts over on the engine, its run time with it
+    auto itr = _runTimes.find(entityID);
+    if (itr != _runTimes.end()) {
+        itr->runTime = 0;
+    }
+}
+
+void EntityScriptEnginePool::unassign(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _assignments.remove(entityID);
+}
+
+void EntityScriptEnginePool::forgetEntity(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _assignments.remove(entityID);
+    _runTimes.remove(entityID);
+}
+
+int EntityScriptEnginePool::getEngineIndex(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _assignments.value(entityID, -1);
+}
+
+ScriptEnginePointer EntityScriptEnginePool::getEngineForEntity(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto itr = _assignments.constFind(entityID);
+    if (itr == _assignments.constEnd()) {
+        return ScriptEnginePointer();
+    }
+    return _engines[itr.value()];
+}
+
+QList<EntityItemID> EntityScriptEnginePool::getAssignedEntities() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _assignments.keys();
+}
+
+void EntityScriptEnginePool::updateRunTimes() {
+    // poll without holding our mutex, the engines take their own locks
+    std::vector<ScriptEnginePointer> engines = getEngines();
+    std::vector<QHash<EntityItemID, quint64>> engineRunTimes;
+    engineRunTimes.reserve(engines.size());
+    for (const auto& engine : engines) {
+        engineRunTimes.push_back(engine->getEntityScriptRunTimes());
+    }
+
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    float seconds = _lastRunTimeUpdate > 0 ? (float)(now - _lastRunTimeUpdate) / USECS_PER_SECOND : 0.0f;
+    _lastRunTimeUpdate = now;
+
+    for (int engineIndex = 0; engineIndex < (int)engineRunTimes.size(); ++engineIndex) {
+        const auto& runTimes = engineRunTimes[engineIndex];
+        for (auto itr = runTimes.cbegin(); itr != runTimes.cend(); ++itr) {
+            if (_assignments.value(itr.key(), -1) != engineIndex) {
+                // left over on an engine the script was moved away from
+                continue;
+            }
+            ScriptRunTime& entry = _runTimes[itr.key()];
+            if (seconds > 0.0f) {
+                quint64 delta = itr.value() >= entry.runTime ? itr.value() - entry.runTime : itr.value();
+                entry.runTimePerSecond = (1.0f - RUN_TIME_SMOOTHING) * entry.runTimePerSecond +
+                    RUN_TIME_SMOOTHING * ((float)delta / seconds);
+            }
+            entry.runTime = itr.value();
+        }
+    }
+}
+
+std::vector<EntityScriptEnginePool::EngineStats> EntityScriptEnginePool::getEngineStats() const {
+    std::vector<ScriptEnginePointer> engines;
+    std::vector<EngineStats> stats;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        engines = _engines;
+        stats.resize(_engines.size());
+        for (auto itr = _assignments.cbegin(); itr != _assignments.cend(); ++itr) {
+            EngineStats& engineStats = stats[itr.value()];
+            ++engineStats.numScripts;
+            engineStats.runTimePerSecond += _runTimes.value(itr.key()).runTimePerSecond;
+        }
+    }
+    for (size_t i = 0; i < engines.size(); ++i) {
+        stats[i].numRunningScripts = engines[i]->getNumRunningEntityScripts();
+    }
+    return stats;
+}
+
+std::vector<EntityScriptEnginePool::ScriptStats> EntityScriptEnginePool::getBusiestScripts(size_t maxScripts) const {
+    std::vector<ScriptStats> scripts;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        scripts.reserve(_assignments.size());
+        for (auto itr = _assignments.cbegin(); itr != _assignments.cend(); ++itr) {
+            ScriptStats scriptStats;
+            scriptStats.entityID = itr.key();
+            scriptStats.engineIndex = itr.value();
+            auto runTime = _runTimes.constFind(itr.key());
+            if (runTime != _runTimes.constEnd()) {
+                scriptStats.runTime = runTime->runTime;
+                scriptStats.runTimePerSecond = runTime->runTimePerSecond;
+            }
+            scripts.push_back(scriptStats);
+        }
+    }
+
+    auto busier = [](const ScriptStats& a, const ScriptStats& b) { return a.runTimePerSecond > b.runTimePerSecond; };
+    if (scripts.size() > maxScripts) {
+        std::partial_sort(scripts.begin(), scripts.begin() + maxScripts, scripts.end(), busier);
+        scripts.resize(maxScripts);
+    } else {
+        std::sort(scripts.begin(), scripts.end(), busier);
+    }
+    return scripts;
+}
+
+void EntityScriptEnginePool::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                    const QStringList& params, const QUuid& remoteCallerID) {
+    // the call may run the target script right away if it lives on the calling thread, so don't hold the mutex
+    ScriptEnginePointer engine = getEngineForEntity(entityID);
+    if (engine) {
+        engine->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+}
+
+QFuture<QVariant> EntityScriptEnginePool::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    ScriptEnginePointer engine = getEngineForEntity(entityID);
+    if (engine) {
+        return engine->getLocalEntityScriptDetails(entityID);
+    }
+    // no script for the entity, answer with empty details right away
+    QFutureInterface<QVariant> noDetails;
+    QVariant empty;
+    noDetails.reportStarted();
+    noDetails.reportFinished(&empty);
+    return noDetails.future();
+}
@@ -0,0 +1,96 @@
+//
+//  EntityScriptEnginePool.h
+//  libraries/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEnginePool_h
+#define hifi_EntityScriptEnginePool_h
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+
+#include <EntitiesScriptEngineProvider.h>
+#include "ScriptEngine.h"
+
+/// The script engines of the entity script server, each running on its own thread, and which entity's server
+/// script lives on which engine.
+///
+/// Calls to entity script methods (Entities.callEntityMethod and friends) are routed to the engine running the
+/// target entity's script, so scripts on different engines can still call each other.  The pool is safe to use
+/// from any thread; engines and assignments are only changed by the entity script server.
+class EntityScriptEnginePool : public EntitiesScriptEngineProvider {
+public:
+    enum class Assignment {
+        Hash, // stable: the entity ID picks the engine
+        Load  // the engine whose scripts used the least run time recently
+    };
+
+    class EngineStats {
+    public:
+        int numScripts { 0 };
+        int numRunningScripts { 0 };
+        float runTimePerSecond { 0.0f }; // usec of script execution per second of wall time, recently
+    };
+
+    class ScriptStats {
+    public:
+        EntityItemID entityID;
+        int engineIndex { -1 };
+        quint64 runTime { 0 }; // usec since the script was loaded
+        float runTimePerSecond { 0.0f };
+    };
+
+    /// Replaces the engines, forgetting all assignments
+    void setEngines(const std::vector<ScriptEnginePointer>& engines);
+    /// Drops the engines, the assignments and what was measured for the scripts
+    void clear();
+    std::vector<ScriptEnginePointer> getEngines() const;
+    int getNumEngines() const;
+    ScriptEnginePointer getEngine(int index) const;
+
+    /// Engine to load a new or reloaded script for this entity on
+    int selectEngine(const EntityItemID& entityID, Assignment assignment) const;
+    void assign(const EntityItemID& entityID, int engineIndex);
+    void unassign(const EntityItemID& entityID);
+    /// Like unassign, and also drops what was measured for the script, for entities that were deleted
+    void forgetEntity(const EntityItemID& entityID);
+    int getEngineIndex(const EntityItemID& entityID) const;
+    ScriptEnginePointer getEngineForEntity(const EntityItemID& entityID) const;
+    QList<EntityItemID> getAssignedEntities() const;
+
+    /// Polls the engines for the run time of their scripts, which feeds load balancing and the stats below.
+    void updateRunTimes();
+    std::vector<EngineStats> getEngineStats() const;
+    /// The scripts with the most recent run time first
+    std::vector<ScriptStats> getBusiestScripts(size_t maxScripts) const;
+
+    // EntitiesScriptEngineProvider
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    class ScriptRunTime {
+    public:
+        quint64 runTime { 0 };
+        float runTimePerSecond { 0.0f };
+    };
+
+    mutable std::mutex _mutex;
+    std::vector<ScriptEnginePointer> _engines;
+    QHash<EntityItemID, int> _assignments;
+    // survives reloads so a script that was busy before is placed accordingly when it comes back
+    QHash<EntityItemID, ScriptRunTime> _runTimes;
+    quint64 _lastRunTimeUpdate { 0 };
+};
+
+using EntityScriptEnginePoolPointer = QSharedPointer<EntityScriptEnginePool>;
+
+#endif // hifi_EntityScriptEnginePool_h
@@ -22,6 +22,7 @@
 #include <QtCore/QRegularExpression>
 
 #include <QtCore/QFuture>
+#include <QtCore/QProcessEnvironment>
 #include <QtConcurrent/QtConcurrentRun>
 
 #include <QtWidgets/QMainWindow>
@@ -44,6 +45,7 @@
 #include <AudioEffectOptions.h>
 #include <AvatarData.h>
 #include <DebugDraw.h>
+#include <EntityPropertySnapshot.h>
 #include <EntityScriptingInterface.h>
 #include <MessagesClient.h>
 #include <NetworkAccessManager.h>
@@ -98,6 +100,11 @@ static const QScriptValue::PropertyFlags READONLY_HIDDEN_PROP_FLAGS { READONLY_P
 
 static const bool HIFI_AUTOREFRESH_FILE_SCRIPTS { true };
 
+// set to a number of seconds to profile every script engine from the start and log a report at that interval
+static const QString HIFI_SCRIPT_PROFILE_FLAG { "HIFI_SCRIPT_PROFILE" };
+static const int DEFAULT_PROFILE_SAMPLING_INTERVAL_MSECS { 10 };
+static const size_t MAX_PROFILE_REPORT_ENTRIES { 20 };
+
 Q_DECLARE_METATYPE(QScriptEngine::FunctionSignature)
 int functionSignatureMetaID = qRegisterMetaType<QScriptEngine::FunctionSignature>();
 
@@ -176,7 +183,7 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
+    _timers(usecTimestampNow() / USECS_PER_MSEC),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this)),
     _assetScriptingInterface(new AssetScriptingInterface(this))
@@ -345,6 +352,11 @@ void ScriptEngine::runDebuggable() {
             return;
         }
 
+        if (!(_isFinished || _isStopping)) {
+            EntityPropertySnapshot::beginFrame();
+            fireExpiredTimers();
+        }
+
         qint64 now = usecTimestampNow();
         // we check for 'now' in the past in case people set their clock back
         if (_lastUpdate < now) {
@@ -1160,6 +1172,11 @@ void ScriptEngine::run() {
     _isRunning = true;
     emit runningStateChanged();
 
+    static const int profileLogInterval = QProcessEnvironment::systemEnvironment().value(HIFI_SCRIPT_PROFILE_FLAG).toInt();
+    if (profileLogInterval > 0) {
+        profileStart(DEFAULT_PROFILE_SAMPLING_INTERVAL_MSECS, profileLogInterval);
+    }
+
     {
         PROFILE_RANGE(script, _fileNameString);
         evaluate(_scriptContents, _fileNameString);
@@ -1270,6 +1287,17 @@ void ScriptEngine::run() {
             }
         }
 
+        EntityPropertySnapshot::beginFrame();
+
+        {
+            PROFILE_RANGE(script, "ScriptTimers");
+            fireExpiredTimers();
+        }
+
+        if (_isFinished) {
+            break;
+        }
+
         qint64 now = usecTimestampNow();
 
         // we check for 'now' in the past in case people set their clock back
@@ -1279,6 +1307,7 @@ void ScriptEngine::run() {
                 auto preUpdate = clock::now();
                 {
                     PROFILE_RANGE(script, "ScriptUpdate");
+                    ScriptProfiler::Scope profileScope(_profiler, [] { return QString("update"); });
                     emit update(deltaTime);
                 }
                 auto postUpdate = clock::now();
@@ -1330,32 +1359,18 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
-        qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
-        stopTimer(timer);
+    if (_timers.size() > 0) {
+        qCDebug(scriptengine) << getFilename() << "stopAllTimers" << _timers.size();
     }
+    _timers.clear();
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
+    for (auto handle : _timers.getHandles()) {
+        if (_timers.get(handle)->callback.definingEntityIdentifier == entityID) {
+            _timers.cancel(handle);
         }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
     }
-    for (auto timer:toDelete) { // now reap 'em
-        stopTimer(timer);
-    }
-
 }
 
 void ScriptEngine::stop(bool marshal) {
@@ -1408,89 +1423,97 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+void ScriptEngine::fireExpiredTimers() {
     {
         QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
         if (!scriptEngines || scriptEngines->isStopped()) {
-            scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename());
-            return; // bail early
+            return; // timers don't fire while shutting down
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    quint64 now = usecTimestampNow() / USECS_PER_MSEC;
+    _expiredTimers.clear();
+    _timers.advance(now, _expiredTimers);
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
+    for (auto handle : _expiredTimers) {
+        // an earlier callback may have cleared this timer
+        ScriptTimer* timer = _timers.get(handle);
+        if (!timer) {
+            continue;
+        }
+        CallbackData timerData = timer->callback;
+        if (timer->isSingleShot) {
+            _timers.cancel(handle);
+        } else {
+            // scheduled before the call so the callback can clear its own interval
+            _timers.reschedule(handle, now + timer->intervalMS);
+        }
+        ++_numTimersFired;
+
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            PROFILE_RANGE(script, "timerFired");
+            auto preTimer = p_high_resolution_clock::now();
+            ScriptProfiler::Scope profileScope(_profiler, [&] {
+                return describeCallback("timer", timerData.function, timerData.definingSandboxURL);
+            });
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        if (_isFinished) {
+            break;
+        }
     }
 }
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
-    }
-
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+QScriptValue ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    ScriptTimer timer;
+    timer.callback = { function, currentEntityIdentifier, currentSandboxURL };
+    // an interval of 0 still waits for the next frame rather than spinning
+    timer.intervalMS = std::max(intervalMS, 0);
+    timer.isSingleShot = isSingleShot;
 
-
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
-
-    newTimer->start(intervalMS);
-    return newTimer;
+    quint64 now = usecTimestampNow() / USECS_PER_MSEC;
+    auto handle = _timers.schedule(now + timer.intervalMS, timer);
+    ++_numTimersScheduled;
+    return QScriptValue((double)handle);
 }
 
-QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
+QScriptValue ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setInterval() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return QScriptValue::NullValue; // bail early
     }
 
     return setupTimerWithInterval(function, intervalMS, false);
 }
 
-QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
+QScriptValue ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setTimeout() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return QScriptValue::NullValue; // bail early
     }
 
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
-    } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+void ScriptEngine::stopTimer(const QScriptValue& timer) {
+    // scripts commonly clear timers they never set, or already cleared
+    if (!timer.isNumber()) {
+        return;
+    }
+    double value = timer.toNumber();
+    if (value <= 0.0) {
+        return;
     }
+    _timers.cancel((TimerWheel<ScriptTimer>::Handle)value);
 }
 
 QUrl ScriptEngine::resolvePath(const QString& include) const {
@@ -1550,6 +1573,84 @@ void ScriptEngine::endProfileRange(const QString& label) const {
     PROFILE_SYNC_END(script, label.toStdString().c_str(), label.toStdString().c_str());
 }
 
+void ScriptEngine::profileStart(int samplingInterval, int logInterval) {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "profileStart", Q_ARG(int, samplingInterval), Q_ARG(int, logInterval));
+        return;
+    }
+
+    _profiler.setSamplingInterval(std::max(samplingInterval, 0) * (int)USECS_PER_MSEC);
+    if (samplingInterval > 0) {
+        if (!_samplingAgent) {
+            _samplingAgent = new ScriptSamplingAgent(this, _profiler);
+        }
+        if (agent() && agent() != _samplingAgent) {
+            // only one agent can be installed, and the debugger's comes first
+            scriptWarningMessage("Script.profileStart(): can't sample the call stack while the script is being debugged");
+        } else {
+            setAgent(_samplingAgent);
+        }
+    } else if (agent() == _samplingAgent) {
+        setAgent(nullptr);
+    }
+
+    if (logInterval > 0) {
+        if (!_profileLogTimer) {
+            _profileLogTimer = new QTimer(this);
+            connect(_profileLogTimer, &QTimer::timeout, this, &ScriptEngine::profileLog);
+        }
+        _profileLogTimer->start(logInterval * (int)MSECS_PER_SECOND);
+    } else if (_profileLogTimer) {
+        _profileLogTimer->stop();
+    }
+
+    _profiler.setEnabled(true);
+}
+
+void ScriptEngine::profileStop() {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "profileStop");
+        return;
+    }
+
+    _profiler.setEnabled(false);
+    if (_samplingAgent && agent() == _samplingAgent) {
+        setAgent(nullptr);
+    }
+    if (_profileLogTimer) {
+        _profileLogTimer->stop();
+    }
+}
+
+void ScriptEngine::profileReset() {
+    _profiler.reset();
+}
+
+QVariantMap ScriptEngine::profileResults() const {
+    QVariantMap results = _profiler.toVariantMap(MAX_PROFILE_REPORT_ENTRIES);
+    QVariantMap timers;
+    timers["active"] = getNumActiveTimers();
+    timers["scheduled"] = (double)_numTimersScheduled;
+    timers["fired"] = (double)_numTimersFired;
+    results["timers"] = timers;
+    return results;
+}
+
+void ScriptEngine::profileLog() const {
+    qCInfo(scriptengine).noquote() << "Script profile for" << getFilename() << _profiler.formatReport(MAX_PROFILE_REPORT_ENTRIES)
+        << QString("timers: %1 active, %2 scheduled, %3 fired").arg(getNumActiveTimers())
+            .arg(_numTimersScheduled).arg(_numTimersFired);
+}
+
+QString ScriptEngine::describeCallback(const QString& kind, const QScriptValue& function, const QUrl& sandboxURL) const {
+    QString name = function.property("name").toString();
+    if (name.isEmpty()) {
+        name = "(anonymous)";
+    }
+    QString source = sandboxURL.isEmpty() ? _fileNameString : sandboxURL.toString();
+    return kind + " " + name + " " + source;
+}
+
 // Script.require.resolve -- like resolvePath, but performs more validation and throws exceptions on invalid module identifiers (for consistency with Node.js)
 QString ScriptEngine::_requireResolve(const QString& moduleId, const QString& relativeTo) {
     if (!IS_THREADSAFE_INVOCATION(thread(), __FUNCTION__)) {
@@ -2063,6 +2164,9 @@ void ScriptEngine::forwardHandlerCall(const EntityItemID& entityID, const QStrin
             // and the entity scripts may be for entities other than the one this is a handler for.
             // Fortunately, the definingEntityIdentifier captured the entity script id (if any) when the handler was added.
             CallbackData& handler = handlersForEvent[i];
+            ScriptProfiler::Scope profileScope(_profiler, [&] {
+                return describeCallback("event " + eventName, handler.function, handler.definingSandboxURL);
+            });
             callWithEnvironment(handler.definingEntityIdentifier, handler.definingSandboxURL, handler.function, QScriptValue(), eventHandlerArgs);
         }
     }
@@ -2153,6 +2257,16 @@ bool ScriptEngine::getEntityScriptDetails(const EntityItemID& entityID, EntitySc
     return true;
 }
 
+QHash<EntityItemID, quint64> ScriptEngine::getEntityScriptRunTimes() const {
+    QHash<EntityItemID, quint64> runTimes;
+    QReadLocker locker { &_entityScriptsLock };
+    runTimes.reserve(_entityScriptRunTimes.size());
+    for (auto itr = _entityScriptRunTimes.cbegin(); itr != _entityScriptRunTimes.cend(); ++itr) {
+        runTimes.insert(itr.key(), itr.value()->load());
+    }
+    return runTimes;
+}
+
 bool ScriptEngine::hasEntityScriptDetails(const EntityItemID& entityID) const {
     QReadLocker locker { &_entityScriptsLock };
     return _entityScripts.contains(entityID);
@@ -2409,6 +2523,12 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         }
     };
 
+    if (_trackEntityScriptRunTimes) {
+        // a reload starts the count over
+        QWriteLocker locker { &_entityScriptsLock };
+        _entityScriptRunTimes[entityID] = std::make_shared<std::atomic<quint64>>(0);
+    }
+
     doWithEnvironment(entityID, sandboxURL, initialization);
 
     if (entityScriptObject.isError()) {
@@ -2478,6 +2598,7 @@ void ScriptEngine::unloadEntityScript(const EntityItemID& entityID, bool shouldR
             {
                 QWriteLocker locker { &_entityScriptsLock };
                 _entityScripts.remove(entityID);
+                _entityScriptRunTimes.remove(entityID);
             }
             emit entityScriptDetailsUpdated();
         } else if (oldDetails.status != EntityScriptStatus::UNLOADED) {
@@ -2523,6 +2644,7 @@ void ScriptEngine::unloadAllEntityScripts(bool blockingCall) {
     {
         QWriteLocker locker{ &_entityScriptsLock };
         _entityScripts.clear();
+        _entityScriptRunTimes.clear();
     }
     emit entityScriptDetailsUpdated();
 
@@ -2573,6 +2695,10 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    // time is charged to the outermost entity script, nested calls run on its behalf
+    bool measureRunTime = _trackEntityScriptRunTimes && !entityID.isNull() && oldIdentifier.isNull();
+    quint64 startTime = measureRunTime ? usecTimestampNow() : 0;
+
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2581,6 +2707,14 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
 #else
     operation();
 #endif
+    if (measureRunTime) {
+        quint64 elapsed = usecTimestampNow() - startTime;
+        QReadLocker locker { &_entityScriptsLock };
+        auto runTime = _entityScriptRunTimes.constFind(entityID);
+        if (runTime != _entityScriptRunTimes.constEnd()) {
+            *runTime.value() += elapsed;
+        }
+    }
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
@@ -2654,6 +2788,9 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
 
             QScriptValue oldData = this->globalObject().property("Script").property("remoteCallerID");
             this->globalObject().property("Script").setProperty("remoteCallerID", remoteCallerID.toString()); // Make the remoteCallerID available to javascript as a global.
+            ScriptProfiler::Scope profileScope(_profiler, [&] {
+                return "entity " + methodName + " " + details.definingSandboxURL.toString();
+            });
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
             this->globalObject().property("Script").setProperty("remoteCallerID", oldData);
         }
@@ -2692,6 +2829,9 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             QScriptValueList args;
             args << entityID.toScriptValue(this);
             args << event.toScriptValue(this);
+            ScriptProfiler::Scope profileScope(_profiler, [&] {
+                return "entity " + methodName + " " + details.definingSandboxURL.toString();
+            });
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
         }
     }
@@ -2731,6 +2871,9 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             args << entityID.toScriptValue(this);
             args << otherID.toScriptValue(this);
             args << collisionToScriptValue(this, collision);
+            ScriptProfiler::Scope profileScope(_profiler, [&] {
+                return "entity " + methodName + " " + details.definingSandboxURL.toString();
+            });
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
         }
     }
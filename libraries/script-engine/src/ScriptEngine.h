@@ -12,6 +12,8 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <atomic>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -31,6 +33,7 @@
 #include <EntityItemID.h>
 #include <EntitiesScriptEngineProvider.h>
 #include <EntityScriptUtils.h>
+#include <shared/TimerWheel.h>
 
 #include "PointerEvent.h"
 #include "ArrayBufferClass.h"
@@ -40,6 +43,7 @@
 #include "Quat.h"
 #include "Mat4.h"
 #include "ScriptCache.h"
+#include "ScriptProfiler.h"
 #include "ScriptUUID.h"
 #include "Vec3.h"
 #include "ConsoleScriptingInterface.h"
@@ -65,6 +69,13 @@ public:
     QUrl definingSandboxURL;
 };
 
+class ScriptTimer {
+public:
+    CallbackData callback;
+    int intervalMS { 0 };
+    bool isSingleShot { true };
+};
+
 class DeferredLoadEntity {
 public:
     EntityItemID entityID;
@@ -444,31 +455,31 @@ public:
      * @function Script.setInterval
      * @param {function} function - The function to call. This can be either the name of a function or an in-line definition.
      * @param {number} interval - The interval at which to call the function, in ms.
-     * @returns {object} A handle to the interval timer. This can be used in {@link Script.clearInterval}.
+     * @returns {number} A handle to the interval timer. This can be used in {@link Script.clearInterval}.
      * @example <caption>Print a message every second.</caption>
      * Script.setInterval(function () {
      *     print("Interval timer fired");
      * }, 1000);
     */
-    Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
+    Q_INVOKABLE QScriptValue setInterval(const QScriptValue& function, int intervalMS);
 
     /**jsdoc
      * Calls a function once, after a delay.
      * @function Script.setTimeout
      * @param {function} function - The function to call. This can be either the name of a function or an in-line definition.
      * @param {number} timeout - The delay after which to call the function, in ms.
-     * @returns {object} A handle to the timeout timer. This can be used in {@link Script.clearTimeout}.
+     * @returns {number} A handle to the timeout timer. This can be used in {@link Script.clearTimeout}.
      * @example <caption>Print a message once, after a second.</caption>
      * Script.setTimeout(function () {
      *     print("Timeout timer fired");
      * }, 1000);
      */
-    Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
+    Q_INVOKABLE QScriptValue setTimeout(const QScriptValue& function, int timeoutMS);
 
     /**jsdoc
      * Stops an interval timer set by {@link Script.setInterval|setInterval}.
      * @function Script.clearInterval
-     * @param {object} timer - The interval timer to stop.
+     * @param {number} timer - The interval timer to stop.
      * @example <caption>Stop an interval timer.</caption>
      * // Print a message every second.
      * var timer = Script.setInterval(function () {
@@ -481,12 +492,12 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(const QScriptValue& timer) { stopTimer(timer); }
 
     /**jsdoc
      * Stops a timeout timer set by {@link Script.setTimeout|setTimeout}.
      * @function Script.clearTimeout
-     * @param {object} timer - The timeout timer to stop.
+     * @param {number} timer - The timeout timer to stop.
      * @example <caption>Stop a timeout timer.</caption>
      * // Print a message after two seconds.
      * var timer = Script.setTimeout(function () {
@@ -496,7 +507,7 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(const QScriptValue& timer) { stopTimer(timer); }
 
     /**jsdoc
      * Prints a message to the program log and emits {@link Script.printedMessage}.
@@ -543,6 +554,52 @@ public:
      */
     Q_INVOKABLE void endProfileRange(const QString& label) const;
 
+    /**jsdoc
+     * Starts recording the time this script spends in each of its callbacks: timers, event handlers, entity methods and
+     * the <code>update</code> signal. Optionally also samples the script's call stack to find hot functions.
+     * @function Script.profileStart
+     * @param {number} [samplingInterval=0] - Milliseconds between call stack samples, <code>0</code> to not sample.
+     *     Sampling slows the script down noticeably while it is on.
+     * @param {number} [logInterval=0] - Seconds between reports written to the log, <code>0</code> for no reports.
+     */
+    Q_INVOKABLE void profileStart(int samplingInterval = 0, int logInterval = 0);
+
+    /**jsdoc
+     * Stops recording profiling data, keeping what was recorded so far.
+     * @function Script.profileStop
+     */
+    Q_INVOKABLE void profileStop();
+
+    /**jsdoc
+     * Discards the profiling data recorded so far.
+     * @function Script.profileReset
+     */
+    Q_INVOKABLE void profileReset();
+
+    /**jsdoc
+     * Gets the profiling data recorded so far.
+     * @function Script.profileResults
+     * @returns {object} An object with <code>profiledTime</code> (ms), <code>callbacks</code> (an array of
+     *     <code>{ label, calls, wallTime, cpuTime, selfWallTime, selfCpuTime, maxWallTime }</code> with times in ms,
+     *     most expensive first; the self times leave out the callbacks run from within the callback, e.g. by
+     *     <code>update</code>),
+     *     <code>samples</code>, <code>hotFunctions</code> (an array of <code>{ function, selfSamples, samples }</code>,
+     *     hottest first) and <code>timers</code> (<code>{ active, scheduled, fired }</code> counts since the script started).
+     */
+    Q_INVOKABLE QVariantMap profileResults() const;
+
+    /**jsdoc
+     * Writes a report of the profiling data recorded so far to the log.
+     * @function Script.profileLog
+     */
+    Q_INVOKABLE void profileLog() const;
+
+    ScriptProfiler& getProfiler() { return _profiler; }
+
+    int getNumActiveTimers() const { return (int)_timers.size(); }
+    quint64 getNumTimersScheduled() const { return _numTimersScheduled; }
+    quint64 getNumTimersFired() const { return _numTimersFired; }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Entity Script Related methods
 
@@ -667,6 +724,10 @@ public:
     int getNumRunningEntityScripts() const;
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
+    /// Wall-clock time (usec) this engine's thread has spent running each loaded entity script, empty unless tracked
+    QHash<EntityItemID, quint64> getEntityScriptRunTimes() const;
+    /// Measures the run time of entity scripts loaded from now on, for engines that share their scripts' load
+    void setTrackEntityScriptRunTimes(bool track) { _trackEntityScriptRunTimes = track; }
 
     void setScriptEngines(QSharedPointer<ScriptEngines>& scriptEngines) { _scriptEngines = scriptEngines; }
 
@@ -893,7 +954,7 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    void fireExpiredTimers();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -901,8 +962,9 @@ protected:
     void setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details);
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
-    QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    QScriptValue setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
+    void stopTimer(const QScriptValue& timer);
+    QString describeCallback(const QString& kind, const QScriptValue& function, const QUrl& sandboxURL) const;
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -932,10 +994,17 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    // timers are serviced once per frame from the script's loop, in msecs of usecTimestampNow()
+    TimerWheel<ScriptTimer> _timers;
+    std::vector<TimerWheel<ScriptTimer>::Handle> _expiredTimers;
+    quint64 _numTimersScheduled { 0 };
+    quint64 _numTimersFired { 0 };
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
+    // entries are added when a script is loaded, so measuring a call only needs the read lock
+    QHash<EntityItemID, std::shared_ptr<std::atomic<quint64>>> _entityScriptRunTimes;
+    std::atomic<bool> _trackEntityScriptRunTimes { false };
     EntityScriptContentAvailableMap _contentAvailableQueue;
 
     bool _isThreaded { false };
@@ -964,6 +1033,10 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    ScriptProfiler _profiler;
+    ScriptSamplingAgent* _samplingAgent { nullptr }; // owned by the engine, installed while sampling
+    QTimer* _profileLogTimer { nullptr };
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
@@ -0,0 +1,281 @@
+//
+//  ScriptProfiler.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+
+#include <QtCore/QSet>
+#include <QtScript/QScriptContext>
+#include <QtScript/QScriptContextInfo>
+#include <QtScript/QScriptEngine>
+
+#if defined(Q_OS_WIN)
+#include <Windows.h>
+#elif defined(Q_OS_MAC)
+#include <mach/mach.h>
+#else
+#include <time.h>
+#endif
+
+#include <SharedUtil.h>
+
+quint64 ScriptProfiler::getWallTime() {
+    return usecTimestampNow();
+}
+
+quint64 ScriptProfiler::getThreadCpuTime() {
+#if defined(Q_OS_WIN)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+    // 100 nsec units
+    quint64 kernel = ((quint64)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    quint64 user = ((quint64)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+    return (kernel + user) / 10;
+#elif defined(Q_OS_MAC)
+    thread_basic_info_data_t info;
+    mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+    mach_port_t thread = mach_thread_self();
+    kern_return_t result = thread_info(thread, THREAD_BASIC_INFO, (thread_info_t)&info, &count);
+    mach_port_deallocate(mach_task_self(), thread);
+    if (result != KERN_SUCCESS) {
+        return 0;
+    }
+    return (quint64)(info.user_time.seconds + info.system_time.seconds) * USECS_PER_SECOND +
+        info.user_time.microseconds + info.system_time.microseconds;
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return 0;
+    }
+    return (quint64)time.tv_sec * USECS_PER_SECOND + time.tv_nsec / NSECS_PER_USEC;
+#endif
+}
+
+void ScriptProfiler::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (enabled == isEnabled()) {
+        return;
+    }
+    quint64 now = getWallTime();
+    if (enabled) {
+        _enabledSince = now;
+    } else {
+        _profiledTime += now - _enabledSince;
+    }
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void ScriptProfiler::recordCall(const QString& label, quint64 wallTime, quint64 cpuTime, quint64 selfWallTime,
+                                quint64 selfCpuTime) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    CallStats& stats = _calls[label];
+    if (stats.label.isEmpty()) {
+        stats.label = label;
+    }
+    ++stats.numCalls;
+    stats.wallTime += wallTime;
+    stats.cpuTime += cpuTime;
+    stats.selfWallTime += selfWallTime;
+    stats.selfCpuTime += selfCpuTime;
+    stats.maxWallTime = std::max(stats.maxWallTime, wallTime);
+}
+
+void ScriptProfiler::recordSample(const QStringList& stack) {
+    if (stack.isEmpty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_numSamples;
+
+    // recursive functions count once per sample
+    QSet<QString> seen;
+    for (int i = 0; i < stack.size(); ++i) {
+        const QString& function = stack[i];
+        if (seen.contains(function)) {
+            continue;
+        }
+        seen.insert(function);
+
+        FunctionStats& stats = _functions[function];
+        if (stats.function.isEmpty()) {
+            stats.function = function;
+        }
+        ++stats.numSamples;
+        if (i == 0) {
+            ++stats.numSelfSamples;
+        }
+    }
+}
+
+void ScriptProfiler::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _calls.clear();
+    _functions.clear();
+    _numSamples = 0;
+    _profiledTime = 0;
+    _enabledSince = getWallTime();
+}
+
+std::vector<ScriptProfiler::CallStats> ScriptProfiler::getCallStats() const {
+    std::vector<CallStats> result;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        result.reserve(_calls.size());
+        for (const auto& stats : _calls) {
+            result.push_back(stats);
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const CallStats& a, const CallStats& b) {
+        return a.wallTime > b.wallTime;
+    });
+    return result;
+}
+
+std::vector<ScriptProfiler::FunctionStats> ScriptProfiler::getHotFunctions(size_t maxFunctions) const {
+    std::vector<FunctionStats> result;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        result.reserve(_functions.size());
+        for (const auto& stats : _functions) {
+            result.push_back(stats);
+        }
+    }
+    auto hotter = [](const FunctionStats& a, const FunctionStats& b) {
+        return a.numSelfSamples > b.numSelfSamples ||
+            (a.numSelfSamples == b.numSelfSamples && a.numSamples > b.numSamples);
+    };
+    if (result.size() > maxFunctions) {
+        std::partial_sort(result.begin(), result.begin() + maxFunctions, result.end(), hotter);
+        result.resize(maxFunctions);
+    } else {
+        std::sort(result.begin(), result.end(), hotter);
+    }
+    return result;
+}
+
+int ScriptProfiler::getNumSamples() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numSamples;
+}
+
+quint64 ScriptProfiler::getProfiledTime() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _profiledTime + (isEnabled() ? getWallTime() - _enabledSince : 0);
+}
+
+QVariantMap ScriptProfiler::toVariantMap(size_t maxFunctions) const {
+    QVariantMap result;
+    result["enabled"] = isEnabled();
+    result["profiledTime"] = (double)getProfiledTime() / USECS_PER_MSEC;
+    result["samplingInterval"] = (double)getSamplingInterval() / USECS_PER_MSEC;
+
+    QVariantList callbacks;
+    for (const auto& stats : getCallStats()) {
+        QVariantMap callback;
+        callback["label"] = stats.label;
+        callback["calls"] = stats.numCalls;
+        callback["wallTime"] = (double)stats.wallTime / USECS_PER_MSEC;
+        callback["cpuTime"] = (double)stats.cpuTime / USECS_PER_MSEC;
+        callback["selfWallTime"] = (double)stats.selfWallTime / USECS_PER_MSEC;
+        callback["selfCpuTime"] = (double)stats.selfCpuTime / USECS_PER_MSEC;
+        callback["maxWallTime"] = (double)stats.maxWallTime / USECS_PER_MSEC;
+        callbacks.push_back(callback);
+    }
+    result["callbacks"] = callbacks;
+
+    result["samples"] = getNumSamples();
+    QVariantList functions;
+    for (const auto& stats : getHotFunctions(maxFunctions)) {
+        QVariantMap function;
+        function["function"] = stats.function;
+        function["selfSamples"] = stats.numSelfSamples;
+        function["samples"] = stats.numSamples;
+        functions.push_back(function);
+    }
+    result["hotFunctions"] = functions;
+    return result;
+}
+
+QString ScriptProfiler::formatReport(size_t maxEntries) const {
+    quint64 profiledTime = getProfiledTime();
+    QString report = QString("profiled for %1 ms\n").arg((double)profiledTime / USECS_PER_MSEC, 0, 'f', 0);
+
+    auto callStats = getCallStats();
+    // the share of the profiled time is the self time, nested callbacks would otherwise be counted twice
+    report += "    wall ms   self ms   cpu ms    calls   max ms   % self  callback\n";
+    for (size_t i = 0; i < callStats.size() && i < maxEntries; ++i) {
+        const CallStats& stats = callStats[i];
+        double share = profiledTime > 0 ? 100.0 * stats.selfWallTime / profiledTime : 0.0;
+        report += QString("%1 %2 %3 %4 %5 %6  %7\n")
+            .arg((double)stats.wallTime / USECS_PER_MSEC, 10, 'f', 1)
+            .arg((double)stats.selfWallTime / USECS_PER_MSEC, 9, 'f', 1)
+            .arg((double)stats.cpuTime / USECS_PER_MSEC, 8, 'f', 1)
+            .arg(stats.numCalls, 8)
+            .arg((double)stats.maxWallTime / USECS_PER_MSEC, 8, 'f', 2)
+            .arg(share, 7, 'f', 1)
+            .arg(stats.label);
+    }
+
+    int numSamples = getNumSamples();
+    if (numSamples > 0) {
+        report += QString("%1 stack samples\n").arg(numSamples);
+        report += "     self %    total %  function\n";
+        for (const auto& stats : getHotFunctions(maxEntries)) {
+            report += QString("%1 %2  %3\n")
+                .arg(100.0 * stats.numSelfSamples / numSamples, 10, 'f', 1)
+                .arg(100.0 * stats.numSamples / numSamples, 10, 'f', 1)
+                .arg(stats.function);
+        }
+    }
+    return report;
+}
+
+// reading the clock on every statement would cost more than the statements themselves
+const int STATEMENTS_PER_CLOCK_CHECK = 32;
+const int MAX_SAMPLED_STACK_DEPTH = 64;
+
+ScriptSamplingAgent::ScriptSamplingAgent(QScriptEngine* engine, ScriptProfiler& profiler) :
+    QScriptEngineAgent(engine),
+    _profiler(profiler)
+{
+}
+
+void ScriptSamplingAgent::positionChange(qint64 scriptId, int lineNumber, int columnNumber) {
+    if (--_statementsUntilClockCheck > 0) {
+        return;
+    }
+    _statementsUntilClockCheck = STATEMENTS_PER_CLOCK_CHECK;
+
+    quint64 now = ScriptProfiler::getWallTime();
+    int samplingInterval = _profiler.getSamplingInterval();
+    if (now < _nextSampleTime || samplingInterval <= 0 || !_profiler.isEnabled()) {
+        return;
+    }
+    _nextSampleTime = now + samplingInterval;
+
+    QStringList stack;
+    for (auto context = engine()->currentContext(); context && stack.size() < MAX_SAMPLED_STACK_DEPTH;
+            context = context->parentContext()) {
+        QScriptContextInfo contextInfo { context };
+        if (contextInfo.functionType() == QScriptContextInfo::NativeFunction) {
+            continue;
+        }
+        QString name = contextInfo.functionName();
+        if (name.isEmpty()) {
+            name = context->parentContext() ? "(anonymous)" : "(global)";
+        }
+        stack.push_back(QString("%1 (%2:%3)").arg(name, contextInfo.fileName())
+            .arg(contextInfo.functionStartLineNumber()));
+    }
+    _profiler.recordSample(stack);
+}
@@ -0,0 +1,147 @@
+//
+//  ScriptProfiler.h
+//  libraries/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptProfiler_h
+#define hifi_ScriptProfiler_h
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtScript/QScriptEngineAgent>
+
+/// Accounting of the time a script engine spends in each kind of callback (timers, event handlers, entity methods,
+/// the update signal), plus hot functions found by sampling the script call stack.
+///
+/// Disabled by default.  While disabled a Scope costs a single relaxed atomic load and its label is never built.
+/// Results are recorded on the engine's thread and may be read from any thread.
+///
+/// Scopes nest (the update signal runs entity and timer callbacks of its own), so each callback gets both its total
+/// time and its self time, the latter leaving out the time spent in the scopes nested in it.  Self times add up to
+/// at most the profiled time, total times don't.
+class ScriptProfiler {
+public:
+    class CallStats {
+    public:
+        QString label;
+        int numCalls { 0 };
+        quint64 wallTime { 0 }; // usec, including nested scopes
+        quint64 cpuTime { 0 }; // usec of thread CPU time, including nested scopes
+        quint64 selfWallTime { 0 }; // usec, not counting nested scopes
+        quint64 selfCpuTime { 0 }; // usec of thread CPU time, not counting nested scopes
+        quint64 maxWallTime { 0 }; // usec
+    };
+
+    class FunctionStats {
+    public:
+        QString function; // "name (file:line)"
+        int numSelfSamples { 0 }; // samples with the function at the top of the stack
+        int numSamples { 0 }; // samples with the function anywhere on the stack
+    };
+
+    /// Times a callback from construction to destruction.  The label function is only called while profiling.
+    class Scope {
+    public:
+        template <typename LabelFunction>
+        Scope(ScriptProfiler& profiler, LabelFunction labelFunction) {
+            if (profiler.isEnabled()) {
+                _profiler = &profiler;
+                _label = labelFunction();
+                _parent = profiler._currentScope;
+                profiler._currentScope = this;
+                _startWallTime = getWallTime();
+                _startCpuTime = getThreadCpuTime();
+            }
+        }
+        ~Scope() {
+            if (_profiler) {
+                quint64 wallTime = getWallTime() - _startWallTime;
+                quint64 cpuTime = getThreadCpuTime() - _startCpuTime;
+                _profiler->_currentScope = _parent;
+                if (_parent) {
+                    _parent->_nestedWallTime += wallTime;
+                    _parent->_nestedCpuTime += cpuTime;
+                }
+                _profiler->recordCall(_label, wallTime, cpuTime, wallTime - std::min(_nestedWallTime, wallTime),
+                                      cpuTime - std::min(_nestedCpuTime, cpuTime));
+            }
+        }
+
+    private:
+        ScriptProfiler* _profiler { nullptr };
+        Scope* _parent { nullptr };
+        QString _label;
+        quint64 _startWallTime { 0 };
+        quint64 _startCpuTime { 0 };
+        quint64 _nestedWallTime { 0 };
+        quint64 _nestedCpuTime { 0 };
+    };
+
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    /// Minimum time between two samples of the call stack, 0 when sampling is off
+    int getSamplingInterval() const { return _samplingInterval.load(std::memory_order_relaxed); }
+    void setSamplingInterval(int usecs) { _samplingInterval.store(usecs, std::memory_order_relaxed); }
+
+    void recordCall(const QString& label, quint64 wallTime, quint64 cpuTime, quint64 selfWallTime, quint64 selfCpuTime);
+    /// \param stack one entry per script function, innermost first
+    void recordSample(const QStringList& stack);
+
+    void reset();
+
+    /// Callbacks ordered by total wall time, most expensive first
+    std::vector<CallStats> getCallStats() const;
+    /// Functions ordered by number of samples they were on top of the stack, hottest first
+    std::vector<FunctionStats> getHotFunctions(size_t maxFunctions) const;
+    int getNumSamples() const;
+    /// usec since profiling was last enabled or reset, while enabled
+    quint64 getProfiledTime() const;
+
+    QVariantMap toVariantMap(size_t maxFunctions) const;
+    QString formatReport(size_t maxEntries) const;
+
+    static quint64 getWallTime(); // usec
+    static quint64 getThreadCpuTime(); // usec, 0 where the platform doesn't tell
+
+private:
+    std::atomic<bool> _enabled { false };
+    std::atomic<int> _samplingInterval { 0 };
+
+    mutable std::mutex _mutex;
+    QHash<QString, CallStats> _calls;
+    QHash<QString, FunctionStats> _functions;
+    int _numSamples { 0 };
+    quint64 _profiledTime { 0 };
+    quint64 _enabledSince { 0 };
+
+    Scope* _currentScope { nullptr }; // innermost open scope, only touched on the engine's thread
+};
+
+/// Samples the script call stack into a ScriptProfiler while the engine runs statements.  Only installed on the
+/// engine (QScriptEngine::setAgent) while sampling, since an installed agent slows down every statement.
+class ScriptSamplingAgent : public QScriptEngineAgent {
+public:
+    ScriptSamplingAgent(QScriptEngine* engine, ScriptProfiler& profiler);
+
+    void positionChange(qint64 scriptId, int lineNumber, int columnNumber) override;
+
+private:
+    ScriptProfiler& _profiler;
+    quint64 _nextSampleTime { 0 };
+    int _statementsUntilClockCheck { 0 };
+};
+
+#endif // hifi_ScriptProfiler_h
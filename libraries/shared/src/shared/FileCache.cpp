@@ -217,6 +217,12 @@ FilePointer FileCache::getFile(const Key& key) {
     return file;
 }
 
+void FileCache::removeFile(const FilePointer& file) {
+    Lock lock(_mutex);
+    eject(file);
+    emit dirty();
+}
+
 std::string FileCache::getFilepath(const Key& key) {
     return _dirpath + DIR_SEP + key + EXT_SEP + _ext;
 }
@@ -98,6 +98,9 @@ public:
     // Add file to the cache and return the cache entry.  
     FilePointer writeFile(const char* data, Metadata&& metadata, bool overwrite = false);
     FilePointer getFile(const Key& key);
+    // Remove a file from the cache, for instance when its content turns out to be corrupt.  It is deleted from disk
+    // once the last pointer to it is released.
+    void removeFile(const FilePointer& file);
 
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath);
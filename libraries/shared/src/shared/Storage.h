@@ -60,7 +60,8 @@ namespace storage {
     class FileStorage : public Storage {
     public:
         static StoragePointer create(const QString& filename, size_t size, const uint8_t* data);
-        FileStorage(const QString& filename);
+        // A read only storage maps the file read only, so its pages stay clean and the OS can drop them at will
+        FileStorage(const QString& filename, bool readOnly = false);
         ~FileStorage();
         // Prevent copying
         FileStorage(const FileStorage& other) = delete;
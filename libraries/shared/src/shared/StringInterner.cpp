@@ -0,0 +1,87 @@
+//
+//  StringInterner.cpp
+//  libraries/shared/src/shared
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StringInterner.h"
+
+#include <algorithm>
+
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+
+namespace {
+
+// A prune walks the whole table, so it waits for the table to double: the cost of pruning stays proportional to the
+// insertions, however large the table grows
+const int MIN_PRUNE_SIZE = 512; // strings
+
+class InternTable {
+public:
+    QMutex mutex;
+    QSet<QString> strings;
+    int pruneSize { MIN_PRUNE_SIZE };
+    quint64 numHits { 0 };
+
+    void prune() {
+        // a detached string is only referenced by the table itself
+        auto itr = strings.begin();
+        while (itr != strings.end()) {
+            if (itr->isDetached()) {
+                itr = strings.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+        pruneSize = std::max(MIN_PRUNE_SIZE, 2 * strings.size());
+    }
+};
+
+InternTable& getTable() {
+    static InternTable table;
+    return table;
+}
+
+}
+
+QString StringInterner::intern(const QString& value) {
+    if (value.isEmpty()) {
+        return value;
+    }
+
+    InternTable& table = getTable();
+    QMutexLocker locker(&table.mutex);
+    auto itr = table.strings.constFind(value);
+    if (itr != table.strings.constEnd()) {
+        ++table.numHits;
+        return *itr;
+    }
+
+    if (table.strings.size() >= table.pruneSize) {
+        table.prune();
+    }
+    return *table.strings.insert(value);
+}
+
+void StringInterner::prune() {
+    InternTable& table = getTable();
+    QMutexLocker locker(&table.mutex);
+    table.prune();
+}
+
+StringInterner::Stats StringInterner::getStats() {
+    InternTable& table = getTable();
+    QMutexLocker locker(&table.mutex);
+    Stats stats;
+    stats.numStrings = table.strings.size();
+    for (const auto& string : table.strings) {
+        stats.numBytes += string.size() * sizeof(QChar);
+    }
+    stats.numHits = table.numHits;
+    return stats;
+}
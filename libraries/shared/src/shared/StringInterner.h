@@ -0,0 +1,37 @@
+//
+//  StringInterner.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Shared_StringInterner_h
+#define hifi_Shared_StringInterner_h
+
+#include <QtCore/QString>
+
+/// Process-wide table of shared string payloads.
+///
+/// QString is implicitly shared, so handing out the table's copy of an equal string makes every holder point at one
+/// buffer instead of each keeping its own (thousands of entities with the same model URL or script end up sharing a
+/// single copy).  Strings nobody references outside the table anymore are dropped when the table is pruned, which
+/// happens on its own whenever the table has doubled in size since it was last pruned.
+class StringInterner {
+public:
+    class Stats {
+    public:
+        int numStrings { 0 };
+        size_t numBytes { 0 };   // payload bytes held by the table
+        quint64 numHits { 0 };   // calls that returned an existing copy
+    };
+
+    static QString intern(const QString& value);
+    static void prune();
+    static Stats getStats();
+};
+
+#endif
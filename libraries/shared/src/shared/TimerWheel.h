@@ -0,0 +1,261 @@
+//
+//  TimerWheel.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Shared_TimerWheel_h
+#define hifi_Shared_TimerWheel_h
+
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+/// Hierarchical timer wheel: timers are scheduled, cancelled and rescheduled in O(1) and expire in batches when the
+/// owner advances the wheel, typically once per frame.
+///
+/// Time is counted in ticks of whatever unit the owner picks (e.g. msecs).  Four levels of 64 slots each cover 2^24
+/// ticks; timers further out sit in the top level and are placed again as the wheel turns.
+///
+/// Handles are opaque, never 0, and fit in the 53 bits of a double so they can be handed to scripts.  A handle goes
+/// stale when its timer is cancelled and is never reused for a later timer: a node's generation changes each time it
+/// is freed, and a node whose 21 bit generation would wrap around is retired instead of being freed.
+template <typename T>
+class TimerWheel {
+public:
+    using Handle = uint64_t;
+    static const Handle INVALID_HANDLE = 0;
+
+    explicit TimerWheel(uint64_t now = 0) : _currentTick(now) { _heads.fill(NONE); }
+
+    /// Schedules a timer at absolute tick 'expiry'.  A timer due now or in the past expires on the next advance().
+    Handle schedule(uint64_t expiry, T value) {
+        int32_t index;
+        if (_free != NONE) {
+            index = _free;
+            _free = _nodes[index].next;
+        } else {
+            index = (int32_t)_nodes.size();
+            _nodes.emplace_back();
+        }
+        Node& node = _nodes[index];
+        node.value = std::move(value);
+        node.state = SCHEDULED;
+        node.expiry = expiry;
+        link(index, false);
+        ++_size;
+        return makeHandle(index, node.generation);
+    }
+
+    /// Moves a scheduled or expired timer to a new expiry, keeping its handle
+    bool reschedule(Handle handle, uint64_t expiry) {
+        int32_t index = findNode(handle);
+        if (index == NONE) {
+            return false;
+        }
+        Node& node = _nodes[index];
+        if (node.state == SCHEDULED) {
+            unlink(index);
+        }
+        node.state = SCHEDULED;
+        node.expiry = expiry;
+        link(index, false);
+        return true;
+    }
+
+    /// Removes a scheduled or expired timer, its handle goes stale
+    bool cancel(Handle handle) {
+        int32_t index = findNode(handle);
+        if (index == NONE) {
+            return false;
+        }
+        release(index);
+        return true;
+    }
+
+    bool contains(Handle handle) const { return findNode(handle) != NONE; }
+
+    /// The timer's value, nullptr if the handle is stale
+    T* get(Handle handle) {
+        int32_t index = findNode(handle);
+        return index != NONE ? &_nodes[index].value : nullptr;
+    }
+
+    /// Turns the wheel to 'now' and appends the timers that expired on the way to 'expired', in expiry order.
+    /// Expired timers stay allocated until they are rescheduled (e.g. intervals) or cancelled (e.g. timeouts).
+    void advance(uint64_t now, std::vector<Handle>& expired) {
+        if (_numScheduled == 0) {
+            _currentTick = std::max(_currentTick, now);
+            return;
+        }
+        while (_currentTick < now) {
+            ++_currentTick;
+            // when a level wraps around, the next slot of the level above moves down
+            for (int level = 1; level < NUM_LEVELS; ++level) {
+                if (_currentTick & ((1ULL << (level * SLOT_BITS)) - 1)) {
+                    break;
+                }
+                cascade(level, (_currentTick >> (level * SLOT_BITS)) & SLOT_MASK);
+            }
+
+            int32_t index = _heads[_currentTick & SLOT_MASK];
+            _heads[_currentTick & SLOT_MASK] = NONE;
+            while (index != NONE) {
+                Node& node = _nodes[index];
+                int32_t next = node.next;
+                node.state = EXPIRED;
+                node.prev = node.next = NONE;
+                --_numScheduled;
+                expired.push_back(makeHandle(index, node.generation));
+                index = next;
+            }
+            if (_numScheduled == 0) {
+                _currentTick = now;
+                break;
+            }
+        }
+    }
+
+    std::vector<Handle> getHandles() const {
+        std::vector<Handle> handles;
+        handles.reserve(_size);
+        for (int32_t i = 0; i < (int32_t)_nodes.size(); ++i) {
+            if (_nodes[i].state != FREE) {
+                handles.push_back(makeHandle(i, _nodes[i].generation));
+            }
+        }
+        return handles;
+    }
+
+    void clear() {
+        for (int32_t i = 0; i < (int32_t)_nodes.size(); ++i) {
+            if (_nodes[i].state != FREE) {
+                release(i);
+            }
+        }
+    }
+
+    size_t size() const { return _size; }
+    size_t getNumScheduled() const { return _numScheduled; }
+    uint64_t getCurrentTick() const { return _currentTick; }
+
+private:
+    static const int SLOT_BITS = 6;
+    static const int NUM_SLOTS = 1 << SLOT_BITS;
+    static const uint64_t SLOT_MASK = NUM_SLOTS - 1;
+    static const int NUM_LEVELS = 4;
+    static const uint64_t MAX_DELTA = (1ULL << (NUM_LEVELS * SLOT_BITS)) - 1;
+    static const int32_t NONE = -1;
+    static const uint32_t GENERATION_MASK = (1U << 21) - 1;
+
+    enum State : uint8_t {
+        FREE,
+        SCHEDULED,
+        EXPIRED
+    };
+
+    struct Node {
+        T value;
+        uint64_t expiry { 0 };
+        int32_t prev { NONE };
+        int32_t next { NONE };
+        uint32_t generation { 0 };
+        uint16_t slot { 0 };
+        State state { FREE };
+    };
+
+    static Handle makeHandle(int32_t index, uint32_t generation) {
+        return ((Handle)generation << 32) | (Handle)(index + 1);
+    }
+
+    int32_t findNode(Handle handle) const {
+        int32_t index = (int32_t)(handle & 0xffffffff) - 1;
+        if (index < 0 || index >= (int32_t)_nodes.size()) {
+            return NONE;
+        }
+        const Node& node = _nodes[index];
+        if (node.state == FREE || node.generation != (uint32_t)(handle >> 32)) {
+            return NONE;
+        }
+        return index;
+    }
+
+    void link(int32_t index, bool cascading) {
+        Node& node = _nodes[index];
+        // the current tick's slot was already emptied, except while it is being refilled by a cascade
+        uint64_t earliest = cascading ? _currentTick : _currentTick + 1;
+        uint64_t expiry = std::max(node.expiry, earliest);
+        uint64_t delta = std::min(expiry - _currentTick, MAX_DELTA);
+        expiry = _currentTick + delta;
+
+        int level = 0;
+        while (level < NUM_LEVELS - 1 && delta >= (1ULL << ((level + 1) * SLOT_BITS))) {
+            ++level;
+        }
+        node.slot = (uint16_t)(level * NUM_SLOTS + ((expiry >> (level * SLOT_BITS)) & SLOT_MASK));
+        node.prev = NONE;
+        node.next = _heads[node.slot];
+        if (node.next != NONE) {
+            _nodes[node.next].prev = index;
+        }
+        _heads[node.slot] = index;
+        ++_numScheduled;
+    }
+
+    void unlink(int32_t index) {
+        Node& node = _nodes[index];
+        if (node.prev != NONE) {
+            _nodes[node.prev].next = node.next;
+        } else {
+            _heads[node.slot] = node.next;
+        }
+        if (node.next != NONE) {
+            _nodes[node.next].prev = node.prev;
+        }
+        node.prev = node.next = NONE;
+        --_numScheduled;
+    }
+
+    void cascade(int level, uint64_t slot) {
+        int32_t index = _heads[level * NUM_SLOTS + slot];
+        _heads[level * NUM_SLOTS + slot] = NONE;
+        while (index != NONE) {
+            int32_t next = _nodes[index].next;
+            --_numScheduled;
+            link(index, true);
+            index = next;
+        }
+    }
+
+    void release(int32_t index) {
+        Node& node = _nodes[index];
+        if (node.state == SCHEDULED) {
+            unlink(index);
+        }
+        node.value = T();
+        node.state = FREE;
+        --_size;
+        if (node.generation == GENERATION_MASK) {
+            // a new timer here would get the handles of timers long gone, the node stays free but unused
+            return;
+        }
+        ++node.generation;
+        node.next = _free;
+        _free = index;
+    }
+
+    std::vector<Node> _nodes;
+    std::array<int32_t, NUM_LEVELS * NUM_SLOTS> _heads;
+    int32_t _free { NONE };
+    size_t _size { 0 };
+    size_t _numScheduled { 0 };
+    uint64_t _currentTick;
+};
+
+#endif // hifi_Shared_TimerWheel_h
@@ -60,15 +60,26 @@ void Transaction::merge(std::vector<Transaction>&& transactionContainer) {
 }
 
 
+// Both return 1 if target had to grow, 0 otherwise
 template <typename T>
-void moveElements(T& target, T& source) {
+uint32_t moveElements(T& target, T& source) {
+    if (source.empty()) {
+        return 0;
+    }
+    auto capacity = target.capacity();
     target.insert(target.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
     source.clear();
+    return (target.capacity() != capacity) ? 1 : 0;
 }
 
 template <typename T>
-void copyElements(T& target, const T& source) {
+uint32_t copyElements(T& target, const T& source) {
+    if (source.empty()) {
+        return 0;
+    }
+    auto capacity = target.capacity();
     target.insert(target.end(), source.begin(), source.end());
+    return (target.capacity() != capacity) ? 1 : 0;
 }
 
 
@@ -84,16 +95,28 @@ void Transaction::update(const Updates& updates) {
     copyElements(_updatedItems, updates);
 }
 
+uint32_t Transaction::moveFrom(Transaction& transaction) {
+    uint32_t numAllocations = 0;
+    numAllocations += moveElements(_resetItems, transaction._resetItems);
+    numAllocations += moveElements(_removedItems, transaction._removedItems);
+    numAllocations += moveElements(_updatedItems, transaction._updatedItems);
+    return numAllocations;
+}
+
+uint32_t Transaction::copyFrom(const Transaction& transaction) {
+    uint32_t numAllocations = 0;
+    numAllocations += copyElements(_resetItems, transaction._resetItems);
+    numAllocations += copyElements(_removedItems, transaction._removedItems);
+    numAllocations += copyElements(_updatedItems, transaction._updatedItems);
+    return numAllocations;
+}
+
 void Transaction::merge(Transaction&& transaction) {
-    moveElements(_resetItems, transaction._resetItems);
-    moveElements(_removedItems, transaction._removedItems);
-    moveElements(_updatedItems, transaction._updatedItems);
+    moveFrom(transaction);
 }
 
 void Transaction::merge(const Transaction& transaction) {
-    copyElements(_resetItems, transaction._resetItems);
-    copyElements(_removedItems, transaction._removedItems);
-    copyElements(_updatedItems, transaction._updatedItems);
+    copyFrom(transaction);
 }
 
 void Transaction::clear() {
@@ -112,8 +135,11 @@ Collection::~Collection() {
 }
 
 void Collection::clear() {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.clear();
+    for (auto& buffer : _transactionBuffers) {
+        std::unique_lock<std::mutex> lock(buffer.mutex);
+        buffer.transaction.clear();
+    }
+    std::unique_lock<std::mutex> lock(_transactionFramesMutex);
     _transactionFrames.clear();
 }
 
@@ -126,29 +152,49 @@ bool Collection::isAllocatedID(const ProxyID& id) const {
     return _IDAllocator.checkIndex(id);
 }
 
+Collection::TransactionBuffer& Collection::getTransactionBuffer() {
+    static std::atomic<uint32_t> nextBufferIndex { 0 };
+    static thread_local uint32_t bufferIndex = nextBufferIndex.fetch_add(1) % NUM_TRANSACTION_BUFFERS;
+    return _transactionBuffers[bufferIndex];
+}
+
 /// Enqueue change batch to the Collection
 void Collection::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    auto& buffer = getTransactionBuffer();
+    std::unique_lock<std::mutex> lock(buffer.mutex);
+    buffer.transaction.copyFrom(transaction);
 }
 
 void Collection::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    auto& buffer = getTransactionBuffer();
+    std::unique_lock<std::mutex> lock(buffer.mutex);
+    buffer.transaction.moveFrom(transaction);
 }
 
 uint32_t Collection::enqueueFrame() {
-    TransactionQueue localTransactionQueue;
+    Transaction consolidatedTransaction;
     {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+        std::unique_lock<std::mutex> lock(_transactionFramesMutex);
+        if (!_freeTransactionFrames.empty()) {
+            consolidatedTransaction = std::move(_freeTransactionFrames.back());
+            _freeTransactionFrames.pop_back();
+        }
+    }
+
+    {
+        // Drained under all the buffer locks so the frame is one cut across the producers, as in render::Scene
+        std::array<std::unique_lock<std::mutex>, NUM_TRANSACTION_BUFFERS> locks;
+        for (uint32_t i = 0; i < NUM_TRANSACTION_BUFFERS; ++i) {
+            locks[i] = std::unique_lock<std::mutex>(_transactionBuffers[i].mutex);
+        }
+        for (auto& buffer : _transactionBuffers) {
+            consolidatedTransaction.moveFrom(buffer.transaction);
+        }
     }
 
-    Transaction consolidatedTransaction;
-    consolidatedTransaction.merge(std::move(localTransactionQueue));
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        _transactionFrames.push_back(consolidatedTransaction);
+        _transactionFrames.push_back(std::move(consolidatedTransaction));
     }
 
     return ++_transactionFrameNumber;
@@ -156,17 +202,28 @@ uint32_t Collection::enqueueFrame() {
 
 
 void Collection::processTransactionQueue() {
-    static TransactionFrames queuedFrames;
     {
         // capture the queued frames and clear the queue
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        queuedFrames.swap(_transactionFrames);
+        _processedTransactionFrames.swap(_transactionFrames);
     }
 
     // go through the queue of frames and process them
-    for (auto& frame : queuedFrames) {
+    for (auto& frame : _processedTransactionFrames) {
         processTransactionFrame(frame);
+        frame.clear();
     }
 
-    queuedFrames.clear();
+    {
+        // hand the frames back to enqueueFrame, with their memory
+        const size_t MAX_FREE_TRANSACTION_FRAMES = 4;
+        std::unique_lock<std::mutex> lock(_transactionFramesMutex);
+        for (auto& frame : _processedTransactionFrames) {
+            if (_freeTransactionFrames.size() >= MAX_FREE_TRANSACTION_FRAMES) {
+                break;
+            }
+            _freeTransactionFrames.push_back(std::move(frame));
+        }
+    }
+    _processedTransactionFrames.clear();
 }
@@ -12,6 +12,7 @@
 #ifndef hifi_workload_Transaction_h
 #define hifi_workload_Transaction_h
 
+#include <array>
 #include <atomic>
 #include <mutex>
 #include <memory>
@@ -105,6 +106,10 @@ public:
 
     Transaction() {}
     ~Transaction() {}
+    Transaction(const Transaction& transaction) = default;
+    Transaction(Transaction&& transaction) = default;
+    Transaction& operator=(const Transaction& transaction) = default;
+    Transaction& operator=(Transaction&& transaction) = default;
 
     // Proxy transactions
     void reset(ProxyID id, const ProxyPayload& sphere, const Owner& owner);
@@ -124,7 +129,11 @@ public:
     void clear();
 
 protected:
+    friend class Collection;
 
+    // Append the commands of transaction, returning how many of the command lists had to grow to hold them
+    uint32_t moveFrom(Transaction& transaction);
+    uint32_t copyFrom(const Transaction& transaction);
 
     Resets _resetItems;
     Removes _removedItems;
@@ -165,13 +174,21 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     indexed_container::Allocator<> _IDAllocator;
 
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
-
+    // Per thread transaction buffers and recycled frames, as in render::Scene
+    static const uint32_t NUM_TRANSACTION_BUFFERS { 16 };
+    class TransactionBuffer {
+    public:
+        std::mutex mutex;
+        Transaction transaction;
+    };
+    std::array<TransactionBuffer, NUM_TRANSACTION_BUFFERS> _transactionBuffers;
+    TransactionBuffer& getTransactionBuffer();
 
     std::mutex _transactionFramesMutex;
     using TransactionFrames = std::vector<Transaction>;
     TransactionFrames _transactionFrames;
+    TransactionFrames _freeTransactionFrames;
+    TransactionFrames _processedTransactionFrames;
     uint32_t _transactionFrameNumber{ 0 };
 
     // Process one transaction frame
@@ -97,6 +97,34 @@ Item {
             ]
         }
 
+        PlotPerf {
+            title: "Transactions"
+            height: parent.evalEvenHeight()
+            object: stats.config
+            plots: [
+                {
+                    prop: "frameTransactionCount",
+                    label: "Transactions",
+                    color: "#00B4EF"
+                },
+                {
+                    prop: "frameTransactionUpdateCount",
+                    label: "Updates",
+                    color: "#1AC567"
+                },
+                {
+                    prop: "frameTransactionCoalescedUpdateCount",
+                    label: "Coalesced",
+                    color: "#FED959"
+                },
+                {
+                    prop: "frameTransactionAllocationCount",
+                    label: "Allocations",
+                    color: "#E2334D"
+                }
+            ]
+        }
+
         property var drawOpaqueConfig: Render.getConfig("RenderMainView.DrawOpaqueDeferred")
         property var drawTransparentConfig: Render.getConfig("RenderMainView.DrawTransparentDeferred")
         property var drawLightConfig: Render.getConfig("RenderMainView.DrawLight")
@@ -25,6 +25,9 @@ Script.include("/~/system/libraries/controllerDispatcherUtils.js");
 (function() {
     Script.include("/~/system/libraries/pointersUtils.js");
 
+    // the dispatcher and its modules read the same nearby entities several times each frame
+    Entities.setPropertySnapshotsEnabled(true);
+
     var NEAR_MAX_RADIUS = 0.1;
     var NEAR_TABLET_MAX_RADIUS = 0.05;
 
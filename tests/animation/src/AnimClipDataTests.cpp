@@ -0,0 +1,113 @@
+//
+//  AnimClipDataTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipDataTests.h"
+
+#include <AnimClipData.h>
+#include <AnimUtil.h>
+#include <GLMHelpers.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimClipDataTests)
+
+const int NUM_FRAMES = 300;
+const int NUM_JOINTS = 4;
+// translations in centimeters, like most avatars
+const float UNIT_SCALE = 0.01f;
+
+// joint 0 holds still, joint 1 spins, joint 2 bobs up and down, joint 3 moves linearly
+static std::vector<AnimPoseVec> makeAnim() {
+    std::vector<AnimPoseVec> anim(NUM_FRAMES, AnimPoseVec(NUM_JOINTS));
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        float t = (float)frame / 30.0f;
+        AnimPoseVec& poses = anim[frame];
+        poses[0] = AnimPose(glm::vec3(1.0f), glm::angleAxis(0.5f, Vectors::UNIT_X), glm::vec3(0.0f, 100.0f, 0.0f));
+        poses[1] = AnimPose(glm::vec3(1.0f), glm::angleAxis(2.0f * t, Vectors::UNIT_Y), glm::vec3(0.0f, 10.0f, 0.0f));
+        poses[2] = AnimPose(glm::vec3(1.0f), Quaternions::IDENTITY, glm::vec3(0.0f, 10.0f + 5.0f * sinf(3.0f * t), 0.0f));
+        poses[3] = AnimPose(glm::vec3(1.0f), Quaternions::IDENTITY, glm::vec3(20.0f * t, 0.0f, 0.0f));
+    }
+    return anim;
+}
+
+void AnimClipDataTests::testConstantTracks() {
+    AnimClipData clipData(makeAnim(), UNIT_SCALE);
+    const auto& stats = clipData.getStats();
+
+    QCOMPARE(stats.numFrames, NUM_FRAMES);
+    QCOMPARE(stats.numJoints, NUM_JOINTS);
+    // every scale, joint 0 entirely, the translation of joint 1 and the rotations of joints 2 and 3
+    QCOMPARE(stats.numConstantTracks, 9);
+    QCOMPARE(stats.numAnimatedTracks, 3);
+    QVERIFY(stats.compressedSize < stats.rawSize / 4);
+
+    qDebug() << clipData.formatStats();
+}
+
+void AnimClipDataTests::testErrorBounds() {
+    auto anim = makeAnim();
+    AnimClipData clipData(anim, UNIT_SCALE);
+    const auto& stats = clipData.getStats();
+
+    // six byte quaternions are good to about 1e-4 radians
+    const float QUANTIZATION_ERROR = 2.0e-4f;
+    QVERIFY(stats.maxRotationError <= AnimClipData::DEFAULT_ROTATION_TOLERANCE + QUANTIZATION_ERROR);
+    QVERIFY(stats.maxTranslationError <= AnimClipData::DEFAULT_TRANSLATION_TOLERANCE + EPSILON);
+    QVERIFY(stats.maxScaleError <= AnimClipData::DEFAULT_SCALE_TOLERANCE + EPSILON);
+
+    // the linear motion of joint 3 needs no keys in between, other than those bounding the key spans
+    auto decompressed = clipData.decompress();
+    QCOMPARE((int)decompressed.size(), NUM_FRAMES);
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        QCOMPARE_WITH_ABS_ERROR(decompressed[frame][3].trans(), anim[frame][3].trans(), 0.001f);
+    }
+
+    // tighter tolerances keep more keys
+    AnimClipData tightClipData(anim, UNIT_SCALE, AnimClipData::DEFAULT_ROTATION_TOLERANCE / 4.0f,
+                               AnimClipData::DEFAULT_TRANSLATION_TOLERANCE / 4.0f);
+    QVERIFY(tightClipData.getStats().numKeys > stats.numKeys);
+    QVERIFY(tightClipData.getStats().maxTranslationError <= AnimClipData::DEFAULT_TRANSLATION_TOLERANCE / 4.0f + EPSILON);
+}
+
+void AnimClipDataTests::testSample() {
+    AnimClipData clipData(makeAnim(), UNIT_SCALE);
+
+    AnimPoseVec prevPoses(NUM_JOINTS);
+    AnimPoseVec nextPoses(NUM_JOINTS);
+    AnimPoseVec expected(NUM_JOINTS);
+    AnimPoseVec poses(NUM_JOINTS);
+
+    // consecutive frames, and the wrap around of a looping clip
+    const std::vector<std::pair<int, int>> FRAME_PAIRS = { { 0, 1 }, { 41, 42 }, { 150, 151 }, { NUM_FRAMES - 1, 0 } };
+    for (const auto& framePair : FRAME_PAIRS) {
+        clipData.decompressFrame(framePair.first, prevPoses.data());
+        clipData.decompressFrame(framePair.second, nextPoses.data());
+        for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+            ::blend(NUM_JOINTS, prevPoses.data(), nextPoses.data(), alpha, expected.data());
+            clipData.sample(framePair.first, framePair.second, alpha, poses.data());
+            for (int i = 0; i < NUM_JOINTS; i++) {
+                QCOMPARE_WITH_ABS_ERROR(poses[i].scale(), expected[i].scale(), EPSILON);
+                QCOMPARE_WITH_ABS_ERROR(poses[i].rot(), expected[i].rot(), EPSILON);
+                QCOMPARE_WITH_ABS_ERROR(poses[i].trans(), expected[i].trans(), EPSILON);
+            }
+        }
+    }
+}
+
+void AnimClipDataTests::testEmpty() {
+    AnimClipData clipData(std::vector<AnimPoseVec>(), UNIT_SCALE);
+    QCOMPARE(clipData.getNumFrames(), 0);
+    QCOMPARE(clipData.getNumJoints(), 0);
+    QVERIFY(clipData.decompress().empty());
+
+    std::vector<AnimPoseVec> singleFrame(1, AnimPoseVec(NUM_JOINTS));
+    AnimClipData singleFrameClipData(singleFrame, UNIT_SCALE);
+    QCOMPARE(singleFrameClipData.getStats().numConstantTracks, 3 * NUM_JOINTS);
+}
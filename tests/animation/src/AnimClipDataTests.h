@@ -0,0 +1,26 @@
+//
+//  AnimClipDataTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipDataTests_h
+#define hifi_AnimClipDataTests_h
+
+#include <QtTest/QtTest>
+
+class AnimClipDataTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testConstantTracks();
+    void testErrorBounds();
+    void testSample();
+    void testEmpty();
+};
+
+#endif // hifi_AnimClipDataTests_h
@@ -555,7 +555,7 @@ void AnimTests::testExpressionParser() {
     QVERIFY(e._opCodes.size() == 1);
     if (e._opCodes.size() == 1) {
         QVERIFY(e._opCodes[0].type == AnimExpression::OpCode::Identifier);
-        QVERIFY(e._opCodes[0].strVal == "twenty");
+        QVERIFY(e._opCodes[0].key.getName() == "twenty");
     }
 
     e = AnimExpression("true || false");
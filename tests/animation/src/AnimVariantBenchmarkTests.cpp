@@ -0,0 +1,233 @@
+//
+//  AnimVariantBenchmarkTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimVariantBenchmarkTests.h"
+
+#include <map>
+
+#include <AnimBlendLinear.h>
+#include <AnimContext.h>
+#include <AnimDefaultPose.h>
+#include <AnimVariant.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimVariantBenchmarkTests)
+
+// about what Rig::updateAnimations and the default avatar graph go through each frame
+const int NUM_RIG_VARS = 120;
+const int NUM_NODE_LOOKUPS = 400;
+const int NUM_UNSET_NODE_VARS = 30;
+const int NUM_JOINTS = 60;
+
+enum class Store {
+    StdMap, // the std::map<QString, AnimVariant> AnimVariantMap used to be
+    ByName,
+    Interned
+};
+Q_DECLARE_METATYPE(Store)
+
+void AnimVariantBenchmarkTests::initTestCase() {
+    for (int i = 0; i < NUM_RIG_VARS; i++) {
+        _rigVarNames.push_back(QString("rigAnimationVar%1").arg(i));
+    }
+    // nodes mostly read what the rig sets, and some vars that nobody sets
+    for (int i = 0; i < NUM_NODE_LOOKUPS; i++) {
+        if (i % (NUM_NODE_LOOKUPS / NUM_UNSET_NODE_VARS) == 0) {
+            _nodeVarNames.push_back(QString("unsetAnimationVar%1").arg(i));
+        } else {
+            _nodeVarNames.push_back(_rigVarNames[(i * 7) % NUM_RIG_VARS]);
+        }
+    }
+}
+
+void AnimVariantBenchmarkTests::testKeys() {
+    AnimVariantKey key(QString("testKeysVar"));
+    QVERIFY(key.isValid());
+    QCOMPARE(AnimVariantKey(QString("testKeysVar")), key);
+    QCOMPARE(AnimVariantKey::find("testKeysVar"), key);
+    QCOMPARE(key.getName(), QString("testKeysVar"));
+    QVERIFY(!AnimVariantKey(QString()).isValid());
+    QVERIFY(!AnimVariantKey::find("testKeysVarNeverInterned").isValid());
+
+    AnimVariantMap map;
+    map.set(key, 2.5f);
+    QCOMPARE(map.lookup("testKeysVar", 0.0f), 2.5f);
+    QCOMPARE(map.lookup(key, 0.0f), 2.5f);
+    QCOMPARE(map.lookup(AnimVariantKey(), 1.0f), 1.0f);
+    QCOMPARE(map.lookup("testKeysVarNeverInterned", 1.0f), 1.0f);
+    QVERIFY(map.hasKey(key));
+
+    AnimVariantMap other;
+    other.set("testKeysOtherVar", true);
+    other.copyVariantsFrom(map);
+    QCOMPARE(other.lookup(key, 0.0f), 2.5f);
+    QCOMPARE(other.lookup("testKeysOtherVar", false), true);
+    auto debugMap = other.toDebugMap();
+    QCOMPARE((int)debugMap.size(), 2);
+
+    map.unset("testKeysVar");
+    QVERIFY(!map.hasKey(key));
+}
+
+void AnimVariantBenchmarkTests::testMergeWithManyKeys() {
+    // keys interned elsewhere don't make a map any bigger, nor do they get in the way of its own
+    const int NUM_OTHER_KEYS = 10000;
+    std::vector<AnimVariantKey> keys;
+    for (int i = 0; i < NUM_OTHER_KEYS; i++) {
+        keys.push_back(AnimVariantKey(QString("testMergeWithManyKeysVar%1").arg(i)));
+    }
+
+    // set out of id order
+    AnimVariantMap map;
+    map.set(keys[NUM_OTHER_KEYS - 1], 1);
+    map.set(keys[0], 2);
+    map.set(keys[NUM_OTHER_KEYS / 2], 3);
+    QCOMPARE((int)map.toDebugMap().size(), 3);
+    QCOMPARE(map.lookup(keys[NUM_OTHER_KEYS - 1], 0), 1);
+    QCOMPARE(map.lookup(keys[0], 0), 2);
+    QCOMPARE(map.lookup(keys[NUM_OTHER_KEYS / 2], 0), 3);
+    QVERIFY(!map.hasKey(keys[1]));
+
+    // the vars of the other map win, the ones only this map has stay
+    AnimVariantMap other;
+    other.set(keys[0], 20);
+    other.set(keys[1], 21);
+    map.copyVariantsFrom(other);
+    QCOMPARE((int)map.toDebugMap().size(), 4);
+    QCOMPARE(map.lookup(keys[0], 0), 20);
+    QCOMPARE(map.lookup(keys[1], 0), 21);
+    QCOMPARE(map.lookup(keys[NUM_OTHER_KEYS / 2], 0), 3);
+    QCOMPARE(map.lookup(keys[NUM_OTHER_KEYS - 1], 0), 1);
+
+    map.unset(keys[NUM_OTHER_KEYS / 2]);
+    QVERIFY(!map.hasKey(keys[NUM_OTHER_KEYS / 2]));
+    QCOMPARE((int)map.toDebugMap().size(), 3);
+
+    AnimVariantMap empty;
+    empty.copyVariantsFrom(map);
+    QCOMPARE(empty.toDebugMap(), map.toDebugMap());
+}
+
+void AnimVariantBenchmarkTests::benchmarkLookups_data() {
+    QTest::addColumn<Store>("store");
+    QTest::newRow("std::map") << Store::StdMap;
+    QTest::newRow("by name") << Store::ByName;
+    QTest::newRow("interned") << Store::Interned;
+}
+
+void AnimVariantBenchmarkTests::benchmarkLookups() {
+    QFETCH(Store, store);
+
+    std::vector<AnimVariantKey> rigKeys(_rigVarNames.begin(), _rigVarNames.end());
+    std::vector<AnimVariantKey> nodeKeys(_nodeVarNames.begin(), _nodeVarNames.end());
+
+    float sum = 0.0f;
+    switch (store) {
+    case Store::StdMap:
+        QBENCHMARK {
+            // like the rig's vars, the map starts over every frame
+            std::map<QString, AnimVariant> map;
+            for (int i = 0; i < NUM_RIG_VARS; i++) {
+                map[_rigVarNames[i]] = AnimVariant((float)i);
+            }
+            for (const auto& name : _nodeVarNames) {
+                auto iter = map.find(name);
+                sum += iter != map.end() ? iter->second.getFloat() : 0.0f;
+            }
+        }
+        break;
+    case Store::ByName:
+        QBENCHMARK {
+            AnimVariantMap map;
+            for (int i = 0; i < NUM_RIG_VARS; i++) {
+                map.set(_rigVarNames[i], (float)i);
+            }
+            for (const auto& name : _nodeVarNames) {
+                sum += map.lookup(name, 0.0f);
+            }
+        }
+        break;
+    case Store::Interned:
+        QBENCHMARK {
+            AnimVariantMap map;
+            for (int i = 0; i < NUM_RIG_VARS; i++) {
+                map.set(rigKeys[i], (float)i);
+            }
+            for (const auto& key : nodeKeys) {
+                sum += map.lookup(key, 0.0f);
+            }
+        }
+        break;
+    }
+    QVERIFY(sum > 0.0f);
+}
+
+static AnimSkeleton::Pointer makeSkeleton() {
+    HFMModel hfmModel;
+    HFMJoint joint;
+    joint.isFree = false;
+    joint.translation = glm::vec3(0.0f, 0.1f, 0.0f);
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = glm::quat();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.transform = glm::mat4();
+    joint.inverseDefaultRotation = glm::quat();
+    joint.inverseBindRotation = glm::quat();
+    joint.bindTransform = glm::mat4();
+    joint.isSkeletonJoint = true;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        joint.name = QString("Joint%1").arg(i);
+        joint.parentIndex = i - 1;
+        hfmModel.joints.push_back(joint);
+    }
+    return std::make_shared<AnimSkeleton>(hfmModel);
+}
+
+void AnimVariantBenchmarkTests::benchmarkRigUpdate() {
+    // a root blend of three blends of three default poses, each blend driven by a var
+    auto root = std::make_shared<AnimBlendLinear>("root", 0.0f, AnimBlendType_Normal);
+    root->setAlphaVar("rootAlpha");
+    for (int i = 0; i < 3; i++) {
+        auto blend = std::make_shared<AnimBlendLinear>(QString("blend%1").arg(i), 0.0f, AnimBlendType_Normal);
+        blend->setAlphaVar(QString("blend%1Alpha").arg(i));
+        for (int j = 0; j < 3; j++) {
+            blend->addChild(std::make_shared<AnimDefaultPose>(QString("pose%1%2").arg(i).arg(j)));
+        }
+        root->addChild(blend);
+    }
+    root->setSkeleton(makeSkeleton());
+
+    std::vector<AnimVariantKey> rigKeys(_rigVarNames.begin(), _rigVarNames.end());
+    const std::vector<AnimVariantKey> alphaKeys = {
+        AnimVariantKey(QString("rootAlpha")), AnimVariantKey(QString("blend0Alpha")),
+        AnimVariantKey(QString("blend1Alpha")), AnimVariantKey(QString("blend2Alpha"))
+    };
+
+    AnimContext context(false, false, false, glm::mat4(), glm::mat4(), 0);
+    AnimVariantMap animVars;
+    const float DELTA_TIME = 1.0f / 90.0f;
+    int frame = 0;
+    QBENCHMARK {
+        for (int i = 0; i < NUM_RIG_VARS; i++) {
+            animVars.set(rigKeys[i], (float)i);
+        }
+        for (const auto& alphaKey : alphaKeys) {
+            animVars.set(alphaKey, 0.001f * (float)(frame % 2000));
+        }
+        AnimVariantMap triggersOut;
+        const AnimPoseVec& poses = root->evaluate(animVars, context, DELTA_TIME, triggersOut);
+        QCOMPARE((int)poses.size(), NUM_JOINTS);
+        animVars = triggersOut;
+        ++frame;
+    }
+}
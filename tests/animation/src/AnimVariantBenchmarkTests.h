@@ -0,0 +1,33 @@
+//
+//  AnimVariantBenchmarkTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimVariantBenchmarkTests_h
+#define hifi_AnimVariantBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+// Per-frame anim var traffic of a Rig: the rig sets its vars, then the nodes of the anim graph look theirs up.
+class AnimVariantBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testKeys();
+    void testMergeWithManyKeys();
+    void benchmarkLookups_data();
+    void benchmarkLookups();
+    void benchmarkRigUpdate();
+
+private:
+    QStringList _rigVarNames;
+    QStringList _nodeVarNames;
+};
+
+#endif // hifi_AnimVariantBenchmarkTests_h
@@ -0,0 +1,221 @@
+//
+//  AnimationLODTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimationLODTests.h"
+
+#include <memory>
+#include <random>
+
+#include <glm/gtx/transform.hpp>
+
+#include <AnimationLOD.h>
+#include <Rig.h>
+#include <TBBHelpers.h>
+
+QTEST_MAIN(AnimationLODTests)
+
+const int NUM_UPDATES = 16;
+const int NUM_RIGS = 24;
+const int NUM_JOINTS = 40;
+
+static ConicalViewFrustum makeView(const glm::vec3& position) {
+    ConicalViewFrustum view;
+    view.setPositionAndSimpleRadius(position, 100.0f);
+    return view;
+}
+
+// the radius that has the given screen size at the given distance from the view
+static float radiusForScreenSize(const ConicalViewFrustum& view, float distance, float screenSize) {
+    return screenSize * view.getAngle() * distance;
+}
+
+static AnimationLOD::Level computeLevel(const ConicalViewFrustums& views, float distance, float radius) {
+    AnimationLOD lod;
+    lod.update(views, glm::vec3(0.0f, 0.0f, distance), radius, false);
+    return lod.getLevel();
+}
+
+// the number of the updates that pose the joints, when every update brings new joint data
+static int countJointUpdates(AnimationLOD& lod) {
+    int numJointUpdates = 0;
+    for (int i = 0; i < NUM_UPDATES; i++) {
+        if (lod.isJointUpdateDue(true)) {
+            lod.jointsUpdated();
+            numJointUpdates++;
+        } else {
+            lod.jointsSkipped();
+        }
+    }
+    return numJointUpdates;
+}
+
+void AnimationLODTests::testLevelByDistance() {
+    ConicalViewFrustums views { makeView(glm::vec3(0.0f)) };
+    const float MID_SCREEN_SIZE = 0.1f;
+    float nearDistance = 0.5f * AnimationLOD::FULL_LOD_DISTANCE;
+    float midDistance = 0.5f * (AnimationLOD::FULL_LOD_DISTANCE + AnimationLOD::LOW_LOD_DISTANCE);
+    float farDistance = 2.0f * AnimationLOD::LOW_LOD_DISTANCE;
+
+    // a tiny avatar close by still gets full animation
+    QCOMPARE(computeLevel(views, nearDistance, 0.01f), AnimationLOD::Full);
+    QCOMPARE(computeLevel(views, midDistance, radiusForScreenSize(views[0], midDistance, MID_SCREEN_SIZE)),
+        AnimationLOD::Reduced);
+    QCOMPARE(computeLevel(views, farDistance, radiusForScreenSize(views[0], farDistance, MID_SCREEN_SIZE)),
+        AnimationLOD::Low);
+}
+
+void AnimationLODTests::testLevelByScreenSize() {
+    ConicalViewFrustums views { makeView(glm::vec3(0.0f)) };
+    float midDistance = 0.5f * (AnimationLOD::FULL_LOD_DISTANCE + AnimationLOD::LOW_LOD_DISTANCE);
+    float farDistance = 2.0f * AnimationLOD::LOW_LOD_DISTANCE;
+    float largeSize = 2.0f * AnimationLOD::FULL_LOD_SCREEN_SIZE;
+    float smallSize = 0.5f * AnimationLOD::REDUCED_LOD_SCREEN_SIZE;
+
+    // a large avatar gets full animation however far it is
+    QCOMPARE(computeLevel(views, farDistance, radiusForScreenSize(views[0], farDistance, largeSize)), AnimationLOD::Full);
+    QCOMPARE(computeLevel(views, midDistance, radiusForScreenSize(views[0], midDistance, largeSize)), AnimationLOD::Full);
+    QCOMPARE(computeLevel(views, midDistance, radiusForScreenSize(views[0], midDistance, smallSize)), AnimationLOD::Low);
+}
+
+void AnimationLODTests::testNearestViewWins() {
+    float farDistance = 2.0f * AnimationLOD::LOW_LOD_DISTANCE;
+    ConicalViewFrustums views {
+        makeView(glm::vec3(0.0f)),
+        makeView(glm::vec3(0.0f, 0.0f, farDistance - 0.5f * AnimationLOD::FULL_LOD_DISTANCE))
+    };
+    QCOMPARE(computeLevel(views, farDistance, 0.01f), AnimationLOD::Full);
+
+    views.pop_back();
+    QCOMPARE(computeLevel(views, farDistance, 0.01f), AnimationLOD::Low);
+
+    // with no view at all, nothing is worth animating in detail
+    QCOMPARE(computeLevel(ConicalViewFrustums(), 0.0f, 1.0f), AnimationLOD::Low);
+}
+
+void AnimationLODTests::testHeroesGetFullLevel() {
+    ConicalViewFrustums views { makeView(glm::vec3(0.0f)) };
+    AnimationLOD lod;
+    lod.update(views, glm::vec3(0.0f, 0.0f, 2.0f * AnimationLOD::LOW_LOD_DISTANCE), 0.01f, true);
+    QCOMPARE(lod.getLevel(), AnimationLOD::Full);
+}
+
+void AnimationLODTests::testJointUpdateIntervals() {
+    for (int level = AnimationLOD::Full; level < AnimationLOD::NumLevels; level++) {
+        AnimationLOD lod;
+        lod.setLevel((AnimationLOD::Level)level);
+        int interval = AnimationLOD::getJointUpdateInterval((AnimationLOD::Level)level);
+        QCOMPARE(countJointUpdates(lod), NUM_UPDATES / interval);
+    }
+    QCOMPARE(AnimationLOD::getJointUpdateInterval(AnimationLOD::Full), 1);
+    QVERIFY(AnimationLOD::getJointUpdateInterval(AnimationLOD::Reduced) > 1);
+    QVERIFY(AnimationLOD::getJointUpdateInterval(AnimationLOD::Low) >
+        AnimationLOD::getJointUpdateInterval(AnimationLOD::Reduced));
+
+    // an avatar that comes close is posed on its next update, without waiting out the interval of its old level
+    AnimationLOD lod;
+    lod.setLevel(AnimationLOD::Low);
+    lod.jointsUpdated();
+    lod.jointsSkipped();
+    QVERIFY(!lod.isJointUpdateDue(true));
+    lod.setLevel(AnimationLOD::Full);
+    QVERIFY(lod.isJointUpdateDue(true));
+}
+
+void AnimationLODTests::testNoJointUpdateWithoutNewData() {
+    AnimationLOD lod;
+    for (int i = 0; i < NUM_UPDATES; i++) {
+        QVERIFY(!lod.isJointUpdateDue(false));
+        lod.jointsSkipped();
+    }
+    QVERIFY(lod.isJointUpdateDue(true));
+}
+
+static HFMModel makeModel() {
+    HFMModel hfmModel;
+    HFMJoint joint;
+    joint.isFree = false;
+    joint.translation = glm::vec3(0.0f, 0.1f, 0.0f);
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = glm::quat();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.inverseDefaultRotation = glm::quat();
+    joint.inverseBindRotation = glm::quat();
+    joint.isSkeletonJoint = true;
+    glm::mat4 transform;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        joint.name = QString("Joint%1").arg(i);
+        joint.parentIndex = i - 1;
+        transform = transform * glm::translate(joint.translation);
+        joint.transform = transform;
+        joint.bindTransform = transform;
+        hfmModel.joints.push_back(joint);
+    }
+    return hfmModel;
+}
+
+static QVector<JointData> makeJointData(std::mt19937& generator) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    QVector<JointData> jointData(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        JointData& data = jointData[i];
+        // leave some joints in their default pose, as the network data does
+        data.rotationIsDefaultPose = (i % 5 == 0);
+        data.translationIsDefaultPose = (i % 3 != 0);
+        data.rotation = glm::normalize(glm::quat(distribution(generator), distribution(generator),
+            distribution(generator), distribution(generator)));
+        data.translation = glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+    }
+    return jointData;
+}
+
+void AnimationLODTests::testParallelPosingMatchesSerial() {
+    HFMModel hfmModel = makeModel();
+    std::mt19937 generator(7);
+    std::vector<QVector<JointData>> jointData;
+    std::vector<std::unique_ptr<Rig>> serialRigs;
+    std::vector<std::unique_ptr<Rig>> parallelRigs;
+    for (int i = 0; i < NUM_RIGS; i++) {
+        jointData.push_back(makeJointData(generator));
+        serialRigs.emplace_back(new Rig());
+        serialRigs.back()->initJointStates(hfmModel, glm::mat4());
+        parallelRigs.emplace_back(new Rig());
+        parallelRigs.back()->initJointStates(hfmModel, glm::mat4());
+    }
+    glm::mat4 rootTransform = glm::scale(glm::vec3(1.5f)) * glm::translate(glm::vec3(0.0f, -1.0f, 0.0f));
+
+    for (int i = 0; i < NUM_RIGS; i++) {
+        serialRigs[i]->computePosesFromJointData(jointData[i], rootTransform);
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, NUM_RIGS, 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            parallelRigs[i]->computePosesFromJointData(jointData[i], rootTransform);
+        }
+    });
+
+    int numPosedJoints = 0;
+    for (int i = 0; i < NUM_RIGS; i++) {
+        for (int j = 0; j < NUM_JOINTS; j++) {
+            AnimPose serialPose;
+            AnimPose parallelPose;
+            QVERIFY(serialRigs[i]->getAbsoluteJointPoseInRigFrame(j, serialPose));
+            QVERIFY(parallelRigs[i]->getAbsoluteJointPoseInRigFrame(j, parallelPose));
+            QVERIFY(parallelPose.rot() == serialPose.rot());
+            QVERIFY(parallelPose.trans() == serialPose.trans());
+            QVERIFY(parallelPose.scale() == serialPose.scale());
+            if (serialPose.rot() != serialRigs[i]->getAbsoluteDefaultPose(j).rot()) {
+                numPosedJoints++;
+            }
+        }
+    }
+    // the joint data did move the joints away from their default poses
+    QVERIFY(numPosedJoints > NUM_RIGS * NUM_JOINTS / 2);
+}
@@ -0,0 +1,30 @@
+//
+//  AnimationLODTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimationLODTests_h
+#define hifi_AnimationLODTests_h
+
+#include <QtTest/QtTest>
+
+// The animation LOD and posing of avatars that are animated from network joint data.
+class AnimationLODTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testLevelByDistance();
+    void testLevelByScreenSize();
+    void testNearestViewWins();
+    void testHeroesGetFullLevel();
+    void testJointUpdateIntervals();
+    void testNoJointUpdateWithoutNewData();
+    void testParallelPosingMatchesSerial();
+};
+
+#endif // hifi_AnimationLODTests_h
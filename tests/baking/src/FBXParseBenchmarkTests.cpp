@@ -0,0 +1,208 @@
+//
+//  FBXParseBenchmarkTests.cpp
+//  tests/baking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXParseBenchmarkTests.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QDir>
+
+#include <FBXSerializer.h>
+#include <FBXWriter.h>
+
+QTEST_MAIN(FBXParseBenchmarkTests)
+
+// about the size of a detailed avatar mesh
+const int GENERATED_MESH_VERTICES = 60000;
+const int ROUND_TRIP_MESH_VERTICES = 1000;
+
+static FBXNode makeNode(const QByteArray& name, const QVariantList& properties = QVariantList()) {
+    FBXNode node;
+    node.name = name;
+    node.properties = properties;
+    return node;
+}
+
+static FBXNode makeMeshDocument(int numVertices) {
+    QVector<double> vertices(numVertices * 3);
+    QVector<double> normals(numVertices * 3);
+    QVector<double> uvs(numVertices * 2);
+    for (int i = 0; i < numVertices; i++) {
+        vertices[3 * i] = sin(0.01 * i);
+        vertices[3 * i + 1] = cos(0.013 * i);
+        vertices[3 * i + 2] = 0.001 * i;
+        normals[3 * i] = cos(0.01 * i);
+        normals[3 * i + 1] = 0.0;
+        normals[3 * i + 2] = sin(0.01 * i);
+        uvs[2 * i] = (i % 256) / 255.0;
+        uvs[2 * i + 1] = (i / 256) / 255.0;
+    }
+    QVector<int> polygonIndices;
+    for (int i = 0; i + 2 < numVertices; i += 3) {
+        polygonIndices << i << i + 1 << -(i + 2) - 1;
+    }
+
+    FBXNode normalLayer = makeNode("LayerElementNormal", { 0 });
+    normalLayer.children << makeNode("MappingInformationType", { QByteArray("ByVertice") });
+    normalLayer.children << makeNode("Normals", { QVariant::fromValue(normals) });
+
+    FBXNode uvLayer = makeNode("LayerElementUV", { 0 });
+    uvLayer.children << makeNode("UV", { QVariant::fromValue(uvs) });
+
+    FBXNode geometry = makeNode("Geometry", { (qint64)1000, QByteArray("Geometry::mesh"), QByteArray("Mesh") });
+    geometry.children << makeNode("Vertices", { QVariant::fromValue(vertices) });
+    geometry.children << makeNode("PolygonVertexIndex", { QVariant::fromValue(polygonIndices) });
+    geometry.children << normalLayer << uvLayer;
+
+    FBXNode objects = makeNode("Objects");
+    objects.children << geometry;
+
+    FBXNode root;
+    root.children << makeNode("Creator", { QByteArray("FBXParseBenchmarkTests") });
+    root.children << makeNode("GlobalSettings", { 1000, 1.0, (qint64)7 });
+    root.children << objects;
+    return root;
+}
+
+template<class T>
+static bool compareArrays(const QVariant& actual, const QVariant& expected) {
+    return actual.userType() == qMetaTypeId<QVector<T>>() && actual.value<QVector<T>>() == expected.value<QVector<T>>();
+}
+
+static bool compareNodes(const FBXNode& actual, const FBXNode& expected) {
+    if (actual.name != expected.name || actual.properties.size() != expected.properties.size() ||
+            actual.children.size() != expected.children.size()) {
+        return false;
+    }
+    for (int i = 0; i < expected.properties.size(); i++) {
+        const QVariant& expectedProperty = expected.properties[i];
+        int type = expectedProperty.userType();
+        bool same;
+        if (type == qMetaTypeId<QVector<double>>()) {
+            same = compareArrays<double>(actual.properties[i], expectedProperty);
+        } else if (type == qMetaTypeId<QVector<int>>()) {
+            same = compareArrays<int>(actual.properties[i], expectedProperty);
+        } else {
+            same = actual.properties[i] == expectedProperty;
+        }
+        if (!same) {
+            return false;
+        }
+    }
+    for (int i = 0; i < expected.children.size(); i++) {
+        if (!compareNodes(actual.children[i], expected.children[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// bytes held by the properties of a node tree
+static size_t getTreeSize(const FBXNode& node) {
+    size_t size = sizeof(FBXNode) + node.name.size();
+    for (const auto& property : node.properties) {
+        int type = property.userType();
+        if (type == qMetaTypeId<QVector<double>>()) {
+            size += property.value<QVector<double>>().size() * sizeof(double);
+        } else if (type == qMetaTypeId<QVector<float>>()) {
+            size += property.value<QVector<float>>().size() * sizeof(float);
+        } else if (type == qMetaTypeId<QVector<int>>()) {
+            size += property.value<QVector<int>>().size() * sizeof(int);
+        } else if (type == qMetaTypeId<QVector<qint64>>()) {
+            size += property.value<QVector<qint64>>().size() * sizeof(qint64);
+        } else if (type == QMetaType::QByteArray) {
+            size += property.toByteArray().size();
+        }
+        size += sizeof(QVariant);
+    }
+    for (const auto& child : node.children) {
+        size += getTreeSize(child);
+    }
+    return size;
+}
+
+void FBXParseBenchmarkTests::initTestCase() {
+    _generatedMesh = FBXWriter::encodeFBX(makeMeshDocument(GENERATED_MESH_VERTICES));
+
+    QString corpusPath = QProcessEnvironment::systemEnvironment().value("HIFI_FBX_BENCHMARK_CORPUS");
+    if (!corpusPath.isEmpty()) {
+        QDir corpus(corpusPath);
+        for (const auto& fileName : corpus.entryList({ "*.fbx" }, QDir::Files, QDir::Name)) {
+            _corpus << corpus.absoluteFilePath(fileName);
+        }
+        qInfo() << "FBX corpus:" << _corpus.size() << "files in" << corpusPath;
+    }
+}
+
+void FBXParseBenchmarkTests::testRoundTrip() {
+    FBXNode document = makeMeshDocument(ROUND_TRIP_MESH_VERTICES);
+    QByteArray data = FBXWriter::encodeFBX(document);
+
+    FBXNode parsed = FBXSerializer::parseFBX(data);
+    QVERIFY(compareNodes(parsed, document));
+
+    // through a device, as before
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QVERIFY(compareNodes(FBXSerializer::parseFBX(&buffer), document));
+}
+
+void FBXParseBenchmarkTests::testTruncated() {
+    QByteArray data = FBXWriter::encodeFBX(makeMeshDocument(ROUND_TRIP_MESH_VERTICES));
+    QByteArray truncated = data.left(data.size() / 2);
+    QVERIFY_EXCEPTION_THROWN(FBXSerializer::parseFBX(truncated), QString);
+}
+
+void FBXParseBenchmarkTests::benchmarkParse_data() {
+    QTest::addColumn<QString>("path");
+    QTest::newRow("generated") << QString();
+    for (const auto& path : _corpus) {
+        QTest::newRow(qPrintable(QFileInfo(path).fileName())) << path;
+    }
+}
+
+void FBXParseBenchmarkTests::benchmarkParse() {
+    QFETCH(QString, path);
+    QByteArray data = _generatedMesh;
+    if (!path.isEmpty()) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        data = file.readAll();
+    }
+
+    FBXNode root;
+    QBENCHMARK {
+        root = FBXSerializer::parseFBX(data);
+    }
+    // parsing holds the file and the node tree, and nothing else of any size
+    qInfo() << "file" << data.size() << "bytes, node tree" << getTreeSize(root) << "bytes";
+}
+
+void FBXParseBenchmarkTests::benchmarkRead_data() {
+    QTest::addColumn<QString>("path");
+    for (const auto& path : _corpus) {
+        QTest::newRow(qPrintable(QFileInfo(path).fileName())) << path;
+    }
+}
+
+void FBXParseBenchmarkTests::benchmarkRead() {
+    if (_corpus.isEmpty()) {
+        QSKIP("set HIFI_FBX_BENCHMARK_CORPUS to a directory of .fbx files");
+    }
+    QFETCH(QString, path);
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray data = file.readAll();
+
+    QBENCHMARK {
+        FBXSerializer serializer;
+        auto model = serializer.read(data, hifi::VariantHash(), QUrl::fromLocalFile(path));
+        QVERIFY(model);
+    }
+}
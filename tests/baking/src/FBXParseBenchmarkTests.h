@@ -0,0 +1,35 @@
+//
+//  FBXParseBenchmarkTests.h
+//  tests/baking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXParseBenchmarkTests_h
+#define hifi_FBXParseBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+// Parse time and memory of binary FBX files.  Besides a generated mesh, every .fbx file in the directory named by the
+// HIFI_FBX_BENCHMARK_CORPUS environment variable (e.g. a copy of the avatar corpus) gets a row.
+class FBXParseBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testRoundTrip();
+    void testTruncated();
+    void benchmarkParse_data();
+    void benchmarkParse();
+    void benchmarkRead_data();
+    void benchmarkRead();
+
+private:
+    QByteArray _generatedMesh;
+    QStringList _corpus;
+};
+
+#endif // hifi_FBXParseBenchmarkTests_h
@@ -0,0 +1,111 @@
+//
+//  EntityTraversalServiceTests.cpp
+//  tests/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTraversalServiceTests.h"
+
+#include <EntityTraversalService.h>
+
+QTEST_MAIN(EntityTraversalServiceTests)
+
+const float VIEW_RADIUS = 100.0f;
+
+static DiffTraversal::View makeView(const glm::vec3& position, float lodScaleFactor = 1.0f) {
+    ConicalViewFrustum frustum;
+    frustum.setPositionAndSimpleRadius(position, VIEW_RADIUS);
+    DiffTraversal::View view;
+    view.viewFrustums.push_back(frustum);
+    view.lodScaleFactor = lodScaleFactor;
+    return view;
+}
+
+static EntityTreePointer makeTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    return tree;
+}
+
+void EntityTraversalServiceTests::testSimilarViewsShareTraversal() {
+    EntityTraversalService service(makeTree(), 1);
+
+    // a meter apart is well within what isVerySimilar allows
+    auto first = service.joinGroup(makeView(glm::vec3(0.0f)), nullptr);
+    auto second = service.joinGroup(makeView(glm::vec3(1.0f, 0.0f, 0.0f)), nullptr);
+    QVERIFY(first);
+    QCOMPARE(first, second);
+
+    auto stats = service.getGroupStats();
+    QCOMPARE((int)stats.size(), 1);
+    QCOMPARE(stats[0].numClients, 2);
+
+    // and both viewers pick up the one result
+    uint64_t generation = 0;
+    QTRY_VERIFY(service.getResult(first, generation));
+    uint64_t secondGeneration = 0;
+    QCOMPARE(service.getResult(second, secondGeneration), service.getResult(first, generation));
+    QCOMPARE(secondGeneration, generation);
+
+    // a viewer that moves a little stays in the group
+    QCOMPARE(service.joinGroup(makeView(glm::vec3(0.0f, 1.0f, 0.0f)), second), first);
+    QCOMPARE((int)service.getGroupStats().size(), 1);
+}
+
+void EntityTraversalServiceTests::testDissimilarViewsDontShare() {
+    EntityTraversalService service(makeTree(), 1);
+
+    auto first = service.joinGroup(makeView(glm::vec3(0.0f)), nullptr);
+    auto farAway = service.joinGroup(makeView(glm::vec3(100.0f, 0.0f, 0.0f)), nullptr);
+    auto otherLOD = service.joinGroup(makeView(glm::vec3(0.0f), 0.5f), nullptr);
+    QVERIFY(first != farAway);
+    QVERIFY(first != otherLOD);
+    QVERIFY(farAway != otherLOD);
+    QCOMPARE((int)service.getGroupStats().size(), 3);
+
+    // each group gets a traversal of its own
+    uint64_t generation = 0;
+    QTRY_VERIFY(service.getResult(first, generation));
+    QTRY_VERIFY(service.getResult(farAway, generation));
+    QTRY_VERIFY(service.getResult(otherLOD, generation));
+    QVERIFY(service.getResult(first, generation) != service.getResult(farAway, generation));
+
+    // a viewer that turns away from a shared view leaves the group for one of its own
+    auto second = service.joinGroup(makeView(glm::vec3(1.0f, 0.0f, 0.0f)), nullptr);
+    QCOMPARE(second, first);
+    auto moved = service.joinGroup(makeView(glm::vec3(0.0f, 0.0f, -100.0f)), second);
+    QVERIFY(moved != first);
+    QCOMPARE((int)service.getGroupStats().size(), 4);
+}
+
+void EntityTraversalServiceTests::testLastViewReleasesTraversal() {
+    EntityTraversalService service(makeTree(), 1);
+
+    auto first = service.joinGroup(makeView(glm::vec3(0.0f)), nullptr);
+    auto second = service.joinGroup(makeView(glm::vec3(1.0f, 0.0f, 0.0f)), nullptr);
+    std::weak_ptr<EntityTraversalService::Group> weakGroup = first;
+    uint64_t generation = 0;
+    QTRY_VERIFY(service.getResult(first, generation));
+
+    // the group lives on while a viewer is left in it
+    service.leaveGroup(first);
+    auto stats = service.getGroupStats();
+    QCOMPARE((int)stats.size(), 1);
+    QCOMPARE(stats[0].numClients, 1);
+
+    // and is dropped by the service with its last viewer, workers included
+    service.leaveGroup(second);
+    QVERIFY(service.getGroupStats().empty());
+    first.reset();
+    second.reset();
+    QTRY_VERIFY(weakGroup.expired());
+
+    // a viewer moving away on its own takes its group along instead of starting another one
+    auto alone = service.joinGroup(makeView(glm::vec3(0.0f)), nullptr);
+    QCOMPARE(service.joinGroup(makeView(glm::vec3(0.0f, 0.0f, -100.0f)), alone), alone);
+    QCOMPARE((int)service.getGroupStats().size(), 1);
+}
@@ -0,0 +1,26 @@
+//
+//  EntityTraversalServiceTests.h
+//  tests/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTraversalServiceTests_h
+#define hifi_EntityTraversalServiceTests_h
+
+#include <QtTest/QtTest>
+
+// Joins and leaves the traversal groups of an EntityTraversalService with views more or less alike.
+class EntityTraversalServiceTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSimilarViewsShareTraversal();
+    void testDissimilarViewsDontShare();
+    void testLastViewReleasesTraversal();
+};
+
+#endif // hifi_EntityTraversalServiceTests_h
@@ -0,0 +1,109 @@
+//
+//  TextureProcessingTests.cpp
+//  tests/image/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureProcessingTests.h"
+
+#include <random>
+#include <thread>
+
+#include <gpu/Texture.h>
+#include <image/TextureProcessing.h>
+
+QTEST_GUILESS_MAIN(TextureProcessingTests)
+
+const int TEST_IMAGE_SIZE = 256;
+const int NUM_CONCURRENT_ENCODES = 4;
+
+// a gradient with noise over it, so that blocks differ and each one takes the encoder some work
+static QImage makeTestImage() {
+    QImage image(TEST_IMAGE_SIZE, TEST_IMAGE_SIZE, QImage::Format_ARGB32);
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> noise(-32, 32);
+    for (int y = 0; y < TEST_IMAGE_SIZE; y++) {
+        for (int x = 0; x < TEST_IMAGE_SIZE; x++) {
+            int red = std::max(0, std::min(255, x + noise(generator)));
+            int green = std::max(0, std::min(255, y + noise(generator)));
+            int blue = std::max(0, std::min(255, (x + y) / 2 + noise(generator)));
+            image.setPixel(x, y, qRgba(red, green, blue, 255));
+        }
+    }
+    return image;
+}
+
+static gpu::TexturePointer compress(const QImage& image, gpu::BackendTarget target) {
+    std::atomic<bool> abortProcessing { false };
+    return image::TextureUsage::process2DTextureColorFromImage(image::Image(image), "test", true, target, false,
+        abortProcessing);
+}
+
+static QList<QByteArray> getStoredMips(const gpu::TexturePointer& texture) {
+    QList<QByteArray> mips;
+    for (uint16_t level = 0; level < texture->getNumMips(); level++) {
+        auto mip = texture->accessStoredMipFace(level);
+        if (mip) {
+            mips.push_back(QByteArray(reinterpret_cast<const char*>(mip->data()), (int)mip->size()));
+        } else {
+            mips.push_back(QByteArray());
+        }
+    }
+    return mips;
+}
+
+void TextureProcessingTests::cleanup() {
+    image::setParallelTextureCompression(true);
+}
+
+void TextureProcessingTests::testParallelMatchesSequential_data() {
+    QTest::addColumn<int>("target");
+    QTest::newRow("bc") << (int)gpu::BackendTarget::GL45;
+    QTest::newRow("etc") << (int)gpu::BackendTarget::GLES32;
+}
+
+void TextureProcessingTests::testParallelMatchesSequential() {
+    QFETCH(int, target);
+    QImage image = makeTestImage();
+
+    image::setParallelTextureCompression(false);
+    auto sequential = compress(image, (gpu::BackendTarget)target);
+    image::setParallelTextureCompression(true);
+    auto parallel = compress(image, (gpu::BackendTarget)target);
+    QVERIFY(sequential);
+    QVERIFY(parallel);
+    QCOMPARE(parallel->getStoredMipFormat().getRaw(), sequential->getStoredMipFormat().getRaw());
+    QVERIFY(parallel->getStoredMipFormat().isCompressed());
+
+    QList<QByteArray> sequentialMips = getStoredMips(sequential);
+    QList<QByteArray> parallelMips = getStoredMips(parallel);
+    QVERIFY(sequentialMips.size() > 1);
+    QVERIFY(!sequentialMips[0].isEmpty());
+    QCOMPARE(parallelMips, sequentialMips);
+}
+
+void TextureProcessingTests::testConcurrentEtcEncodes() {
+    QImage image = makeTestImage();
+    image::setParallelTextureCompression(false);
+    QList<QByteArray> expectedMips = getStoredMips(compress(image, gpu::BackendTarget::GLES32));
+    image::setParallelTextureCompression(true);
+
+    // the encodes share the encoder thread budget between them, and each still gets at least one thread
+    std::vector<QList<QByteArray>> mips(NUM_CONCURRENT_ENCODES);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_CONCURRENT_ENCODES; i++) {
+        threads.emplace_back([&, i] {
+            mips[i] = getStoredMips(compress(image, gpu::BackendTarget::GLES32));
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& encodedMips : mips) {
+        QCOMPARE(encodedMips, expectedMips);
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  TextureProcessingTests.h
+//  tests/image/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureProcessingTests_h
+#define hifi_TextureProcessingTests_h
+
+#include <QtTest/QtTest>
+
+class TextureProcessingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+    void testParallelMatchesSequential_data();
+    void testParallelMatchesSequential();
+    void testConcurrentEtcEncodes();
+};
+
+#endif // hifi_TextureProcessingTests_h
@@ -15,6 +15,7 @@
 #include <ktx/KTX.h>
 #include <gpu/Texture.h>
 #include <image/Image.h>
+#include <SharedUtil.h>
 
 
 QTEST_GUILESS_MAIN(KtxTests)
@@ -142,6 +143,81 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+// Private memory in use by the process.  File backed pages aren't included, so mapping a KTX shouldn't move it.
+static bool getPrivateMemoryBytes(uint64_t& bytes) {
+#if defined(Q_OS_LINUX)
+    QFile status("/proc/self/status");
+    if (!status.open(QFile::ReadOnly | QFile::Text)) {
+        return false;
+    }
+    for (auto line : QString(status.readAll()).split('\n')) {
+        if (line.startsWith("RssAnon:")) {
+            bytes = line.split(' ', QString::SkipEmptyParts).value(1).toULongLong() * 1024;
+            return true;
+        }
+    }
+    return false;
+#else
+    MemoryInfo info;
+    if (!getMemoryInfo(info)) {
+        return false;
+    }
+    bytes = info.processUsedMemoryBytes;
+    return true;
+#endif
+}
+
+void KtxTests::testKtxMappedMips() {
+    const uint16_t SIZE = 1024;
+    auto testTexture = gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, SIZE, SIZE, gpu::Texture::MAX_NUM_MIPS);
+    testTexture->setStoredMipFormat(gpu::Element::COLOR_RGBA_32);
+    for (uint16_t level = 0; level < testTexture->getNumMips(); ++level) {
+        auto size = testTexture->evalMipDimensions(level);
+        std::vector<uint8_t> texels(size.x * size.y * 4, (uint8_t)(level + 1));
+        testTexture->assignStoredMip(level, texels.size(), texels.data());
+    }
+    auto ktxMemory = gpu::Texture::serialize(*testTexture);
+    QVERIFY(ktxMemory.get());
+
+    QTemporaryFile TEST_IMAGE_KTX;
+    {
+        const auto& ktxStorage = ktxMemory->getStorage();
+        QVERIFY(TEST_IMAGE_KTX.open());
+        QCOMPARE(TEST_IMAGE_KTX.write(reinterpret_cast<const char*>(ktxStorage->data()), ktxStorage->size()), (qint64)ktxStorage->size());
+        TEST_IMAGE_KTX.close();
+    }
+    testTexture.reset();
+
+    auto texture = gpu::Texture::unserialize(TEST_IMAGE_KTX.fileName().toStdString());
+    QVERIFY(texture);
+
+    uint64_t privateBytesBefore = 0;
+    bool haveMemoryInfo = getPrivateMemoryBytes(privateBytesBefore);
+
+    // Hold on to every mip, reading all of their texels
+    std::vector<gpu::PixelsPointer> mips;
+    size_t mipBytes = 0;
+    for (uint16_t level = 0; level < texture->getNumMips(); ++level) {
+        auto mip = texture->accessStoredMipFace(level);
+        QVERIFY(mip);
+        QCOMPARE(mip->size(), (size_t)ktxMemory->_images[level]._imageSize);
+        QVERIFY(0 == memcmp(mip->data(), ktxMemory->_images[level]._faceBytes[0], mip->size()));
+        mipBytes += mip->size();
+        mips.push_back(mip);
+    }
+
+    // Mips are views of the one mapping, not copies
+    QCOMPARE(texture->accessStoredMipFace(0)->data(), mips[0]->data());
+
+    uint64_t privateBytesAfter = 0;
+    if (!haveMemoryInfo || !getPrivateMemoryBytes(privateBytesAfter)) {
+        QSKIP("Process memory usage is not available on this platform");
+    }
+    qDebug() << "Private memory grew by" << (qint64)(privateBytesAfter - privateBytesBefore) << "bytes for"
+             << mipBytes << "bytes of mips";
+    QVERIFY(privateBytesAfter < privateBytesBefore + mipBytes / 4);
+}
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
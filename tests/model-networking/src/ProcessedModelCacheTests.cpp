@@ -0,0 +1,158 @@
+//
+//  ProcessedModelCacheTests.cpp
+//  tests/model-networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProcessedModelCacheTests.h"
+
+#include <NumericalConstants.h>
+#include <model-networking/ProcessedModelCache.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_GUILESS_MAIN(ProcessedModelCacheTests)
+
+static std::shared_ptr<ProcessedModelCache> makeCache(const QString& location) {
+    auto cache = std::make_shared<ProcessedModelCache>(location.toStdString());
+    // skips the cache version check of ProcessedModelCache::initialize, which needs the settings
+    cache->cache::FileCache::initialize();
+    return cache;
+}
+
+static hfm::Model makeModel() {
+    hfm::Model model;
+    model.originalURL = "file:///model.fbx";
+    model.hasSkeletonJoints = true;
+
+    hfm::Mesh mesh;
+    mesh.vertices = { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    mesh.parts.emplace_back();
+    mesh.parts[0].triangleIndices = { 0, 1, 2 };
+    mesh.triangleListMesh.vertices.assign(mesh.vertices.begin(), mesh.vertices.end());
+    mesh.triangleListMesh.indices = { 0, 1, 2 };
+    mesh.triangleListMesh.parts = { glm::ivec2(0, 3) };
+    mesh.triangleListMesh.partExtents.emplace_back();
+    mesh.meshIndex = 0;
+    model.meshes.push_back(mesh);
+    model.meshIndicesToModelNames.insert(0, "triangle");
+
+    hfm::Material material;
+    material.name = "material";
+    material._material = std::make_shared<graphics::Material>();
+    material._material->setAlbedo(glm::vec3(0.5f), false);
+    model.materials.push_back(material);
+
+    hfm::Joint joint;
+    joint.parentIndex = -1;
+    joint.name = "Hips";
+    joint.translation = glm::vec3(0.0f, 1.0f, 0.0f);
+    joint.isSkeletonJoint = true;
+    joint.bindTransformFoundInCluster = false;
+    model.joints.push_back(joint);
+    model.jointIndices.insert(joint.name, 1);
+
+    hfm::Shape shape;
+    shape.mesh = 0;
+    shape.meshPart = 0;
+    shape.material = 0;
+    shape.joint = 0;
+    model.shapes.push_back(shape);
+    return model;
+}
+
+void ProcessedModelCacheTests::testRoundTrip() {
+    auto cache = makeCache(_testDir.path() + "/roundTrip");
+    const ProcessedModelCache::Key key = "roundtrip";
+    auto model = makeModel();
+    cache->store(key, model);
+    QCOMPARE(cache->getNumWrites(), (uint32_t)1);
+
+    auto loaded = cache->load(key);
+    QVERIFY(loaded);
+    QCOMPARE(cache->getNumHits(), (uint32_t)1);
+    QCOMPARE(loaded->originalURL, model.originalURL);
+
+    QCOMPARE((int)loaded->meshes.size(), 1);
+    const auto& mesh = loaded->meshes[0];
+    QCOMPARE(mesh.vertices, model.meshes[0].vertices);
+    QCOMPARE(mesh.parts[0].triangleIndices, model.meshes[0].parts[0].triangleIndices);
+    QCOMPARE(mesh.triangleListMesh.indices, model.meshes[0].triangleListMesh.indices);
+    QCOMPARE(mesh.triangleListMesh.parts, model.meshes[0].triangleListMesh.parts);
+    QCOMPARE(loaded->meshIndicesToModelNames, model.meshIndicesToModelNames);
+
+    QCOMPARE((int)loaded->materials.size(), 1);
+    QCOMPARE(loaded->materials[0].name, model.materials[0].name);
+    QVERIFY(loaded->materials[0]._material);
+    QCOMPARE(loaded->materials[0]._material->getKey()._flags, model.materials[0]._material->getKey()._flags);
+    QCOMPARE_WITH_ABS_ERROR(loaded->materials[0]._material->getAlbedo(false), glm::vec3(0.5f), EPSILON);
+
+    QCOMPARE((int)loaded->joints.size(), 1);
+    QCOMPARE(loaded->joints[0].name, model.joints[0].name);
+    QCOMPARE(loaded->joints[0].parentIndex, -1);
+    QCOMPARE(loaded->joints[0].translation, model.joints[0].translation);
+    QCOMPARE(loaded->getJointIndex("Hips"), 0);
+
+    QCOMPARE((int)loaded->shapes.size(), 1);
+    QCOMPARE(loaded->shapes[0].mesh, (uint32_t)0);
+    QCOMPARE(loaded->shapes[0].material, (uint32_t)0);
+    QCOMPARE(loaded->shapes[0].skinDeformer, hfm::UNDEFINED_KEY);
+
+    QVERIFY(!cache->load("missing"));
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+}
+
+void ProcessedModelCacheTests::testTruncatedEntry() {
+    auto cache = makeCache(_testDir.path() + "/truncated");
+    const ProcessedModelCache::Key key = "truncated";
+    cache->store(key, makeModel());
+
+    QString filepath;
+    {
+        auto file = cache->getFile(key);
+        QVERIFY(file);
+        filepath = QString::fromStdString(file->getFilepath());
+    }
+    // cut off in the middle of the model, with a header that agrees so the reader itself runs out of bytes
+    const qint64 HEADER_SIZE = 4 * sizeof(uint32_t) + sizeof(uint64_t);
+    QFile entry(filepath);
+    QVERIFY(entry.open(QIODevice::ReadWrite));
+    QVERIFY(entry.resize(entry.size() / 2));
+    uint64_t payloadSize = (uint64_t)(entry.size() - HEADER_SIZE);
+    QVERIFY(entry.seek(4 * sizeof(uint32_t)));
+    QCOMPARE(entry.write(reinterpret_cast<const char*>(&payloadSize), sizeof(payloadSize)), (qint64)sizeof(payloadSize));
+    entry.close();
+
+    // a miss that removes the entry, from the cache and from disk
+    QVERIFY(!cache->load(key));
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+    QVERIFY(!cache->getFile(key));
+    QVERIFY(!QFile::exists(filepath));
+
+    // so the model baked again takes its place
+    cache->store(key, makeModel());
+    QVERIFY(cache->load(key));
+}
+
+void ProcessedModelCacheTests::testIndexOutOfRange() {
+    auto cache = makeCache(_testDir.path() + "/outOfRange");
+    const ProcessedModelCache::Key key = "outofrange";
+    auto model = makeModel();
+    model.shapes[0].material = 1;
+    cache->store(key, model);
+
+    // the entry reads back whole, but its shape points past the materials
+    QVERIFY(!cache->load(key));
+    QVERIFY(!cache->getFile(key));
+
+    model = makeModel();
+    model.joints[0].parentIndex = 1;
+    cache->store(key, model);
+    QVERIFY(!cache->load(key));
+    QCOMPARE(cache->getNumMisses(), (uint32_t)2);
+}
@@ -0,0 +1,28 @@
+//
+//  ProcessedModelCacheTests.h
+//  tests/model-networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ProcessedModelCacheTests_h
+#define hifi_ProcessedModelCacheTests_h
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+
+class ProcessedModelCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRoundTrip();
+    void testTruncatedEntry();
+    void testIndexOutOfRange();
+
+private:
+    QTemporaryDir _testDir;
+};
+
+#endif // hifi_ProcessedModelCacheTests_h
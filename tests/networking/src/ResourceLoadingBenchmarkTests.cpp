@@ -0,0 +1,294 @@
+//
+//  ResourceLoadingBenchmarkTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceLoadingBenchmarkTests.h"
+
+#include <algorithm>
+#include <list>
+#include <random>
+
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include <DependencyManager.h>
+#include <LimitedNodeList.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ResourceCache.h>
+#include <ResourceRequestObserver.h>
+#include <StatTracker.h>
+
+QTEST_MAIN(ResourceLoadingBenchmarkTests)
+
+// The scenario is generated from a fixed seed, so every run replays the same arrival
+const unsigned int SCENARIO_SEED = 1234;
+const int NUM_RESOURCES = 240;
+const int MIN_RESOURCE_SIZE = 16 * 1024;
+const int MAX_RESOURCE_SIZE = 512 * 1024;
+
+const int NUM_SERVERS = 2;
+const int SERVER_BYTES_PER_SECOND = 8 * 1024 * 1024;
+const int SERVER_LATENCY_MSECS = 30;
+const int SERVER_TICK_MSECS = 10;
+
+// The origin limit is below the connections QNetworkAccessManager opens per host, and both servers at the origin limit
+// stay under the request limit, so the origin limit alone caps what each server gets
+const uint32_t REQUEST_LIMIT = 8;
+const uint32_t ORIGIN_REQUEST_LIMIT = 3;
+const int MOVE_AFTER_MSECS = 500;
+const int TIMEOUT_MSECS = 60 * 1000;
+
+enum class Arrival {
+    Unprioritized, // every resource at the same priority
+    Prioritized, // priorities known from the start
+    Moving // priorities change part way through, as if the user had turned around
+};
+Q_DECLARE_METATYPE(Arrival)
+
+// A local stand-in for an asset host.  Serves /<name>-<size> as <size> bytes after a fixed latency, with every transfer
+// in flight sharing the server's bandwidth.
+class SyntheticContentServer : public QTcpServer {
+public:
+    SyntheticContentServer() {
+        connect(this, &QTcpServer::newConnection, this, &SyntheticContentServer::acceptConnections);
+        connect(&_tick, &QTimer::timeout, this, &SyntheticContentServer::sendChunks);
+        _tick.start(SERVER_TICK_MSECS);
+    }
+
+private:
+    class Transfer {
+    public:
+        QPointer<QTcpSocket> socket;
+        qint64 remaining { 0 };
+    };
+
+    void acceptConnections() {
+        while (hasPendingConnections()) {
+            QTcpSocket* socket = nextPendingConnection();
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket] { readRequest(socket); });
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    }
+
+    void readRequest(QTcpSocket* socket) {
+        QByteArray& request = _requests[socket];
+        request += socket->readAll();
+        if (!request.contains("\r\n\r\n")) {
+            return;
+        }
+        QByteArray path = request.left(request.indexOf("\r\n")).split(' ').value(1);
+        _requests.remove(socket);
+
+        qint64 size = path.mid(path.lastIndexOf('-') + 1).toLongLong();
+        QPointer<QTcpSocket> guardedSocket(socket);
+        QTimer::singleShot(SERVER_LATENCY_MSECS, this, [this, guardedSocket, size] {
+            if (!guardedSocket) {
+                return;
+            }
+            guardedSocket->write(QString("HTTP/1.1 200 OK\r\n"
+                                         "Content-Type: application/octet-stream\r\n"
+                                         "Content-Length: %1\r\n"
+                                         "Cache-Control: no-store\r\n"
+                                         "Connection: close\r\n\r\n").arg(size).toUtf8());
+            _transfers.push_back({ guardedSocket, size });
+        });
+    }
+
+    void sendChunks() {
+        if (_transfers.empty()) {
+            return;
+        }
+        const qint64 budget = (qint64)SERVER_BYTES_PER_SECOND * SERVER_TICK_MSECS / (qint64)MSECS_PER_SECOND;
+        const qint64 share = std::max<qint64>(budget / (qint64)_transfers.size(), 1);
+        for (auto transfer = _transfers.begin(); transfer != _transfers.end();) {
+            if (!transfer->socket) {
+                transfer = _transfers.erase(transfer);
+                continue;
+            }
+            qint64 chunk = std::min(share, transfer->remaining);
+            transfer->socket->write(QByteArray((int)chunk, 'x'));
+            transfer->remaining -= chunk;
+            if (transfer->remaining == 0) {
+                transfer->socket->disconnectFromHost();
+                transfer = _transfers.erase(transfer);
+                continue;
+            }
+            ++transfer;
+        }
+    }
+
+    QTimer _tick;
+    QHash<QTcpSocket*, QByteArray> _requests;
+    std::list<Transfer> _transfers;
+};
+
+class ScenarioResource {
+public:
+    QUrl url;
+    float priority { 0.0f };
+    float movedPriority { 0.0f };
+    qint64 loadedMsecs { -1 };
+};
+
+static std::vector<ScenarioResource> makeScenario(const std::vector<quint16>& ports) {
+    std::mt19937 generator(SCENARIO_SEED);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<ScenarioResource> scenario(NUM_RESOURCES);
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        // mostly small resources with a long tail of big ones, like a domain's textures and models
+        int size = (int)(MIN_RESOURCE_SIZE * powf((float)MAX_RESOURCE_SIZE / MIN_RESOURCE_SIZE, unit(generator)));
+        auto port = ports[i % ports.size()];
+        scenario[i].url = QUrl(QString("http://127.0.0.1:%1/resource%2-%3").arg(port).arg(i).arg(size));
+        scenario[i].priority = unit(generator);
+        scenario[i].movedPriority = unit(generator);
+    }
+    return scenario;
+}
+
+// The mean time to load the tenth of the resources with the highest priority, and of all of them
+static std::pair<float, float> meanLoadTimes(const std::vector<ScenarioResource>& scenario, bool moved) {
+    std::vector<const ScenarioResource*> byPriority;
+    for (const auto& resource : scenario) {
+        byPriority.push_back(&resource);
+    }
+    std::sort(byPriority.begin(), byPriority.end(), [moved](const ScenarioResource* a, const ScenarioResource* b) {
+        return moved ? a->movedPriority > b->movedPriority : a->priority > b->priority;
+    });
+
+    const size_t numHighest = byPriority.size() / 10;
+    float highestSum = 0.0f;
+    float allSum = 0.0f;
+    for (size_t i = 0; i < byPriority.size(); i++) {
+        if (i < numHighest) {
+            highestSum += byPriority[i]->loadedMsecs;
+        }
+        allSum += byPriority[i]->loadedMsecs;
+    }
+    return { highestSum / numHighest, allSum / byPriority.size() };
+}
+
+void ResourceLoadingBenchmarkTests::initTestCase() {
+    DependencyManager::set<StatTracker>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<ResourceRequestObserver>();
+
+    ResourceCache::setRequestLimit(REQUEST_LIMIT);
+    ResourceCache::setOriginRequestLimit(ORIGIN_REQUEST_LIMIT);
+
+    for (int i = 0; i < NUM_SERVERS; i++) {
+        _servers.emplace_back(new SyntheticContentServer());
+        QVERIFY(_servers.back()->listen(QHostAddress::LocalHost));
+    }
+}
+
+void ResourceLoadingBenchmarkTests::cleanupTestCase() {
+    _servers.clear();
+    DependencyManager::get<ResourceManager>()->cleanup();
+}
+
+void ResourceLoadingBenchmarkTests::benchmarkArrival_data() {
+    QTest::addColumn<Arrival>("arrival");
+    QTest::newRow("unprioritized") << Arrival::Unprioritized;
+    QTest::newRow("prioritized") << Arrival::Prioritized;
+    QTest::newRow("moving") << Arrival::Moving;
+}
+
+void ResourceLoadingBenchmarkTests::benchmarkArrival() {
+    QFETCH(Arrival, arrival);
+
+    std::vector<quint16> ports;
+    for (const auto& server : _servers) {
+        ports.push_back(server->serverPort());
+    }
+    auto scenario = makeScenario(ports);
+
+    QObject owner;
+    std::vector<QSharedPointer<Resource>> resources;
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    std::vector<QString> origins;
+    for (auto port : ports) {
+        origins.push_back(ResourceCacheSharedItems::getOrigin(QUrl(QString("http://127.0.0.1:%1/").arg(port))));
+    }
+    std::vector<uint32_t> maxRequestsPerOrigin(origins.size(), 0);
+    auto sampleRequestsPerOrigin = [&] {
+        for (size_t i = 0; i < origins.size(); i++) {
+            maxRequestsPerOrigin[i] = std::max(maxRequestsPerOrigin[i], sharedItems->getLoadingRequestsCount(origins[i]));
+        }
+    };
+    int numFinished = 0;
+    int numFailed = 0;
+    quint64 bytesBefore = ResourceCache::getBytesReceived();
+    qint64 totalMsecs = 0;
+
+    QBENCHMARK_ONCE {
+        QEventLoop loop;
+        QElapsedTimer timer;
+        timer.start();
+
+        for (int i = 0; i < NUM_RESOURCES; i++) {
+            auto resource = QSharedPointer<Resource>::create(scenario[i].url);
+            resource->setSelf(resource);
+            if (arrival != Arrival::Unprioritized) {
+                resource->setLoadPriority(&owner, scenario[i].priority);
+            }
+            connect(resource.data(), &Resource::finished, &loop, [&, i](bool success) {
+                scenario[i].loadedMsecs = timer.elapsed();
+                sampleRequestsPerOrigin();
+                if (!success) {
+                    numFailed++;
+                }
+                if (++numFinished == NUM_RESOURCES) {
+                    loop.quit();
+                }
+            });
+            resources.push_back(resource);
+        }
+        for (const auto& resource : resources) {
+            resource->ensureLoading();
+        }
+        sampleRequestsPerOrigin();
+        QTimer sampler;
+        connect(&sampler, &QTimer::timeout, &loop, sampleRequestsPerOrigin);
+        sampler.start(SERVER_TICK_MSECS);
+
+        if (arrival == Arrival::Moving) {
+            QTimer::singleShot(MOVE_AFTER_MSECS, &loop, [&] {
+                for (int i = 0; i < NUM_RESOURCES; i++) {
+                    if (!resources[i]->isLoaded()) {
+                        resources[i]->setLoadPriority(&owner, scenario[i].movedPriority);
+                    }
+                }
+            });
+        }
+
+        QTimer::singleShot(TIMEOUT_MSECS, &loop, &QEventLoop::quit);
+        loop.exec();
+        totalMsecs = timer.elapsed();
+    }
+
+    QCOMPARE(numFinished, NUM_RESOURCES);
+    QCOMPARE(numFailed, 0);
+
+    auto meanTimes = meanLoadTimes(scenario, arrival == Arrival::Moving);
+    float megabytes = (float)(ResourceCache::getBytesReceived() - bytesBefore) / MB_TO_BYTES(1);
+    float megabytesPerSecond = megabytes * MSECS_PER_SECOND / std::max<qint64>(totalMsecs, 1);
+    qDebug() << "Loaded" << NUM_RESOURCES << "resources in" << totalMsecs << "ms:" << megabytes << "MB at"
+             << megabytesPerSecond << "MB/s, mean load time" << meanTimes.second
+             << "ms, highest priority tenth" << meanTimes.first << "ms";
+
+    // the load times depend on the machine, so they are reported but not checked; the request counts are not
+    for (size_t i = 0; i < origins.size(); i++) {
+        QCOMPARE(maxRequestsPerOrigin[i], ORIGIN_REQUEST_LIMIT);
+    }
+}
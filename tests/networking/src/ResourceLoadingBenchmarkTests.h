@@ -0,0 +1,36 @@
+//
+//  ResourceLoadingBenchmarkTests.h
+//  tests/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceLoadingBenchmarkTests_h
+#define hifi_ResourceLoadingBenchmarkTests_h
+
+#include <memory>
+#include <vector>
+
+#include <QtNetwork/QTcpServer>
+#include <QtTest/QtTest>
+
+// Replays arriving in a dense domain: a few hundred resources of mixed size and priority are requested at once from two
+// local, bandwidth limited HTTP servers, and the time until each one loads is reported against its priority.  What is
+// checked is that each server gets as many concurrent requests as the origin limit allows, and no more.
+class ResourceLoadingBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void benchmarkArrival_data();
+    void benchmarkArrival();
+    void cleanupTestCase();
+
+private:
+    std::vector<std::unique_ptr<QTcpServer>> _servers;
+};
+
+#endif // hifi_ResourceLoadingBenchmarkTests_h
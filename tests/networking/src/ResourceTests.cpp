@@ -93,3 +93,18 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+void ResourceTests::testOrigin() {
+    // a url without a port shares the origin of the same url with the scheme's default port
+    QCOMPARE(ResourceCacheSharedItems::getOrigin(QUrl("http://example.com/a.fst")),
+             ResourceCacheSharedItems::getOrigin(QUrl("http://example.com:80/b.fbx")));
+    QCOMPARE(ResourceCacheSharedItems::getOrigin(QUrl("https://example.com/a.fst")),
+             ResourceCacheSharedItems::getOrigin(QUrl("https://example.com:443/b.fbx")));
+    QVERIFY(ResourceCacheSharedItems::getOrigin(QUrl("http://example.com/a.fst")) !=
+            ResourceCacheSharedItems::getOrigin(QUrl("http://example.com:8080/a.fst")));
+    QVERIFY(ResourceCacheSharedItems::getOrigin(QUrl("http://example.com/a.fst")) !=
+            ResourceCacheSharedItems::getOrigin(QUrl("https://example.com/a.fst")));
+
+    // local files have no origin
+    QVERIFY(ResourceCacheSharedItems::getOrigin(QUrl::fromLocalFile("/models/a.fst")).isEmpty());
+}
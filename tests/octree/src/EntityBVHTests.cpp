@@ -0,0 +1,204 @@
+//
+//  EntityBVHTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBVHTests.h"
+
+#include <set>
+
+#include <EntityBVH.h>
+#include <EntityItemProperties.h>
+#include <EntityTypes.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(EntityBVHTests)
+
+const float WORLD_HALF_WIDTH = 100.0f;
+
+struct TestEntity {
+    EntityItemPointer entity;
+    AABox bounds;
+};
+
+static std::vector<TestEntity> createEntities(size_t count) {
+    std::vector<TestEntity> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        TestEntity testEntity;
+        testEntity.entity = EntityTypes::constructEntityItem(EntityTypes::Box, EntityItemID(QUuid::createUuid()),
+                                                             EntityItemProperties());
+        glm::vec3 corner(randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH),
+                         randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH),
+                         randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH));
+        glm::vec3 dimensions(randFloatInRange(0.1f, 5.0f), randFloatInRange(0.1f, 5.0f), randFloatInRange(0.1f, 5.0f));
+        testEntity.bounds = AABox(corner, dimensions);
+        entities.push_back(testEntity);
+    }
+    return entities;
+}
+
+static bool rayHitsBox(const AABox& box, const glm::vec3& origin, const glm::vec3& direction) {
+    if (box.contains(origin)) {
+        return true;
+    }
+    float distance;
+    BoxFace face;
+    glm::vec3 normal;
+    return box.findRayIntersection(origin, direction, 1.0f / direction, distance, face, normal);
+}
+
+void EntityBVHTests::testInsertRemove() {
+    const size_t NUM_ENTITIES = 1000;
+    std::vector<TestEntity> entities = createEntities(NUM_ENTITIES);
+
+    EntityBVH bvh;
+    for (const auto& testEntity : entities) {
+        bvh.insert(testEntity.entity, testEntity.bounds);
+    }
+    QCOMPARE(bvh.size(), NUM_ENTITIES);
+
+    // a balanced binary tree of 1000 leaves is ~10 deep, rotations should keep us well under twice that
+    QVERIFY(bvh.getHeight() < 25);
+
+    for (size_t i = 0; i < NUM_ENTITIES; i += 2) {
+        bvh.remove(entities[i].entity->getEntityItemID());
+    }
+    QCOMPARE(bvh.size(), NUM_ENTITIES / 2);
+    for (size_t i = 0; i < NUM_ENTITIES; ++i) {
+        QCOMPARE(bvh.contains(entities[i].entity->getEntityItemID()), (i % 2) == 1);
+    }
+
+    bvh.clear();
+    QCOMPARE(bvh.size(), (size_t)0);
+    QCOMPARE(bvh.getHeight(), 0);
+}
+
+void EntityBVHTests::testRayQuery() {
+    std::vector<TestEntity> entities = createEntities(500);
+    EntityBVH bvh;
+    for (const auto& testEntity : entities) {
+        bvh.insert(testEntity.entity, testEntity.bounds);
+    }
+
+    const int NUM_RAYS = 50;
+    for (int i = 0; i < NUM_RAYS; ++i) {
+        glm::vec3 origin(randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH), randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH),
+                         -2.0f * WORLD_HALF_WIDTH);
+        glm::vec3 direction = glm::normalize(glm::vec3(randFloatInRange(-0.2f, 0.2f), randFloatInRange(-0.2f, 0.2f), 1.0f));
+
+        // never shrink maxDistance, so every entity whose bounds are hit must be visited
+        std::set<EntityItem*> visited;
+        bvh.findRayIntersections(origin, direction, FLT_MAX, [&](const EntityItemPointer& entity, float maxDistance) {
+            visited.insert(entity.get());
+            return maxDistance;
+        });
+
+        for (const auto& testEntity : entities) {
+            if (rayHitsBox(testEntity.bounds, origin, direction)) {
+                QVERIFY(visited.count(testEntity.entity.get()) == 1);
+            }
+        }
+    }
+
+    // shrinking maxDistance to the first hit stops the search
+    glm::vec3 origin(0.0f, 0.0f, -2.0f * WORLD_HALF_WIDTH);
+    glm::vec3 direction(0.0f, 0.0f, 1.0f);
+    int numVisited = 0;
+    bvh.findRayIntersections(origin, direction, FLT_MAX, [&](const EntityItemPointer& entity, float maxDistance) {
+        ++numVisited;
+        return 0.0f;
+    });
+    QVERIFY(numVisited <= 1);
+}
+
+void EntityBVHTests::testBatchedRayQuery() {
+    std::vector<TestEntity> entities = createEntities(500);
+    EntityBVH bvh;
+    for (const auto& testEntity : entities) {
+        bvh.insert(testEntity.entity, testEntity.bounds);
+    }
+
+    std::vector<EntityBVH::Ray> rays;
+    for (int i = 0; i < 4; ++i) {
+        EntityBVH::Ray ray;
+        ray.origin = glm::vec3(randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH), 0.0f, -2.0f * WORLD_HALF_WIDTH);
+        ray.direction = glm::normalize(glm::vec3(0.0f, randFloatInRange(-0.2f, 0.2f), 1.0f));
+        rays.push_back(ray);
+    }
+
+    std::vector<std::set<EntityItem*>> visited(rays.size());
+    bvh.findRayIntersections(rays, [&](size_t rayIndex, const EntityItemPointer& entity, float maxDistance) {
+        visited[rayIndex].insert(entity.get());
+        return maxDistance;
+    });
+
+    for (size_t i = 0; i < rays.size(); ++i) {
+        for (const auto& testEntity : entities) {
+            if (rayHitsBox(testEntity.bounds, rays[i].origin, rays[i].direction)) {
+                QVERIFY(visited[i].count(testEntity.entity.get()) == 1);
+            }
+        }
+    }
+}
+
+void EntityBVHTests::testSphereAndBoxQueries() {
+    std::vector<TestEntity> entities = createEntities(500);
+    EntityBVH bvh;
+    for (const auto& testEntity : entities) {
+        bvh.insert(testEntity.entity, testEntity.bounds);
+    }
+
+    glm::vec3 center(0.0f);
+    float radius = 30.0f;
+    std::set<EntityItem*> inSphere;
+    bvh.findEntitiesInSphere(center, radius, [&](const EntityItemPointer& entity) {
+        inSphere.insert(entity.get());
+    });
+
+    AABox queryBox(glm::vec3(-20.0f), glm::vec3(40.0f));
+    std::set<EntityItem*> inBox;
+    bvh.findEntitiesInBox(queryBox, [&](const EntityItemPointer& entity) {
+        inBox.insert(entity.get());
+    });
+
+    for (const auto& testEntity : entities) {
+        glm::vec3 closestPoint = glm::clamp(center, testEntity.bounds.getMinimumPoint(), testEntity.bounds.getMaximumPoint());
+        if (glm::distance(closestPoint, center) < radius) {
+            QVERIFY(inSphere.count(testEntity.entity.get()) == 1);
+        }
+        if (queryBox.touches(testEntity.bounds)) {
+            QVERIFY(inBox.count(testEntity.entity.get()) == 1);
+        }
+    }
+}
+
+void EntityBVHTests::testUpdate() {
+    std::vector<TestEntity> entities = createEntities(100);
+    EntityBVH bvh;
+    for (const auto& testEntity : entities) {
+        bvh.insert(testEntity.entity, testEntity.bounds);
+    }
+
+    // a tiny move stays inside the fattened leaf
+    TestEntity& moved = entities[0];
+    AABox nudged(moved.bounds.getCorner() + glm::vec3(0.001f), moved.bounds.getDimensions());
+    QCOMPARE(bvh.update(moved.entity, nudged), false);
+
+    // a big move re-inserts it, and it is found at its new location only
+    AABox farAway(glm::vec3(10.0f * WORLD_HALF_WIDTH), glm::vec3(1.0f));
+    QCOMPARE(bvh.update(moved.entity, farAway), true);
+    QCOMPARE(bvh.size(), entities.size());
+
+    std::set<EntityItem*> found;
+    bvh.findEntitiesInBox(farAway, [&](const EntityItemPointer& entity) {
+        found.insert(entity.get());
+    });
+    QCOMPARE(found.size(), (size_t)1);
+    QVERIFY(found.count(moved.entity.get()) == 1);
+}
@@ -0,0 +1,27 @@
+//
+//  EntityBVHTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBVHTests_h
+#define hifi_EntityBVHTests_h
+
+#include <QtTest/QtTest>
+
+class EntityBVHTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testInsertRemove();
+    void testRayQuery();
+    void testBatchedRayQuery();
+    void testSphereAndBoxQueries();
+    void testUpdate();
+};
+
+#endif // hifi_EntityBVHTests_h
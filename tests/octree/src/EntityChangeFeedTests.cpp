@@ -0,0 +1,207 @@
+//
+//  EntityChangeFeedTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityChangeFeedTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <AddEntityOperator.h>
+#include <EntityChangeFeed.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTypes.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <SimpleEntitySimulation.h>
+
+QTEST_MAIN(EntityChangeFeedTests)
+
+void EntityChangeFeedTests::testPublishAndRead() {
+    EntityChangeFeed feed(16);
+    EntityChangeFeed::Sequence cursor = feed.getLatestSequence();
+    QCOMPARE(cursor, (EntityChangeFeed::Sequence)0);
+    QVERIFY(!feed.hasChangesSince(cursor));
+
+    EntityItemID first(QUuid::createUuid());
+    EntityItemID second(QUuid::createUuid());
+    feed.publish(EntityChange::Add, first);
+    feed.publish(EntityChange::Edit, first, EntityPropertyFlags(PROP_POSITION));
+    feed.publish(EntityChange::Add, second);
+    feed.publish(EntityChange::Delete, first);
+    QVERIFY(feed.hasChangesSince(cursor));
+
+    // a bounded read leaves the rest for the next one
+    std::vector<EntityChange> changes;
+    QCOMPARE(feed.read(cursor, changes, 3), EntityChangeFeed::Ok);
+    QCOMPARE((int)changes.size(), 3);
+    QCOMPARE(cursor, (EntityChangeFeed::Sequence)3);
+    QCOMPARE(feed.read(cursor, changes), EntityChangeFeed::Ok);
+    QCOMPARE((int)changes.size(), 4);
+    QCOMPARE(cursor, feed.getLatestSequence());
+
+    QCOMPARE(changes[0].type, EntityChange::Add);
+    QCOMPARE(changes[0].entityID, first);
+    QCOMPARE(changes[1].type, EntityChange::Edit);
+    QCOMPARE(changes[2].entityID, second);
+    QCOMPARE(changes[3].type, EntityChange::Delete);
+    for (size_t i = 0; i < changes.size(); ++i) {
+        QCOMPARE(changes[i].sequence, (EntityChangeFeed::Sequence)(i + 1));
+    }
+
+    changes.clear();
+    QCOMPARE(feed.read(cursor, changes), EntityChangeFeed::Ok);
+    QVERIFY(changes.empty());
+}
+
+void EntityChangeFeedTests::testChangedProperties() {
+    EntityChangeFeed feed;
+    EntityPropertyFlags flags;
+    flags += PROP_POSITION;
+    flags += PROP_ROTATION;
+    flags += PROP_SCRIPT;
+    feed.publish(EntityChange::Edit, EntityItemID(QUuid::createUuid()), flags);
+
+    EntityChangeFeed::Sequence cursor = 0;
+    std::vector<EntityChange> changes;
+    QCOMPARE(feed.read(cursor, changes), EntityChangeFeed::Ok);
+    QCOMPARE((int)changes.size(), 1);
+    QVERIFY(changes[0].hasChangedProperty(PROP_POSITION));
+    QVERIFY(changes[0].hasChangedProperty(PROP_SCRIPT));
+    QVERIFY(!changes[0].hasChangedProperty(PROP_VELOCITY));
+    QVERIFY(changes[0].getChangedProperties() == flags);
+}
+
+void EntityChangeFeedTests::testOverrun() {
+    EntityChangeFeed feed(8);
+    QCOMPARE((int)feed.getCapacity(), 8);
+
+    EntityChangeFeed::Sequence cursor = feed.getLatestSequence();
+    for (int i = 0; i < 20; ++i) {
+        feed.publish(EntityChange::Edit, EntityItemID(QUuid::createUuid()));
+    }
+
+    std::vector<EntityChange> changes;
+    QCOMPARE(feed.read(cursor, changes), EntityChangeFeed::Overrun);
+    QCOMPARE(cursor, feed.getLatestSequence());
+
+    // once resynchronized the reader follows along again
+    feed.publish(EntityChange::Delete, EntityItemID(QUuid::createUuid()));
+    changes.clear();
+    QCOMPARE(feed.read(cursor, changes), EntityChangeFeed::Ok);
+    QCOMPARE((int)changes.size(), 1);
+    QCOMPARE(changes[0].type, EntityChange::Delete);
+}
+
+void EntityChangeFeedTests::testConcurrentReaders() {
+    const int NUM_CHANGES = 20000;
+    const int NUM_READERS = 4;
+    EntityChangeFeed feed(1024);
+    std::atomic<bool> done { false };
+    std::atomic<int> errors { 0 };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < NUM_READERS; ++i) {
+        readers.emplace_back([&] {
+            EntityChangeFeed::Sequence cursor = 0;
+            std::vector<EntityChange> changes;
+            while (true) {
+                bool wasDone = done.load();
+                changes.clear();
+                EntityChangeFeed::Sequence previous = cursor;
+                if (feed.read(cursor, changes) == EntityChangeFeed::Ok) {
+                    // every change we got must be complete and in order
+                    for (const auto& change : changes) {
+                        if (change.sequence != ++previous || change.entityID.isNull() ||
+                                !change.hasChangedProperty(PROP_POSITION)) {
+                            ++errors;
+                        }
+                    }
+                }
+                if (wasDone && !feed.hasChangesSince(cursor)) {
+                    break;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < NUM_CHANGES; ++i) {
+        feed.publish(EntityChange::Edit, EntityItemID(QUuid::createUuid()), EntityPropertyFlags(PROP_POSITION));
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    QCOMPARE(errors.load(), 0);
+    QCOMPARE(feed.getLatestSequence(), (EntityChangeFeed::Sequence)NUM_CHANGES);
+}
+
+void EntityChangeFeedTests::testKinematicMoveIntoView() {
+    // the entity server skips Repeat traversals of a static view while the feed doesn't move, so an entity the
+    // simulation moves into that view must show up in the feed
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    SimpleEntitySimulationPointer simulation { new SimpleEntitySimulation() };
+    simulation->setEntityTree(tree);
+    tree->setSimulation(simulation);
+
+    const AABox view(glm::vec3(-5.0f), 10.0f);
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(20.0f, 0.0f, 0.0f));
+    properties.setDimensions(glm::vec3(1.0f));
+    properties.setDamping(0.0f);
+    EntityItemPointer entity = EntityTypes::constructEntityItem(EntityTypes::Box, EntityItemID(QUuid::createUuid()),
+                                                                properties);
+    QVERIFY(entity);
+    tree->withWriteLock([&] {
+        AddEntityOperator theOperator(tree, entity);
+        tree->recurseTreeWithOperator(&theOperator);
+        tree->postAddEntity(entity);
+    });
+
+    // start moving towards the view, the simulation picks it up as a simple kinematic entity
+    EntityItemProperties velocity;
+    velocity.setVelocity(glm::vec3(-20.0f, 0.0f, 0.0f));
+    entity->setProperties(velocity);
+    tree->entityChanged(entity);
+    tree->preUpdate();
+
+    QVector<QUuid> inView;
+    tree->withReadLock([&] {
+        tree->evalEntitiesInBox(view, PickFilter(), inView);
+    });
+    QVERIFY(inView.isEmpty());
+
+    EntityChangeFeed::Sequence cursor = tree->getChangeFeed().getLatestSequence();
+    entity->setLastSimulated(usecTimestampNow() - USECS_PER_SECOND);
+    tree->update(true);
+
+    tree->withReadLock([&] {
+        tree->evalEntitiesInBox(view, PickFilter(), inView);
+    });
+    QCOMPARE(inView.size(), 1);
+    QCOMPARE(inView[0], entity->getID());
+
+    QVERIFY(tree->getChangeFeed().hasChangesSince(cursor));
+    std::vector<EntityChange> changes;
+    QCOMPARE(tree->getChangeFeed().read(cursor, changes), EntityChangeFeed::Ok);
+    bool foundMove = false;
+    for (const auto& change : changes) {
+        if (change.entityID == entity->getEntityItemID() && change.type == EntityChange::Edit &&
+                change.hasChangedProperty(PROP_POSITION)) {
+            foundMove = true;
+        }
+    }
+    QVERIFY(foundMove);
+
+    tree->setSimulation(nullptr);
+    tree->eraseAllOctreeElements(false);
+}
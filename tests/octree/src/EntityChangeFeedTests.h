@@ -0,0 +1,27 @@
+//
+//  EntityChangeFeedTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityChangeFeedTests_h
+#define hifi_EntityChangeFeedTests_h
+
+#include <QtTest/QtTest>
+
+class EntityChangeFeedTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testPublishAndRead();
+    void testChangedProperties();
+    void testOverrun();
+    void testConcurrentReaders();
+    void testKinematicMoveIntoView();
+};
+
+#endif // hifi_EntityChangeFeedTests_h
@@ -0,0 +1,170 @@
+//
+//  EntityPropertySnapshotTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPropertySnapshotTests.h"
+
+#include <AddEntityOperator.h>
+#include <EntityChangeFeed.h>
+#include <EntityItemProperties.h>
+#include <EntityPropertySnapshot.h>
+#include <EntityTree.h>
+#include <EntityTypes.h>
+
+QTEST_MAIN(EntityPropertySnapshotTests)
+
+static EntityPropertyFlags positionProperties() {
+    EntityPropertyFlags flags;
+    flags += PROP_POSITION;
+    flags += PROP_PARENT_ID;
+    flags += PROP_PARENT_JOINT_INDEX;
+    return flags;
+}
+
+static EntityItemProperties childOf(const EntityItemID& parentID) {
+    EntityItemProperties properties;
+    properties.setParentID(parentID);
+    return properties;
+}
+
+static bool isCached(EntityPropertySnapshot& snapshot, const EntityItemID& entityID,
+                     const EntityPropertyFlags& desiredProperties = positionProperties()) {
+    EntityItemProperties properties;
+    bool scalesWithParent;
+    return snapshot.find(entityID, desiredProperties, properties, scalesWithParent);
+}
+
+void EntityPropertySnapshotTests::testFindByPropertyList() {
+    EntityPropertySnapshot snapshot;
+    EntityItemID entityID(QUuid::createUuid());
+    QVERIFY(!isCached(snapshot, entityID));
+
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    snapshot.insert(entityID, positionProperties(), properties, true);
+
+    EntityItemProperties found;
+    bool scalesWithParent = false;
+    QVERIFY(snapshot.find(entityID, positionProperties(), found, scalesWithParent));
+    QCOMPARE(found.getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(scalesWithParent);
+
+    // another property list is another read
+    QVERIFY(!isCached(snapshot, entityID, EntityPropertyFlags(PROP_NAME)));
+    QCOMPARE(snapshot.getNumHits(), 1);
+    QCOMPARE(snapshot.getNumMisses(), 2);
+
+    snapshot.clear();
+    QVERIFY(!isCached(snapshot, entityID));
+}
+
+void EntityPropertySnapshotTests::testInvalidateDescendants() {
+    EntityPropertySnapshot snapshot;
+    EntityItemID parentID(QUuid::createUuid());
+    EntityItemID childID(QUuid::createUuid());
+    EntityItemID grandchildID(QUuid::createUuid());
+    EntityItemID otherID(QUuid::createUuid());
+    // inserted children first, so one pass over the entries isn't enough
+    snapshot.insert(grandchildID, positionProperties(), childOf(childID), false);
+    snapshot.insert(childID, positionProperties(), childOf(parentID), false);
+    snapshot.insert(parentID, positionProperties(), EntityItemProperties(), false);
+    snapshot.insert(otherID, positionProperties(), EntityItemProperties(), false);
+
+    // the world position of descendants was read relative to the entity that changed
+    snapshot.invalidate(parentID);
+    QVERIFY(!isCached(snapshot, parentID));
+    QVERIFY(!isCached(snapshot, childID));
+    QVERIFY(!isCached(snapshot, grandchildID));
+    QVERIFY(isCached(snapshot, otherID));
+}
+
+void EntityPropertySnapshotTests::testCatchUpWithFeed() {
+    const size_t CAPACITY = 16;
+    EntityChangeFeed feed(CAPACITY);
+    EntityPropertySnapshot snapshot;
+    EntityItemID first(QUuid::createUuid());
+    EntityItemID second(QUuid::createUuid());
+
+    // changes from before the snapshot was first used have nothing to invalidate
+    feed.publish(EntityChange::Edit, first);
+    snapshot.catchUp(feed);
+    snapshot.insert(first, positionProperties(), EntityItemProperties(), false);
+    snapshot.insert(second, positionProperties(), EntityItemProperties(), false);
+    snapshot.catchUp(feed);
+    QVERIFY(isCached(snapshot, first));
+
+    // moves, edits and deletes from anywhere reach the snapshot through the feed
+    feed.publish(EntityChange::Edit, first, EntityPropertyFlags(PROP_POSITION));
+    snapshot.catchUp(feed);
+    QVERIFY(!isCached(snapshot, first));
+    QVERIFY(isCached(snapshot, second));
+
+    feed.publish(EntityChange::Delete, second);
+    snapshot.catchUp(feed);
+    QVERIFY(!isCached(snapshot, second));
+
+    // when the feed was lapped the snapshot doesn't know what changed
+    snapshot.insert(first, positionProperties(), EntityItemProperties(), false);
+    for (size_t i = 0; i < 2 * CAPACITY; ++i) {
+        feed.publish(EntityChange::Edit, EntityItemID(QUuid::createUuid()));
+    }
+    snapshot.catchUp(feed);
+    QVERIFY(!isCached(snapshot, first));
+
+    // nor does it know about the changes of another tree
+    snapshot.insert(first, positionProperties(), EntityItemProperties(), false);
+    EntityChangeFeed otherFeed(CAPACITY);
+    snapshot.catchUp(otherFeed);
+    QVERIFY(!isCached(snapshot, first));
+}
+
+void EntityPropertySnapshotTests::testParentEditInTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(1.0f));
+    properties.setDimensions(glm::vec3(1.0f));
+    EntityItemID parentID(QUuid::createUuid());
+    EntityItemPointer parent = EntityTypes::constructEntityItem(EntityTypes::Box, parentID, properties);
+    EntityItemID otherID(QUuid::createUuid());
+    EntityItemPointer other = EntityTypes::constructEntityItem(EntityTypes::Box, otherID, properties);
+    properties.setParentID(parentID);
+    EntityItemID childID(QUuid::createUuid());
+    EntityItemPointer child = EntityTypes::constructEntityItem(EntityTypes::Box, childID, properties);
+    QVERIFY(parent && child && other);
+    tree->withWriteLock([&] {
+        for (const auto& entity : { parent, other, child }) {
+            AddEntityOperator theOperator(tree, entity);
+            tree->recurseTreeWithOperator(&theOperator);
+            tree->postAddEntity(entity);
+        }
+    });
+
+    EntityPropertySnapshot snapshot;
+    snapshot.catchUp(tree->getChangeFeed());
+    tree->withReadLock([&] {
+        for (const auto& entity : { parent, other, child }) {
+            snapshot.insert(entity->getEntityItemID(), positionProperties(), entity->getProperties(positionProperties()),
+                            false);
+        }
+    });
+    QVERIFY(isCached(snapshot, childID));
+
+    // moving the parent moves the child, which the snapshot must not keep serving from the old read
+    EntityItemProperties move;
+    move.setPosition(glm::vec3(5.0f));
+    QVERIFY(tree->updateEntity(parentID, move));
+    snapshot.catchUp(tree->getChangeFeed());
+    QVERIFY(!isCached(snapshot, parentID));
+    QVERIFY(!isCached(snapshot, childID));
+    QVERIFY(isCached(snapshot, otherID));
+
+    tree->eraseAllOctreeElements(false);
+}
@@ -0,0 +1,26 @@
+//
+//  EntityPropertySnapshotTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPropertySnapshotTests_h
+#define hifi_EntityPropertySnapshotTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPropertySnapshotTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testFindByPropertyList();
+    void testInvalidateDescendants();
+    void testCatchUpWithFeed();
+    void testParentEditInTree();
+};
+
+#endif // hifi_EntityPropertySnapshotTests_h
@@ -0,0 +1,206 @@
+//
+//  OctreeElementStoreTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeElementStoreTests.h"
+
+#include <iostream>
+
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <OctreeElementStore.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(OctreeElementStoreTests)
+
+const float WORLD_HALF_WIDTH = 1000.0f;
+
+static void populateTree(const EntityTreePointer& tree, uint32_t numCells) {
+    // entity-sized cells scattered through the domain, roughly what 'numCells' entities would produce
+    for (uint32_t i = 0; i < numCells; ++i) {
+        glm::vec3 position(randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH),
+                           randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH),
+                           randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH));
+        float size = randFloatInRange(0.25f, 4.0f);
+        tree->getOrCreateChildElementContaining(AACube(position, size));
+    }
+}
+
+void OctreeElementStoreTests::testTraversalOrder() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    populateTree(tree, 200);
+
+    std::vector<OctreeElement*> expected;
+    tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+        expected.push_back(element.get());
+        return true;
+    });
+
+    std::vector<OctreeElement*> actual;
+    tree->recurseTreeWithOperationFlat([&](const OctreeElementPointer& element, void*) {
+        actual.push_back(element.get());
+        return true;
+    });
+
+    QCOMPARE(actual.size(), expected.size());
+    QVERIFY(actual == expected);
+    QCOMPARE((size_t)tree->getElementStore()->size(), expected.size());
+}
+
+void OctreeElementStoreTests::testChildHandles() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    populateTree(tree, 50);
+
+    ConstOctreeElementStorePointer store = tree->getElementStore();
+    std::vector<OctreeElementStore::Handle> handles;
+    store->traverse([&](OctreeElementStore::Handle handle) {
+        handles.push_back(handle);
+        return true;
+    });
+    QCOMPARE((uint32_t)handles.size(), store->size());
+
+    for (auto handle : handles) {
+        const OctreeElementPointer& element = store->getElement(handle);
+        QVERIFY(store->getAACube(handle) == element->getAACube());
+        for (int i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+            OctreeElementStore::Handle child = store->getChild(handle, i);
+            OctreeElementPointer expectedChild = element->getChildAtIndex(i);
+            if (expectedChild) {
+                QVERIFY(child != OctreeElementStore::INVALID_HANDLE);
+                QCOMPARE(store->getElement(child), expectedChild);
+            } else {
+                QCOMPARE(child, OctreeElementStore::INVALID_HANDLE);
+            }
+        }
+    }
+}
+
+void OctreeElementStoreTests::testRayIntersectedElements() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    AACube target(glm::vec3(10.0f, 0.0f, 0.0f), 1.0f);
+    OctreeElementPointer targetElement = tree->getOrCreateChildElementContaining(target);
+    AACube miss(glm::vec3(10.0f, 50.0f, 0.0f), 1.0f);
+    OctreeElementPointer missElement = tree->getOrCreateChildElementContaining(miss);
+
+    ConstOctreeElementStorePointer store = tree->getElementStore();
+    std::vector<OctreeElementStore::HandleDistance> hits;
+    glm::vec3 origin(-100.0f, 0.5f, 0.5f);
+    glm::vec3 direction(1.0f, 0.0f, 0.0f);
+    store->findRayIntersectedElements(origin, direction, FLT_MAX, hits);
+
+    bool foundTarget = false;
+    float lastDistance = 0.0f;
+    for (const auto& hit : hits) {
+        QVERIFY(hit.first >= lastDistance);
+        lastDistance = hit.first;
+        const OctreeElementPointer& element = store->getElement(hit.second);
+        QVERIFY(element != missElement);
+        if (element == targetElement) {
+            foundTarget = true;
+            QVERIFY(hit.first <= 110.0f);
+        }
+    }
+    QVERIFY(foundTarget);
+
+    // a short ray stops before reaching the target
+    hits.clear();
+    store->findRayIntersectedElements(origin, direction, 50.0f, hits);
+    for (const auto& hit : hits) {
+        QVERIFY(store->getElement(hit.second) != targetElement);
+    }
+}
+
+void OctreeElementStoreTests::testStaleAfterEdit() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    populateTree(tree, 10);
+
+    ConstOctreeElementStorePointer before = tree->getElementStore();
+    QVERIFY(!before->isStale(tree->getStructureGeneration()));
+    QCOMPARE(tree->getElementStore(), before);
+
+    tree->getOrCreateChildElementContaining(AACube(glm::vec3(-500.0f, 500.0f, -500.0f), 0.5f));
+    QVERIFY(before->isStale(tree->getStructureGeneration()));
+
+    ConstOctreeElementStorePointer after = tree->getElementStore();
+    QVERIFY(after != before);
+    QVERIFY(!after->isStale(tree->getStructureGeneration()));
+    QVERIFY(after->size() > before->size());
+}
+
+void OctreeElementStoreTests::testStalePerTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    populateTree(tree, 10);
+    ConstOctreeElementStorePointer store = tree->getElementStore();
+
+    // growing another tree in the same process leaves this one's store alone
+    EntityTreePointer otherTree = std::make_shared<EntityTree>();
+    otherTree->createRootElement();
+    populateTree(otherTree, 10);
+    QVERIFY(!store->isStale(tree->getStructureGeneration()));
+    QCOMPARE(tree->getElementStore(), store);
+}
+
+#ifdef MANUAL_TEST
+void OctreeElementStoreTests::benchmarkTraversal() {
+    const uint32_t NUM_CELLS = 100000;
+    const int NUM_PASSES = 20;
+
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    populateTree(tree, NUM_CELLS);
+
+    uint64_t startTime = usecTimestampNow();
+    ConstOctreeElementStorePointer store = tree->getElementStore();
+    uint64_t buildTime = usecTimestampNow() - startTime;
+
+    uint32_t count = 0;
+    startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_PASSES; ++i) {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+            ++count;
+            return true;
+        });
+    }
+    uint64_t pointerTime = usecTimestampNow() - startTime;
+
+    startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_PASSES; ++i) {
+        tree->recurseTreeWithOperationFlat([&](const OctreeElementPointer& element, void*) {
+            ++count;
+            return true;
+        });
+    }
+    uint64_t flatTime = usecTimestampNow() - startTime;
+
+    const int NUM_RAYS = 1000;
+    std::vector<OctreeElementStore::HandleDistance> hits;
+    startTime = usecTimestampNow();
+    for (int i = 0; i < NUM_RAYS; ++i) {
+        glm::vec3 origin(randFloatInRange(-WORLD_HALF_WIDTH, WORLD_HALF_WIDTH), 0.0f, -WORLD_HALF_WIDTH);
+        glm::vec3 direction = glm::normalize(glm::vec3(randFloatInRange(-0.1f, 0.1f), randFloatInRange(-0.1f, 0.1f), 1.0f));
+        hits.clear();
+        store->findRayIntersectedElements(origin, direction, 2.0f * WORLD_HALF_WIDTH, hits);
+        count += (uint32_t)hits.size();
+    }
+    uint64_t rayTime = usecTimestampNow() - startTime;
+
+    std::cout << "numCells = " << NUM_CELLS << "  numElements = " << store->size()
+        << "  storeBytes = " << store->getMemoryUsage() << std::endl;
+    std::cout << "build = " << buildTime << " usec" << std::endl;
+    std::cout << "pointer traversal = " << (pointerTime / NUM_PASSES) << " usec/pass" << std::endl;
+    std::cout << "flat traversal = " << (flatTime / NUM_PASSES) << " usec/pass" << std::endl;
+    std::cout << "flat ray = " << ((float)rayTime / (float)NUM_RAYS) << " usec/ray" << std::endl;
+    std::cout << "(ignore " << count << ")" << std::endl;
+}
+#endif // MANUAL_TEST
@@ -0,0 +1,32 @@
+//
+//  OctreeElementStoreTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeElementStoreTests_h
+#define hifi_OctreeElementStoreTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class OctreeElementStoreTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testTraversalOrder();
+    void testChildHandles();
+    void testRayIntersectedElements();
+    void testStaleAfterEdit();
+    void testStalePerTree();
+#ifdef MANUAL_TEST
+    void benchmarkTraversal();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_OctreeElementStoreTests_h
@@ -0,0 +1,137 @@
+//
+//  PhysicsStateBatchTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsStateBatchTests.h"
+
+#include <PhysicsStateBatch.h>
+
+QTEST_MAIN(PhysicsStateBatchTests)
+
+const int MAX_MESSAGE_SIZE = 1400;
+
+static PhysicsStateBatch::Record makeRecord(const glm::vec3& position, int i) {
+    PhysicsStateBatch::Record record;
+    record.id = QUuid::createUuid();
+    record.position = position;
+    record.rotation = glm::angleAxis(0.1f * (float)i, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f)));
+    record.velocity = glm::vec3(0.5f * (float)i, -1.0f, 0.25f);
+    record.angularVelocity = glm::vec3(0.0f, 3.0f, -0.1f * (float)i);
+    record.acceleration = glm::vec3(0.0f, -9.8f, 0.0f);
+    return record;
+}
+
+void PhysicsStateBatchTests::testRoundTrip() {
+    PhysicsStateBatch batch(MAX_MESSAGE_SIZE);
+    std::vector<PhysicsStateBatch::Record> sent;
+    for (int i = 0; i < 10; ++i) {
+        PhysicsStateBatch::Record record = makeRecord(glm::vec3(100.0f + (float)i, 2.0f, -50.0f), i);
+        if (i == 3) {
+            record.hasQueryAACube = true;
+            record.queryAACube = AACube(glm::vec3(102.5f, 1.5f, -50.5f), 1.0f);
+        }
+        QVERIFY(batch.append(record));
+        sent.push_back(record);
+    }
+
+    const quint64 LAST_EDITED = 1234567890ULL;
+    QByteArray buffer = batch.encode(LAST_EDITED);
+    // plus a byte of the next message, which must be left alone
+    buffer.append('x');
+
+    int processedBytes = 0;
+    quint64 lastEdited = 0;
+    std::vector<PhysicsStateBatch::Record> received;
+    QVERIFY(PhysicsStateBatch::decode(reinterpret_cast<const unsigned char*>(buffer.constData()), buffer.size(),
+                                      processedBytes, lastEdited, received));
+    QCOMPARE(processedBytes, buffer.size() - 1);
+    QCOMPARE(lastEdited, LAST_EDITED);
+    QCOMPARE(received.size(), sent.size());
+
+    // append() already rounded what was sent to what is received
+    for (size_t i = 0; i < sent.size(); ++i) {
+        QCOMPARE(received[i].id, sent[i].id);
+        QCOMPARE(received[i].position, sent[i].position);
+        QCOMPARE(received[i].rotation, sent[i].rotation);
+        QCOMPARE(received[i].velocity, sent[i].velocity);
+        QCOMPARE(received[i].angularVelocity, sent[i].angularVelocity);
+        QCOMPARE(received[i].acceleration, sent[i].acceleration);
+        QCOMPARE(received[i].hasQueryAACube, sent[i].hasQueryAACube);
+        if (sent[i].hasQueryAACube) {
+            QCOMPARE(received[i].queryAACube, sent[i].queryAACube);
+        }
+    }
+
+    // truncated data is rejected
+    QVERIFY(!PhysicsStateBatch::decode(reinterpret_cast<const unsigned char*>(buffer.constData()), buffer.size() - 10,
+                                       processedBytes, lastEdited, received));
+}
+
+void PhysicsStateBatchTests::testQuantization() {
+    PhysicsStateBatch batch(MAX_MESSAGE_SIZE);
+    for (int i = 0; i < 20; ++i) {
+        PhysicsStateBatch::Record original = makeRecord(glm::vec3(-300.0f + 1.37f * (float)i, 0.123f, 7.77f), i);
+        PhysicsStateBatch::Record record = original;
+        QVERIFY(batch.append(record));
+
+        const float POSITION_STEP = 1.0f / (float)(1 << PhysicsStateBatch::POSITION_RADIX);
+        const float VELOCITY_STEP = 1.0f / (float)(1 << PhysicsStateBatch::VELOCITY_RADIX);
+        QVERIFY(glm::all(glm::lessThanEqual(glm::abs(record.position - original.position), glm::vec3(POSITION_STEP))));
+        QVERIFY(glm::all(glm::lessThanEqual(glm::abs(record.velocity - original.velocity), glm::vec3(VELOCITY_STEP))));
+        QVERIFY(glm::all(glm::lessThanEqual(glm::abs(record.angularVelocity - original.angularVelocity),
+                                            glm::vec3(VELOCITY_STEP))));
+        // within about a tenth of a degree
+        QVERIFY(fabsf(glm::dot(record.rotation, original.rotation)) > 0.99999f);
+    }
+}
+
+void PhysicsStateBatchTests::testLimits() {
+    // too far from the batch's origin
+    PhysicsStateBatch batch(MAX_MESSAGE_SIZE);
+    PhysicsStateBatch::Record record = makeRecord(glm::vec3(10.0f), 0);
+    QVERIFY(batch.append(record));
+    PhysicsStateBatch::Record farRecord = makeRecord(glm::vec3(10.0f + 2.0f * PhysicsStateBatch::POSITION_RANGE), 1);
+    PhysicsStateBatch::Record unchanged = farRecord;
+    QVERIFY(!batch.append(farRecord));
+    QCOMPARE(farRecord.position, unchanged.position);
+    QCOMPARE(batch.getNumRecords(), 1);
+
+    // too fast
+    PhysicsStateBatch::Record fastRecord = makeRecord(glm::vec3(10.0f), 2);
+    fastRecord.velocity.x = 2.0f * PhysicsStateBatch::VELOCITY_RANGE;
+    QVERIFY(!PhysicsStateBatch::canEncode(fastRecord));
+    QVERIFY(!batch.append(fastRecord));
+
+    // full
+    PhysicsStateBatch smallBatch(200);
+    int numAppended = 0;
+    for (int i = 0; i < 10; ++i) {
+        PhysicsStateBatch::Record next = makeRecord(glm::vec3(1.0f), i);
+        if (smallBatch.append(next)) {
+            ++numAppended;
+        }
+    }
+    QVERIFY(numAppended > 0 && numAppended < 10);
+    QVERIFY(smallBatch.encode(0).size() <= 200);
+}
+
+void PhysicsStateBatchTests::testClockSkew() {
+    PhysicsStateBatch batch(MAX_MESSAGE_SIZE);
+    PhysicsStateBatch::Record record = makeRecord(glm::vec3(0.0f), 0);
+    QVERIFY(batch.append(record));
+    QByteArray buffer = batch.encode(1000);
+    PhysicsStateBatch::adjustForClockSkew(buffer, -250);
+
+    int processedBytes = 0;
+    quint64 lastEdited = 0;
+    std::vector<PhysicsStateBatch::Record> received;
+    QVERIFY(PhysicsStateBatch::decode(reinterpret_cast<const unsigned char*>(buffer.constData()), buffer.size(),
+                                      processedBytes, lastEdited, received));
+    QCOMPARE(lastEdited, (quint64)750);
+}
@@ -0,0 +1,26 @@
+//
+//  PhysicsStateBatchTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsStateBatchTests_h
+#define hifi_PhysicsStateBatchTests_h
+
+#include <QtTest/QtTest>
+
+class PhysicsStateBatchTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testQuantization();
+    void testLimits();
+    void testClockSkew();
+};
+
+#endif // hifi_PhysicsStateBatchTests_h
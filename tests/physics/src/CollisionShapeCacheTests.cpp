@@ -0,0 +1,330 @@
+//
+//  CollisionShapeCacheTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CollisionShapeCacheTests.h"
+
+#include <CollisionShapeCache.h>
+#include <ShapeFactory.h>
+
+QTEST_GUILESS_MAIN(CollisionShapeCacheTests)
+
+// the layout of an entry: its header, then for hulls the margin and point count of the first hull
+const qint64 PAYLOAD_SIZE_OFFSET = 3 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+const qint64 HEADER_SIZE = PAYLOAD_SIZE_OFFSET + sizeof(uint64_t);
+const qint64 FIRST_HULL_NUM_POINTS_OFFSET = HEADER_SIZE + sizeof(float);
+
+const int GRID_SIZE = 16;
+
+static std::shared_ptr<CollisionShapeCache> makeCache(const QString& location) {
+    auto cache = std::make_shared<CollisionShapeCache>(location.toStdString());
+    // skips the cache version check of CollisionShapeCache::initialize, which needs the settings
+    cache->cache::FileCache::initialize();
+    return cache;
+}
+
+// the path of the one entry in the cache
+static QString getEntryPath(const QString& location) {
+    auto entries = QDir(location).entryInfoList({ "*.shape" }, QDir::Files);
+    return entries.size() == 1 ? entries[0].absoluteFilePath() : QString();
+}
+
+// cuts the entry in half, with a header that agrees so only the payload itself runs out
+static bool truncateEntry(const QString& filepath) {
+    QFile entry(filepath);
+    if (!entry.open(QIODevice::ReadWrite) || !entry.resize(HEADER_SIZE + (entry.size() - HEADER_SIZE) / 2)) {
+        return false;
+    }
+    uint64_t payloadSize = (uint64_t)(entry.size() - HEADER_SIZE);
+    return entry.seek(PAYLOAD_SIZE_OFFSET) &&
+        entry.write(reinterpret_cast<const char*>(&payloadSize), sizeof(payloadSize)) == (qint64)sizeof(payloadSize);
+}
+
+static ShapeInfo makeHullInfo() {
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(1.0f), "file:///hulls.fbx");
+    return info;
+}
+
+static std::vector<btConvexHullShape*> makeHulls() {
+    std::vector<btConvexHullShape*> hulls;
+    for (int i = 0; i < 2; ++i) {
+        btConvexHullShape* hull = new btConvexHullShape();
+        float offset = (float)i;
+        hull->addPoint(btVector3(offset + 1.0f, 1.0f, 1.0f), false);
+        hull->addPoint(btVector3(offset + 1.0f, -1.0f, -1.0f), false);
+        hull->addPoint(btVector3(offset - 1.0f, 1.0f, -1.0f), false);
+        hull->addPoint(btVector3(offset - 1.0f, -1.0f, 1.0f), false);
+        hull->recalcLocalAabb();
+        hull->setMargin(0.01f * (float)(i + 1));
+        hulls.push_back(hull);
+    }
+    return hulls;
+}
+
+static void deleteHulls(std::vector<btConvexHullShape*>& hulls) {
+    for (auto hull : hulls) {
+        delete hull;
+    }
+    hulls.clear();
+}
+
+// a bumpy grid of gridSize x gridSize quads
+static ShapeInfo makeMeshInfo(int gridSize, const QString& url = "file:///mesh.fbx") {
+    ShapeInfo::PointList points;
+    for (int y = 0; y <= gridSize; ++y) {
+        for (int x = 0; x <= gridSize; ++x) {
+            points.push_back(glm::vec3((float)x, 0.1f * (float)((x * y) % 3), (float)y));
+        }
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.5f * (float)gridSize), url);
+    info.setPointCollection({ points });
+    auto& indices = info.getTriangleIndices();
+    int rowSize = gridSize + 1;
+    for (int y = 0; y < gridSize; ++y) {
+        for (int x = 0; x < gridSize; ++x) {
+            int i = y * rowSize + x;
+            indices.insert(indices.end(), { i, i + 1, i + rowSize, i + 1, i + rowSize + 1, i + rowSize });
+        }
+    }
+    return info;
+}
+
+class TriangleCounter : public btTriangleCallback {
+public:
+    void processTriangle(btVector3* triangle, int partId, int triangleIndex) override { ++numTriangles; }
+    int numTriangles { 0 };
+};
+
+// walks the bvh of the shape, whether it was built or loaded
+static int countTriangles(const btCollisionShape* shape) {
+    const btBvhTriangleMeshShape* meshShape = static_cast<const btBvhTriangleMeshShape*>(shape);
+    TriangleCounter counter;
+    const btScalar EXTENT = 1000.0f;
+    meshShape->processAllTriangles(&counter, btVector3(-EXTENT, -EXTENT, -EXTENT), btVector3(EXTENT, EXTENT, EXTENT));
+    return counter.numTriangles;
+}
+
+void CollisionShapeCacheTests::testHullRoundTrip() {
+    auto cache = makeCache(_testDir.path() + "/hullRoundTrip");
+    auto info = makeHullInfo();
+    const uint64_t CONTENT_HASH = 1;
+
+    std::vector<btConvexHullShape*> loaded;
+    QVERIFY(!cache->loadHulls(info, CONTENT_HASH, loaded));
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+
+    auto hulls = makeHulls();
+    cache->storeHulls(info, CONTENT_HASH, hulls);
+    QCOMPARE(cache->getNumWrites(), (uint32_t)1);
+
+    QVERIFY(cache->loadHulls(info, CONTENT_HASH, loaded));
+    QCOMPARE(cache->getNumHits(), (uint32_t)1);
+    QCOMPARE(loaded.size(), hulls.size());
+    for (size_t i = 0; i < hulls.size(); ++i) {
+        QCOMPARE(loaded[i]->getMargin(), hulls[i]->getMargin());
+        QCOMPARE(loaded[i]->getNumPoints(), hulls[i]->getNumPoints());
+        for (int j = 0; j < hulls[i]->getNumPoints(); ++j) {
+            QVERIFY(loaded[i]->getUnscaledPoints()[j] == hulls[i]->getUnscaledPoints()[j]);
+        }
+    }
+    deleteHulls(loaded);
+    deleteHulls(hulls);
+}
+
+void CollisionShapeCacheTests::testHullStaleHash() {
+    QString location = _testDir.path() + "/hullStaleHash";
+    auto cache = makeCache(location);
+    auto info = makeHullInfo();
+    auto hulls = makeHulls();
+    cache->storeHulls(info, 1, hulls);
+
+    // the model at the url changed: a miss, which leaves the entry of the old content alone
+    std::vector<btConvexHullShape*> loaded;
+    QVERIFY(!cache->loadHulls(info, 2, loaded));
+    QVERIFY(loaded.empty());
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+    QVERIFY(!getEntryPath(location).isEmpty());
+    QVERIFY(cache->loadHulls(info, 1, loaded));
+    deleteHulls(loaded);
+    deleteHulls(hulls);
+}
+
+void CollisionShapeCacheTests::testTruncatedHulls() {
+    QString location = _testDir.path() + "/truncatedHulls";
+    auto cache = makeCache(location);
+    auto info = makeHullInfo();
+    auto hulls = makeHulls();
+    cache->storeHulls(info, 1, hulls);
+    QString filepath = getEntryPath(location);
+    QVERIFY(truncateEntry(filepath));
+
+    // a miss that removes the entry, from the cache and from disk
+    std::vector<btConvexHullShape*> loaded;
+    QVERIFY(!cache->loadHulls(info, 1, loaded));
+    QVERIFY(loaded.empty());
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+    QCOMPARE(cache->getNumHits(), (uint32_t)0);
+    QVERIFY(!QFile::exists(filepath));
+
+    // so the hulls built again take its place
+    cache->storeHulls(info, 1, hulls);
+    QCOMPARE(cache->getNumWrites(), (uint32_t)2);
+    QVERIFY(cache->loadHulls(info, 1, loaded));
+    deleteHulls(loaded);
+    deleteHulls(hulls);
+}
+
+void CollisionShapeCacheTests::testCorruptHulls() {
+    QString location = _testDir.path() + "/corruptHulls";
+    auto cache = makeCache(location);
+    auto info = makeHullInfo();
+    auto hulls = makeHulls();
+    cache->storeHulls(info, 1, hulls);
+    QString filepath = getEntryPath(location);
+
+    // a first hull with more points than the file holds, behind a header that checks out
+    {
+        QFile entry(filepath);
+        QVERIFY(entry.open(QIODevice::ReadWrite));
+        uint32_t numPoints = 0x7fffffff;
+        QVERIFY(entry.seek(FIRST_HULL_NUM_POINTS_OFFSET));
+        QCOMPARE(entry.write(reinterpret_cast<const char*>(&numPoints), sizeof(numPoints)), (qint64)sizeof(numPoints));
+    }
+
+    std::vector<btConvexHullShape*> loaded;
+    QVERIFY(!cache->loadHulls(info, 1, loaded));
+    QVERIFY(loaded.empty());
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+    QVERIFY(!QFile::exists(filepath));
+    deleteHulls(hulls);
+}
+
+void CollisionShapeCacheTests::testBvhRoundTrip() {
+    QString location = _testDir.path() + "/bvhRoundTrip";
+    auto cache = makeCache(location);
+    auto info = makeMeshInfo(GRID_SIZE);
+    const int NUM_TRIANGLES = 2 * GRID_SIZE * GRID_SIZE;
+
+    // built and stored the first time
+    auto built = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QVERIFY(built);
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+    QCOMPARE(cache->getNumWrites(), (uint32_t)1);
+
+    // loaded the next, and the loaded bvh finds every triangle
+    auto loaded = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QVERIFY(loaded);
+    QCOMPARE(cache->getNumHits(), (uint32_t)1);
+    QCOMPARE(cache->getNumWrites(), (uint32_t)1);
+    QCOMPARE(countTriangles(built), NUM_TRIANGLES);
+    QCOMPARE(countTriangles(loaded), NUM_TRIANGLES);
+
+    ShapeFactory::deleteShape(loaded);
+    ShapeFactory::deleteShape(built);
+}
+
+void CollisionShapeCacheTests::testBvhStaleHash() {
+    QString location = _testDir.path() + "/bvhStaleHash";
+    auto cache = makeCache(location);
+    auto shape = ShapeFactory::createShapeFromInfo(makeMeshInfo(GRID_SIZE), cache.get());
+    QString oldEntry = getEntryPath(location);
+    QVERIFY(!oldEntry.isEmpty());
+
+    // another mesh at the same url and size: a miss, and an entry of its own next to the old one
+    auto info = makeMeshInfo(GRID_SIZE);
+    info.getPointCollection()[0][0].y += 1.0f;
+    auto changed = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QVERIFY(changed);
+    QCOMPARE(cache->getNumMisses(), (uint32_t)2);
+    QCOMPARE(cache->getNumHits(), (uint32_t)0);
+    QCOMPARE(cache->getNumWrites(), (uint32_t)2);
+    QVERIFY(QFile::exists(oldEntry));
+
+    ShapeFactory::deleteShape(changed);
+    ShapeFactory::deleteShape(shape);
+}
+
+void CollisionShapeCacheTests::testTruncatedBvh() {
+    QString location = _testDir.path() + "/truncatedBvh";
+    auto cache = makeCache(location);
+    auto info = makeMeshInfo(GRID_SIZE);
+    ShapeFactory::deleteShape(ShapeFactory::createShapeFromInfo(info, cache.get()));
+    QString filepath = getEntryPath(location);
+    QVERIFY(truncateEntry(filepath));
+
+    // the shape is built again, and replaces the entry
+    auto shape = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QVERIFY(shape);
+    QCOMPARE(countTriangles(shape), 2 * GRID_SIZE * GRID_SIZE);
+    QCOMPARE(cache->getNumMisses(), (uint32_t)2);
+    QCOMPARE(cache->getNumHits(), (uint32_t)0);
+    QCOMPARE(cache->getNumWrites(), (uint32_t)2);
+    ShapeFactory::deleteShape(shape);
+
+    shape = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QCOMPARE(cache->getNumHits(), (uint32_t)1);
+    ShapeFactory::deleteShape(shape);
+}
+
+void CollisionShapeCacheTests::testCorruptBvh() {
+    QString location = _testDir.path() + "/corruptBvh";
+    auto cache = makeCache(location);
+    auto info = makeMeshInfo(GRID_SIZE);
+    ShapeFactory::deleteShape(ShapeFactory::createShapeFromInfo(info, cache.get()));
+    QString filepath = getEntryPath(location);
+
+    // garbage over the end of the nodes and the subtree headers, at the size the header says: node and triangle
+    // indices Bullet would follow out of bounds
+    {
+        QFile entry(filepath);
+        QVERIFY(entry.open(QIODevice::ReadWrite));
+        qint64 size = entry.size();
+        QVERIFY(entry.seek(size / 2));
+        QByteArray garbage(size - size / 2, (char)0x7f);
+        QCOMPARE(entry.write(garbage), (qint64)garbage.size());
+    }
+
+    auto shape = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QVERIFY(shape);
+    QCOMPARE(countTriangles(shape), 2 * GRID_SIZE * GRID_SIZE);
+    QCOMPARE(cache->getNumMisses(), (uint32_t)2);
+    QCOMPARE(cache->getNumHits(), (uint32_t)0);
+    QCOMPARE(cache->getNumWrites(), (uint32_t)2);
+    ShapeFactory::deleteShape(shape);
+
+    shape = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QCOMPARE(cache->getNumHits(), (uint32_t)1);
+    QCOMPARE(countTriangles(shape), 2 * GRID_SIZE * GRID_SIZE);
+    ShapeFactory::deleteShape(shape);
+}
+
+void CollisionShapeCacheTests::testBvhForAnotherMesh() {
+    QString location = _testDir.path() + "/anotherMesh";
+    auto cache = makeCache(location);
+
+    // a well formed bvh whose leaves point past the triangles of the mesh it is stored for
+    auto large = ShapeFactory::createShapeFromInfo(makeMeshInfo(GRID_SIZE));
+    auto largeBvh = static_cast<btBvhTriangleMeshShape*>(const_cast<btCollisionShape*>(large))->getOptimizedBvh();
+    QVERIFY(largeBvh);
+    auto small = makeMeshInfo(GRID_SIZE / 4);
+    cache->storeBvh(small, CollisionShapeCache::computeContentHash(small), largeBvh);
+    QString filepath = getEntryPath(location);
+    QVERIFY(!filepath.isEmpty());
+
+    auto shape = ShapeFactory::createShapeFromInfo(small, cache.get());
+    QVERIFY(shape);
+    QCOMPARE(countTriangles(shape), 2 * (GRID_SIZE / 4) * (GRID_SIZE / 4));
+    QCOMPARE(cache->getNumMisses(), (uint32_t)1);
+    QCOMPARE(cache->getNumHits(), (uint32_t)0);
+
+    ShapeFactory::deleteShape(shape);
+    ShapeFactory::deleteShape(large);
+}
@@ -0,0 +1,34 @@
+//
+//  CollisionShapeCacheTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CollisionShapeCacheTests_h
+#define hifi_CollisionShapeCacheTests_h
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+
+class CollisionShapeCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testHullRoundTrip();
+    void testHullStaleHash();
+    void testTruncatedHulls();
+    void testCorruptHulls();
+    void testBvhRoundTrip();
+    void testBvhStaleHash();
+    void testTruncatedBvh();
+    void testCorruptBvh();
+    void testBvhForAnotherMesh();
+
+private:
+    QTemporaryDir _testDir;
+};
+
+#endif // hifi_CollisionShapeCacheTests_h
@@ -0,0 +1,152 @@
+//
+//  PhysicsEngineBenchmarkTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsEngineBenchmarkTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(PhysicsEngineBenchmarkTests)
+
+const float BOX_HALF_EXTENT = 0.25f;
+const float SPHERE_RADIUS = 0.25f;
+const int STACK_HEIGHT = 8;
+const int NUM_SETTLING_STEPS = 10;
+const btVector3 GRAVITY(0.0f, -9.8f, 0.0f);
+
+// Owns the bodies and shapes it adds to a world, which doesn't delete them
+class BenchmarkScene {
+public:
+    BenchmarkScene(btDiscreteDynamicsWorld* world) : _world(world) {}
+    ~BenchmarkScene() {
+        for (auto& body : _bodies) {
+            _world->removeRigidBody(body.get());
+        }
+    }
+
+    void addGround(float halfWidth) {
+        _shapes.emplace_back(new btBoxShape(btVector3(halfWidth, 1.0f, halfWidth)));
+        addBody(_shapes.back().get(), 0.0f, btVector3(0.0f, -1.0f, 0.0f));
+    }
+
+    // columns of boxes resting on each other: few islands, many contacts per island
+    void addStacks(int numBodies) {
+        _shapes.emplace_back(new btBoxShape(btVector3(BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT)));
+        btCollisionShape* box = _shapes.back().get();
+        int numStacks = (numBodies + STACK_HEIGHT - 1) / STACK_HEIGHT;
+        int side = (int)ceilf(sqrtf((float)numStacks));
+        const float SPACING = 4.0f * BOX_HALF_EXTENT;
+        addGround(0.5f * (float)side * SPACING + 1.0f);
+        for (int i = 0; i < numBodies; ++i) {
+            int stack = i / STACK_HEIGHT;
+            btVector3 position(SPACING * (float)(stack % side - side / 2),
+                               BOX_HALF_EXTENT + 2.0f * BOX_HALF_EXTENT * (float)(i % STACK_HEIGHT),
+                               SPACING * (float)(stack / side - side / 2));
+            addBody(box, 1.0f, position);
+        }
+    }
+
+    // a block of spheres falling onto the ground: many small islands that merge as the pile forms
+    void addFallingBodies(int numBodies) {
+        _shapes.emplace_back(new btSphereShape(SPHERE_RADIUS));
+        btCollisionShape* sphere = _shapes.back().get();
+        int side = (int)ceilf(cbrtf((float)numBodies));
+        const float SPACING = 2.2f * SPHERE_RADIUS;
+        addGround((float)side * SPACING + 1.0f);
+        for (int i = 0; i < numBodies; ++i) {
+            btVector3 position(SPACING * (float)(i % side - side / 2),
+                               1.0f + SPACING * (float)((i / side) % side),
+                               SPACING * (float)(i / (side * side) - side / 2));
+            btRigidBody* body = addBody(sphere, 1.0f, position);
+            body->setLinearVelocity(btVector3((float)(i % 3 - 1), 0.0f, (float)(i % 5 - 2)));
+        }
+    }
+
+private:
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const btVector3& position) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(position);
+        // no motion state: the benchmark never synchronizes with the outside
+        _bodies.emplace_back(new btRigidBody(mass, nullptr, shape, inertia));
+        btRigidBody* body = _bodies.back().get();
+        body->setWorldTransform(transform);
+        _world->addRigidBody(body);
+        if (mass > 0.0f) {
+            // keep every body awake so all iterations measure the same amount of work
+            body->setActivationState(DISABLE_DEACTIVATION);
+            body->setGravity(GRAVITY);
+        }
+        return body;
+    }
+
+    btDiscreteDynamicsWorld* _world;
+    std::vector<std::unique_ptr<btCollisionShape>> _shapes;
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+};
+
+void PhysicsEngineBenchmarkTests::cleanup() {
+    PhysicsEngine::setNumSimulationThreads(1);
+}
+
+void PhysicsEngineBenchmarkTests::benchmarkStep_data() {
+    QTest::addColumn<int>("numThreads");
+    QTest::addColumn<int>("numBodies");
+    QTest::addColumn<bool>("stacked");
+
+    int maxThreads = PhysicsEngine::getMaxNumSimulationThreads();
+    for (bool stacked : { true, false }) {
+        for (int numBodies : { 256, 1024, 4096 }) {
+            for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+                QString name = QString("%1 %2 bodies, %3 threads").arg(stacked ? "stacked" : "falling")
+                    .arg(numBodies).arg(numThreads);
+                QTest::newRow(qPrintable(name)) << numThreads << numBodies << stacked;
+            }
+        }
+    }
+}
+
+void PhysicsEngineBenchmarkTests::benchmarkStep() {
+    QFETCH(int, numThreads);
+    QFETCH(int, numBodies);
+    QFETCH(bool, stacked);
+
+    PhysicsEngine::setNumSimulationThreads(numThreads);
+    QCOMPARE(PhysicsEngine::getNumSimulationThreads(), numThreads);
+
+    PhysicsEngine engine(glm::vec3(0.0f));
+    engine.init();
+    ThreadSafeDynamicsWorld* world = static_cast<ThreadSafeDynamicsWorld*>(engine.getDynamicsWorld());
+
+    BenchmarkScene scene(world);
+    if (stacked) {
+        scene.addStacks(numBodies);
+    } else {
+        scene.addFallingBodies(numBodies);
+    }
+
+    // let the first contacts and islands form before measuring
+    for (int i = 0; i < NUM_SETTLING_STEPS; ++i) {
+        world->stepSimulationWithSubstepCallback(PHYSICS_ENGINE_FIXED_SUBSTEP, 1, PHYSICS_ENGINE_FIXED_SUBSTEP);
+    }
+
+    QBENCHMARK {
+        world->stepSimulationWithSubstepCallback(PHYSICS_ENGINE_FIXED_SUBSTEP, 1, PHYSICS_ENGINE_FIXED_SUBSTEP);
+    }
+    QVERIFY(world->getNumSubsteps() > NUM_SETTLING_STEPS);
+}
@@ -0,0 +1,27 @@
+//
+//  PhysicsEngineBenchmarkTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsEngineBenchmarkTests_h
+#define hifi_PhysicsEngineBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+// Headless timing of one simulation step for crowds of bodies at different numbers of simulation threads.
+// Run with e.g. "-iterations 100" for steadier numbers.
+class PhysicsEngineBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+    void benchmarkStep_data();
+    void benchmarkStep();
+};
+
+#endif // hifi_PhysicsEngineBenchmarkTests_h
@@ -0,0 +1,193 @@
+//
+//  CullSortTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullSortTests.h"
+
+#include <random>
+
+#include <OctreeConstants.h>
+#include <render/CullTask.h>
+#include <render/SortTask.h>
+
+QTEST_MAIN(CullSortTests)
+
+const unsigned int SCENE_SEED = 4321;
+const int NUM_ITEMS = 50000;
+const float SCENE_EXTENT = 400.0f; // meters, around the origin
+const float MIN_ITEM_SIZE = 0.05f;
+const float MAX_ITEM_SIZE = 8.0f;
+const float LOD_ANGLE_HALF_TAN = 0.01f;
+
+class TestBox {
+public:
+    AABox bound;
+};
+using TestBoxPointer = std::shared_ptr<TestBox>;
+
+namespace render {
+template <> const ItemKey payloadGetKey(const TestBoxPointer& box) {
+    return ItemKey::Builder::opaqueShape();
+}
+template <> const Item::Bound payloadGetBound(const TestBoxPointer& box) {
+    return box->bound;
+}
+}
+
+// Same test as LODManager::shouldRender
+static bool isBigEnough(const RenderArgs* args, const AABox& bound) {
+    auto eyeToCenter = args->getViewFrustum().getPosition() - bound.calcCenter();
+    auto dimensions = bound.getDimensions();
+    return 0.25f * glm::dot(dimensions, dimensions) >= args->_lodAngleHalfTanSq * glm::dot(eyeToCenter, eyeToCenter);
+}
+
+static ViewFrustum makeViewFrustum() {
+    ViewFrustum frustum;
+    frustum.setProjection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f));
+    frustum.setPosition(glm::vec3(10.0f, 2.0f, 30.0f));
+    frustum.setOrientation(glm::angleAxis(glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    frustum.calculate();
+    return frustum;
+}
+
+class CullContext {
+public:
+    CullContext(const render::ScenePointer& scene) : args(nullptr, 1.0f, 0, LOD_ANGLE_HALF_TAN) {
+        args.setViewFrustum(makeViewFrustum());
+        context = std::make_shared<render::RenderContext>();
+        context->args = &args;
+        context->_scene = scene;
+        context->jobConfig = std::make_shared<render::CullSpatialSelectionConfig>();
+    }
+
+    render::ItemSpatialTree::ItemSelection select(const render::ItemFilter& filter) const {
+        render::ItemSpatialTree::ItemSelection selection;
+        const auto& spatialTree = context->_scene->getSpatialTree();
+        spatialTree.selectCellItems(selection, filter, args.getViewFrustum(), args._lodAngleHalfTan);
+        return selection;
+    }
+
+    RenderArgs args;
+    render::RenderContextPointer context;
+};
+
+void CullSortTests::initTestCase() {
+    _scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * (float)TREE_SCALE), (float)TREE_SCALE);
+
+    std::mt19937 generator(SCENE_SEED);
+    std::uniform_real_distribution<float> position(-SCENE_EXTENT, SCENE_EXTENT);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    render::Transaction transaction;
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        auto box = std::make_shared<TestBox>();
+        // mostly small items, like the parts of a content-dense domain
+        glm::vec3 size(MIN_ITEM_SIZE * powf(MAX_ITEM_SIZE / MIN_ITEM_SIZE, unit(generator)));
+        box->bound = AABox(glm::vec3(position(generator), 0.1f * position(generator), position(generator)), size);
+        transaction.resetItem(_scene->allocateID(), std::make_shared<render::Payload<TestBox>>(box));
+    }
+    _scene->enqueueTransaction(transaction);
+    _scene->enqueueFrame();
+    _scene->processTransactionQueue();
+}
+
+void CullSortTests::testCullSpatialSelection() {
+    CullContext cullContext(_scene);
+    const auto filter = render::ItemFilter::Builder::visibleWorldItems().build();
+    const auto selection = cullContext.select(filter);
+    QVERIFY(selection.numItems() > 0);
+
+    render::CullSpatialSelection cull(isBigEnough, false, render::RenderDetails::ITEM);
+    render::ItemBounds culledItems;
+    cull.run(cullContext.context, render::CullSpatialSelection::Inputs(selection, filter), culledItems);
+
+    // every list of the selection, in order, with the tests its items need
+    const RenderArgs* args = &cullContext.args;
+    const ViewFrustum& frustum = args->getViewFrustum();
+    render::ItemBounds expectedItems;
+    auto cullList = [&](const render::ItemIDs& ids, bool testFrustum, bool testSolidAngle) {
+        for (auto id : ids) {
+            const auto bound = _scene->getItem(id).getBound();
+            if ((!testFrustum || frustum.boxIntersectsFrustum(bound)) && (!testSolidAngle || isBigEnough(args, bound))) {
+                expectedItems.emplace_back(id, bound);
+            }
+        }
+    };
+    cullList(selection.insideItems, false, false);
+    cullList(selection.insideSubcellItems, false, true);
+    cullList(selection.partialItems, true, false);
+    cullList(selection.partialSubcellItems, true, true);
+
+    QCOMPARE(culledItems.size(), expectedItems.size());
+    for (size_t i = 0; i < culledItems.size(); i++) {
+        QCOMPARE(culledItems[i].id, expectedItems[i].id);
+    }
+
+    const auto& details = cullContext.args._details.edit(render::RenderDetails::ITEM);
+    QCOMPARE(details._considered, (int)selection.numItems());
+    QCOMPARE(details._rendered, (int)culledItems.size());
+    QCOMPARE(details._outOfView + details._tooSmall + details._rendered, details._considered);
+}
+
+void CullSortTests::testDepthSortItems() {
+    CullContext cullContext(_scene);
+    const auto filter = render::ItemFilter::Builder::visibleWorldItems().build();
+    const auto selection = cullContext.select(filter);
+
+    render::CullSpatialSelection cull(isBigEnough, false, render::RenderDetails::ITEM);
+    render::ItemBounds culledItems;
+    cull.run(cullContext.context, render::CullSpatialSelection::Inputs(selection, filter), culledItems);
+
+    const glm::vec3 eyePosition = cullContext.args.getViewFrustum().getPosition();
+    auto depth = [&](const render::ItemBound& item) {
+        glm::vec3 eyeToCenter = item.bound.calcCenter() - eyePosition;
+        return glm::dot(eyeToCenter, eyeToCenter);
+    };
+
+    for (bool frontToBack : { true, false }) {
+        render::ItemBounds sortedItems;
+        AABox sortedBounds;
+        render::depthSortItems(cullContext.context, frontToBack, culledItems, sortedItems, &sortedBounds);
+
+        QCOMPARE(sortedItems.size(), culledItems.size());
+        QVERIFY(!sortedBounds.isNull());
+        for (size_t i = 1; i < sortedItems.size(); i++) {
+            if (frontToBack) {
+                QVERIFY(depth(sortedItems[i - 1]) <= depth(sortedItems[i]));
+            } else {
+                QVERIFY(depth(sortedItems[i - 1]) >= depth(sortedItems[i]));
+            }
+        }
+
+        std::vector<render::ItemID> culledIDs;
+        std::vector<render::ItemID> sortedIDs;
+        for (size_t i = 0; i < culledItems.size(); i++) {
+            culledIDs.push_back(culledItems[i].id);
+            sortedIDs.push_back(sortedItems[i].id);
+        }
+        std::sort(culledIDs.begin(), culledIDs.end());
+        std::sort(sortedIDs.begin(), sortedIDs.end());
+        QVERIFY(culledIDs == sortedIDs);
+    }
+}
+
+void CullSortTests::benchmarkCullSort() {
+    CullContext cullContext(_scene);
+    const auto filter = render::ItemFilter::Builder::visibleWorldItems().build();
+    const auto selection = cullContext.select(filter);
+
+    render::CullSpatialSelection cull(isBigEnough, false, render::RenderDetails::ITEM);
+    render::ItemBounds culledItems;
+    render::ItemBounds sortedItems;
+    QBENCHMARK {
+        cull.run(cullContext.context, render::CullSpatialSelection::Inputs(selection, filter), culledItems);
+        render::depthSortItems(cullContext.context, true, culledItems, sortedItems);
+    }
+    qDebug() << "Culled" << selection.numItems() << "selected items to" << culledItems.size();
+}
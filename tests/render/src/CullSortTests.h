@@ -0,0 +1,33 @@
+//
+//  CullSortTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_CullSortTests_h
+#define hifi_render_CullSortTests_h
+
+#include <QtTest/QtTest>
+
+#include <render/Scene.h>
+
+// Culls and sorts a scene of 50k boxes the way RenderFetchCullSortTask does, without a gpu context, and checks the
+// result against testing every item one after the other.
+class CullSortTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testCullSpatialSelection();
+    void testDepthSortItems();
+    void benchmarkCullSort();
+
+private:
+    render::ScenePointer _scene;
+};
+
+#endif // hifi_render_CullSortTests_h
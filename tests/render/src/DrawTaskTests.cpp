@@ -0,0 +1,202 @@
+//
+//  DrawTaskTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DrawTaskTests.h"
+
+#include <thread>
+
+#include <OctreeConstants.h>
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/null/NullBackend.h>
+#include <render/DrawTask.h>
+#include <render/ShapePipeline.h>
+#include <shaders/Shaders.h>
+
+QTEST_MAIN(DrawTaskTests)
+
+// Enough items for several shards, from a few buckets of different sizes and a handful with their own pipeline
+const int NUM_ITEMS = 4000;
+const int NUM_OWN_PIPELINE_ITEMS = 5;
+
+class TestShape {
+public:
+    render::ShapeKey key;
+    uint32_t numVertices { 3 };
+};
+using TestShapePointer = std::shared_ptr<TestShape>;
+
+namespace render {
+template <> const ItemKey payloadGetKey(const TestShapePointer& shape) {
+    return ItemKey::Builder::opaqueShape();
+}
+template <> const ShapeKey shapeGetShapeKey(const TestShapePointer& shape) {
+    return shape->key;
+}
+template <> void payloadRender(const TestShapePointer& shape, RenderArgs* args) {
+    args->_batch->draw(gpu::TRIANGLES, shape->numVertices);
+    args->_details._materialSwitches++;
+    args->_details._trianglesRendered += shape->numVertices / 3;
+    args->_details._item._rendered++;
+}
+}
+
+// A command with its params, with the batch-local cache index of a pipeline resolved to the pipeline itself
+class RecordedCommand {
+public:
+    gpu::Batch::Command command;
+    std::vector<uint64_t> params;
+
+    bool operator==(const RecordedCommand& other) const { return command == other.command && params == other.params; }
+};
+
+static void recordCommands(const gpu::Batch& batch, std::vector<RecordedCommand>& commands) {
+    const auto& offsets = batch.getCommandOffsets();
+    const auto& params = batch.getParams();
+    for (size_t i = 0; i < batch.getCommands().size(); i++) {
+        RecordedCommand recorded;
+        recorded.command = batch.getCommands()[i];
+        size_t end = (i + 1 < offsets.size()) ? offsets[i + 1] : params.size();
+        for (size_t p = offsets[i]; p < end; p++) {
+            if (recorded.command == gpu::Batch::COMMAND_setPipeline) {
+                recorded.params.push_back((uint64_t)(uintptr_t)batch._pipelines.get(params[p]._uint).get());
+            } else {
+                recorded.params.push_back(params[p]._uint);
+            }
+        }
+        commands.push_back(recorded);
+    }
+}
+
+static void compareItemDetails(const render::RenderDetails::Item& actual, const render::RenderDetails::Item& expected) {
+    QCOMPARE(actual._considered, expected._considered);
+    QCOMPARE(actual._outOfView, expected._outOfView);
+    QCOMPARE(actual._tooSmall, expected._tooSmall);
+    QCOMPARE(actual._rendered, expected._rendered);
+}
+
+void DrawTaskTests::initTestCase() {
+    gpu::Context::init<gpu::null::Backend>();
+
+    const std::vector<render::ShapeKey> keys = {
+        render::ShapeKey::Builder().build(),
+        render::ShapeKey::Builder().withMaterial().build(),
+        render::ShapeKey::Builder().withMaterial().withTangents().build(),
+        render::ShapeKey::Builder().withUnlit().build()
+    };
+    _shapePlumber = std::make_shared<render::ShapePlumber>();
+    auto program = gpu::Shader::createProgram(shader::render::program::drawItemBounds);
+    for (const auto& key : keys) {
+        _shapePlumber->addPipeline(key, program, std::make_shared<gpu::State>());
+    }
+
+    _scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * (float)TREE_SCALE), (float)TREE_SCALE);
+    render::Transaction transaction;
+    for (int i = 0; i < NUM_ITEMS + NUM_OWN_PIPELINE_ITEMS; i++) {
+        auto shape = std::make_shared<TestShape>();
+        // uneven buckets, so shards end in the middle of the bucket list
+        shape->key = (i < NUM_ITEMS) ? keys[(i * i) % keys.size()] : render::ShapeKey::Builder::ownPipeline();
+        shape->numVertices = 3 * (1 + i % 7);
+        auto id = _scene->allocateID();
+        transaction.resetItem(id, std::make_shared<render::Payload<TestShape>>(shape));
+        _items.emplace_back(id, AABox());
+    }
+    _scene->enqueueTransaction(transaction);
+    _scene->enqueueFrame();
+    _scene->processTransactionQueue();
+}
+
+void DrawTaskTests::testParallelRecordingMatchesSerial() {
+    auto context = std::make_shared<gpu::Context>();
+    auto renderContext = std::make_shared<render::RenderContext>();
+    renderContext->_scene = _scene;
+
+    // serially, into one batch
+    RenderArgs serialArgs(context);
+    gpu::Batch serialBatch;
+    serialArgs._batch = &serialBatch;
+    renderContext->args = &serialArgs;
+    render::renderStateSortShapes(renderContext, _shapePlumber, _items);
+    serialArgs._batch = nullptr;
+
+    // in parallel, into the batches of a frame
+    RenderArgs parallelArgs(context);
+    renderContext->args = &parallelArgs;
+    context->beginFrame();
+    render::renderStateSortShapesInParallel(renderContext, _shapePlumber, _items, "DrawTaskTests", [](gpu::Batch& batch) {});
+    auto frame = context->endFrame();
+    renderContext->args = nullptr;
+    if (std::thread::hardware_concurrency() > 1) {
+        QVERIFY(frame->batches.size() > 1);
+    }
+
+    // the shards start at bucket boundaries, so their batches one after the other are the serial batch
+    std::vector<RecordedCommand> serialCommands;
+    recordCommands(serialBatch, serialCommands);
+    std::vector<RecordedCommand> parallelCommands;
+    for (const auto& batch : frame->batches) {
+        recordCommands(*batch, parallelCommands);
+    }
+    QCOMPARE(parallelCommands.size(), serialCommands.size());
+    for (size_t i = 0; i < serialCommands.size(); i++) {
+        QVERIFY2(parallelCommands[i] == serialCommands[i], qPrintable(QString("command %1 differs").arg(i)));
+    }
+
+    // and every detail the items recorded on the workers reaches the caller's
+    QCOMPARE(parallelArgs._details._materialSwitches, serialArgs._details._materialSwitches);
+    QCOMPARE(parallelArgs._details._trianglesRendered, serialArgs._details._trianglesRendered);
+    QCOMPARE(parallelArgs._details._item._rendered, NUM_ITEMS + NUM_OWN_PIPELINE_ITEMS);
+    compareItemDetails(parallelArgs._details._item, serialArgs._details._item);
+    compareItemDetails(parallelArgs._details._shadow, serialArgs._details._shadow);
+    compareItemDetails(parallelArgs._details._other, serialArgs._details._other);
+
+    context->shutdown();
+}
+
+void DrawTaskTests::benchmarkRecordAndReplay_data() {
+    QTest::addColumn<bool>("parallel");
+    QTest::newRow("serial") << false;
+    QTest::newRow("parallel") << true;
+}
+
+void DrawTaskTests::benchmarkRecordAndReplay() {
+    QFETCH(bool, parallel);
+
+    auto context = std::make_shared<gpu::Context>();
+    auto renderContext = std::make_shared<render::RenderContext>();
+    renderContext->_scene = _scene;
+    RenderArgs args(context);
+    renderContext->args = &args;
+
+    // each frame is recorded and then replayed into the null backend, as the present thread would
+    auto recordFrame = [&] {
+        context->beginFrame();
+        if (parallel) {
+            render::renderStateSortShapesInParallel(renderContext, _shapePlumber, _items, "DrawTaskTests",
+                [](gpu::Batch& batch) {});
+        } else {
+            gpu::doInBatch("DrawTaskTests", context, [&](gpu::Batch& batch) {
+                args._batch = &batch;
+                render::renderStateSortShapes(renderContext, _shapePlumber, _items);
+                args._batch = nullptr;
+            });
+        }
+        return context->endFrame();
+    };
+
+    // the first frame fills the batch pool and grows the batch reservations
+    context->executeFrame(recordFrame());
+    QBENCHMARK {
+        context->executeFrame(recordFrame());
+    }
+    renderContext->args = nullptr;
+
+    context->shutdown();
+}
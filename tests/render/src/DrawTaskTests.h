@@ -0,0 +1,37 @@
+//
+//  DrawTaskTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_DrawTaskTests_h
+#define hifi_render_DrawTaskTests_h
+
+#include <QtTest/QtTest>
+
+#include <render/Scene.h>
+#include <render/ShapePipeline.h>
+
+// Records the same state sorted shapes with renderStateSortShapes and with renderStateSortShapesInParallel, on the null
+// gpu backend, and checks the batches and render details come out the same.  The benchmark records and replays a frame
+// of them each way.
+class DrawTaskTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testParallelRecordingMatchesSerial();
+    void benchmarkRecordAndReplay_data();
+    void benchmarkRecordAndReplay();
+
+private:
+    render::ShapePlumberPointer _shapePlumber;
+    render::ScenePointer _scene;
+    render::ItemBounds _items;
+};
+
+#endif // hifi_render_DrawTaskTests_h
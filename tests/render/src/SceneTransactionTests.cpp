@@ -0,0 +1,204 @@
+//
+//  SceneTransactionTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneTransactionTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <OctreeConstants.h>
+#include <render/Scene.h>
+
+QTEST_MAIN(SceneTransactionTests)
+
+const int NUM_ITEMS = 1000;
+const int NUM_THREADS = 8;
+const int NUM_UPDATES_PER_THREAD = 4;
+
+class MovingBox {
+public:
+    AABox bound;
+    int numUpdates { 0 };
+};
+using MovingBoxPointer = std::shared_ptr<MovingBox>;
+
+namespace render {
+template <> const ItemKey payloadGetKey(const MovingBoxPointer& box) {
+    return ItemKey::Builder::opaqueShape();
+}
+template <> const Item::Bound payloadGetBound(const MovingBoxPointer& box) {
+    return box->bound;
+}
+}
+
+static render::ScenePointer makeScene(std::vector<MovingBoxPointer>& boxes, render::ItemIDs& ids) {
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-0.5f * (float)TREE_SCALE), (float)TREE_SCALE);
+    render::Transaction transaction;
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        auto box = std::make_shared<MovingBox>();
+        box->bound = AABox(glm::vec3((float)i, 0.0f, 0.0f), 0.5f);
+        auto id = scene->allocateID();
+        transaction.resetItem(id, std::make_shared<render::Payload<MovingBox>>(box));
+        boxes.push_back(box);
+        ids.push_back(id);
+    }
+    scene->enqueueTransaction(transaction);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+    return scene;
+}
+
+static glm::vec3 getThreadPosition(int thread, int update, int item) {
+    return glm::vec3((float)item, 10.0f * (float)(thread + 1), 10.0f * (float)update);
+}
+
+void SceneTransactionTests::testUpdatesFromManyThreads() {
+    std::vector<MovingBoxPointer> boxes;
+    render::ItemIDs ids;
+    auto scene = makeScene(boxes, ids);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&, t] {
+            for (int u = 0; u < NUM_UPDATES_PER_THREAD; u++) {
+                render::Transaction transaction;
+                for (int i = 0; i < NUM_ITEMS; i++) {
+                    auto position = getThreadPosition(t, u, i);
+                    transaction.updateItem<MovingBox>(ids[i], [position](MovingBox& box) {
+                        box.bound = AABox(position, 0.5f);
+                        box.numUpdates++;
+                    });
+                }
+                scene->enqueueTransaction(std::move(transaction));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    // every update is applied, each item being moved in the tree to wherever its last update left it
+    const int NUM_UPDATES_PER_ITEM = NUM_THREADS * NUM_UPDATES_PER_THREAD;
+    const auto& tree = scene->getSpatialTree();
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        QCOMPARE(boxes[i]->numUpdates, NUM_UPDATES_PER_ITEM);
+        render::ItemSpatialTree::Coord3f minCoord;
+        render::ItemSpatialTree::Coord3f maxCoord;
+        auto location = tree.evalLocation(boxes[i]->bound, minCoord, maxCoord);
+        QVERIFY(tree.getCellLocation(scene->getItem(ids[i]).getCell()) == location);
+    }
+
+    auto stats = scene->getTransactionStats();
+    QCOMPARE(stats.numTransactions, (uint32_t)(NUM_THREADS * NUM_UPDATES_PER_THREAD));
+    QCOMPARE(stats.numUpdates, (uint32_t)(NUM_ITEMS * NUM_UPDATES_PER_ITEM));
+    QCOMPARE(stats.numCoalescedUpdates, (uint32_t)(NUM_ITEMS * (NUM_UPDATES_PER_ITEM - 1)));
+}
+
+void SceneTransactionTests::testRepeatedUpdatesMoveItemOnce() {
+    std::vector<MovingBoxPointer> boxes;
+    render::ItemIDs ids;
+    auto scene = makeScene(boxes, ids);
+
+    // move an item far away and back within a frame: it should end up where it started
+    const auto& tree = scene->getSpatialTree();
+    auto startLocation = tree.getCellLocation(scene->getItem(ids[0]).getCell());
+    auto startBound = boxes[0]->bound;
+    render::Transaction transaction;
+    transaction.updateItem<MovingBox>(ids[0], [](MovingBox& box) {
+        box.bound = AABox(glm::vec3(1000.0f), 100.0f);
+    });
+    transaction.updateItem(ids[0]);
+    transaction.updateItem<MovingBox>(ids[0], [startBound](MovingBox& box) {
+        box.bound = startBound;
+    });
+    scene->enqueueTransaction(transaction);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    QVERIFY(tree.getCellLocation(scene->getItem(ids[0]).getCell()) == startLocation);
+    QCOMPARE(scene->getTransactionStats().numCoalescedUpdates, (uint32_t)2);
+}
+
+void SceneTransactionTests::testTransactionMemoryIsReused() {
+    std::vector<MovingBoxPointer> boxes;
+    render::ItemIDs ids;
+    auto scene = makeScene(boxes, ids);
+
+    auto enqueueUpdates = [&] {
+        render::Transaction transaction;
+        for (auto id : ids) {
+            transaction.updateItem(id);
+        }
+        scene->enqueueTransaction(std::move(transaction));
+        scene->enqueueFrame();
+        scene->processTransactionQueue();
+    };
+
+    // once the buffers have grown to a frame's worth of updates, the same frame again allocates nothing
+    enqueueUpdates();
+    QVERIFY(scene->getTransactionStats().numAllocations > 0);
+    enqueueUpdates();
+    QCOMPARE(scene->getTransactionStats().numAllocations, (uint32_t)0);
+}
+
+void SceneTransactionTests::testFrameCutsAllThreadsAtOnce() {
+    std::vector<MovingBoxPointer> boxes;
+    render::ItemIDs ids;
+    auto scene = makeScene(boxes, ids);
+
+    // the frame each item's updates were applied in, the second update of an item being enqueued by another
+    // thread once the first one was enqueued
+    std::vector<uint32_t> firstFrames(NUM_ITEMS, 0);
+    std::vector<uint32_t> secondFrames(NUM_ITEMS, 0);
+    uint32_t frame = 0;
+    std::atomic<int> numFirstUpdates { 0 };
+    std::atomic<bool> done { false };
+
+    std::thread first([&] {
+        for (int i = 0; i < NUM_ITEMS; i++) {
+            render::Transaction transaction;
+            transaction.updateItem<MovingBox>(ids[i], [&firstFrames, &frame, i](MovingBox& box) {
+                firstFrames[i] = frame;
+            });
+            scene->enqueueTransaction(std::move(transaction));
+            numFirstUpdates = i + 1;
+        }
+    });
+    std::thread second([&] {
+        for (int i = 0; i < NUM_ITEMS; i++) {
+            while (numFirstUpdates <= i) {
+                std::this_thread::yield();
+            }
+            render::Transaction transaction;
+            transaction.updateItem<MovingBox>(ids[i], [&secondFrames, &frame, i](MovingBox& box) {
+                secondFrames[i] = frame;
+            });
+            scene->enqueueTransaction(std::move(transaction));
+        }
+        done = true;
+    });
+
+    while (!done) {
+        frame = scene->enqueueFrame();
+        scene->processTransactionQueue();
+    }
+    first.join();
+    second.join();
+    frame = scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    // an update enqueued after another one is never in an earlier frame than it, whichever threads enqueued them
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        QVERIFY(firstFrames[i] > 0);
+        QVERIFY(secondFrames[i] >= firstFrames[i]);
+    }
+}
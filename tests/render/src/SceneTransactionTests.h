@@ -0,0 +1,27 @@
+//
+//  SceneTransactionTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_SceneTransactionTests_h
+#define hifi_render_SceneTransactionTests_h
+
+#include <QtTest/QtTest>
+
+// Enqueues transactions into a render::Scene from several threads and checks what a frame of them does to the items.
+class SceneTransactionTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testUpdatesFromManyThreads();
+    void testRepeatedUpdatesMoveItemOnce();
+    void testTransactionMemoryIsReused();
+    void testFrameCutsAllThreadsAtOnce();
+};
+
+#endif // hifi_render_SceneTransactionTests_h
@@ -0,0 +1,190 @@
+//
+//  EntityScriptEnginePoolTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEnginePoolTests.h"
+
+#include <thread>
+
+#include <EntityScriptEnginePool.h>
+
+QTEST_MAIN(EntityScriptEnginePoolTests)
+
+const int NUM_ENGINES = 3;
+
+// An engine that is never run, with the environment an entity script call runs in exposed
+class TestScriptEngine : public ScriptEngine {
+public:
+    TestScriptEngine() : ScriptEngine(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, "about:EntityScriptEnginePoolTests") {}
+
+    using ScriptEngine::callWithEnvironment;
+    EntityItemID getCurrentEntityIdentifier() const { return currentEntityIdentifier; }
+};
+
+static std::vector<ScriptEnginePointer> makeEngines(int numEngines) {
+    std::vector<ScriptEnginePointer> engines;
+    for (int i = 0; i < numEngines; ++i) {
+        engines.push_back(ScriptEnginePointer(new TestScriptEngine(), &QObject::deleteLater));
+    }
+    return engines;
+}
+
+static TestScriptEngine* asTestEngine(const ScriptEnginePointer& engine) {
+    return static_cast<TestScriptEngine*>(engine.data());
+}
+
+// what the engines saw while the last call to recordEnvironment ran
+static std::vector<EntityItemID> seenEntityIdentifiers;
+static std::vector<ScriptEnginePointer> observedEngines;
+
+static QScriptValue recordEnvironment(QScriptContext* context, QScriptEngine* engine) {
+    seenEntityIdentifiers.clear();
+    for (const auto& observedEngine : observedEngines) {
+        seenEntityIdentifiers.push_back(asTestEngine(observedEngine)->getCurrentEntityIdentifier());
+    }
+    return QScriptValue();
+}
+
+static QScriptValue spin(QScriptContext* context, QScriptEngine* engine) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return QScriptValue();
+}
+
+void EntityScriptEnginePoolTests::testHashAssignment() {
+    EntityScriptEnginePool pool;
+    pool.setEngines(makeEngines(NUM_ENGINES));
+
+    for (int i = 0; i < 20; ++i) {
+        EntityItemID entityID = QUuid::createUuid();
+        int engineIndex = pool.selectEngine(entityID, EntityScriptEnginePool::Assignment::Hash);
+        QVERIFY(engineIndex >= 0 && engineIndex < NUM_ENGINES);
+        // a reload lands on the same engine
+        QCOMPARE(pool.selectEngine(entityID, EntityScriptEnginePool::Assignment::Hash), engineIndex);
+
+        pool.assign(entityID, engineIndex);
+        QCOMPARE(pool.getEngineIndex(entityID), engineIndex);
+        QCOMPARE(pool.getEngineForEntity(entityID), pool.getEngine(engineIndex));
+    }
+
+    EntityItemID entityID = QUuid::createUuid();
+    pool.assign(entityID, 1);
+    pool.unassign(entityID);
+    QCOMPARE(pool.getEngineIndex(entityID), -1);
+    QVERIFY(!pool.getEngineForEntity(entityID));
+
+    // a single engine takes every script
+    EntityScriptEnginePool single;
+    single.setEngines(makeEngines(1));
+    QCOMPARE(single.selectEngine(entityID, EntityScriptEnginePool::Assignment::Hash), 0);
+    QCOMPARE(single.selectEngine(entityID, EntityScriptEnginePool::Assignment::Load), 0);
+}
+
+void EntityScriptEnginePoolTests::testLoadAssignment() {
+    EntityScriptEnginePool pool;
+    pool.setEngines(makeEngines(NUM_ENGINES));
+
+    EntityItemID first = QUuid::createUuid();
+    EntityItemID second = QUuid::createUuid();
+    EntityItemID third = QUuid::createUuid();
+    pool.assign(first, 0);
+    pool.assign(second, 0);
+    pool.assign(third, 1);
+
+    // nothing ran yet, so the engine with the fewest scripts wins
+    QCOMPARE(pool.selectEngine(QUuid::createUuid(), EntityScriptEnginePool::Assignment::Load), 2);
+
+    // a reloaded script doesn't count against the engine it is on
+    pool.assign(QUuid::createUuid(), 2);
+    QCOMPARE(pool.selectEngine(third, EntityScriptEnginePool::Assignment::Load), 1);
+
+    auto stats = pool.getEngineStats();
+    QCOMPARE((int)stats.size(), NUM_ENGINES);
+    QCOMPARE(stats[0].numScripts, 2);
+    QCOMPARE(stats[1].numScripts, 1);
+    QCOMPARE(stats[2].numScripts, 1);
+}
+
+void EntityScriptEnginePoolTests::testSetEnginesForgetsAssignments() {
+    EntityScriptEnginePool pool;
+    pool.setEngines(makeEngines(NUM_ENGINES));
+    EntityItemID entityID = QUuid::createUuid();
+    pool.assign(entityID, 2);
+
+    // the scripts are reloaded onto the new engines, nothing may be routed to the old ones
+    pool.setEngines(makeEngines(1));
+    QCOMPARE(pool.getNumEngines(), 1);
+    QCOMPARE(pool.getEngineIndex(entityID), -1);
+    QVERIFY(pool.getAssignedEntities().isEmpty());
+
+    pool.assign(entityID, 0);
+    pool.clear();
+    QCOMPARE(pool.getNumEngines(), 0);
+    QVERIFY(pool.getEngines().empty());
+    QVERIFY(!pool.getEngineForEntity(entityID));
+    QVERIFY(pool.getBusiestScripts(10).empty());
+}
+
+void EntityScriptEnginePoolTests::testNoEngineForEntity() {
+    EntityScriptEnginePool pool;
+    pool.setEngines(makeEngines(NUM_ENGINES));
+    EntityItemID entityID = QUuid::createUuid();
+
+    // calls to an entity without a script go nowhere, and its details are answered right away
+    pool.callEntityScriptMethod(entityID, "preload");
+    QFuture<QVariant> details = pool.getLocalEntityScriptDetails(entityID);
+    QVERIFY(details.isFinished());
+    QVERIFY(!details.result().isValid());
+}
+
+void EntityScriptEnginePoolTests::testEnvironmentIsolation() {
+    auto engines = makeEngines(2);
+    TestScriptEngine* first = asTestEngine(engines[0]);
+    TestScriptEngine* second = asTestEngine(engines[1]);
+    observedEngines = engines;
+
+    // a call runs as its entity on its own engine only, and the engine is itself again afterwards
+    EntityItemID entityID = QUuid::createUuid();
+    first->callWithEnvironment(entityID, QUrl(), first->newFunction(recordEnvironment), QScriptValue(),
+                               QScriptValueList());
+    QCOMPARE((int)seenEntityIdentifiers.size(), 2);
+    QCOMPARE(seenEntityIdentifiers[0], entityID);
+    QVERIFY(seenEntityIdentifiers[1].isNull());
+    QVERIFY(first->getCurrentEntityIdentifier().isNull());
+
+    // and the engines don't share globals
+    first->globalObject().setProperty("sharedByMistake", 1);
+    QVERIFY(first->globalObject().property("sharedByMistake").isValid());
+    QVERIFY(!second->globalObject().property("sharedByMistake").isValid());
+
+    observedEngines.clear();
+}
+
+void EntityScriptEnginePoolTests::testRunTimesOnlyForBoundEntities() {
+    auto engines = makeEngines(1);
+    TestScriptEngine* engine = asTestEngine(engines[0]);
+    EntityItemID entityID = QUuid::createUuid();
+
+    // not tracked: nothing is measured
+    engine->callWithEnvironment(entityID, QUrl(), engine->newFunction(spin), QScriptValue(), QScriptValueList());
+    QVERIFY(engine->getEntityScriptRunTimes().isEmpty());
+
+    // tracked, but the entity has no script loaded on the engine: calls don't add entries
+    engine->setTrackEntityScriptRunTimes(true);
+    engine->callWithEnvironment(entityID, QUrl(), engine->newFunction(spin), QScriptValue(), QScriptValueList());
+    QVERIFY(engine->getEntityScriptRunTimes().isEmpty());
+
+    // and the pool has nothing to attribute
+    EntityScriptEnginePool pool;
+    pool.setEngines(engines);
+    pool.assign(entityID, 0);
+    pool.updateRunTimes();
+    auto scripts = pool.getBusiestScripts(10);
+    QCOMPARE((int)scripts.size(), 1);
+    QCOMPARE(scripts[0].runTime, (quint64)0);
+}
@@ -0,0 +1,28 @@
+//
+//  EntityScriptEnginePoolTests.h
+//  tests/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEnginePoolTests_h
+#define hifi_EntityScriptEnginePoolTests_h
+
+#include <QtTest/QtTest>
+
+class EntityScriptEnginePoolTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testHashAssignment();
+    void testLoadAssignment();
+    void testSetEnginesForgetsAssignments();
+    void testNoEngineForEntity();
+    void testEnvironmentIsolation();
+    void testRunTimesOnlyForBoundEntities();
+};
+
+#endif // hifi_EntityScriptEnginePoolTests_h
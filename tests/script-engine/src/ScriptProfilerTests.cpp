@@ -0,0 +1,176 @@
+//
+//  ScriptProfilerTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfilerTests.h"
+
+#include <thread>
+
+#include <NumericalConstants.h>
+#include <ScriptProfiler.h>
+
+QTEST_MAIN(ScriptProfilerTests)
+
+static const ScriptProfiler::FunctionStats* findFunction(const std::vector<ScriptProfiler::FunctionStats>& functions,
+                                                         const QString& function) {
+    for (const auto& stats : functions) {
+        if (stats.function == function) {
+            return &stats;
+        }
+    }
+    return nullptr;
+}
+
+static const ScriptProfiler::CallStats* findCall(const std::vector<ScriptProfiler::CallStats>& calls,
+                                                 const QString& label) {
+    for (const auto& stats : calls) {
+        if (stats.label == label) {
+            return &stats;
+        }
+    }
+    return nullptr;
+}
+
+static void sleepFor(int msecs) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(msecs));
+}
+
+void ScriptProfilerTests::testRecursiveSamples() {
+    ScriptProfiler profiler;
+
+    // innermost first: a recursing function is on the stack once as far as the sample goes
+    profiler.recordSample({ "fib (a.js:1)", "fib (a.js:1)", "fib (a.js:1)", "main (a.js:10)" });
+    profiler.recordSample({ "helper (a.js:20)", "fib (a.js:1)", "main (a.js:10)" });
+    profiler.recordSample({});
+
+    QCOMPARE(profiler.getNumSamples(), 2);
+    auto functions = profiler.getHotFunctions(10);
+    QCOMPARE((int)functions.size(), 3);
+
+    auto fib = findFunction(functions, "fib (a.js:1)");
+    QVERIFY(fib);
+    QCOMPARE(fib->numSelfSamples, 1);
+    QCOMPARE(fib->numSamples, 2);
+
+    auto main = findFunction(functions, "main (a.js:10)");
+    QVERIFY(main);
+    QCOMPARE(main->numSelfSamples, 0);
+    QCOMPARE(main->numSamples, 2);
+
+    auto helper = findFunction(functions, "helper (a.js:20)");
+    QVERIFY(helper);
+    QCOMPARE(helper->numSelfSamples, 1);
+    QCOMPARE(helper->numSamples, 1);
+
+    profiler.reset();
+    QCOMPARE(profiler.getNumSamples(), 0);
+    QVERIFY(profiler.getHotFunctions(10).empty());
+}
+
+void ScriptProfilerTests::testHotFunctionOrder() {
+    ScriptProfiler profiler;
+    for (int i = 0; i < 5; ++i) {
+        profiler.recordSample({ "hot", "caller" });
+    }
+    for (int i = 0; i < 3; ++i) {
+        profiler.recordSample({ "warm", "caller" });
+    }
+    // as many self samples as 'cold', on the stack more often
+    profiler.recordSample({ "lukewarm", "caller" });
+    profiler.recordSample({ "cold", "lukewarm", "caller" });
+
+    // hottest first by self samples, then by samples anywhere on the stack
+    auto functions = profiler.getHotFunctions(10);
+    QCOMPARE((int)functions.size(), 5);
+    QCOMPARE(functions[0].function, QString("hot"));
+    QCOMPARE(functions[1].function, QString("warm"));
+    QCOMPARE(functions[2].function, QString("lukewarm"));
+    QCOMPARE(functions[3].function, QString("cold"));
+    QCOMPARE(functions[4].function, QString("caller"));
+
+    // truncating keeps the hottest, in the same order
+    auto top = profiler.getHotFunctions(3);
+    QCOMPARE((int)top.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(top[i].function, functions[i].function);
+    }
+    QVERIFY(profiler.getHotFunctions(0).empty());
+}
+
+void ScriptProfilerTests::testNestedScopes() {
+    ScriptProfiler profiler;
+    profiler.setEnabled(true);
+    {
+        // like the update signal running an entity's callback
+        ScriptProfiler::Scope outer(profiler, [] { return QString("update"); });
+        sleepFor(5);
+        {
+            ScriptProfiler::Scope inner(profiler, [] { return QString("entity method"); });
+            sleepFor(20);
+        }
+    }
+    profiler.setEnabled(false);
+
+    auto calls = profiler.getCallStats();
+    QCOMPARE((int)calls.size(), 2);
+    auto outer = findCall(calls, "update");
+    auto inner = findCall(calls, "entity method");
+    QVERIFY(outer && inner);
+    QCOMPARE(outer->numCalls, 1);
+    QCOMPARE(inner->numCalls, 1);
+
+    // the outer scope's total includes the inner one, its self time doesn't
+    QVERIFY(outer->wallTime >= inner->wallTime);
+    QCOMPARE(outer->selfWallTime + inner->wallTime, outer->wallTime);
+    QCOMPARE(inner->selfWallTime, inner->wallTime);
+    QVERIFY(outer->selfCpuTime <= outer->cpuTime);
+
+    // so self times never add up to more than the time profiled
+    QVERIFY(outer->selfWallTime + inner->selfWallTime <= profiler.getProfiledTime());
+}
+
+void ScriptProfilerTests::testDisabledScope() {
+    ScriptProfiler profiler;
+    bool labelBuilt = false;
+    {
+        ScriptProfiler::Scope scope(profiler, [&] {
+            labelBuilt = true;
+            return QString("timer");
+        });
+    }
+    QVERIFY(!labelBuilt);
+    QVERIFY(profiler.getCallStats().empty());
+}
+
+void ScriptProfilerTests::testProfiledTime() {
+    ScriptProfiler profiler;
+    QCOMPARE(profiler.getProfiledTime(), (quint64)0);
+
+    // only the time spent enabled counts
+    profiler.setEnabled(true);
+    sleepFor(10);
+    profiler.setEnabled(false);
+    quint64 firstTime = profiler.getProfiledTime();
+    QVERIFY(firstTime >= 10 * USECS_PER_MSEC);
+
+    sleepFor(10);
+    QCOMPARE(profiler.getProfiledTime(), firstTime);
+
+    // enabling again adds up, and the time keeps growing while enabled
+    profiler.setEnabled(true);
+    sleepFor(10);
+    quint64 runningTime = profiler.getProfiledTime();
+    QVERIFY(runningTime >= firstTime + 10 * USECS_PER_MSEC);
+    sleepFor(1);
+    QVERIFY(profiler.getProfiledTime() > runningTime);
+    profiler.setEnabled(false);
+
+    profiler.reset();
+    QCOMPARE(profiler.getProfiledTime(), (quint64)0);
+}
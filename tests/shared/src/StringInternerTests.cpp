@@ -0,0 +1,127 @@
+//
+//  StringInternerTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StringInternerTests.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <shared/StringInterner.h>
+
+QTEST_MAIN(StringInternerTests)
+
+// built at runtime so that equal strings start out with buffers of their own
+static QString makeString(const QString& prefix, int index) {
+    return prefix + QString::number(index);
+}
+
+void StringInternerTests::testSharedPayload() {
+    QString first = makeString("atp:/models/chair", 1);
+    QString second = makeString("atp:/models/chair", 1);
+    QVERIFY(first.constData() != second.constData());
+
+    quint64 numHits = StringInterner::getStats().numHits;
+    QString internedFirst = StringInterner::intern(first);
+    QString internedSecond = StringInterner::intern(second);
+
+    // equal strings come back as the same payload, with the value they went in with
+    QCOMPARE(internedFirst, first);
+    QCOMPARE(internedSecond, second);
+    QCOMPARE(internedFirst.constData(), internedSecond.constData());
+    QCOMPARE(StringInterner::getStats().numHits, numHits + 1);
+
+    QVERIFY(StringInterner::intern(QString()).isEmpty());
+    QVERIFY(StringInterner::intern(QString("")).isEmpty());
+}
+
+void StringInternerTests::testStableWhileHeld() {
+    QString held = StringInterner::intern(makeString("http://example.com/script", 2));
+    const QChar* payload = held.constData();
+
+    // pruning only drops strings nobody else references
+    StringInterner::prune();
+    QCOMPARE(StringInterner::intern(makeString("http://example.com/script", 2)).constData(), payload);
+
+    // neither do the automatic prunes that come with enough insertions
+    const int NUM_OTHER_STRINGS = 2000;
+    for (int i = 0; i < NUM_OTHER_STRINGS; ++i) {
+        StringInterner::intern(makeString("http://example.com/other", i));
+    }
+    QCOMPARE(StringInterner::intern(makeString("http://example.com/script", 2)).constData(), payload);
+}
+
+void StringInternerTests::testPrune() {
+    StringInterner::prune();
+    StringInterner::Stats before = StringInterner::getStats();
+
+    const int NUM_STRINGS = 100;
+    {
+        std::vector<QString> held;
+        for (int i = 0; i < NUM_STRINGS; ++i) {
+            held.push_back(StringInterner::intern(makeString("atp:/textures/prune", i)));
+        }
+        StringInterner::prune();
+        QCOMPARE(StringInterner::getStats().numStrings, before.numStrings + NUM_STRINGS);
+        QVERIFY(StringInterner::getStats().numBytes > before.numBytes);
+    }
+
+    StringInterner::prune();
+    StringInterner::Stats after = StringInterner::getStats();
+    QCOMPARE(after.numStrings, before.numStrings);
+    QCOMPARE(after.numBytes, before.numBytes);
+}
+
+void StringInternerTests::testAutomaticPrune() {
+    StringInterner::prune();
+    const int MIN_PRUNE_SIZE = 512;
+    int maxNumStrings = 2 * std::max(MIN_PRUNE_SIZE, StringInterner::getStats().numStrings);
+
+    // strings nobody holds on to don't pile up, the table is pruned before it grows past twice its pruned size
+    const int NUM_DROPPED_STRINGS = 10 * maxNumStrings;
+    for (int i = 0; i < NUM_DROPPED_STRINGS; ++i) {
+        StringInterner::intern(makeString("atp:/sounds/dropped", i));
+        QVERIFY(StringInterner::getStats().numStrings <= maxNumStrings);
+    }
+}
+
+void StringInternerTests::testConcurrentInterning() {
+    const int NUM_THREADS = 8;
+    const int NUM_STRINGS = 1000;
+
+    // every thread interns the same names from copies of its own, and keeps what it got back
+    std::vector<std::vector<QString>> results(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([i, &results] {
+            std::vector<QString>& result = results[i];
+            result.reserve(NUM_STRINGS);
+            for (int j = 0; j < NUM_STRINGS; ++j) {
+                // each thread walks the names from a different starting point to mix up who inserts first
+                int index = (j + i * (NUM_STRINGS / NUM_THREADS)) % NUM_STRINGS;
+                result.push_back(StringInterner::intern(makeString("atp:/models/concurrent", index)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        for (int j = 0; j < NUM_STRINGS; ++j) {
+            int index = (j + i * (NUM_STRINGS / NUM_THREADS)) % NUM_STRINGS;
+            const QString& interned = results[i][j];
+            QCOMPARE(interned, makeString("atp:/models/concurrent", index));
+            // all threads share the payload of whichever thread inserted the name first
+            int firstThreadJ = index;
+            QCOMPARE(interned.constData(), results[0][firstThreadJ].constData());
+        }
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  StringInternerTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_StringInternerTests_h
+#define hifi_StringInternerTests_h
+
+#include <QtTest/QtTest>
+
+class StringInternerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSharedPayload();
+    void testStableWhileHeld();
+    void testPrune();
+    void testAutomaticPrune();
+    void testConcurrentInterning();
+};
+
+#endif // hifi_StringInternerTests_h
@@ -0,0 +1,202 @@
+//
+//  TimerWheelTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <map>
+
+#include <shared/TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using Wheel = TimerWheel<int>;
+
+void TimerWheelTests::testExpiryOrder() {
+    Wheel wheel(1000);
+    wheel.schedule(1030, 3);
+    wheel.schedule(1010, 1);
+    wheel.schedule(1020, 2);
+    wheel.schedule(900, 0); // in the past, due on the next advance
+
+    std::vector<Wheel::Handle> expired;
+    wheel.advance(1001, expired);
+    QCOMPARE((int)expired.size(), 1);
+    QCOMPARE(*wheel.get(expired[0]), 0);
+
+    expired.clear();
+    wheel.advance(1025, expired);
+    QCOMPARE((int)expired.size(), 2);
+    QCOMPARE(*wheel.get(expired[0]), 1);
+    QCOMPARE(*wheel.get(expired[1]), 2);
+
+    // expired timers stay around until cancelled
+    QCOMPARE((int)wheel.size(), 4);
+    QCOMPARE((int)wheel.getNumScheduled(), 1);
+
+    expired.clear();
+    wheel.advance(1030, expired);
+    QCOMPARE((int)expired.size(), 1);
+    QCOMPARE(*wheel.get(expired[0]), 3);
+    QCOMPARE(wheel.getCurrentTick(), (uint64_t)1030);
+}
+
+void TimerWheelTests::testCancel() {
+    Wheel wheel;
+    auto first = wheel.schedule(10, 1);
+    auto second = wheel.schedule(10, 2);
+    auto third = wheel.schedule(10, 3);
+    QVERIFY(wheel.cancel(second));
+    QVERIFY(!wheel.cancel(second));
+    QVERIFY(!wheel.contains(second));
+    QCOMPARE((int)wheel.size(), 2);
+
+    std::vector<Wheel::Handle> expired;
+    wheel.advance(10, expired);
+    QCOMPARE((int)expired.size(), 2);
+    QVERIFY(std::find(expired.begin(), expired.end(), first) != expired.end());
+    QVERIFY(std::find(expired.begin(), expired.end(), third) != expired.end());
+
+    QVERIFY(wheel.cancel(first));
+    QVERIFY(wheel.cancel(third));
+    QCOMPARE((int)wheel.size(), 0);
+}
+
+void TimerWheelTests::testFarExpiry() {
+    // beyond what the four levels cover, so the timer is placed again as the wheel turns
+    const uint64_t FAR = 40000000;
+    Wheel wheel(5);
+    auto far = wheel.schedule(FAR, 1);
+    auto mid = wheel.schedule(70000, 2);
+
+    std::vector<Wheel::Handle> expired;
+    uint64_t now = 5;
+    while (now < FAR + 100) {
+        now += 997;
+        wheel.advance(now, expired);
+        for (auto handle : expired) {
+            uint64_t expected = handle == far ? FAR : 70000;
+            QVERIFY(now >= expected);
+            QVERIFY(now - expected < 997);
+            wheel.cancel(handle);
+        }
+        expired.clear();
+    }
+    QVERIFY(!wheel.contains(far));
+    QVERIFY(!wheel.contains(mid));
+}
+
+void TimerWheelTests::testReschedule() {
+    Wheel wheel;
+    auto interval = wheel.schedule(16, 7);
+    std::vector<Wheel::Handle> expired;
+    int numFired = 0;
+    for (uint64_t now = 1; now <= 160; ++now) {
+        wheel.advance(now, expired);
+        for (auto handle : expired) {
+            QCOMPARE(handle, interval);
+            QCOMPARE(now % 16, (uint64_t)0);
+            ++numFired;
+            QVERIFY(wheel.reschedule(handle, now + 16));
+        }
+        expired.clear();
+    }
+    QCOMPARE(numFired, 10);
+    QCOMPARE(*wheel.get(interval), 7);
+
+    // moving a pending timer earlier
+    QVERIFY(wheel.reschedule(interval, 170));
+    wheel.advance(170, expired);
+    QCOMPARE((int)expired.size(), 1);
+}
+
+void TimerWheelTests::testStaleHandles() {
+    Wheel wheel;
+    QVERIFY(!wheel.contains(Wheel::INVALID_HANDLE));
+    QVERIFY(wheel.get(Wheel::INVALID_HANDLE) == nullptr);
+    QVERIFY(!wheel.cancel(12345));
+
+    auto first = wheel.schedule(10, 1);
+    wheel.cancel(first);
+    // the slot is reused, the handle is not
+    auto second = wheel.schedule(10, 2);
+    QVERIFY(first != second);
+    QVERIFY(wheel.get(first) == nullptr);
+    QVERIFY(!wheel.reschedule(first, 20));
+    QCOMPARE(*wheel.get(second), 2);
+
+    // handles have to survive a round trip through a script number
+    QCOMPARE((Wheel::Handle)(double)second, second);
+
+    wheel.clear();
+    QVERIFY(!wheel.contains(second));
+    QCOMPARE((int)wheel.size(), 0);
+}
+
+void TimerWheelTests::testGenerationWrap() {
+    Wheel wheel;
+    auto stale = wheel.schedule(10, 1);
+    QVERIFY(wheel.cancel(stale));
+
+    // every other generation of the node goes by, the next timer on it would wrap back to the first handle
+    const int NUM_GENERATIONS = 1 << 21;
+    Wheel::Handle last = stale;
+    for (int i = 1; i < NUM_GENERATIONS; ++i) {
+        last = wheel.schedule(10, 2);
+        QVERIFY(wheel.cancel(last));
+    }
+    QVERIFY(last != stale);
+
+    // the node is retired rather than handing the first handle out again
+    auto live = wheel.schedule(10, 3);
+    QVERIFY(live != stale);
+    QVERIFY(!wheel.contains(stale));
+    QVERIFY(!wheel.cancel(stale));
+    QVERIFY(wheel.contains(live));
+    QCOMPARE(*wheel.get(live), 3);
+    QVERIFY(live < (1ULL << 53));
+}
+
+void TimerWheelTests::testRandomized() {
+    srand(42);
+    Wheel wheel(1000);
+    std::map<Wheel::Handle, uint64_t> pending;
+    std::vector<Wheel::Handle> expired;
+    uint64_t now = 1000;
+    for (int step = 0; step < 20000; ++step) {
+        int action = rand() % 4;
+        if (action == 0) {
+            uint64_t delay = (rand() % 3 == 0) ? (uint64_t)(rand() % 300000) : (uint64_t)(rand() % 200);
+            pending[wheel.schedule(now + delay, step)] = std::max(now + delay, now + 1);
+        } else if (action == 1 && !pending.empty()) {
+            auto itr = pending.begin();
+            std::advance(itr, rand() % pending.size());
+            QVERIFY(wheel.cancel(itr->first));
+            pending.erase(itr);
+        } else {
+            now += rand() % 40;
+            wheel.advance(now, expired);
+            uint64_t previous = 0;
+            for (auto handle : expired) {
+                auto itr = pending.find(handle);
+                QVERIFY(itr != pending.end());
+                QVERIFY(itr->second <= now);
+                QVERIFY(itr->second >= previous);
+                previous = itr->second;
+                wheel.cancel(handle);
+                pending.erase(itr);
+            }
+            expired.clear();
+            for (const auto& entry : pending) {
+                QVERIFY(entry.second > now);
+            }
+        }
+        QCOMPARE(wheel.size(), pending.size());
+    }
+}
@@ -0,0 +1,270 @@
+//
+//  FrameBenchApp.cpp
+//  tools/gpu-frame-bench/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameBenchApp.h"
+
+#include <algorithm>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <NumericalConstants.h>
+
+#include <gpu/Batch.h>
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/FrameIO.h>
+#include <gpu/FrameIOKeys.h>
+#include <gpu/null/NullBackend.h>
+
+const int DEFAULT_NUM_ITERATIONS = 100;
+
+// Smallest, mean and largest of a per batch quantity
+class Range {
+public:
+    void add(uint64_t value) {
+        min = (count == 0) ? value : std::min(min, value);
+        max = std::max(max, value);
+        total += value;
+        count++;
+    }
+
+    QJsonObject toJson() const {
+        QJsonObject result;
+        result["min"] = (qint64)min;
+        result["mean"] = count ? (double)total / (double)count : 0.0;
+        result["max"] = (qint64)max;
+        return result;
+    }
+
+    uint64_t min { 0 };
+    uint64_t max { 0 };
+    uint64_t total { 0 };
+    uint64_t count { 0 };
+};
+
+static QString formatRange(const Range& range) {
+    return QString("%1 / %2 / %3").arg(range.min).arg(range.count ? range.total / range.count : 0).arg(range.max);
+}
+
+FrameBenchApp::FrameBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity GPU Frame Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption iterationsOption("n", "number of times each frame is replayed", "count",
+                                              QString::number(DEFAULT_NUM_ITERATIONS));
+    parser.addOption(iterationsOption);
+
+    const QCommandLineOption profileCommandsOption("p", "time every command, which adds its own cost to the frame time");
+    parser.addOption(profileCommandsOption);
+
+    const QCommandLineOption jsonOption("o", "write the results to a json file", "filename.json");
+    parser.addOption(jsonOption);
+
+    const QCommandLineOption maxFrameTimeOption("max-frame-usecs", "fail if the median frame time of a frame exceeds it",
+                                                "usecs");
+    parser.addOption(maxFrameTimeOption);
+
+    parser.addPositionalArgument("frames", "frames captured with gpu::writeFrame", "frame.hfb...");
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption) || parser.positionalArguments().isEmpty()) {
+        parser.showHelp();
+        return;
+    }
+
+    _numIterations = std::max(1, parser.value(iterationsOption).toInt());
+    _profileCommands = parser.isSet(profileCommandsOption);
+    double maxFrameUsecs = parser.isSet(maxFrameTimeOption) ? parser.value(maxFrameTimeOption).toDouble() : 0.0;
+
+    gpu::Context::init<gpu::null::Backend>();
+    _context = std::make_shared<gpu::Context>();
+    // executeFrame needs the frame timer a first frame creates
+    _context->beginFrame();
+    _context->endFrame();
+
+    QJsonArray results;
+    for (const auto& filename : parser.positionalArguments()) {
+        if (!QFile::exists(filename)) {
+            qCritical() << "Failed to open file" << filename;
+            _returnCode = 2;
+            return;
+        }
+        auto frame = gpu::readFrame(filename.toStdString(), 0);
+        if (!frame) {
+            qCritical() << "Failed to read frame" << filename;
+            _returnCode = 2;
+            return;
+        }
+
+        auto result = benchmarkFrame(filename, frame);
+        if (maxFrameUsecs > 0.0 && result["medianFrameUsecs"].toDouble() > maxFrameUsecs) {
+            qCritical() << filename << "takes" << result["medianFrameUsecs"].toDouble() << "usecs per frame, more than"
+                        << maxFrameUsecs;
+            _returnCode = 3;
+        }
+        results.append(result);
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly)) {
+            qCritical() << "Failed to write" << file.fileName();
+            _returnCode = 2;
+            return;
+        }
+        file.write(QJsonDocument(results).toJson());
+    }
+
+    _context->shutdown();
+    _context.reset();
+}
+
+FrameBenchApp::~FrameBenchApp() {
+}
+
+QJsonObject FrameBenchApp::benchmarkFrame(const QString& filename, const gpu::FramePointer& frame) {
+    auto backend = std::static_pointer_cast<gpu::null::Backend>(_context->getBackend());
+
+    // What the frame holds
+    Range commands;
+    Range params;
+    Range data;
+    Range objects;
+    for (const auto& batch : frame->batches) {
+        commands.add(batch->getCommands().size());
+        params.add(batch->getParams().size());
+        data.add(batch->_data.size());
+        objects.add(batch->_objects.size());
+    }
+
+    // A first replay applies the buffer updates of the frame and warms up the caches
+    _context->executeFrame(frame);
+    backend->enableCommandProfiling(_profileCommands);
+    backend->resetReplayStats();
+
+    std::vector<qint64> frameNsecs;
+    frameNsecs.reserve(_numIterations);
+    uint64_t startAllocationCount = getAllocationCount();
+    QElapsedTimer timer;
+    for (int i = 0; i < _numIterations; i++) {
+        timer.start();
+        _context->executeFrame(frame);
+        frameNsecs.push_back(timer.nsecsElapsed());
+    }
+    uint64_t numAllocations = getAllocationCount() - startAllocationCount;
+    backend->enableCommandProfiling(false);
+
+    gpu::ContextStats frameStats;
+    _context->getFrameStats(frameStats);
+    const auto& replayStats = backend->getReplayStats();
+    const auto& commandsStats = backend->getCommandsStats();
+
+    std::sort(frameNsecs.begin(), frameNsecs.end());
+    double medianFrameUsecs = (double)frameNsecs[frameNsecs.size() / 2] / (double)NSECS_PER_USEC;
+    double minFrameUsecs = (double)frameNsecs.front() / (double)NSECS_PER_USEC;
+    double maxFrameUsecs = (double)frameNsecs.back() / (double)NSECS_PER_USEC;
+    double iterations = (double)_numIterations;
+
+    qInfo().noquote() << filename;
+    qInfo().noquote() << QString("  %1 batches, %2 iterations").arg(frame->batches.size()).arg(_numIterations);
+    qInfo().noquote() << QString("  frame time (usecs): median %1, min %2, max %3")
+        .arg(medianFrameUsecs, 0, 'f', 1).arg(minFrameUsecs, 0, 'f', 1).arg(maxFrameUsecs, 0, 'f', 1);
+    qInfo().noquote() << QString("  allocations per frame: %1").arg((double)numAllocations / iterations, 0, 'f', 1);
+    qInfo().noquote() << QString("  per batch (min / mean / max): commands %1, params %2, data bytes %3, objects %4")
+        .arg(formatRange(commands), formatRange(params), formatRange(data), formatRange(objects));
+    qInfo().noquote() << QString("  transform buffers per frame: %1 cameras (%2 bytes), objects %3 bytes, draw call infos %4 bytes")
+        .arg(replayStats.numCameras / _numIterations).arg(replayStats.cameraBufferSize / _numIterations)
+        .arg(replayStats.objectBufferSize / _numIterations).arg(replayStats.drawCallInfoBufferSize / _numIterations);
+    qInfo().noquote() << QString("  drawcalls %1 (API %2), triangles %3, pipelines %4, textures %5")
+        .arg(frameStats._DSNumDrawcalls).arg(frameStats._DSNumAPIDrawcalls).arg(frameStats._DSNumTriangles)
+        .arg(frameStats._PSNumSetPipelines).arg(frameStats._RSNumTextureBounded);
+
+    QJsonObject result;
+    result["file"] = filename;
+    result["numBatches"] = (qint64)frame->batches.size();
+    result["iterations"] = _numIterations;
+    result["medianFrameUsecs"] = medianFrameUsecs;
+    result["minFrameUsecs"] = minFrameUsecs;
+    result["maxFrameUsecs"] = maxFrameUsecs;
+    result["allocationsPerFrame"] = (double)numAllocations / iterations;
+
+    QJsonObject batchSizes;
+    batchSizes["commands"] = commands.toJson();
+    batchSizes["params"] = params.toJson();
+    batchSizes["dataBytes"] = data.toJson();
+    batchSizes["objects"] = objects.toJson();
+    result["batchSizes"] = batchSizes;
+
+    QJsonObject transformBuffers;
+    transformBuffers["cameras"] = (double)replayStats.numCameras / iterations;
+    transformBuffers["cameraBytes"] = (double)replayStats.cameraBufferSize / iterations;
+    transformBuffers["objectBytes"] = (double)replayStats.objectBufferSize / iterations;
+    transformBuffers["drawCallInfoBytes"] = (double)replayStats.drawCallInfoBufferSize / iterations;
+    result["transformBuffers"] = transformBuffers;
+
+    QJsonObject stats;
+    stats["drawcalls"] = (qint64)frameStats._DSNumDrawcalls;
+    stats["apiDrawcalls"] = (qint64)frameStats._DSNumAPIDrawcalls;
+    stats["triangles"] = (qint64)frameStats._DSNumTriangles;
+    stats["pipelines"] = (qint64)frameStats._PSNumSetPipelines;
+    stats["textures"] = (qint64)frameStats._RSNumTextureBounded;
+    result["stats"] = stats;
+
+    // Commands by the time they take, or by count when they are not timed
+    std::vector<int> order;
+    for (int i = 0; i < gpu::Batch::NUM_COMMANDS; i++) {
+        if (commandsStats[i].count > 0) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        if (commandsStats[a].nsecs != commandsStats[b].nsecs) {
+            return commandsStats[a].nsecs > commandsStats[b].nsecs;
+        }
+        return commandsStats[a].count > commandsStats[b].count;
+    });
+
+    qInfo().noquote() << QString("  %1 %2 %3 %4").arg("command", -40).arg("per frame", 12).arg("usecs/frame", 12)
+        .arg("nsecs/command", 14);
+    QJsonObject commandResults;
+    for (int i : order) {
+        const auto& commandStats = commandsStats[i];
+        double countPerFrame = (double)commandStats.count / iterations;
+        double usecsPerFrame = (double)commandStats.nsecs / (iterations * (double)NSECS_PER_USEC);
+        double nsecsPerCommand = (double)commandStats.nsecs / (double)commandStats.count;
+        qInfo().noquote() << QString("  %1 %2 %3 %4").arg(gpu::keys::COMMAND_NAMES[i], -40)
+            .arg(countPerFrame, 12, 'f', 0).arg(usecsPerFrame, 12, 'f', 2).arg(nsecsPerCommand, 14, 'f', 1);
+
+        QJsonObject commandResult;
+        commandResult["perFrame"] = countPerFrame;
+        if (_profileCommands) {
+            commandResult["usecsPerFrame"] = usecsPerFrame;
+            commandResult["nsecsPerCommand"] = nsecsPerCommand;
+        }
+        commandResults[gpu::keys::COMMAND_NAMES[i]] = commandResult;
+    }
+    result["commands"] = commandResults;
+
+    return result;
+}
@@ -0,0 +1,41 @@
+//
+//  FrameBenchApp.h
+//  tools/gpu-frame-bench/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrameBenchApp_h
+#define hifi_FrameBenchApp_h
+
+#include <QCoreApplication>
+#include <QJsonObject>
+
+#include <gpu/Forward.h>
+
+uint64_t getAllocationCount();
+
+// Replays frames captured with gpu::writeFrame through the null gpu backend, without a window or a graphics API, and
+// reports what executing them costs on the CPU: time per frame and per command type, batch and transform buffer sizes
+// and allocations.  A maximum frame time turns it into a pass / fail check for machines without a GPU.
+class FrameBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    FrameBenchApp(int argc, char* argv[]);
+    ~FrameBenchApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    QJsonObject benchmarkFrame(const QString& filename, const gpu::FramePointer& frame);
+
+    gpu::ContextPointer _context;
+    int _numIterations { 0 };
+    bool _profileCommands { false };
+    int _returnCode { 0 };
+};
+
+#endif // hifi_FrameBenchApp_h
@@ -0,0 +1,44 @@
+//
+//  main.cpp
+//  tools/gpu-frame-bench/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <SharedUtil.h>
+
+#include "FrameBenchApp.h"
+
+// Count every allocation made by the tool and the libraries linked into it, to report the allocations of a replay
+static std::atomic<uint64_t> allocationCount { 0 };
+
+uint64_t getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* pointer = malloc(size ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("GPU Frame Bench");
+
+    FrameBenchApp app(argc, argv);
+    return app.getReturnCode();
+}
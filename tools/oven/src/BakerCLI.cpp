@@ -18,6 +18,9 @@
 
 #include <unordered_map>
 
+#include <NumericalConstants.h>
+#include <image/TextureProcessing.h>
+
 #include "OvenCLIApplication.h"
 #include "ModelBakingLoggingCategory.h"
 #include "baking/BakerLibrary.h"
@@ -113,6 +116,15 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
 
 void BakerCLI::handleFinishedBaker() {
     qCDebug(model_baking) << "Finished baking file.";
+
+    auto timings = image::getTextureProcessingTimings();
+    if (timings.numImages > 0) {
+        qCDebug(model_baking) << "Processed" << timings.numImages << "texture images:"
+            << timings.convertUsecs / USECS_PER_MSEC << "ms converting,"
+            << timings.mipUsecs / USECS_PER_MSEC << "ms building mips,"
+            << timings.compressUsecs / USECS_PER_MSEC << "ms compressing";
+    }
+
     int exitCode = OVEN_STATUS_CODE_SUCCESS;
     // Do we need this?
     if (_baker->wasAborted()) {